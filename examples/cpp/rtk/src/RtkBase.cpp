@@ -167,6 +167,8 @@ auto main(int argc, char* argv[]) -> int
         return -1;
     }
 
+    uint64_t lastBundle =
+        ubxHat->rtk()->base()->corrections()->lastBundleSequence();
     while (g_running)
     {
         const auto pvt = ubxHat->waitAndGetFreshNavigation().pvt;
@@ -186,16 +188,19 @@ auto main(int argc, char* argv[]) -> int
                 "[%s] RTK Base ready with TimeOnlyFix\r\n",
                 time.c_str()
             );
-            const auto rtcm3Frames =
-                ubxHat->rtk()->base()->getFullCorrections();
-
-            std::for_each(
-                rtcm3Frames.cbegin(),
-                rtcm3Frames.cend(),
-                [&time](const auto& f) { printFrame(f, time); }
-            );
-
-            caster.feed(rtcm3Frames);
+            // Every epoch completed since the last pass, each sent once
+            const auto bundles =
+                ubxHat->rtk()->base()->corrections()->bundlesAfter(lastBundle);
+            for (const auto& bundle : bundles)
+            {
+                std::for_each(
+                    bundle->messages.cbegin(),
+                    bundle->messages.cend(),
+                    [&time](const auto& m) { printFrame(m->frame, time); }
+                );
+                caster.feed(bundle->messages);
+                lastBundle = bundle->sequence;
+            }
             caster.updatePosition(pvt.latitude, pvt.longitude);
 
             if (caster.clientCount() > 0)
@@ -100,6 +100,9 @@ int main(int argc, char* argv[])
                 host, port, mount);
 
     // ── Main loop ───────────────────────────────────────────────────
+    // Each epoch's MSM bundle is pushed exactly once, never a stale frame
+    auto* base = hat->rtk()->base();
+    uint64_t lastBundle = base->corrections()->lastBundleSequence();
     while (g_running)
     {
         const auto nav = hat->waitAndGetFreshNavigation();
@@ -110,11 +113,12 @@ int main(int argc, char* argv[])
             continue;
         }
 
-        auto corrections = hat->rtk()->base()->getFullCorrections();
-        if (!corrections.empty())
-            server.feed(corrections);
-
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const auto bundles = base->corrections()->bundlesAfter(lastBundle);
+        for (const auto& bundle : bundles)
+        {
+            server.feed(bundle->messages);
+            lastBundle = bundle->sequence;
+        }
     }
 
     auto stats = server.getStats();
@@ -17,7 +17,7 @@ using namespace JimmyPaputto;
 namespace
 {
     /// Bit-by-bit reference CRC-24Q (poly 0x1864CFB, MSB-first, init 0)
-    /// to validate the table-driven implementation in RtcmAnalyzer.
+    /// to validate the slicing and carry-less multiply paths of Crc24q.hpp.
     uint32_t crc24qReference(const uint8_t* data, size_t len)
     {
         constexpr uint32_t kPoly = 0x1864CFB;
@@ -103,11 +103,37 @@ TEST(RtcmCrc24q, MatchesBitwiseReference)
     for (const auto& s : samples)
     {
         uint32_t expected = crc24qReference(s.data(), s.size());
-        uint32_t got = detail::crc24q(s.data(), s.size());
+        uint32_t got = crc24q(s.data(), s.size());
         EXPECT_EQ(got, expected);
     }
 }
 
+TEST(RtcmCrc24q, MatchesReferenceUpToMaxFrameAtAnyAlignment)
+{
+    // Every length up to a full 1029-byte frame crosses each tail case of
+    // both the 8-byte slicing loop and the 64/16-byte folding loops
+    std::vector<uint8_t> data(1029 + 8);
+    uint32_t state = 0x12345678;
+    for (auto& byte : data)
+    {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+
+    for (size_t offset = 0; offset < 8; offset += 3)
+    {
+        for (size_t len = 0; len <= 1029; ++len)
+        {
+            const uint8_t* p = data.data() + offset;
+            ASSERT_EQ(crc24q(p, len), crc24qReference(p, len))
+                << "offset " << offset << " length " << len;
+            ASSERT_EQ(detail::crc24qSlicing(0, p, len) >> 8,
+                      crc24qReference(p, len))
+                << "offset " << offset << " length " << len;
+        }
+    }
+}
+
 // ------------------------------------------------------------ msmGnss()
 
 TEST(MsmClassify, MapsMsgTypeToConstellation)
@@ -13,11 +13,14 @@
 #include "ublox/Gnss.hpp"
 #include "ublox/GnssConfig.hpp"
 #include "ublox/NmeaForwarder.hpp"
+#include "ublox/NtpShmFeed.hpp"
 #include "ublox/RtkFactory.hpp"
 #include "ublox/Run.hpp"
 #include "ublox/SpiDriver.hpp"
+#include "ublox/StreamServer.hpp"
 #include "ublox/Timepulse.hpp"
 #include "ublox/TimeMarkTrigger.hpp"
+#include "ublox/RecordingCommDriver.hpp"
 #include "ublox/TxReady.hpp"
 #include "ublox/UartDriver.hpp"
 #include "ublox/Ublox.hpp"
@@ -82,17 +85,30 @@ public:
 
     template<class StartupStrategy, class RunStrategy>
     bool start(const GnssConfig& config);
+    bool recordTo(const std::string& path) override;
     Navigation waitAndGetFreshNavigation() override;
     Navigation navigation() const override;
+    NavigationEpoch navigationEpoch() const override;
+    std::shared_ptr<NavigationSubscription> subscribeNavigation(
+        std::size_t capacity, EOverflowPolicy policy) override;
+    UbxDispatcher& ubxDispatcher() override;
+    UbxFrameTap& ubxFrameTap() override;
     bool enableTimepulse() override;
     void disableTimepulse() override;
-    bool startForwardForGpsd() override;
+    bool startForwardForGpsd(const NmeaOutputConfig& output) override;
     void stopForwardForGpsd() override;
     void joinForwardForGpsd() override;
     std::string getGpsdDevicePath() const override;
+    NmeaForwarderStats gpsdForwardingStats() const override;
+    bool startStreamServer(const StreamServerConfig& config) override;
+    void stopStreamServer() override;
+    StreamServerStats streamServerStats() const override;
+    bool startNtpShm(uint8_t unit) override;
+    void stopNtpShm() override;
+    PpsOffsetStats ppsOffsetStats() const override;
     void hardResetUbloxSom_ColdStart() const override;
     void softResetUbloxSom_HotStart() override;
-    void timepulse() override;
+    EdgeTimestamp timepulse() override;
 
     std::optional<TimeMark> timeMark() const override;
     TimeMark waitAndGetFreshTimeMark() override;
@@ -102,6 +118,10 @@ public:
     void triggerTimeMark(ETimeMarkTriggerEdge edge) override;
 
     SystemHealth systemHealth() const override;
+    SpiDrainStats spiDrainStats() const override;
+    RtcmUartStats rtcmUartStats() const override;
+    UartLinkStats uartLinkStats() const override;
+    LatencySnapshot ingressLatency(EUbxMsg msg) const override;
     std::string swVersion() const override
     {
         return gnss_.swVersion();
@@ -119,16 +139,21 @@ protected:
     void stopUbloxThread();
     virtual std::optional<std::reference_wrapper<Rtcm3Store>> rtcm3Store();
 
+    Gnss gnss_;
+    UbxDispatcher ubxDispatcher_;
+    UbxFrameTap ubxFrameTap_;
     std::unique_ptr<ICommDriver> commDriver_;
+    std::unique_ptr<RecordingCommDriver> recordingCommDriver_;
     std::unique_ptr<IUbloxConfigRegistry> configRegistry_;
     std::unique_ptr<UbxParser> ubxParser_;
     std::unique_ptr<IRunStrategy> runStrategy_;
     std::unique_ptr<IStartupStrategy> startupStrategy_;
     std::unique_ptr<Ublox> ublox_;
-    Gnss& gnss_;
     std::unique_ptr<TxReadyInterrupt> txReady_;
     std::unique_ptr<Timepulse> timepulse_;
     std::unique_ptr<NmeaForwarder> nmeaForwarder_;
+    std::unique_ptr<NtpShmFeed> ntpShmFeed_;
+    std::unique_ptr<StreamServer> streamServer_;
     Notifier txReadyNotifier_;
     Notifier timepulseNotifier_;
     Notifier navigationNotifier_;
@@ -178,6 +203,7 @@ public:
         stopSource_.request_stop();
         stopUbloxThread();
         nmeaForwarder_.reset();
+        streamServer_.reset();
     }
 
     bool start(const GnssConfig& config) override
@@ -202,7 +228,7 @@ public:
     TimeMark waitAndGetFreshTimeMark() override
     {
         timeMarkNotifier_.wait(stopSource_.get_token());
-        return Gnss::instance().timeMark().value_or(TimeMark{});
+        return gnss_.timeMark().value_or(TimeMark{});
     }
 
     SystemHealth systemHealth() const override
@@ -358,7 +384,6 @@ GnssHat::GnssHat(std::unique_ptr<ICommDriver>&& commDriver)
     ubxParser_(nullptr),
     startupStrategy_(nullptr),
     ublox_(nullptr),
-    gnss_(Gnss::instance()),
     txReady_(nullptr),
     timepulse_(nullptr),
     nmeaForwarder_(nullptr)
@@ -370,8 +395,10 @@ GnssHat::~GnssHat()
     stopSource_.request_stop();
     stopUbloxThread();
     txReady_.reset();
+    ntpShmFeed_.reset();
     timepulse_.reset();
     nmeaForwarder_.reset();
+    streamServer_.reset();
 }
 
 template<class StartupStrategy>
@@ -397,10 +424,40 @@ bool validateConfig(const GnssConfig& config)
             return false;
         }
 
+        if (!checkSpiProfile(config.spi))
+            return false;
+
+        if constexpr (std::is_same_v<StartupStrategy, M9NStartup>)
+        {
+            if (config.maxUartBaudrate.has_value())
+            {
+                fprintf(
+                    stderr,
+                    "[GnssConfig] M9N does not use its UART - "
+                    "maxUartBaudrate must be nullopt\r\n"
+                );
+                return false;
+            }
+        }
+        else if (!checkUartBaudrate(config.maxUartBaudrate))
+        {
+            return false;
+        }
+
         return checkGeofencing(config.geofencing);
     }
     else if constexpr (std::is_same_v<StartupStrategy, F10TStartup>)
     {
+        if (config.spi.has_value())
+        {
+            fprintf(
+                stderr,
+                "[GnssConfig] F10T is connected over UART, SPI profile "
+                "does not apply\r\n"
+            );
+            return false;
+        }
+
         if (config.geofencing.has_value())
         {
             fprintf(
@@ -419,6 +476,8 @@ bool validateConfig(const GnssConfig& config)
             );
             return false;
         }
+        if (!checkUartBaudrate(config.maxUartBaudrate))
+            return false;
         return checkTiming(config.timing);
     }
 
@@ -435,27 +494,37 @@ bool GnssHat::start(const GnssConfig& config)
     }
 
     config_ = config;
+    if constexpr (!std::is_same_v<StartupStrategy, F10TStartup>)
+    {
+        if (config.spi.has_value())
+            static_cast<SpiDriver&>(*commDriver_).setProfile(*config.spi);
+    }
     configRegistry_ = std::make_unique<UbloxConfigRegistry>(config_);
     constexpr bool callbackNotificationEnabled =
         std::is_same_v<RunStrategy, F10TRun>;
     ubxParser_ = std::make_unique<UbxParser>(
-        *configRegistry_, navigationNotifier_, timeMarkNotifier_,
-        callbackNotificationEnabled
+        *configRegistry_, gnss_, navigationNotifier_, timeMarkNotifier_,
+        callbackNotificationEnabled, &ubxDispatcher_, &ubxFrameTap_
     );
     startupStrategy_ = std::make_unique<StartupStrategy>(
-        *commDriver_, *configRegistry_, *ubxParser_
+        *commDriver_, *configRegistry_, *ubxParser_, gnss_
     );
+    // Startup casts the driver to its concrete type, only the run phase
+    // goes through the recorder
+    ICommDriver& runCommDriver = recordingCommDriver_
+        ? static_cast<ICommDriver&>(*recordingCommDriver_)
+        : *commDriver_;
     if constexpr (std::is_same_v<RunStrategy, F9PRun>)
     {
         runStrategy_ = createRunStrategy<RunStrategy>(
-            *commDriver_, *ubxParser_, txReadyNotifier_, navigationNotifier_,
+            runCommDriver, *ubxParser_, txReadyNotifier_, navigationNotifier_,
             rtcm3Store()->get(), config
         );
     }
     else
     {
         runStrategy_ = createRunStrategy<RunStrategy>(
-            *commDriver_, *ubxParser_, txReadyNotifier_, navigationNotifier_
+            runCommDriver, *ubxParser_, txReadyNotifier_, navigationNotifier_
         );
     }
     ublox_ = std::make_unique<Ublox>(
@@ -470,6 +539,12 @@ bool GnssHat::start(const GnssConfig& config)
         return false;
     }
 
+    if constexpr (std::is_same_v<RunStrategy, F10TRun>)
+    {
+        static_cast<F10TRun&>(*runStrategy_).setBaudrate(
+            static_cast<UartDriver&>(*commDriver_).currentBaudrate());
+    }
+
     if (config.geofencing.has_value())
     {
         const auto& geo = config.geofencing.value();
@@ -486,7 +561,7 @@ bool GnssHat::start(const GnssConfig& config)
     if constexpr (!std::is_same_v<RunStrategy, F10TRun>)
     {
         txReady_ = std::make_unique<TxReadyInterrupt>(
-            txReadyNotifier_, config.measurementRate_Hz
+            txReadyNotifier_, gnss_, config.measurementRate_Hz
         );
         txReady_->run();
     }
@@ -509,24 +584,33 @@ Navigation GnssHat::waitAndGetFreshNavigation()
         return empty;
     }
 
-    Navigation navigation;
-    if (gnss_.lock())
-    {
-        navigation = gnss_.navigation();
-        gnss_.unlock();
-    }
-    return navigation;
+    return gnss_.navigation();
 }
 
 Navigation GnssHat::navigation() const
 {
-    Navigation navigation;
-    if (gnss_.lock())
-    {
-        navigation = gnss_.navigation();
-        gnss_.unlock();
-    }
-    return navigation;
+    return gnss_.navigation();
+}
+
+NavigationEpoch GnssHat::navigationEpoch() const
+{
+    return gnss_.navigationEpoch();
+}
+
+std::shared_ptr<NavigationSubscription> GnssHat::subscribeNavigation(
+    std::size_t capacity, EOverflowPolicy policy)
+{
+    return gnss_.subscribe(capacity, policy);
+}
+
+UbxDispatcher& GnssHat::ubxDispatcher()
+{
+    return ubxDispatcher_;
+}
+
+UbxFrameTap& GnssHat::ubxFrameTap()
+{
+    return ubxFrameTap_;
 }
 
 bool GnssHat::enableTimepulse()
@@ -537,7 +621,7 @@ bool GnssHat::enableTimepulse()
         return true;
     }
 
-    timepulse_ = std::make_unique<Timepulse>(timepulseNotifier_);
+    timepulse_ = std::make_unique<Timepulse>(timepulseNotifier_, gnss_);
     timepulse_->run();
     timepulseEnabled_.store(true);
     return true;
@@ -548,6 +632,7 @@ void GnssHat::disableTimepulse()
     if (!timepulseEnabled_.load())
         return;
 
+    ntpShmFeed_.reset();
     timepulse_.reset();
     timepulseEnabled_.store(false);
 }
@@ -570,7 +655,7 @@ void GnssHat::softResetUbloxSom_HotStart()
     commDriver_->transmitReceive(txBuffer, rxBuffer);
 }
 
-void GnssHat::timepulse()
+EdgeTimestamp GnssHat::timepulse()
 {
     if (!timepulseEnabled_.load() || !timepulse_)
     {
@@ -578,9 +663,10 @@ void GnssHat::timepulse()
             stderr,
             "[GNSS] Timepulse not enabled. Call enableTimepulse() first.\r\n"
         );
-        return;
+        return {};
     }
     timepulseNotifier_.wait();
+    return gnss_.timepulseEdge();
 }
 
 std::optional<TimeMark> GnssHat::timeMark() const
@@ -592,6 +678,29 @@ std::optional<TimeMark> GnssHat::timeMark() const
     return std::nullopt;
 }
 
+SpiDrainStats GnssHat::spiDrainStats() const
+{
+    const auto* spiRun = dynamic_cast<const M9NRun*>(runStrategy_.get());
+    return spiRun ? spiRun->drainStats() : SpiDrainStats{};
+}
+
+RtcmUartStats GnssHat::rtcmUartStats() const
+{
+    const auto* rtkRun = dynamic_cast<const F9PRun*>(runStrategy_.get());
+    return rtkRun ? rtkRun->roverUartStats() : RtcmUartStats{};
+}
+
+UartLinkStats GnssHat::uartLinkStats() const
+{
+    const auto* uartRun = dynamic_cast<const F10TRun*>(runStrategy_.get());
+    return uartRun ? uartRun->linkStats() : UartLinkStats{};
+}
+
+LatencySnapshot GnssHat::ingressLatency(EUbxMsg msg) const
+{
+    return ubxParser_ ? ubxParser_->ingressLatency(msg) : LatencySnapshot{};
+}
+
 SystemHealth GnssHat::systemHealth() const
 {
     fprintf(stderr,
@@ -631,7 +740,7 @@ void GnssHat::triggerTimeMark(ETimeMarkTriggerEdge)
         static_cast<int>(name().size()), name().data());
 }
 
-bool GnssHat::startForwardForGpsd()
+bool GnssHat::startForwardForGpsd(const NmeaOutputConfig& output)
 {
     if (nmeaForwarder_ && nmeaForwarder_->isRunning())
     {
@@ -648,7 +757,7 @@ bool GnssHat::startForwardForGpsd()
         return false;
     }
 
-    nmeaForwarder_->startForwarding(gnss_);
+    nmeaForwarder_->startForwarding(gnss_, output);
     return true;
 }
 
@@ -675,6 +784,95 @@ std::string GnssHat::getGpsdDevicePath() const
     return "";
 }
 
+NmeaForwarderStats GnssHat::gpsdForwardingStats() const
+{
+    return nmeaForwarder_ ? nmeaForwarder_->stats() : NmeaForwarderStats{};
+}
+
+bool GnssHat::startStreamServer(const StreamServerConfig& config)
+{
+    streamServer_.reset();
+    streamServer_ = std::make_unique<StreamServer>(gnss_, ubxDispatcher_,
+        config);
+    if (!streamServer_->start())
+    {
+        fprintf(stderr, "[GNSS] Failed to start stream server\r\n");
+        streamServer_.reset();
+        return false;
+    }
+    return true;
+}
+
+void GnssHat::stopStreamServer()
+{
+    streamServer_.reset();
+}
+
+StreamServerStats GnssHat::streamServerStats() const
+{
+    return streamServer_ ? streamServer_->stats() : StreamServerStats{};
+}
+
+bool GnssHat::startNtpShm(uint8_t unit)
+{
+    if (!timepulseEnabled_.load())
+    {
+        fprintf(stderr,
+            "[GNSS] NTP SHM needs the timepulse, call enableTimepulse() "
+            "first\r\n");
+        return false;
+    }
+
+    const auto& pin = config_.timepulsePinConfig;
+    if (!pin.active || pin.fixedPulse.frequency != 1 ||
+        pin.polarity != ETimepulsePinPolarity::RisingEdgeAtTopOfSecond)
+    {
+        fprintf(stderr,
+            "[GNSS] NTP SHM needs a 1 Hz timepulse rising at the top of "
+            "the second\r\n");
+        return false;
+    }
+
+    ntpShmFeed_.reset();
+    ntpShmFeed_ = std::make_unique<NtpShmFeed>(gnss_, unit);
+    if (!ntpShmFeed_->isAttached())
+    {
+        ntpShmFeed_.reset();
+        return false;
+    }
+    printf("[GNSS] Feeding NTP SHM unit %u\r\n", unit);
+    return true;
+}
+
+void GnssHat::stopNtpShm()
+{
+    ntpShmFeed_.reset();
+}
+
+PpsOffsetStats GnssHat::ppsOffsetStats() const
+{
+    return ntpShmFeed_ ? ntpShmFeed_->stats() : PpsOffsetStats{};
+}
+
+bool GnssHat::recordTo(const std::string& path)
+{
+    if (runStrategy_)
+    {
+        fprintf(stderr, "[GNSS] recordTo() must be called before start()\r\n");
+        return false;
+    }
+
+    recordingCommDriver_ = std::make_unique<RecordingCommDriver>(
+        *commDriver_, path
+    );
+    if (!recordingCommDriver_->isRecording())
+    {
+        recordingCommDriver_.reset();
+        return false;
+    }
+    return true;
+}
+
 void GnssHat::stopUbloxThread()
 {
     ubloxThread_.request_stop();
@@ -7,15 +7,28 @@
 
 #include "Version.hpp"
 
+#include <memory>
 #include <string>
 #include <string_view>
 #include <optional>
 
 #include "ublox/GnssConfig.hpp"
 #include "ublox/Navigation.hpp"
+#include "ublox/NavigationEpoch.hpp"
+#include "ublox/NavigationSubscription.hpp"
+#include "ublox/NmeaForwarderStats.hpp"
+#include "ublox/NmeaOutputConfig.hpp"
+#include "ublox/PpsOffsetStats.hpp"
 #include "ublox/RTK.hpp"
+#include "ublox/RtcmUartStats.hpp"
+#include "ublox/SpiDrainStats.hpp"
+#include "ublox/StreamServerConfig.hpp"
+#include "ublox/UartLinkStats.hpp"
 #include "ublox/SystemHealth.hpp"
 #include "ublox/TimeMark.hpp"
+#include "ublox/UbxDispatcher.hpp"
+#include "ublox/UbxFrameSinks.hpp"
+#include "ublox/UbxFrameTap.hpp"
 
 #include "ntrip/NtripCaster.hpp"
 #include "ntrip/NtripClient.hpp"
@@ -29,29 +42,79 @@ class IGnssHat
 public:
     virtual bool start(const GnssConfig& config) = 0;
 
+    // Tees everything read from the receiver after startup into `path`
+    // (see CommRecording) for offline replay. Call before start().
+    virtual bool recordTo(const std::string& path) = 0;
+
     virtual std::string_view name() const = 0;
 
     virtual Navigation navigation() const = 0;
     virtual Navigation waitAndGetFreshNavigation() = 0;
+    virtual NavigationEpoch navigationEpoch() const = 0;
+
+    // Every epoch published from now on is queued for the returned
+    // subscription until it is popped or the queue overflows. Dropping
+    // the last copy of the handle unsubscribes.
+    virtual std::shared_ptr<NavigationSubscription> subscribeNavigation(
+        std::size_t capacity = 16,
+        EOverflowPolicy policy = EOverflowPolicy::DropOldest) = 0;
+
+    // Callback runs on a dispatcher worker with the decoded
+    // UbxPayload_t<Msg>; raw frames, unsubscribe and latency stats are on
+    // ubxDispatcher().
+    template<EUbxMsg Msg, typename Callback>
+    UbxSubscriptionId subscribe(Callback&& callback)
+    {
+        return ubxDispatcher().subscribe<Msg>(
+            std::forward<Callback>(callback));
+    }
+    virtual UbxDispatcher& ubxDispatcher() = 0;
+    // Raw frames inline on the receiver thread, and which ones get decoded
+    virtual UbxFrameTap& ubxFrameTap() = 0;
 
     virtual void hardResetUbloxSom_ColdStart() const = 0;
     virtual void softResetUbloxSom_HotStart() = 0;
 
     virtual IRtk* rtk() = 0;
 
-    virtual bool startForwardForGpsd() = 0;
+    virtual bool startForwardForGpsd(
+        const NmeaOutputConfig& output = {}) = 0;
     virtual void stopForwardForGpsd() = 0;
     virtual void joinForwardForGpsd() = 0;
     virtual std::string getGpsdDevicePath() const = 0;
+    // Epochs the gpsd pty took whole, cut at a sentence or dropped
+    virtual NmeaForwarderStats gpsdForwardingStats() const = 0;
+
+    // NMEA, raw UBX and binary epoch records to local TCP and Unix socket
+    // clients, next to or instead of the gpsd pty
+    virtual bool startStreamServer(const StreamServerConfig& config) = 0;
+    virtual void stopStreamServer() = 0;
+    virtual StreamServerStats streamServerStats() const = 0;
 
     virtual bool enableTimepulse() = 0;
     virtual void disableTimepulse() = 0;
-    virtual void timepulse() = 0;
+    // Blocks until the next pulse and returns its kernel edge timestamp
+    virtual EdgeTimestamp timepulse() = 0;
+    // Pairs timepulse edges with the NAV-PVT second and writes the offset
+    // samples to NTP SHM refclock `unit` for chrony or ntpd. Needs
+    // enableTimepulse() and a 1 Hz pulse rising at the top of the second.
+    virtual bool startNtpShm(uint8_t unit = 0) = 0;
+    virtual void stopNtpShm() = 0;
+    virtual PpsOffsetStats ppsOffsetStats() const = 0;
 
     virtual std::optional<TimeMark> timeMark() const = 0;
     virtual TimeMark waitAndGetFreshTimeMark() = 0;
 
     virtual SystemHealth systemHealth() const = 0;
+    // Run-loop SPI bus usage; all zero on UART receivers
+    virtual SpiDrainStats spiDrainStats() const = 0;
+    // Corrections written to the F9P by an RTK rover; all zero otherwise
+    virtual RtcmUartStats rtcmUartStats() const = 0;
+    // Per-epoch load of the F10T UART; all zero on SPI receivers
+    virtual UartLinkStats uartLinkStats() const = 0;
+    // From the read that completed a message to the end of its callbacks;
+    // only the F10T UART loop timestamps its reads
+    virtual LatencySnapshot ingressLatency(EUbxMsg msg) const = 0;
     virtual std::string swVersion() const = 0;
     virtual std::string hwVersion() const = 0;
     virtual std::vector<std::string> monVerExtensions() const = 0;
@@ -995,7 +995,8 @@ jp_gnss_rtk_corrections_t* jp_gnss_rtk_get_full_corrections(
     if (!base)
         return nullptr;
 
-    auto cpp_corrections = base->getFullCorrections();
+    const auto cpp_corrections =
+        base->corrections()->select(IBase::fullCorrectionIds);
     if (cpp_corrections.empty())
         return nullptr;
 
@@ -1015,7 +1016,7 @@ jp_gnss_rtk_corrections_t* jp_gnss_rtk_get_full_corrections(
     for (uint32_t i = 0; i < result->count; ++i)
     {
         result->frames[i].size =
-            static_cast<uint32_t>(cpp_corrections[i].size());
+            static_cast<uint32_t>(cpp_corrections[i]->frame.size());
         result->frames[i].data =
             new (std::nothrow) uint8_t[result->frames[i].size];
         if (!result->frames[i].data)
@@ -1026,7 +1027,7 @@ jp_gnss_rtk_corrections_t* jp_gnss_rtk_get_full_corrections(
             delete result;
             return nullptr;
         }
-        std::memcpy(result->frames[i].data, cpp_corrections[i].data(),
+        std::memcpy(result->frames[i].data, cpp_corrections[i]->frame.data(),
             result->frames[i].size);
     }
 
@@ -1047,7 +1048,8 @@ jp_gnss_rtk_corrections_t* jp_gnss_rtk_get_tiny_corrections(
     if (!base)
         return nullptr;
 
-    auto cpp_corrections = base->getTinyCorrections();
+    const auto cpp_corrections =
+        base->corrections()->select(IBase::tinyCorrectionIds);
     if (cpp_corrections.empty())
         return nullptr;
 
@@ -1067,7 +1069,7 @@ jp_gnss_rtk_corrections_t* jp_gnss_rtk_get_tiny_corrections(
     for (uint32_t i = 0; i < result->count; ++i)
     {
         result->frames[i].size =
-            static_cast<uint32_t>(cpp_corrections[i].size());
+            static_cast<uint32_t>(cpp_corrections[i]->frame.size());
         result->frames[i].data =
             new (std::nothrow) uint8_t[result->frames[i].size];
         if (!result->frames[i].data)
@@ -1078,7 +1080,7 @@ jp_gnss_rtk_corrections_t* jp_gnss_rtk_get_tiny_corrections(
             delete result;
             return nullptr;
         }
-        std::memcpy(result->frames[i].data, cpp_corrections[i].data(),
+        std::memcpy(result->frames[i].data, cpp_corrections[i]->frame.data(),
             result->frames[i].size);
     }
 
@@ -1470,7 +1472,8 @@ uint32_t jp_gnss_ntrip_client_receive(
         return 0;
     }
 
-    auto cpp_frames = client->instance->receiveFrames();
+    RtcmFrameBatch cpp_frames;
+    client->instance->receiveFrames(cpp_frames);
     if (cpp_frames.empty())
     {
         *frames_out = nullptr;
@@ -0,0 +1,13 @@
+/*
+ * Jimmy Paputto — auto-generated by CMake, do not edit.
+ */
+
+#ifndef GNSS_HAT_VERSION_HPP_
+#define GNSS_HAT_VERSION_HPP_
+
+#define GNSS_HAT_VERSION_MAJOR 1
+#define GNSS_HAT_VERSION_MINOR 0
+#define GNSS_HAT_VERSION_PATCH 0
+#define GNSS_HAT_VERSION "1.0.0"
+
+#endif  /* GNSS_HAT_VERSION_HPP_ */
@@ -0,0 +1,149 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_BOUNDED_QUEUE_HPP_
+#define JIMMY_PAPUTTO_BOUNDED_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+
+namespace JimmyPaputto
+{
+
+// Fixed-capacity lock-free queue (Vyukov's bounded MPMC design).
+//
+// Every cell carries a sequence number telling whether it is free for the
+// next push or holds a value for the next pop, so a cell is reused only
+// after the thread reading it is done. Values are copy-assigned into
+// preallocated cells: a T owning heap memory stops allocating once its
+// capacity has been reached. Any thread may pop, which lets a producer drop
+// the oldest entry of a full queue without racing the consumer. A single
+// cell cannot tell "full" from "free" apart, so capacity is at least two.
+template<typename T>
+class BoundedQueue final
+{
+public:
+    explicit BoundedQueue(const std::size_t capacity)
+    :   capacity_(capacity > 1 ? capacity : 2),
+        cells_(std::make_unique<Cell[]>(capacity_)),
+        enqueuePos_(0),
+        dequeuePos_(0)
+    {
+        for (std::size_t i = 0; i < capacity_; i++)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bool tryPush(const T& value)
+    {
+        return push([&value](T& cell) { cell = value; });
+    }
+
+    // Lets the caller fill the cell in place, e.g. assign a span into a
+    // vector cell without building a temporary T first
+    template<typename WriteFn>
+    bool tryPushWith(WriteFn&& write)
+    {
+        return push(std::forward<WriteFn>(write));
+    }
+
+    bool tryPop(T& out)
+    {
+        return pop([&out](T& value) { out = value; });
+    }
+
+    // Pops the oldest entry without copying it out
+    bool discard()
+    {
+        return pop([](T&) {});
+    }
+
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value = T();
+    };
+
+    template<typename WriteFn>
+    bool push(WriteFn&& write)
+    {
+        auto pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &cells_[pos % capacity_];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) -
+                static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                    std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        write(cell->value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename ReadFn>
+    bool pop(ReadFn&& read)
+    {
+        auto pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &cells_[pos % capacity_];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) -
+                static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1,
+                    std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        read(cell->value);
+        cell->sequence.store(pos + capacity_, std::memory_order_release);
+        return true;
+    }
+
+    const std::size_t capacity_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<std::size_t> enqueuePos_;
+    alignas(64) std::atomic<std::size_t> dequeuePos_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_BOUNDED_QUEUE_HPP_
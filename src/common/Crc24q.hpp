@@ -0,0 +1,197 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_CRC24Q_HPP_
+#define JIMMY_PAPUTTO_CRC24Q_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define JIMMY_PAPUTTO_CRC24Q_CLMUL 1
+#endif
+
+
+namespace JimmyPaputto
+{
+
+// CRC-24Q as RTCM 10403.x frames it: polynomial 0x1864CFB, MSB first,
+// initial value 0, no final xor. Header only, so ntrip-caster-pub carries
+// the same file; the GnssHat CMake configure step fails if they differ.
+//
+// The 24-bit register is kept in the top of a 32-bit one, i.e. CRC-24Q is
+// run as a CRC-32 over G(x) = P(x) * x^8 and the remainder comes out
+// shifted left by 8. That keeps the slicing tables byte aligned and the
+// folding constants 32 bits wide.
+namespace detail
+{
+
+constexpr uint64_t crc24qPoly = 0x1864CFBull << 8;
+
+using Crc24qTables = std::array<std::array<uint32_t, 256>, 8>;
+
+// tables[k][b]: byte b followed by k zero bytes
+constexpr Crc24qTables crc24qMakeTables()
+{
+    Crc24qTables tables{};
+    for (uint32_t b = 0; b < 256; b++)
+    {
+        uint32_t crc = b << 24;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80000000u) ?
+                (crc << 1) ^ static_cast<uint32_t>(crc24qPoly) : crc << 1;
+        }
+        tables[0][b] = crc;
+    }
+    for (std::size_t k = 1; k < tables.size(); k++)
+    {
+        for (uint32_t b = 0; b < 256; b++)
+        {
+            const uint32_t previous = tables[k - 1][b];
+            tables[k][b] = (previous << 8) ^ tables[0][previous >> 24];
+        }
+    }
+    return tables;
+}
+
+inline constexpr Crc24qTables crc24qTables = crc24qMakeTables();
+
+inline uint32_t loadBE32(const uint8_t* data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) |
+        (static_cast<uint32_t>(data[1]) << 16) |
+        (static_cast<uint32_t>(data[2]) << 8) |
+        static_cast<uint32_t>(data[3]);
+}
+
+// Slicing-by-8: one table lookup per byte, but the eight of a word are
+// independent, so they overlap instead of waiting on each other's result
+inline uint32_t crc24qSlicing(uint32_t crc, const uint8_t* data,
+    std::size_t length)
+{
+    const auto& t = crc24qTables;
+    for (; length >= 8; data += 8, length -= 8)
+    {
+        const uint32_t hi = crc ^ loadBE32(data);
+        const uint32_t lo = loadBE32(data + 4);
+        crc = t[7][hi >> 24] ^ t[6][(hi >> 16) & 0xFF] ^
+            t[5][(hi >> 8) & 0xFF] ^ t[4][hi & 0xFF] ^
+            t[3][lo >> 24] ^ t[2][(lo >> 16) & 0xFF] ^
+            t[1][(lo >> 8) & 0xFF] ^ t[0][lo & 0xFF];
+    }
+    for (; length > 0; data++, length--)
+        crc = (crc << 8) ^ t[0][(crc >> 24) ^ *data];
+    return crc;
+}
+
+#ifdef JIMMY_PAPUTTO_CRC24Q_CLMUL
+
+// x^n mod G
+constexpr uint64_t crc24qXPowMod(const unsigned n)
+{
+    uint64_t remainder = 1;
+    for (unsigned i = 0; i < n; i++)
+    {
+        remainder <<= 1;
+        if (remainder & (1ull << 32))
+            remainder ^= crc24qPoly;
+    }
+    return remainder;
+}
+
+// Below this the setup costs more than folding saves
+constexpr std::size_t crc24qClmulMinLength = 64;
+
+__attribute__((target("pclmul,ssse3")))
+inline __m128i crc24qLoad(const uint8_t* data)
+{
+    // First byte is the highest-order coefficient
+    const __m128i reverse = _mm_setr_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), reverse);
+}
+
+// A 128-bit chunk H * x^64 + L moved n bits further along the message:
+// H * (x^(n+64) mod G) + L * (x^n mod G), congruent and still 128 bits
+__attribute__((target("pclmul,ssse3")))
+inline __m128i crc24qFold(const __m128i chunk, const __m128i constants)
+{
+    return _mm_xor_si128(_mm_clmulepi64_si128(chunk, constants, 0x11),
+        _mm_clmulepi64_si128(chunk, constants, 0x00));
+}
+
+// Four 16-byte accumulators advance 64 bytes per round, each product
+// independent of the other three; the remainder of what is left is the
+// remainder of the whole message, and that goes through the tables
+__attribute__((target("pclmul,ssse3")))
+inline uint32_t crc24qClmul(const uint8_t* data, std::size_t length)
+{
+    const __m128i by512 = _mm_set_epi64x(
+        static_cast<int64_t>(crc24qXPowMod(512 + 64)),
+        static_cast<int64_t>(crc24qXPowMod(512)));
+    const __m128i by128 = _mm_set_epi64x(
+        static_cast<int64_t>(crc24qXPowMod(128 + 64)),
+        static_cast<int64_t>(crc24qXPowMod(128)));
+
+    __m128i acc0 = crc24qLoad(data);
+    __m128i acc1 = crc24qLoad(data + 16);
+    __m128i acc2 = crc24qLoad(data + 32);
+    __m128i acc3 = crc24qLoad(data + 48);
+    data += 64;
+    length -= 64;
+
+    for (; length >= 64; data += 64, length -= 64)
+    {
+        acc0 = _mm_xor_si128(crc24qFold(acc0, by512), crc24qLoad(data));
+        acc1 = _mm_xor_si128(crc24qFold(acc1, by512), crc24qLoad(data + 16));
+        acc2 = _mm_xor_si128(crc24qFold(acc2, by512), crc24qLoad(data + 32));
+        acc3 = _mm_xor_si128(crc24qFold(acc3, by512), crc24qLoad(data + 48));
+    }
+
+    __m128i acc = _mm_xor_si128(crc24qFold(acc0, by128), acc1);
+    acc = _mm_xor_si128(crc24qFold(acc, by128), acc2);
+    acc = _mm_xor_si128(crc24qFold(acc, by128), acc3);
+    for (; length >= 16; data += 16, length -= 16)
+        acc = _mm_xor_si128(crc24qFold(acc, by128), crc24qLoad(data));
+
+    alignas(16) uint8_t rest[32];
+    const __m128i reverse = _mm_setr_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    _mm_store_si128(reinterpret_cast<__m128i*>(rest),
+        _mm_shuffle_epi8(acc, reverse));
+    std::memcpy(rest + 16, data, length);
+    return crc24qSlicing(0, rest, 16 + length);
+}
+
+inline bool crc24qHasClmul()
+{
+    static const bool hasClmul = __builtin_cpu_supports("pclmul") &&
+        __builtin_cpu_supports("ssse3");
+    return hasClmul;
+}
+
+#endif  // JIMMY_PAPUTTO_CRC24Q_CLMUL
+
+}  // namespace detail
+
+// Slicing-by-8 tables everywhere; on x86-64 CPUs with PCLMULQDQ, checked
+// once at runtime, anything from 64 bytes up is folded with carry-less
+// multiplies instead
+inline uint32_t crc24q(const uint8_t* data, std::size_t length)
+{
+#ifdef JIMMY_PAPUTTO_CRC24Q_CLMUL
+    if (length >= detail::crc24qClmulMinLength && detail::crc24qHasClmul())
+        return detail::crc24qClmul(data, length) >> 8;
+#endif
+    return detail::crc24qSlicing(0, data, length) >> 8;
+}
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_CRC24Q_HPP_
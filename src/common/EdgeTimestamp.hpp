@@ -0,0 +1,33 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_EDGE_TIMESTAMP_HPP_
+#define JIMMY_PAPUTTO_EDGE_TIMESTAMP_HPP_
+
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+// A GPIO edge as the kernel stamped it in its interrupt handler, before
+// any scheduling delay of the thread that handled it
+struct EdgeTimestamp
+{
+    uint64_t sequence = 0;      // edges seen on the line, 0 means none yet
+    int64_t monotonic_ns = 0;   // [ns] CLOCK_MONOTONIC
+    // [ns] the same instant on CLOCK_REALTIME, mapped through both clocks
+    // read together when the edge was handled
+    int64_t realtime_ns = 0;
+    int64_t handled_ns = 0;     // [ns] CLOCK_MONOTONIC in the handler thread
+
+    bool valid() const { return sequence > 0; }
+
+    // Interrupt to user space, what a second sampling layer would add
+    int64_t wakeupLatency_ns() const { return handled_ns - monotonic_ns; }
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_EDGE_TIMESTAMP_HPP_
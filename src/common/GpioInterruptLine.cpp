@@ -4,6 +4,7 @@
 
 #include "GpioInterruptLine.hpp"
 
+#include <chrono>
 #include <cstdio>
 #include <exception>
 
@@ -16,17 +17,17 @@ namespace JimmyPaputto
 {
 
 GpioInterruptLine::GpioInterruptLine(
-    unsigned int pin, Edge edge, const char* consumer)
+    unsigned int pin, Edge edge, const char* consumer, const char* chipName)
 :   pin_(pin)
 {
 #if LIBGPIOD_VERSION >= 2
-    chip_ = gpiod_chip_open(CHIP_NAME);
+    chip_ = gpiod_chip_open(chipName);
     if (!chip_)
     {
         fprintf(
             stderr,
             "[GpioInterruptLine] Failed to open gpiochip %s\r\n",
-            CHIP_NAME
+            chipName
         );
         std::terminate();
     }
@@ -48,6 +49,7 @@ GpioInterruptLine::GpioInterruptLine(
         case Edge::Both:    edgeType = GPIOD_LINE_EDGE_BOTH;    break;
     }
     gpiod_line_settings_set_edge_detection(settings, edgeType);
+    gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_MONOTONIC);
 
     struct gpiod_line_config* config = gpiod_line_config_new();
     if (!config)
@@ -102,13 +104,13 @@ GpioInterruptLine::GpioInterruptLine(
         std::terminate();
     }
 #else
-    chip_ = gpiod_chip_open_by_name(CHIP_NAME);
+    chip_ = gpiod_chip_open_by_name(chipName);
     if (!chip_)
     {
         fprintf(
             stderr,
             "[GpioInterruptLine] Failed to open gpiochip %s\r\n",
-            CHIP_NAME
+            chipName
         );
         std::terminate();
     }
@@ -187,12 +189,16 @@ GpioInterruptLine::EventType GpioInterruptLine::waitEvent(int64_t timeoutNs)
         return EventType::Error;
 
     auto type = gpiod_edge_event_get_event_type(event);
-    if (type == GPIOD_EDGE_EVENT_RISING_EDGE)
-        return EventType::Rising;
-    if (type == GPIOD_EDGE_EVENT_FALLING_EDGE)
-        return EventType::Falling;
+    if (type != GPIOD_EDGE_EVENT_RISING_EDGE &&
+        type != GPIOD_EDGE_EVENT_FALLING_EDGE)
+    {
+        return EventType::Error;
+    }
 
-    return EventType::Error;
+    stamp(static_cast<int64_t>(gpiod_edge_event_get_timestamp_ns(event)));
+    return type == GPIOD_EDGE_EVENT_RISING_EDGE
+        ? EventType::Rising
+        : EventType::Falling;
 #else
     const struct timespec* tsPtr = nullptr;
     struct timespec ts{};
@@ -214,15 +220,33 @@ GpioInterruptLine::EventType GpioInterruptLine::waitEvent(int64_t timeoutNs)
     if (ret < 0)
         return EventType::Error;
 
-    if (event.event_type == GPIOD_LINE_EVENT_RISING_EDGE)
-        return EventType::Rising;
-    if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
-        return EventType::Falling;
+    if (event.event_type != GPIOD_LINE_EVENT_RISING_EDGE &&
+        event.event_type != GPIOD_LINE_EVENT_FALLING_EDGE)
+    {
+        return EventType::Error;
+    }
 
-    return EventType::Error;
+    // The v1 character device stamps with CLOCK_MONOTONIC since Linux 5.7
+    stamp(static_cast<int64_t>(event.ts.tv_sec) * 1'000'000'000 +
+        event.ts.tv_nsec);
+    return event.event_type == GPIOD_LINE_EVENT_RISING_EDGE
+        ? EventType::Rising
+        : EventType::Falling;
 #endif
 }
 
+void GpioInterruptLine::stamp(const int64_t kernelTimestamp_ns)
+{
+    const auto handled = monotonicNow().count();
+    const auto realtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    lastEdge_.sequence++;
+    lastEdge_.monotonic_ns = kernelTimestamp_ns;
+    lastEdge_.handled_ns = handled;
+    lastEdge_.realtime_ns = kernelTimestamp_ns + (realtime - handled);
+}
+
 int GpioInterruptLine::getValue() const
 {
 #if LIBGPIOD_VERSION >= 2
@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include "EdgeTimestamp.hpp"
+
 
 struct gpiod_chip;
 #if LIBGPIOD_VERSION >= 2
@@ -37,7 +39,8 @@ public:
         Error
     };
 
-    GpioInterruptLine(unsigned int pin, Edge edge, const char* consumer);
+    GpioInterruptLine(unsigned int pin, Edge edge, const char* consumer,
+        const char* chipName = CHIP_NAME);
     ~GpioInterruptLine();
 
     GpioInterruptLine(const GpioInterruptLine&) = delete;
@@ -46,11 +49,16 @@ public:
     GpioInterruptLine& operator=(GpioInterruptLine&&) = delete;
 
     EventType waitEvent(int64_t timeoutNs = -1);
+    // Kernel timestamp of the last Rising or Falling event returned
+    const EdgeTimestamp& lastEdge() const { return lastEdge_; }
 
     int getValue() const;
 
 private:
+    void stamp(int64_t kernelTimestamp_ns);
+
     unsigned int pin_;
+    EdgeTimestamp lastEdge_;
     struct gpiod_chip* chip_ = nullptr;
 #if LIBGPIOD_VERSION >= 2
     struct gpiod_line_request* lineReq_ = nullptr;
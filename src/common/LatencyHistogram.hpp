@@ -0,0 +1,91 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_LATENCY_HISTOGRAM_HPP_
+#define JIMMY_PAPUTTO_LATENCY_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+struct LatencySnapshot
+{
+    // Bucket 0 counts samples below 1 us, bucket i samples in
+    // [2^(i-1), 2^i) us; the last bucket also takes everything slower
+    static constexpr uint8_t numberOfBuckets = 24;
+
+    std::array<uint64_t, numberOfBuckets> buckets;
+    uint64_t count;
+    uint64_t max_ns;
+
+    static constexpr uint64_t bucketUpperBound_us(const uint8_t bucket)
+    {
+        return uint64_t(1) << bucket;
+    }
+
+    // Upper bound of the bucket holding the q-th quantile, 0 when empty
+    uint64_t percentile_us(const double q) const
+    {
+        if (count == 0)
+            return 0;
+
+        const auto rank = static_cast<uint64_t>(q * (count - 1)) + 1;
+        uint64_t seen = 0;
+        for (uint8_t i = 0; i < numberOfBuckets; i++)
+        {
+            seen += buckets[i];
+            if (seen >= rank)
+                return bucketUpperBound_us(i);
+        }
+        return bucketUpperBound_us(numberOfBuckets - 1);
+    }
+};
+
+// Log2-bucketed latency histogram. record() is a couple of relaxed atomic
+// increments, so it can sit on a hot path and be read from any thread.
+class LatencyHistogram final
+{
+public:
+    void record(const std::chrono::nanoseconds latency)
+    {
+        const auto ns = static_cast<uint64_t>(
+            latency.count() > 0 ? latency.count() : 0);
+        const auto us = ns / 1000;
+        const auto bucket = std::min<uint64_t>(std::bit_width(us),
+            LatencySnapshot::numberOfBuckets - 1);
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+
+        auto max = max_ns_.load(std::memory_order_relaxed);
+        while (ns > max && !max_ns_.compare_exchange_weak(max, ns,
+            std::memory_order_relaxed));
+    }
+
+    LatencySnapshot snapshot() const
+    {
+        LatencySnapshot snapshot;
+        for (uint8_t i = 0; i < LatencySnapshot::numberOfBuckets; i++)
+            snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        snapshot.count = count_.load(std::memory_order_relaxed);
+        snapshot.max_ns = max_ns_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, LatencySnapshot::numberOfBuckets>
+        buckets_ {};
+    std::atomic<uint64_t> count_ {0};
+    std::atomic<uint64_t> max_ns_ {0};
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_LATENCY_HISTOGRAM_HPP_
@@ -0,0 +1,85 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "NtpShm.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+
+namespace JimmyPaputto
+{
+
+NtpShmSegment::NtpShmSegment(uint8_t unit)
+:   NtpShmSegment(baseKey + unit, unit < 2 ? 0600 : 0666)
+{
+}
+
+NtpShmSegment::NtpShmSegment(key_t key, int permissions)
+:   shmId_(shmget(key, sizeof(NtpShmTime), IPC_CREAT | permissions)),
+    shm_(nullptr)
+{
+    if (shmId_ < 0)
+    {
+        fprintf(stderr, "[NtpShm] shmget(0x%08X) failed: %s\r\n",
+            static_cast<unsigned>(key), strerror(errno));
+        return;
+    }
+
+    void* shm = shmat(shmId_, nullptr, 0);
+    if (shm == reinterpret_cast<void*>(-1))
+    {
+        fprintf(stderr, "[NtpShm] shmat(0x%08X) failed: %s\r\n",
+            static_cast<unsigned>(key), strerror(errno));
+        return;
+    }
+
+    shm_ = static_cast<NtpShmTime*>(shm);
+    shm_->valid = 0;
+    shm_->mode = 1;
+    shm_->nsamples = 3;
+}
+
+NtpShmSegment::~NtpShmSegment()
+{
+    if (shm_)
+        shmdt(shm_);
+}
+
+void NtpShmSegment::publish(const int64_t clockTime_ns,
+    const int64_t receiveTime_ns, const int precision, const int leap)
+{
+    if (!shm_)
+        return;
+
+    constexpr int64_t nsPerSecond = 1'000'000'000;
+    const auto clockSec = clockTime_ns / nsPerSecond;
+    const auto clockNSec = clockTime_ns % nsPerSecond;
+    const auto receiveSec = receiveTime_ns / nsPerSecond;
+    const auto receiveNSec = receiveTime_ns % nsPerSecond;
+
+    // Same sequence as gpsd: a reader racing with us sees `count` move or
+    // `valid` cleared and drops the sample
+    shm_->valid = 0;
+    shm_->count = shm_->count + 1;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    shm_->clockTimeStampSec = static_cast<time_t>(clockSec);
+    shm_->clockTimeStampUSec = static_cast<int>(clockNSec / 1000);
+    shm_->clockTimeStampNSec = static_cast<unsigned>(clockNSec);
+    shm_->receiveTimeStampSec = static_cast<time_t>(receiveSec);
+    shm_->receiveTimeStampUSec = static_cast<int>(receiveNSec / 1000);
+    shm_->receiveTimeStampNSec = static_cast<unsigned>(receiveNSec);
+    shm_->leap = leap;
+    shm_->precision = precision;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    shm_->count = shm_->count + 1;
+    shm_->valid = 1;
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,68 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_NTP_SHM_HPP_
+#define JIMMY_PAPUTTO_NTP_SHM_HPP_
+
+#include <cstdint>
+#include <ctime>
+
+#include <sys/types.h>
+
+
+namespace JimmyPaputto
+{
+
+// Segment layout of the NTP shared-memory refclock, as read by ntpd's
+// SHM driver and chrony's "refclock SHM"
+struct NtpShmTime
+{
+    int mode;
+    volatile int count;
+    time_t clockTimeStampSec;
+    int clockTimeStampUSec;
+    time_t receiveTimeStampSec;
+    int receiveTimeStampUSec;
+    int leap;
+    int precision;
+    int nsamples;
+    volatile int valid;
+    unsigned clockTimeStampNSec;
+    unsigned receiveTimeStampNSec;
+    int dummy[8];
+};
+
+// Writer side of one SHM refclock unit in mode 1: the reader takes a
+// sample only if `count` did not move while it copied and `valid` is set
+class NtpShmSegment
+{
+public:
+    static constexpr key_t baseKey = 0x4E545030;  // "NTP0"
+    static constexpr int leapNoWarning = 0;
+    static constexpr int leapNotInSync = 3;
+
+    // Units 0 and 1 are root-only as ntpd expects, the rest world-writable
+    explicit NtpShmSegment(uint8_t unit);
+    NtpShmSegment(key_t key, int permissions);
+    ~NtpShmSegment();
+
+    NtpShmSegment(const NtpShmSegment&) = delete;
+    NtpShmSegment& operator=(const NtpShmSegment&) = delete;
+
+    bool isAttached() const { return shm_ != nullptr; }
+    int shmId() const { return shmId_; }
+
+    // clockTime is the reference time of an event, receiveTime the system
+    // clock at that same event, both in CLOCK_REALTIME nanoseconds
+    void publish(int64_t clockTime_ns, int64_t receiveTime_ns,
+        int precision, int leap = leapNoWarning);
+
+private:
+    int shmId_;
+    NtpShmTime* shm_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_NTP_SHM_HPP_
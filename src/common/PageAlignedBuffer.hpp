@@ -0,0 +1,69 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_PAGE_ALIGNED_BUFFER_HPP_
+#define JIMMY_PAPUTTO_PAGE_ALIGNED_BUFFER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <utility>
+
+
+namespace JimmyPaputto
+{
+
+// Fixed-size byte buffer starting on a page boundary, for transfer buffers
+// handed to the kernel (spidev maps them page by page).
+class PageAlignedBuffer final
+{
+public:
+    static constexpr std::size_t pageSize = 4096;
+
+    explicit PageAlignedBuffer(const std::size_t size, const uint8_t fill = 0)
+    :   data_(static_cast<uint8_t*>(
+            ::operator new[](size, std::align_val_t(pageSize)))),
+        size_(size)
+    {
+        std::memset(data_, fill, size_);
+    }
+
+    ~PageAlignedBuffer()
+    {
+        ::operator delete[](data_, std::align_val_t(pageSize));
+    }
+
+    PageAlignedBuffer(PageAlignedBuffer&& other) noexcept
+    :   data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    PageAlignedBuffer& operator=(PageAlignedBuffer&& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    PageAlignedBuffer(const PageAlignedBuffer&) = delete;
+    PageAlignedBuffer& operator=(const PageAlignedBuffer&) = delete;
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    uint8_t& operator[](const std::size_t i) { return data_[i]; }
+
+    std::span<uint8_t> span() { return { data_, size_ }; }
+
+private:
+    uint8_t* data_;
+    std::size_t size_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_PAGE_ALIGNED_BUFFER_HPP_
@@ -0,0 +1,86 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_SNAPSHOT_BUFFER_HPP_
+#define JIMMY_PAPUTTO_SNAPSHOT_BUFFER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+
+namespace JimmyPaputto
+{
+
+// Single-writer, many-reader publication of a value without locks.
+//
+// The writer fills a slot that is neither current nor pinned by a reader
+// and then flips `current_` to it; a reader pins the current slot, checks
+// it is still current and copies it out. Neither side ever waits on the
+// other, and T may own heap memory (vectors are copy-assigned into a slot,
+// so their capacity is reused once warmed up).
+//
+// publish() always succeeds for a single writer. Readers only pin a slot
+// while copying it and never wait on the writer, so when more of them are
+// copying at once than there are spare slots the writer yields until one
+// of those copies finishes; no update is ever dropped.
+template<typename T, uint8_t numberOfSlots = 4>
+class SnapshotBuffer final
+{
+    static_assert(numberOfSlots >= 3);
+
+public:
+    void publish(const T& value)
+    {
+        const auto current = current_.load();
+        while (true)
+        {
+            for (uint8_t i = 0; i < numberOfSlots; i++)
+            {
+                auto& slot = slots_[i];
+                if (i == current || slot.readers.load() != 0)
+                    continue;
+
+                slot.value = value;
+                current_.store(i);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    T read() const
+    {
+        while (true)
+        {
+            const auto current = current_.load();
+            auto& slot = slots_[current];
+            slot.readers.fetch_add(1);
+            // The writer only fills slots that are not current, so if the
+            // slot is still current after pinning it cannot be overwritten
+            if (current_.load() == current)
+            {
+                T value = slot.value;
+                slot.readers.fetch_sub(1);
+                return value;
+            }
+            slot.readers.fetch_sub(1);
+        }
+    }
+
+private:
+    struct alignas(64) Slot
+    {
+        mutable std::atomic<uint32_t> readers = 0;
+        T value = T();
+    };
+
+    std::array<Slot, numberOfSlots> slots_;
+    std::atomic<uint8_t> current_ = 0;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_SNAPSHOT_BUFFER_HPP_
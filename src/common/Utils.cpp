@@ -9,6 +9,7 @@
 #include <thread>
 
 #include <gpiod.h>
+#include <time.h>
 
 
 bool try3times(std::function<bool()> task)
@@ -26,6 +27,20 @@ bool try3times(std::function<bool()> task)
     return result;
 }
 
+std::chrono::nanoseconds monotonicRawNow()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+std::chrono::nanoseconds monotonicNow()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
 void setGpio(const char* chipname, const uint32_t line_num, int value)
 {
 #if LIBGPIOD_VERSION < 2
@@ -6,6 +6,7 @@
 #define JIMMY_PAPUTTO_UTILS_HPP_
 
 #include <bit>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <functional>
@@ -20,6 +21,12 @@ bool try3times(std::function<bool()> configureFunction);
 void setGpio(const char* chipname, const uint32_t line_num, int value);
 int getGpio(const char* chipname, const uint32_t line_num);
 
+// CLOCK_MONOTONIC_RAW: not slewed by NTP, so intervals between two
+// readings are what the oscillator counted
+std::chrono::nanoseconds monotonicRawNow();
+// CLOCK_MONOTONIC, the clock GPIO edge events are stamped with
+std::chrono::nanoseconds monotonicNow();
+
 template<typename E, E beginVal, E endVal>
 constexpr uint8_t countEnum()
 {
@@ -0,0 +1,159 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "HttpChunkedDecoder.hpp"
+
+#include <algorithm>
+
+namespace JimmyPaputto
+{
+
+    namespace
+    {
+        // 15 hex digits keep the size well inside uint64_t
+        constexpr uint8_t maxSizeDigits = 15;
+
+        int hexValue(uint8_t c)
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+            return -1;
+        }
+    }
+
+    std::span<const uint8_t> HttpChunkedDecoder::next(
+        std::span<const uint8_t> &data)
+    {
+        while (!data.empty())
+        {
+            if (state_ == EState::Data)
+            {
+                const size_t run = static_cast<size_t>(
+                    std::min<uint64_t>(remaining_, data.size()));
+                const auto payload = data.first(run);
+                data = data.subspan(run);
+                remaining_ -= run;
+                if (remaining_ == 0)
+                    state_ = EState::DataCr;
+                return payload;
+            }
+
+            if (state_ == EState::Passthrough)
+            {
+                const auto payload = data;
+                data = {};
+                return payload;
+            }
+
+            if (state_ == EState::Done)
+            {
+                data = {};
+                return {};
+            }
+
+            consume(data.front());
+            data = data.subspan(1);
+        }
+        return {};
+    }
+
+    void HttpChunkedDecoder::reset()
+    {
+        state_ = EState::Size;
+        remaining_ = 0;
+        sizeDigits_ = 0;
+        trailerLineEmpty_ = true;
+    }
+
+    void HttpChunkedDecoder::consume(uint8_t byte)
+    {
+        switch (state_)
+        {
+        case EState::Size:
+        {
+            const int digit = hexValue(byte);
+            if (digit >= 0 && sizeDigits_ < maxSizeDigits)
+            {
+                remaining_ = (remaining_ << 4) | static_cast<uint64_t>(digit);
+                ++sizeDigits_;
+            }
+            else if (sizeDigits_ == 0 || digit >= 0)
+                state_ = EState::Passthrough;
+            else if (byte == ';' || byte == ' ' || byte == '\t')
+                state_ = EState::Extension;
+            else if (byte == '\r')
+                state_ = EState::SizeLf;
+            else if (byte == '\n')
+                endSizeLine();
+            else
+                state_ = EState::Passthrough;
+            break;
+        }
+        case EState::Extension:
+            if (byte == '\r')
+                state_ = EState::SizeLf;
+            else if (byte == '\n')
+                endSizeLine();
+            break;
+        case EState::SizeLf:
+            if (byte == '\n')
+                endSizeLine();
+            else
+                state_ = EState::Passthrough;
+            break;
+        case EState::DataCr:
+            if (byte == '\r')
+                state_ = EState::DataLf;
+            else if (byte == '\n')
+                state_ = EState::Size;
+            else
+                state_ = EState::Passthrough;
+            break;
+        case EState::DataLf:
+            state_ = byte == '\n' ? EState::Size : EState::Passthrough;
+            break;
+        case EState::Trailer:
+        case EState::TrailerLf:
+            if (byte == '\r')
+            {
+                state_ = EState::TrailerLf;
+            }
+            else if (byte == '\n')
+            {
+                // An empty line ends the message
+                state_ = trailerLineEmpty_ ? EState::Done : EState::Trailer;
+                trailerLineEmpty_ = true;
+            }
+            else
+            {
+                state_ = EState::Trailer;
+                trailerLineEmpty_ = false;
+            }
+            break;
+        case EState::Data:
+        case EState::Done:
+        case EState::Passthrough:
+            break;
+        }
+    }
+
+    void HttpChunkedDecoder::endSizeLine()
+    {
+        sizeDigits_ = 0;
+        if (remaining_ == 0)
+        {
+            state_ = EState::Trailer;
+            trailerLineEmpty_ = true;
+        }
+        else
+        {
+            state_ = EState::Data;
+        }
+    }
+
+}
@@ -0,0 +1,64 @@
+/*
+ * Jimmy Paputto 2026
+ *
+ * Streaming decoder for HTTP/1.1 chunked transfer-encoding.
+ */
+
+#ifndef HTTP_CHUNKED_DECODER_HPP_
+#define HTTP_CHUNKED_DECODER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace JimmyPaputto
+{
+
+    /// Strips chunk-size lines, chunk CRLFs and the trailer from an NTRIP
+    /// v2 response body as it arrives, however recv() splits it.  Payload
+    /// is returned as spans into the caller's buffer, never copied.
+    ///
+    /// A body that breaks the chunk syntax is passed through unchanged
+    /// from that point on, leaving resync to the RTCM3 CRC as before.
+    class HttpChunkedDecoder
+    {
+    public:
+        /// Consume framing at the front of `data` up to the next payload
+        /// run, advance `data` past that run and return it.  Returns an
+        /// empty span once `data` is used up.
+        std::span<const uint8_t> next(std::span<const uint8_t> &data);
+
+        void reset();
+
+        /// Last chunk and trailer seen; anything after is ignored.
+        bool finished() const { return state_ == EState::Done; }
+
+        /// Body was not valid chunked encoding, now passing through.
+        bool failed() const { return state_ == EState::Passthrough; }
+
+    private:
+        enum class EState
+        {
+            Size,        // hex digits of the chunk size
+            Extension,   // ";name=value" or whitespace up to the CR
+            SizeLf,      // LF ending the size line
+            Data,        // `remaining_` payload bytes
+            DataCr,      // CR after the payload
+            DataLf,      // LF after the payload
+            Trailer,     // header lines after the last chunk
+            TrailerLf,   // LF ending a trailer line
+            Done,
+            Passthrough
+        };
+
+        void consume(uint8_t byte);
+        void endSizeLine();
+
+        EState state_ = EState::Size;
+        uint64_t remaining_ = 0;
+        uint8_t sizeDigits_ = 0;
+        bool trailerLineEmpty_ = true;
+    };
+
+}
+#endif // HTTP_CHUNKED_DECODER_HPP_
@@ -134,42 +134,18 @@ namespace JimmyPaputto
 
     void NtripCaster::feed(const std::vector<std::vector<uint8_t>> &frames)
     {
-        // Track statistics
-        statsRecordTxFrames(frames);
-
-        // Concatenate all frames into a single buffer
-        size_t totalSize = 0;
-        for (const auto &f : frames)
-            totalSize += f.size();
-
-        if (totalSize == 0)
-            return;
-
-        std::vector<uint8_t> buf;
-        buf.reserve(totalSize);
-        for (const auto &f : frames)
-            buf.insert(buf.end(), f.begin(), f.end());
-
-        std::lock_guard lock(clientsMutex_);
-        std::vector<int> dead;
-
-        for (int fd : clients_)
-        {
-            if (!sendAll(fd, buf.data(), buf.size()))
-                dead.push_back(fd);
-        }
+        const std::vector<std::span<const uint8_t>> views(frames.begin(),
+                                                          frames.end());
+        feedFrames(views);
+    }
 
-        for (int fd : dead)
-        {
-            clients_.erase(
-                std::remove(clients_.begin(), clients_.end(), fd),
-                clients_.end());
-            closeClientTls(fd);
-            ::shutdown(fd, SHUT_RDWR);
-            log(ENtripLogLevel::Debug, "[NtripCaster] Client fd=%d disconnected during feed "
-                "(total: %zu)",
-                fd, clients_.size());
-        }
+    void NtripCaster::feed(std::span<const Rtcm3MessagePtr> messages)
+    {
+        std::vector<std::span<const uint8_t>> views;
+        views.reserve(messages.size());
+        for (const auto &message : messages)
+            views.emplace_back(message->frame);
+        feedFrames(views);
     }
 
     size_t NtripCaster::clientCount() const
@@ -208,6 +184,48 @@ namespace JimmyPaputto
     // Private
     // ---------------------------------------------------------------------------
 
+    void NtripCaster::feedFrames(
+        std::span<const std::span<const uint8_t>> frames)
+    {
+        // Track statistics
+        statsRecordTxFrames(frames);
+
+        // Concatenate all frames into a single buffer, written to every
+        // client
+        size_t totalSize = 0;
+        for (const auto &f : frames)
+            totalSize += f.size();
+
+        if (totalSize == 0)
+            return;
+
+        std::vector<uint8_t> buf;
+        buf.reserve(totalSize);
+        for (const auto &f : frames)
+            buf.insert(buf.end(), f.begin(), f.end());
+
+        std::lock_guard lock(clientsMutex_);
+        std::vector<int> dead;
+
+        for (int fd : clients_)
+        {
+            if (!sendAll(fd, buf.data(), buf.size()))
+                dead.push_back(fd);
+        }
+
+        for (int fd : dead)
+        {
+            clients_.erase(
+                std::remove(clients_.begin(), clients_.end(), fd),
+                clients_.end());
+            closeClientTls(fd);
+            ::shutdown(fd, SHUT_RDWR);
+            log(ENtripLogLevel::Debug, "[NtripCaster] Client fd=%d disconnected during feed "
+                "(total: %zu)",
+                fd, clients_.size());
+        }
+    }
+
     void NtripCaster::acceptLoop(std::stop_token stoken)
     {
         while (!stoken.stop_requested() && running_)
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "NtripLog.hpp"
 #include "NtripStats.hpp"
 #include "NtripTls.hpp"
+#include "ublox/Rtcm3Snapshot.hpp"
 
 namespace JimmyPaputto
 {
@@ -40,6 +42,10 @@ namespace JimmyPaputto
 
         void feed(const std::vector<std::vector<uint8_t>> &frames);
 
+        /// Broadcast shared store frames, e.g. from IBase::corrections(),
+        /// without copying them out first.
+        void feed(std::span<const Rtcm3MessagePtr> messages);
+
         size_t clientCount() const;
         void updatePosition(double lat, double lon);
 
@@ -54,6 +60,7 @@ namespace JimmyPaputto
         static bool isTlsAvailable();
 
     private:
+        void feedFrames(std::span<const std::span<const uint8_t>> frames);
         void acceptLoop(std::stop_token stoken);
         void handleClient(int clientFd, std::string clientAddr);
         void registerClient(int fd, const std::string &addr);
@@ -16,13 +16,32 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cctype>
 #include <sstream>
+#include <string_view>
 
 #include "common/Utils.hpp"
-#include "ublox/Rtcm3Parser.hpp"
 
 namespace JimmyPaputto
 {
+    namespace
+    {
+        /// True when a response header carries "Transfer-Encoding: chunked".
+        bool isChunkedResponse(std::string_view header)
+        {
+            std::string lower(header);
+            std::transform(lower.begin(), lower.end(), lower.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+
+            const size_t field = lower.find("\r\ntransfer-encoding:");
+            if (field == std::string::npos)
+                return false;
+            const size_t eol = lower.find("\r\n", field + 2);
+            return lower.substr(field, eol - field).find("chunked") !=
+                   std::string::npos;
+        }
+    }
+
     // -----------------------------------------------------------------------
     // Public
     // -----------------------------------------------------------------------
@@ -277,14 +296,23 @@ namespace JimmyPaputto
             return false;
         }
 
-        // Feed any trailing data after headers into the parse buffer
         const char *bodyStart = strstr(hdrBuf, "\r\n\r\n") + 4;
+        {
+            std::lock_guard lock(framesMutex_);
+            chunkedBody_ = isChunkedResponse(std::string_view(
+                hdrBuf, static_cast<size_t>(bodyStart - hdrBuf)));
+            chunkedDecoder_.reset();
+        }
+        if (chunkedBody_)
+            log(ENtripLogLevel::Debug, "[NtripClient] Chunked transfer-encoding");
+
+        // Feed any trailing data after headers into the parse buffer
         size_t trailing = hdrLen - static_cast<size_t>(bodyStart - hdrBuf);
         if (trailing > 0)
         {
             std::lock_guard lock(framesMutex_);
-            extractFrames(reinterpret_cast<const uint8_t *>(bodyStart),
-                          trailing);
+            receiveBody(reinterpret_cast<const uint8_t *>(bodyStart),
+                        trailing);
         }
 
         connected_ = true;
@@ -329,7 +357,7 @@ namespace JimmyPaputto
 
         std::lock_guard lock(framesMutex_);
         pendingFrames_.clear();
-        parseBuffer_.clear();
+        extractor_.clear();
         statsReset();
 
         log(ENtripLogLevel::Info, "[NtripClient] Disconnected.");
@@ -340,12 +368,18 @@ namespace JimmyPaputto
         return connected_;
     }
 
-    std::vector<std::vector<uint8_t>> NtripClient::receiveFrames()
+    void NtripClient::receiveFrames(RtcmFrameBatch &batch)
     {
+        batch.clear();
         std::lock_guard lock(framesMutex_);
-        std::vector<std::vector<uint8_t>> out;
-        out.swap(pendingFrames_);
-        return out;
+        batch.swap(pendingFrames_);
+    }
+
+    std::vector<std::vector<uint8_t>> NtripClient::receiveFrames()
+    {
+        RtcmFrameBatch batch;
+        receiveFrames(batch);
+        return batch.toVectors();
     }
 
     void NtripClient::setAutoReconnect(bool enable,
@@ -634,7 +668,7 @@ namespace JimmyPaputto
 
             std::lock_guard lock(framesMutex_);
             statsRecordRx(static_cast<size_t>(n));
-            extractFrames(buf, static_cast<size_t>(n));
+            receiveBody(buf, static_cast<size_t>(n));
         }
 
         // Auto-reconnect with exponential backoff
@@ -678,67 +712,35 @@ namespace JimmyPaputto
         }
     }
 
-    void NtripClient::extractFrames(const uint8_t *data, size_t len)
+    void NtripClient::receiveBody(const uint8_t *data, size_t len)
     {
-        // Append new data to parse buffer
-        parseBuffer_.insert(parseBuffer_.end(), data, data + len);
-
-        while (parseBuffer_.size() >= 6)
+        if (!chunkedBody_)
         {
-            // Find RTCM3 preamble (0xD3)
-            auto it = std::find(parseBuffer_.begin(), parseBuffer_.end(), 0xD3);
-            if (it == parseBuffer_.end())
-            {
-                parseBuffer_.clear();
-                return;
-            }
-
-            // Discard bytes before preamble
-            if (it != parseBuffer_.begin())
-                parseBuffer_.erase(parseBuffer_.begin(), it);
-
-            if (parseBuffer_.size() < 6)
-                return; // Need more data
-
-            // Check reserved bits (byte 1 upper 6 bits should be 0)
-            if ((parseBuffer_[1] & 0xFC) != 0)
-            {
-                parseBuffer_.erase(parseBuffer_.begin());
-                continue;
-            }
-
-            // Extract payload length from bytes 1-2 (10 bits)
-            uint16_t payloadLen = (static_cast<uint16_t>(parseBuffer_[1] & 0x03) << 8)
-                                | static_cast<uint16_t>(parseBuffer_[2]);
-
-            // Total frame: 3 (header) + payload + 3 (CRC)
-            size_t frameLen = 3u + payloadLen + 3u;
-            if (parseBuffer_.size() < frameLen)
-                return; // Need more data
-
-            // Verify CRC-24Q over header + payload
-            uint32_t computed = Rtcm3Parser::crc24q(parseBuffer_.data(), 3u + payloadLen);
-            uint32_t received =
-                (static_cast<uint32_t>(parseBuffer_[3 + payloadLen]) << 16) |
-                (static_cast<uint32_t>(parseBuffer_[4 + payloadLen]) << 8) |
-                 static_cast<uint32_t>(parseBuffer_[5 + payloadLen]);
-
-            if (computed != received)
-            {
-                // Bad CRC — skip this preamble byte
-                parseBuffer_.erase(parseBuffer_.begin());
-                continue;
-            }
+            extractFrames(data, len);
+            return;
+        }
 
-            // Valid frame
-            statsRecordFrame(parseBuffer_.data(), frameLen);
-            pendingFrames_.emplace_back(
-                parseBuffer_.begin(),
-                parseBuffer_.begin() + static_cast<ptrdiff_t>(frameLen));
-            parseBuffer_.erase(
-                parseBuffer_.begin(),
-                parseBuffer_.begin() + static_cast<ptrdiff_t>(frameLen));
+        // Chunk payload goes to the extractor straight out of the recv
+        // buffer, one span per run between chunk headers
+        const bool failedBefore = chunkedDecoder_.failed();
+        std::span<const uint8_t> body(data, len);
+        while (!body.empty())
+        {
+            const auto payload = chunkedDecoder_.next(body);
+            if (!payload.empty())
+                extractFrames(payload.data(), payload.size());
         }
+        if (chunkedDecoder_.failed() && !failedBefore)
+            log(ENtripLogLevel::Warning,
+                "[NtripClient] Malformed chunked body, passing it through");
+    }
+
+    void NtripClient::extractFrames(const uint8_t *data, size_t len)
+    {
+        const size_t first = pendingFrames_.size();
+        extractor_.feed({data, len}, pendingFrames_);
+        for (size_t i = first; i < pendingFrames_.size(); ++i)
+            statsRecordFrame(pendingFrames_[i].data(), pendingFrames_[i].size());
     }
 
     void NtripClient::autoGgaLoop(std::stop_token stoken)
@@ -18,9 +18,12 @@
 #include <thread>
 #include <vector>
 
+#include "HttpChunkedDecoder.hpp"
 #include "NtripLog.hpp"
 #include "NtripStats.hpp"
 #include "NtripTls.hpp"
+#include "Rtcm3FrameExtractor.hpp"
+#include "RtcmFrameBatch.hpp"
 
 namespace JimmyPaputto
 {
@@ -54,7 +57,14 @@ namespace JimmyPaputto
         void disconnect();
         bool isConnected() const;
 
-        /// Drain all received frames since the last call.
+        /// Drain all received frames since the last call by swapping them
+        /// into `batch`.  Whatever `batch` held is dropped and its storage
+        /// goes back to the receive thread, so polling with the same batch
+        /// does not allocate once it has grown to a typical burst.
+        void receiveFrames(RtcmFrameBatch &batch);
+
+        /// Drain all received frames since the last call, one vector per
+        /// frame.  Copies out of the batch; prefer the overload above.
         std::vector<std::vector<uint8_t>> receiveFrames();
 
         /// Send GGA position to the caster (for VRS / nearest base).
@@ -92,6 +102,7 @@ namespace JimmyPaputto
     private:
         bool connectInternal(std::stop_token stoken = {});
         void receiveLoop(std::stop_token stoken);
+        void receiveBody(const uint8_t *data, size_t len);
         void extractFrames(const uint8_t *data, size_t len);
         void autoGgaLoop(std::stop_token stoken);
 
@@ -109,8 +120,11 @@ namespace JimmyPaputto
         std::jthread recvThread_;
 
         mutable std::mutex framesMutex_;
-        std::vector<std::vector<uint8_t>> pendingFrames_;
-        std::vector<uint8_t> parseBuffer_;
+        RtcmFrameBatch pendingFrames_;
+        Rtcm3FrameExtractor extractor_;
+        // Set per connection from the Transfer-Encoding response header
+        bool chunkedBody_ = false;
+        HttpChunkedDecoder chunkedDecoder_;
 
         // Auto-reconnect state
         std::atomic<bool> autoReconnect_{false};
@@ -124,6 +124,41 @@ namespace JimmyPaputto
     }
 
     void NtripServer::feed(const std::vector<std::vector<uint8_t>> &frames)
+    {
+        const std::vector<std::span<const uint8_t>> views(frames.begin(),
+                                                          frames.end());
+        feedFrames(views);
+    }
+
+    void NtripServer::feed(std::span<const Rtcm3MessagePtr> messages)
+    {
+        std::vector<std::span<const uint8_t>> views;
+        views.reserve(messages.size());
+        for (const auto &message : messages)
+            views.emplace_back(message->frame);
+        feedFrames(views);
+    }
+
+    void NtripServer::setAutoReconnect(bool enable,
+                                       uint32_t initialDelayMs,
+                                       uint32_t maxDelayMs)
+    {
+        autoReconnect_ = enable;
+        reconnectInitialMs_ = initialDelayMs;
+        reconnectMaxMs_ = maxDelayMs;
+    }
+
+    uint32_t NtripServer::reconnectCount() const
+    {
+        return reconnectCount_;
+    }
+
+    // -----------------------------------------------------------------------
+    // Private
+    // -----------------------------------------------------------------------
+
+    void NtripServer::feedFrames(
+        std::span<const std::span<const uint8_t>> frames)
     {
         if (!connected_ || sockFd_ < 0)
             return;
@@ -151,24 +186,6 @@ namespace JimmyPaputto
         }
     }
 
-    void NtripServer::setAutoReconnect(bool enable,
-                                       uint32_t initialDelayMs,
-                                       uint32_t maxDelayMs)
-    {
-        autoReconnect_ = enable;
-        reconnectInitialMs_ = initialDelayMs;
-        reconnectMaxMs_ = maxDelayMs;
-    }
-
-    uint32_t NtripServer::reconnectCount() const
-    {
-        return reconnectCount_;
-    }
-
-    // -----------------------------------------------------------------------
-    // Private
-    // -----------------------------------------------------------------------
-
     bool NtripServer::connectInternal(std::stop_token stoken)
     {
         // Resolve hostname
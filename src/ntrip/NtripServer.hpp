@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <mutex>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "NtripLog.hpp"
 #include "NtripStats.hpp"
 #include "NtripTls.hpp"
+#include "ublox/Rtcm3Snapshot.hpp"
 
 namespace JimmyPaputto
 {
@@ -44,6 +46,10 @@ namespace JimmyPaputto
         /// Send RTCM3 frames to the remote caster.
         void feed(const std::vector<std::vector<uint8_t>> &frames);
 
+        /// Send shared store frames, e.g. from IBase::corrections(),
+        /// without copying them out first.
+        void feed(std::span<const Rtcm3MessagePtr> messages);
+
         /// Enable/disable auto-reconnect with exponential backoff.
         void setAutoReconnect(bool enable,
                               uint32_t initialDelayMs = 1000,
@@ -59,6 +65,7 @@ namespace JimmyPaputto
         static bool isTlsAvailable();
 
     private:
+        void feedFrames(std::span<const std::span<const uint8_t>> frames);
         bool connectInternal(std::stop_token stoken = {});
         void monitorLoop(std::stop_token stoken);
         bool sendAll(const void *data, size_t len);
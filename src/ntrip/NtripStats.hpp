@@ -13,6 +13,9 @@
 #include <cstdint>
 #include <map>
 #include <mutex>
+#include <span>
+
+#include "common/Crc24q.hpp"
 
 namespace JimmyPaputto
 {
@@ -115,6 +118,22 @@ namespace JimmyPaputto
                             static_cast<uint16_t>(data[i + 2]);
                         size_t frameLen = 3 + payloadLen + 3; // header + payload + CRC
 
+                        // A whole frame in this read must carry a valid
+                        // CRC, otherwise the 0xD3 was payload: move on.
+                        if (i + frameLen <= len)
+                        {
+                            const uint8_t* crc = data + i + 3 + payloadLen;
+                            uint32_t received =
+                                (static_cast<uint32_t>(crc[0]) << 16) |
+                                (static_cast<uint32_t>(crc[1]) << 8) |
+                                static_cast<uint32_t>(crc[2]);
+                            if (crc24q(data + i, 3 + payloadLen) != received)
+                            {
+                                ++i;
+                                continue;
+                            }
+                        }
+
                         uint16_t msgType =
                             (static_cast<uint16_t>(data[i + 3]) << 4) |
                             (static_cast<uint16_t>(data[i + 4]) >> 4);
@@ -158,7 +177,7 @@ namespace JimmyPaputto
         }
 
         void statsRecordTxFrames(
-            const std::vector<std::vector<uint8_t>>& frames)
+            std::span<const std::span<const uint8_t>> frames)
         {
             size_t totalBytes = 0;
             for (const auto& f : frames)
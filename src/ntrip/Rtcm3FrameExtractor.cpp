@@ -0,0 +1,135 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "Rtcm3FrameExtractor.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/Crc24q.hpp"
+
+namespace JimmyPaputto
+{
+
+    Rtcm3FrameExtractor::Rtcm3FrameExtractor()
+        : ring_(capacity), scratch_{}
+    {
+    }
+
+    size_t Rtcm3FrameExtractor::feed(std::span<const uint8_t> data,
+                                     RtcmFrameBatch &out)
+    {
+        // scan() leaves less than one frame behind, so the ring always has
+        // room for the next chunk of a read larger than it
+        size_t frames = 0;
+        while (!data.empty())
+        {
+            const size_t chunk = std::min(data.size(), capacity - buffered());
+            write(data.data(), chunk);
+            data = data.subspan(chunk);
+            frames += scan(out);
+        }
+        return frames;
+    }
+
+    void Rtcm3FrameExtractor::clear()
+    {
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    void Rtcm3FrameExtractor::write(const uint8_t *data, size_t len)
+    {
+        const size_t start = tail_ & mask;
+        const size_t first = std::min(len, capacity - start);
+        std::memcpy(ring_.data() + start, data, first);
+        std::memcpy(ring_.data(), data + first, len - first);
+        tail_ += len;
+    }
+
+    size_t Rtcm3FrameExtractor::scan(RtcmFrameBatch &out)
+    {
+        size_t frames = 0;
+        while (buffered() >= 6)
+        {
+            // Find RTCM3 preamble (0xD3)
+            if (at(0) != 0xD3 && !skipToPreamble())
+                return frames;
+
+            if (buffered() < 6)
+                return frames; // Need more data
+
+            // Check reserved bits (byte 1 upper 6 bits should be 0)
+            if ((at(1) & 0xFC) != 0)
+            {
+                ++head_;
+                continue;
+            }
+
+            // Total frame: 3 (header) + payload + 3 (CRC)
+            const size_t payloadLen =
+                (static_cast<size_t>(at(1) & 0x03) << 8) | at(2);
+            const size_t frameLen = 3u + payloadLen + 3u;
+            if (buffered() < frameLen)
+                return frames; // Need more data
+
+            const uint8_t *frame = contiguous(frameLen);
+            const uint32_t received =
+                (static_cast<uint32_t>(frame[3 + payloadLen]) << 16) |
+                (static_cast<uint32_t>(frame[4 + payloadLen]) << 8) |
+                 static_cast<uint32_t>(frame[5 + payloadLen]);
+            if (crc24q(frame, 3u + payloadLen) != received)
+            {
+                // Bad CRC — skip this preamble byte
+                ++head_;
+                continue;
+            }
+
+            out.append({frame, frameLen});
+            head_ += frameLen;
+            ++frames;
+        }
+        return frames;
+    }
+
+    bool Rtcm3FrameExtractor::skipToPreamble()
+    {
+        // At most two runs of memchr, one either side of the wrap
+        size_t offset = 0;
+        while (offset < buffered())
+        {
+            const size_t start = (head_ + offset) & mask;
+            const size_t run = std::min(buffered() - offset, capacity - start);
+            const void *found = std::memchr(ring_.data() + start, 0xD3, run);
+            if (found)
+            {
+                head_ += offset + static_cast<size_t>(
+                    static_cast<const uint8_t *>(found) -
+                    (ring_.data() + start));
+                return true;
+            }
+            offset += run;
+        }
+        head_ = tail_;
+        return false;
+    }
+
+    uint8_t Rtcm3FrameExtractor::at(size_t offset) const
+    {
+        return ring_[(head_ + offset) & mask];
+    }
+
+    const uint8_t *Rtcm3FrameExtractor::contiguous(size_t len)
+    {
+        const size_t start = head_ & mask;
+        if (start + len <= capacity)
+            return ring_.data() + start;
+
+        const size_t first = capacity - start;
+        std::memcpy(scratch_.data(), ring_.data() + start, first);
+        std::memcpy(scratch_.data() + first, ring_.data(), len - first);
+        return scratch_.data();
+    }
+
+}
@@ -0,0 +1,65 @@
+/*
+ * Jimmy Paputto 2026
+ *
+ * Incremental RTCM3 framer for the NtripClient receive path.
+ */
+
+#ifndef RTCM3_FRAME_EXTRACTOR_HPP_
+#define RTCM3_FRAME_EXTRACTOR_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "RtcmFrameBatch.hpp"
+
+namespace JimmyPaputto
+{
+
+    /// Pulls CRC-checked RTCM3 frames out of an arbitrarily split byte
+    /// stream.  Received bytes go into a fixed ring and are consumed by
+    /// moving a read cursor, so skipping garbage, a bad CRC or a delivered
+    /// frame never shifts the rest of the buffer: every byte is looked at
+    /// a bounded number of times however the stream resyncs.
+    class Rtcm3FrameExtractor
+    {
+    public:
+        /// 3 byte header + 1023 byte payload + 3 byte CRC.
+        static constexpr size_t maxFrameLength = 1029;
+
+        Rtcm3FrameExtractor();
+
+        /// Feed received bytes, appending each complete frame to `out`.
+        /// Returns the number of frames appended.
+        size_t feed(std::span<const uint8_t> data, RtcmFrameBatch &out);
+
+        /// Drop any partial frame, e.g. after a reconnect.
+        void clear();
+
+        /// Bytes buffered towards the next frame.
+        size_t buffered() const { return tail_ - head_; }
+
+    private:
+        // Any partial frame plus the largest recv() with room to spare
+        static constexpr size_t capacity = 16 * 1024;
+        static constexpr size_t mask = capacity - 1;
+        static_assert((capacity & mask) == 0);
+
+        void write(const uint8_t *data, size_t len);
+        size_t scan(RtcmFrameBatch &out);
+        bool skipToPreamble();
+        uint8_t at(size_t offset) const;
+        const uint8_t *contiguous(size_t len);
+
+        std::vector<uint8_t> ring_;
+        // Frames that wrap are copied here for the CRC
+        std::array<uint8_t, maxFrameLength> scratch_;
+        // Monotonic; the ring index is the value & mask
+        size_t head_ = 0;
+        size_t tail_ = 0;
+    };
+
+}
+#endif // RTCM3_FRAME_EXTRACTOR_HPP_
@@ -0,0 +1,123 @@
+/*
+ * Jimmy Paputto 2026
+ *
+ * RTCM3 frames stored back to back in one byte arena.
+ */
+
+#ifndef RTCM_FRAME_BATCH_HPP_
+#define RTCM_FRAME_BATCH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace JimmyPaputto
+{
+
+    /// Frames handed out as spans into a shared arena.  clear() keeps the
+    /// capacity, so a batch that is swapped back and forth with
+    /// NtripClient::receiveFrames() stops allocating once it has held the
+    /// largest burst.  Spans stay valid until the batch is cleared,
+    /// appended to or swapped.
+    class RtcmFrameBatch
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::span<const uint8_t>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            const_iterator() = default;
+            const_iterator(const RtcmFrameBatch *batch, size_t index)
+                : batch_(batch), index_(index) {}
+
+            value_type operator*() const { return (*batch_)[index_]; }
+
+            const_iterator &operator++()
+            {
+                ++index_;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator previous = *this;
+                ++index_;
+                return previous;
+            }
+
+            bool operator==(const const_iterator &other) const
+            {
+                return index_ == other.index_;
+            }
+
+        private:
+            const RtcmFrameBatch *batch_ = nullptr;
+            size_t index_ = 0;
+        };
+
+        size_t size() const { return frames_.size(); }
+        bool empty() const { return frames_.empty(); }
+
+        /// Total bytes of all frames.
+        size_t bytes() const { return arena_.size(); }
+
+        std::span<const uint8_t> operator[](size_t index) const
+        {
+            const Frame &frame = frames_[index];
+            return {arena_.data() + frame.offset, frame.length};
+        }
+
+        const_iterator begin() const { return {this, 0}; }
+        const_iterator end() const { return {this, frames_.size()}; }
+
+        void append(std::span<const uint8_t> frame)
+        {
+            frames_.push_back({static_cast<uint32_t>(arena_.size()),
+                               static_cast<uint32_t>(frame.size())});
+            arena_.insert(arena_.end(), frame.begin(), frame.end());
+        }
+
+        void clear()
+        {
+            arena_.clear();
+            frames_.clear();
+        }
+
+        void swap(RtcmFrameBatch &other) noexcept
+        {
+            arena_.swap(other.arena_);
+            frames_.swap(other.frames_);
+        }
+
+        /// One vector per frame, for IRover::applyCorrections() and the
+        /// other vector-of-frames APIs.
+        std::vector<std::vector<uint8_t>> toVectors() const
+        {
+            std::vector<std::vector<uint8_t>> out;
+            out.reserve(frames_.size());
+            for (const auto frame : *this)
+                out.emplace_back(frame.begin(), frame.end());
+            return out;
+        }
+
+    private:
+        struct Frame
+        {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        std::vector<uint8_t> arena_;
+        std::vector<Frame> frames_;
+    };
+
+}
+#endif // RTCM_FRAME_BATCH_HPP_
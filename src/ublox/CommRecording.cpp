@@ -0,0 +1,130 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "CommRecording.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "common/Utils.hpp"
+
+
+namespace JimmyPaputto
+{
+
+namespace
+{
+
+constexpr uint32_t headerSize = sizeof(CommRecording::magic) + 4;
+constexpr uint32_t segmentHeaderSize = 8 + 4;
+
+}  // namespace
+
+std::optional<CommRecording> CommRecording::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        fprintf(stderr, "[CommRecording] Cannot open %s\r\n", path.c_str());
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> content(std::istreambuf_iterator<char>(file), {});
+    const bool recorded = content.size() >= headerSize &&
+        std::equal(std::begin(magic), std::end(magic), content.begin());
+    if (!recorded)
+        return untimed(std::move(content));
+
+    const std::span<const uint8_t> data(content);
+    if (readLE<uint32_t>(data, sizeof(magic)) != version)
+    {
+        fprintf(stderr, "[CommRecording] %s: unsupported version\r\n",
+            path.c_str());
+        return std::nullopt;
+    }
+
+    CommRecording recording;
+    std::size_t offset = headerSize;
+    while (offset + segmentHeaderSize <= data.size())
+    {
+        const auto at = std::chrono::nanoseconds(
+            readLE<int64_t>(data, offset));
+        const auto size = readLE<uint32_t>(data, offset + 8);
+        offset += segmentHeaderSize;
+        if (offset + size > data.size())
+        {
+            // Recorder killed mid-write, keep what is complete
+            fprintf(stderr, "[CommRecording] %s: truncated last read\r\n",
+                path.c_str());
+            break;
+        }
+        recording.append(at, data.subspan(offset, size));
+        offset += size;
+    }
+    return recording;
+}
+
+CommRecording CommRecording::untimed(std::vector<uint8_t> stream)
+{
+    CommRecording recording;
+    const auto size = static_cast<uint32_t>(stream.size());
+    recording.bytes = std::move(stream);
+    recording.segments.push_back({ std::chrono::nanoseconds(0), 0, size });
+    return recording;
+}
+
+void CommRecording::append(std::chrono::nanoseconds at,
+    std::span<const uint8_t> data)
+{
+    segments.push_back({ at, static_cast<uint32_t>(bytes.size()),
+        static_cast<uint32_t>(data.size()) });
+    bytes.insert(bytes.end(), data.begin(), data.end());
+}
+
+bool CommRecording::save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        fprintf(stderr, "[CommRecording] Cannot create %s\r\n", path.c_str());
+        return false;
+    }
+
+    writeHeader(file);
+    for (const auto& segment : segments)
+    {
+        writeSegment(file, segment.at,
+            std::span(bytes).subspan(segment.offset, segment.size));
+    }
+    return file.good();
+}
+
+std::chrono::nanoseconds CommRecording::duration() const
+{
+    return segments.empty()
+        ? std::chrono::nanoseconds(0)
+        : segments.back().at;
+}
+
+void CommRecording::writeHeader(std::ostream& out)
+{
+    std::vector<uint8_t> header(std::begin(magic), std::end(magic));
+    appendLE<uint32_t>(version, header);
+    out.write(reinterpret_cast<const char*>(header.data()), header.size());
+}
+
+void CommRecording::writeSegment(std::ostream& out,
+    std::chrono::nanoseconds at, std::span<const uint8_t> data)
+{
+    std::vector<uint8_t> header;
+    header.reserve(segmentHeaderSize);
+    appendLE<int64_t>(at.count(), header);
+    appendLE<uint32_t>(static_cast<uint32_t>(data.size()), header);
+    out.write(reinterpret_cast<const char*>(header.data()), header.size());
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,55 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_COMM_RECORDING_HPP_
+#define JIMMY_PAPUTTO_COMM_RECORDING_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace JimmyPaputto
+{
+
+// Receiver traffic as RecordingCommDriver saw it: every read, stamped with
+// the time it completed relative to the first one.
+//
+// File layout (little endian): "JPCOMREC", u32 version, then per read
+// i64 nanoseconds, u32 size and the bytes. A file without the magic is
+// taken as a raw untimed byte stream (e.g. a u-center or `cat` capture).
+struct CommRecording
+{
+    struct Segment
+    {
+        std::chrono::nanoseconds at;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    std::vector<uint8_t> bytes;
+    std::vector<Segment> segments;
+
+    static std::optional<CommRecording> load(const std::string& path);
+    static CommRecording untimed(std::vector<uint8_t> stream);
+
+    void append(std::chrono::nanoseconds at, std::span<const uint8_t> data);
+    bool save(const std::string& path) const;
+    std::chrono::nanoseconds duration() const;
+
+    static void writeHeader(std::ostream& out);
+    static void writeSegment(std::ostream& out, std::chrono::nanoseconds at,
+        std::span<const uint8_t> data);
+
+    static constexpr char magic[8] = { 'J', 'P', 'C', 'O', 'M', 'R', 'E', 'C' };
+    static constexpr uint32_t version = 1;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_COMM_RECORDING_HPP_
@@ -7,176 +7,243 @@
 #include "common/Utils.hpp"
 
 
-#define SEMAPHORE_TIMEOUT 100
-
 namespace JimmyPaputto
 {
 
 Gnss::Gnss()
+:   epochOpen_(false),
+    pendingMsgs_(0),
+    expectedMsgs_(0)
 {
 }
 
-void Gnss::dop(const DilutionOverPrecision& dop)
+bool Gnss::dop(const DilutionOverPrecision& dop, uint32_t iTOW)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        navigation_.dop = dop;
-        xSemaphore_.releaseResource();
-    }
+    const bool closed = epochMsg(EUbxMsg::UBX_NAV_DOP, iTOW);
+    epoch_.navigation.dop = dop;
+    return closeEpochIfDone() || closed;
 }
 
-void Gnss::pvt(const PositionVelocityTime& pvt)
+bool Gnss::pvt(const PositionVelocityTime& pvt, uint32_t iTOW)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        navigation_.pvt = pvt;
-        xSemaphore_.releaseResource();
-    }
+    const bool closed = epochMsg(EUbxMsg::UBX_NAV_PVT, iTOW);
+    epoch_.navigation.pvt = pvt;
+    return closeEpochIfDone() || closed;
 }
 
 void Gnss::geofencingCfg(const Geofencing::Cfg& cfg)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        navigation_.geofencing.cfg = cfg;
-        xSemaphore_.releaseResource();
-    }
+    // Configuration, not receiver output: visible right away in the last
+    // published epoch and carried into the following ones
+    epoch_.navigation.geofencing.cfg = cfg;
+    auto published = navigationSnapshot_.read();
+    published.navigation.geofencing.cfg = cfg;
+    navigationSnapshot_.publish(published);
 }
 
-void Gnss::geofencingNav(const Geofencing::Nav& nav)
+bool Gnss::geofencingNav(const Geofencing::Nav& nav)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
+    const bool closed = epochMsg(EUbxMsg::UBX_NAV_GEOFENCE, nav.iTOW);
+    epoch_.navigation.geofencing.nav = nav;
+    return closeEpochIfDone() || closed;
+}
+
+bool Gnss::rfBlocks(const std::vector<RfBlock>& rfBlocks)
+{
+    epoch_.navigation.rfBlocks = rfBlocks;
+    return untaggedMsg(EUbxMsg::UBX_MON_RF);
+}
+
+bool Gnss::rfBlocksSpectrumData(const std::vector<RfBlockSpectrumData>& rfBlocksSpectrumData)
+{
+    epoch_.navigation.rfBlocksSpectrumData = rfBlocksSpectrumData;
+    return untaggedMsg(EUbxMsg::UBX_MON_SPAN);
+}
+
+bool Gnss::satellites(const std::vector<SatelliteInfo>& satellites, uint32_t iTOW)
+{
+    const bool closed = epochMsg(EUbxMsg::UBX_NAV_SAT, iTOW);
+    epoch_.navigation.satellites = satellites;
+    return closeEpochIfDone() || closed;
+}
+
+bool Gnss::epochMsg(EUbxMsg eUbxMsg, uint32_t iTOW)
+{
+    bool closed = false;
+    if (epochOpen_ && epoch_.iTOW != iTOW)
+    {
+        // Next epoch started before this one had everything: publish what
+        // we have, flagged partial, and expect this set from now on
+        closeEpoch();
+        closed = true;
+    }
+
+    if (!epochOpen_ && epoch_.sequence > 0 && epoch_.iTOW == iTOW)
     {
-        navigation_.geofencing.nav = nav;
-        xSemaphore_.releaseResource();
+        // Straggler of the epoch just published: wait for it from now on,
+        // its data goes out with the next epoch
+        expectedMsgs_ |= 1u << to_underlying(eUbxMsg);
+        return false;
     }
+
+    if (!epochOpen_)
+    {
+        epochOpen_ = true;
+        epoch_.iTOW = iTOW;
+        epoch_.txReady = txReadySnapshot_.read();
+        epoch_.arrivedMsgs = pendingMsgs_;
+        pendingMsgs_ = 0;
+    }
+    epoch_.arrivedMsgs |= 1u << to_underlying(eUbxMsg);
+    return closed;
 }
 
-void Gnss::rfBlocks(const std::vector<RfBlock>& rfBlocks)
+bool Gnss::untaggedMsg(EUbxMsg eUbxMsg)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
+    // MON-* carry no iTOW, they belong to the epoch being assembled or,
+    // between epochs, to the next one
+    if (!epochOpen_)
     {
-        navigation_.rfBlocks = rfBlocks;
-        xSemaphore_.releaseResource();
+        pendingMsgs_ |= 1u << to_underlying(eUbxMsg);
+        return false;
     }
+    epoch_.arrivedMsgs |= 1u << to_underlying(eUbxMsg);
+    return closeEpochIfDone();
 }
 
-void Gnss::rfBlocksSpectrumData(const std::vector<RfBlockSpectrumData>& rfBlocksSpectrumData)
+bool Gnss::closeEpochIfDone()
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
+    if (!epochOpen_ || expectedMsgs_ == 0 ||
+        (epoch_.arrivedMsgs & expectedMsgs_) != expectedMsgs_)
     {
-        navigation_.rfBlocksSpectrumData = rfBlocksSpectrumData;
-        xSemaphore_.releaseResource();
+        return false;
     }
+
+    closeEpoch();
+    return true;
 }
 
-void Gnss::satellites(const std::vector<SatelliteInfo>& satellites)
+void Gnss::closeEpoch()
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
+    const bool complete =
+        (epoch_.arrivedMsgs & expectedMsgs_) == expectedMsgs_;
+    expectedMsgs_ = complete
+        ? expectedMsgs_ | epoch_.arrivedMsgs
+        : epoch_.arrivedMsgs;
+
+    epoch_.sequence++;
+    epoch_.complete = complete;
+    epoch_.timepulse = timepulseSnapshot_.read();
+    epoch_.published_ns = monotonicNow().count();
+    navigationSnapshot_.publish(epoch_);
+    epochOpen_ = false;
+
+    bool anyClosed = false;
+    for (const auto& subscriber : subscribers_.read())
+    {
+        subscriber->push(epoch_);
+        anyClosed = anyClosed || !subscriber->isOpen();
+    }
+
+    if (anyClosed)
     {
-        navigation_.satellites = satellites;
-        xSemaphore_.releaseResource();
+        // Never wait for subscribe() here, pruning can happen next epoch
+        std::unique_lock lock(subscribersMutex_, std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            std::erase_if(subscribersList_, [](const auto& subscriber) {
+                return !subscriber->isOpen();
+            });
+            subscribers_.publish(subscribersList_);
+        }
     }
 }
 
+std::shared_ptr<NavigationSubscription> Gnss::subscribe(std::size_t capacity,
+    EOverflowPolicy policy)
+{
+    auto subscription =
+        std::make_shared<NavigationSubscription>(capacity, policy);
+
+    std::lock_guard lock(subscribersMutex_);
+    std::erase_if(subscribersList_, [](const auto& subscriber) {
+        return !subscriber->isOpen();
+    });
+    subscribersList_.push_back(subscription);
+    subscribers_.publish(subscribersList_);
+
+    // The caller's handle unsubscribes once its last copy is gone, so a
+    // Block subscription nobody pops any more cannot stall closeEpoch()
+    return std::shared_ptr<NavigationSubscription>(subscription.get(),
+        [subscription](NavigationSubscription*) {
+            subscription->unsubscribe();
+        });
+}
+
 void Gnss::monVer(const std::string& swVersion, const std::string& hwVersion,
                   const std::vector<std::string>& extensions)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        swVersion_ = swVersion;
-        hwVersion_ = hwVersion;
-        monVerExtensions_ = extensions;
-        xSemaphore_.releaseResource();
-    }
+    monVerSnapshot_.publish({ swVersion, hwVersion, extensions });
 }
 
 std::string Gnss::swVersion() const
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        auto v = swVersion_;
-        xSemaphore_.releaseResource();
-        return v;
-    }
-    return {};
+    return monVerSnapshot_.read().swVersion;
 }
 
 std::string Gnss::hwVersion() const
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        auto v = hwVersion_;
-        xSemaphore_.releaseResource();
-        return v;
-    }
-    return {};
+    return monVerSnapshot_.read().hwVersion;
 }
 
 std::vector<std::string> Gnss::monVerExtensions() const
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        auto v = monVerExtensions_;
-        xSemaphore_.releaseResource();
-        return v;
-    }
-    return {};
+    return monVerSnapshot_.read().extensions;
 }
 
 void Gnss::systemHealth(const SystemHealth& systemHealth)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        systemHealth_ = systemHealth;
-        xSemaphore_.releaseResource();
-    }
+    systemHealthSnapshot_.publish(systemHealth);
 }
 
 SystemHealth Gnss::systemHealth() const
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        auto s = systemHealth_;
-        xSemaphore_.releaseResource();
-        return s;
-    }
-    return {};
+    return systemHealthSnapshot_.read();
 }
 
 void Gnss::timeMark(const TimeMark& timeMark)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        timeMark_ = timeMark;
-        xSemaphore_.releaseResource();
-    }
+    timeMarkSnapshot_.publish(timeMark);
 }
 
 std::optional<TimeMark> Gnss::timeMark() const
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        auto tm = timeMark_;
-        xSemaphore_.releaseResource();
-        return tm;
-    }
-    return std::nullopt;
+    return timeMarkSnapshot_.read();
+}
+
+void Gnss::txReadyEdge(const EdgeTimestamp& edge)
+{
+    txReadySnapshot_.publish(edge);
 }
 
-bool Gnss::lock() const
+void Gnss::timepulseEdge(const EdgeTimestamp& edge)
 {
-    return xSemaphore_.takeResource(SEMAPHORE_TIMEOUT);
+    timepulseSnapshot_.publish(edge);
 }
 
-void Gnss::unlock() const
+EdgeTimestamp Gnss::timepulseEdge() const
 {
-    xSemaphore_.releaseResource();
+    return timepulseSnapshot_.read();
 }
 
 Navigation Gnss::navigation() const
 {
-    return navigation_;
+    return navigationSnapshot_.read().navigation;
+}
+
+NavigationEpoch Gnss::navigationEpoch() const
+{
+    return navigationSnapshot_.read();
 }
 
 }  // JimmyPaputto
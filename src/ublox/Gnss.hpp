@@ -5,13 +5,16 @@
 #ifndef GNSS_HPP_
 #define GNSS_HPP_
 
-#include "common/GenericSingleton.hpp"
-#include "common/JPGuard.hpp"
+#include "common/SnapshotBuffer.hpp"
 
 #include "ublox/Navigation.hpp"
+#include "ublox/NavigationEpoch.hpp"
+#include "ublox/NavigationSubscription.hpp"
 #include "ublox/SystemHealth.hpp"
 #include "ublox/TimeMark.hpp"
 
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
@@ -19,18 +22,29 @@
 namespace JimmyPaputto
 {
 
-class Gnss: public GenericSingleton<Gnss>
+// Receiver state shared between the parser thread, which is the only
+// writer apart from the GPIO edge handlers, and any number of readers.
+// Navigation setters feed the epoch being assembled and return true when
+// that epoch closed and was published; readers copy the last published
+// value and neither side takes a lock. Each GnssHat owns one, so receivers
+// in one process share nothing.
+class Gnss
 {
 public:
     explicit Gnss();
 
-    void dop(const DilutionOverPrecision& dop);
-    void pvt(const PositionVelocityTime& pvt);
+    Gnss(const Gnss&) = delete;
+    Gnss& operator=(const Gnss&) = delete;
+
+    bool dop(const DilutionOverPrecision& dop, uint32_t iTOW);
+    bool pvt(const PositionVelocityTime& pvt, uint32_t iTOW);
     void geofencingCfg(const Geofencing::Cfg& cfg);
-    void geofencingNav(const Geofencing::Nav& nav);
-    void rfBlocks(const std::vector<RfBlock>& rfBlocks);
-    void rfBlocksSpectrumData(const std::vector<RfBlockSpectrumData>& rfBlocksSpectrumData);
-    void satellites(const std::vector<SatelliteInfo>& satellites);
+    bool geofencingNav(const Geofencing::Nav& nav);
+    bool rfBlocks(const std::vector<RfBlock>& rfBlocks);
+    bool rfBlocksSpectrumData(
+        const std::vector<RfBlockSpectrumData>& rfBlocksSpectrumData);
+    bool satellites(const std::vector<SatelliteInfo>& satellites,
+        uint32_t iTOW);
 
     void monVer(const std::string& swVersion, const std::string& hwVersion,
                 const std::vector<std::string>& extensions);
@@ -44,19 +58,45 @@ public:
     void timeMark(const TimeMark& timeMark);
     std::optional<TimeMark> timeMark() const;
 
-    bool lock() const;
-    void unlock() const;
+    // Called from the TX-ready and timepulse handler threads, one each
+    void txReadyEdge(const EdgeTimestamp& edge);
+    void timepulseEdge(const EdgeTimestamp& edge);
+    EdgeTimestamp timepulseEdge() const;
 
     Navigation navigation() const;
+    NavigationEpoch navigationEpoch() const;
+
+    std::shared_ptr<NavigationSubscription> subscribe(std::size_t capacity,
+        EOverflowPolicy policy);
 
 private:
-    Navigation navigation_;
-    std::optional<TimeMark> timeMark_;
-    std::string swVersion_;
-    std::string hwVersion_;
-    std::vector<std::string> monVerExtensions_;
-    SystemHealth systemHealth_;
-    mutable JPGuard xSemaphore_;
+    using Subscribers = std::vector<std::shared_ptr<NavigationSubscription>>;
+
+    bool epochMsg(EUbxMsg eUbxMsg, uint32_t iTOW);
+    bool untaggedMsg(EUbxMsg eUbxMsg);
+    bool closeEpochIfDone();
+    void closeEpoch();
+
+    struct MonVer
+    {
+        std::string swVersion;
+        std::string hwVersion;
+        std::vector<std::string> extensions;
+    };
+
+    NavigationEpoch epoch_;
+    bool epochOpen_;
+    uint32_t pendingMsgs_;
+    uint32_t expectedMsgs_;
+    SnapshotBuffer<NavigationEpoch> navigationSnapshot_;
+    std::mutex subscribersMutex_;
+    Subscribers subscribersList_;
+    SnapshotBuffer<Subscribers> subscribers_;
+    SnapshotBuffer<std::optional<TimeMark>> timeMarkSnapshot_;
+    SnapshotBuffer<MonVer> monVerSnapshot_;
+    SnapshotBuffer<SystemHealth> systemHealthSnapshot_;
+    SnapshotBuffer<EdgeTimestamp> txReadySnapshot_;
+    SnapshotBuffer<EdgeTimestamp> timepulseSnapshot_;
 };
 
 }  // JimmyPaputto
@@ -4,9 +4,11 @@
 
 #include "ublox/GnssConfig.hpp"
 
+#include <algorithm>
 #include <cstdio>
 
 #include "common/Utils.hpp"
+#include "ublox/UartDriver.hpp"
 
 
 namespace JimmyPaputto
@@ -302,4 +304,81 @@ bool checkNavigationFilters(
     return true;
 }
 
+bool checkSpiProfile(const std::optional<SpiProfile>& spi)
+{
+    if (!spi.has_value())
+    {
+        return true;
+    }
+
+    if (spi->maxClock_Hz > SpiProfile::moduleMaxClock_Hz)
+    {
+        fprintf(
+            stderr,
+            "[GnssConfig] Invalid SPI maxClock_Hz: %u, the module is rated "
+            "up to %u Hz\r\n",
+            spi->maxClock_Hz, SpiProfile::moduleMaxClock_Hz
+        );
+        return false;
+    }
+
+    if (spi->clock_Hz < SpiProfile::minClock_Hz ||
+        spi->clock_Hz > spi->maxClock_Hz)
+    {
+        fprintf(
+            stderr,
+            "[GnssConfig] Invalid SPI clock_Hz: %u, should be %u - %u Hz\r\n",
+            spi->clock_Hz, SpiProfile::minClock_Hz, spi->maxClock_Hz
+        );
+        return false;
+    }
+
+    if (spi->bitsPerWord != 8)
+    {
+        fprintf(
+            stderr,
+            "[GnssConfig] Invalid SPI bitsPerWord: %u, the receiver only "
+            "supports 8\r\n",
+            static_cast<unsigned>(spi->bitsPerWord)
+        );
+        return false;
+    }
+
+    if (spi->chunkSize < 256 || spi->chunkSize > 65536)
+    {
+        fprintf(
+            stderr,
+            "[GnssConfig] Invalid SPI chunkSize: %u, should be 256 - 65536 "
+            "bytes (and within spidev bufsiz)\r\n",
+            spi->chunkSize
+        );
+        return false;
+    }
+
+    return true;
+}
+
+bool checkUartBaudrate(const std::optional<uint32_t>& baudrate)
+{
+    if (!baudrate.has_value())
+    {
+        return true;
+    }
+
+    const auto& supported = UartDriver::highSpeedBaudrates;
+    if (std::find(supported.begin(), supported.end(), *baudrate) ==
+        supported.end())
+    {
+        fprintf(
+            stderr,
+            "[GnssConfig] Invalid maxUartBaudrate: %u, should be 115200, "
+            "230400, 460800 or 921600\r\n",
+            *baudrate
+        );
+        return false;
+    }
+
+    return true;
+}
+
 }  // JimmyPaputto
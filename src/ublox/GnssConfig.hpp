@@ -11,6 +11,7 @@
 #include "EDynamicModel.hpp"
 #include "Geofence.hpp"
 #include "RtkConfig.hpp"
+#include "SpiProfile.hpp"
 #include "TimepulsePinConfig.hpp"
 #include "TimingConfig.hpp"
 
@@ -62,6 +63,14 @@ struct GnssConfig
     };
     std::optional<NavigationFilters> navigationFilters{};
 
+    // SPI HATs only (M9N, F9P); nullopt keeps 5 MHz
+    std::optional<SpiProfile> spi{};
+
+    // F10T: UART1 is raised step by step up to this rate and falls back
+    // to the last rate that passed a self-test. F9P: UART2 (RTCM3) is set
+    // to it. One of UartDriver::highSpeedBaudrates, nullopt keeps 115200.
+    std::optional<uint32_t> maxUartBaudrate{};
+
     bool saveToFlash{false};
 };
 
@@ -71,6 +80,8 @@ bool checkGeofencing(const std::optional<GnssConfig::Geofencing>& geofencing);
 bool checkTiming(const std::optional<TimingConfig>& timing);
 bool checkNavigationFilters(
     const std::optional<GnssConfig::NavigationFilters>& filters);
+bool checkSpiProfile(const std::optional<SpiProfile>& spi);
+bool checkUartBaudrate(const std::optional<uint32_t>& baudrate);
 
 }  // JimmyPaputto
 
@@ -22,6 +22,21 @@ public:
     virtual void transmitReceive(std::span<const uint8_t> txBuff,
         std::vector<uint8_t>& rxBuff) = 0;
     virtual void getRxBuff(uint8_t* rxBuff, const uint32_t size) = 0;
+
+    // Fills every segment in turn; SPI clocks them all in one message.
+    virtual void getRxBuffs(std::span<const std::span<uint8_t>> segments)
+    {
+        for (const auto& segment : segments)
+            getRxBuff(segment.data(), segment.size());
+    }
+
+    // Stream (UART) side: waits up to timeoutMs for bytes and reads what
+    // arrived. Returns the byte count, 0 on timeout and -1 on error or when
+    // the driver has no stream mode (SPI).
+    virtual int epoll(uint8_t*, const uint32_t, int)
+    {
+        return -1;
+    }
 };
 
 }  // JimmyPaputto
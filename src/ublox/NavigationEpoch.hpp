@@ -0,0 +1,44 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef NAVIGATION_EPOCH_HPP_
+#define NAVIGATION_EPOCH_HPP_
+
+#include <cstdint>
+
+#include "EUbxMsg.hpp"
+#include "Navigation.hpp"
+#include "common/EdgeTimestamp.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// One navigation epoch as the receiver reported it. Messages are grouped by
+// their iTOW; the epoch is published once it closes, either because every
+// message seen in the previous epoch has arrived or because a message of
+// the next epoch showed up first. Fields not refreshed in this epoch keep
+// their last known value.
+struct NavigationEpoch
+{
+    uint64_t sequence = 0;        // increments on every published epoch
+    uint32_t iTOW = 0;            // [ms] GPS time of week
+    uint32_t arrivedMsgs = 0;     // bit to_underlying(EUbxMsg) per message
+    bool complete = false;        // nothing expected was missing
+    Navigation navigation;
+    // TX-ready rise the epoch's first message followed; SPI receivers only
+    EdgeTimestamp txReady;
+    // Last timepulse before the epoch closed, while timepulse is enabled
+    EdgeTimestamp timepulse;
+    int64_t published_ns = 0;     // [ns] CLOCK_MONOTONIC at publication
+
+    bool arrived(const EUbxMsg eUbxMsg) const
+    {
+        return arrivedMsgs & (1u << to_underlying(eUbxMsg));
+    }
+};
+
+}  // JimmyPaputto
+
+#endif  // NAVIGATION_EPOCH_HPP_
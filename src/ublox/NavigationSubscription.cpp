@@ -0,0 +1,125 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "NavigationSubscription.hpp"
+
+
+namespace JimmyPaputto
+{
+
+NavigationSubscription::NavigationSubscription(std::size_t capacity,
+    EOverflowPolicy policy)
+:   queue_(capacity),
+    policy_(policy),
+    open_(true),
+    pushed_(0),
+    popped_(0),
+    delivered_(0),
+    consumed_(0),
+    discarded_(0),
+    rejected_(0),
+    maxLag_(0)
+{
+}
+
+bool NavigationSubscription::pop(NavigationEpoch& epoch,
+    std::stop_token stoken)
+{
+    std::stop_callback onStop(stoken, [this] { wake(pushed_); });
+    while (true)
+    {
+        const auto seen = pushed_.load();
+        if (tryPop(epoch))
+            return true;
+        if (stoken.stop_requested() || !open_.load())
+            return false;
+        pushed_.wait(seen);
+    }
+}
+
+bool NavigationSubscription::tryPop(NavigationEpoch& epoch)
+{
+    if (!queue_.tryPop(epoch))
+        return false;
+
+    consumed_++;
+    if (policy_ == EOverflowPolicy::Block)
+        wake(popped_);
+    return true;
+}
+
+void NavigationSubscription::unsubscribe()
+{
+    open_.store(false);
+    wake(pushed_);
+    wake(popped_);
+}
+
+bool NavigationSubscription::isOpen() const
+{
+    return open_.load();
+}
+
+NavigationSubscriptionStats NavigationSubscription::stats() const
+{
+    const auto delivered = delivered_.load();
+    const auto gone = consumed_.load() + discarded_.load();
+    return {
+        delivered,
+        consumed_.load(),
+        discarded_.load() + rejected_.load(),
+        delivered > gone ? delivered - gone : 0,
+        maxLag_.load()
+    };
+}
+
+void NavigationSubscription::push(const NavigationEpoch& epoch)
+{
+    if (!open_.load())
+        return;
+
+    while (!queue_.tryPush(epoch))
+    {
+        if (policy_ == EOverflowPolicy::DropNewest)
+        {
+            rejected_++;
+            return;
+        }
+
+        if (policy_ == EOverflowPolicy::DropOldest)
+        {
+            if (queue_.discard())
+            {
+                discarded_++;
+                continue;
+            }
+            // Only cell left is being copied out by the consumer right now
+            if (queue_.tryPush(epoch))
+                break;
+            rejected_++;
+            return;
+        }
+
+        const auto seen = popped_.load();
+        if (queue_.tryPush(epoch))
+            break;
+        if (!open_.load())
+            return;
+        popped_.wait(seen);
+    }
+
+    delivered_++;
+    const auto lag = stats().lag;
+    if (lag > maxLag_.load())
+        maxLag_.store(lag);
+    wake(pushed_);
+}
+
+void NavigationSubscription::wake(std::atomic<uint32_t>& counter)
+{
+    counter.fetch_add(1);
+    counter.notify_all();
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,73 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef NAVIGATION_SUBSCRIPTION_HPP_
+#define NAVIGATION_SUBSCRIPTION_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <stop_token>
+
+#include "NavigationEpoch.hpp"
+#include "common/BoundedQueue.hpp"
+
+
+namespace JimmyPaputto
+{
+
+enum class EOverflowPolicy : uint8_t
+{
+    DropOldest = 0x00,  // keep the most recent epochs
+    DropNewest = 0x01,  // keep what is queued, lose the incoming epoch
+    Block      = 0x02   // stall the receiver thread until there is room
+};
+
+struct NavigationSubscriptionStats
+{
+    uint64_t delivered;  // epochs queued for this subscriber
+    uint64_t consumed;   // epochs popped by this subscriber
+    uint64_t dropped;    // epochs lost to the overflow policy
+    uint64_t lag;        // epochs queued and not popped yet
+    uint64_t maxLag;
+};
+
+// Per-consumer queue of navigation epochs. The receiver thread pushes every
+// published epoch into every open subscription; each consumer pops at its
+// own pace, so a slow consumer only ever affects its own queue (unless it
+// asked for EOverflowPolicy::Block).
+class NavigationSubscription final
+{
+public:
+    explicit NavigationSubscription(std::size_t capacity,
+        EOverflowPolicy policy);
+
+    // Waits for the next epoch; false once stopped or unsubscribed
+    bool pop(NavigationEpoch& epoch, std::stop_token stoken = {});
+    bool tryPop(NavigationEpoch& epoch);
+
+    void unsubscribe();
+    bool isOpen() const;
+    NavigationSubscriptionStats stats() const;
+
+    // Receiver side
+    void push(const NavigationEpoch& epoch);
+
+private:
+    void wake(std::atomic<uint32_t>& counter);
+
+    BoundedQueue<NavigationEpoch> queue_;
+    const EOverflowPolicy policy_;
+    std::atomic<bool> open_;
+    std::atomic<uint32_t> pushed_;
+    std::atomic<uint32_t> popped_;
+    std::atomic<uint64_t> delivered_;
+    std::atomic<uint64_t> consumed_;
+    std::atomic<uint64_t> discarded_;
+    std::atomic<uint64_t> rejected_;
+    std::atomic<uint64_t> maxLag_;
+};
+
+}  // JimmyPaputto
+
+#endif  // NAVIGATION_SUBSCRIPTION_HPP_
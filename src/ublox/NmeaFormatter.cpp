@@ -0,0 +1,434 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "ublox/NmeaFormatter.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+
+namespace JimmyPaputto
+{
+
+namespace
+{
+
+constexpr uint8_t firstNmeaSystemId = 1;
+constexpr uint8_t lastNmeaSystemId = 5;
+constexpr int maxGsaPrns = 12;
+constexpr int gsvSatellitesPerSentence = 4;
+
+std::string_view gnssIdToGsvTalkerId(EGnssId id)
+{
+    switch (id)
+    {
+        case EGnssId::GPS:
+        case EGnssId::SBAS:    return "GP";
+        case EGnssId::GLONASS: return "GL";
+        case EGnssId::Galileo: return "GA";
+        case EGnssId::BeiDou:  return "GB";
+        case EGnssId::QZSS:    return "GQ";
+        default:               return "GP";
+    }
+}
+
+uint8_t gnssIdToNmeaSystemId(EGnssId id)
+{
+    switch (id)
+    {
+        case EGnssId::GPS:
+        case EGnssId::SBAS:    return 1;
+        case EGnssId::GLONASS: return 2;
+        case EGnssId::Galileo: return 3;
+        case EGnssId::BeiDou:  return 4;
+        case EGnssId::QZSS:    return 5;
+        default:               return 1;
+    }
+}
+
+int satelliteToNmeaPrn(const SatelliteInfo& sat)
+{
+    switch (sat.gnssId)
+    {
+        case EGnssId::GLONASS: return sat.svId + 64;
+        default:               return sat.svId;
+    }
+}
+
+int gsaFixType(const EFixType fixType)
+{
+    switch (fixType)
+    {
+        case EFixType::Fix2D: return 2;
+        case EFixType::Fix3D:
+        case EFixType::GnssWithDeadReckoning: return 3;
+        default: return 1;
+    }
+}
+
+}  // anonymous namespace
+
+NmeaFormatter::NmeaFormatter(std::span<char> buffer)
+:   buffer_(buffer),
+    size_(0),
+    sentenceBegin_(0),
+    overflow_(false),
+    dropped_(0)
+{
+}
+
+std::string_view NmeaFormatter::sentences() const
+{
+    return std::string_view(buffer_.data(), size_);
+}
+
+void NmeaFormatter::clear()
+{
+    size_ = 0;
+    dropped_ = 0;
+}
+
+void NmeaFormatter::gga(const Navigation& navigation)
+{
+    const auto& pvt = navigation.pvt;
+    begin("GNGGA,");
+    putTime(pvt.utc);
+    put(',');
+    putLatitude(pvt.latitude);
+    put(pvt.latitude >= 0 ? ",N," : ",S,");
+    putLongitude(pvt.longitude);
+    put(pvt.longitude >= 0 ? ",E," : ",W,");
+    putInt(static_cast<int>(pvt.fixQuality));
+    put(',');
+    putInt(pvt.visibleSatellites);
+    put(',');
+    putFixed(navigation.dop.horizontal, 1);
+    put(',');
+    putFixed(pvt.altitudeMSL, 1);
+    put(",M,");
+    putFixed(pvt.altitude - pvt.altitudeMSL, 1);
+    put(",M,,");
+    end();
+}
+
+void NmeaFormatter::rmc(const Navigation& navigation)
+{
+    // 1 m/s = 1.94384 knots
+    constexpr float knotsConversionFactor = 1.94384f;
+
+    const auto& pvt = navigation.pvt;
+    begin("GNRMC,");
+    putTime(pvt.utc);
+    put(pvt.fixStatus == EFixStatus::Active ? ",A," : ",V,");
+    putLatitude(pvt.latitude);
+    put(pvt.latitude >= 0 ? ",N," : ",S,");
+    putLongitude(pvt.longitude);
+    put(pvt.longitude >= 0 ? ",E," : ",W,");
+    putFixed(pvt.speedOverGround * knotsConversionFactor, 1);
+    put(',');
+    putFixed(pvt.heading, 1);
+    put(',');
+    if (pvt.date.valid)
+    {
+        putInt(pvt.date.day, 2);
+        putInt(pvt.date.month, 2);
+        putInt(pvt.date.year % 100, 2);
+    }
+    put(",,,");
+    end();
+}
+
+void NmeaFormatter::gsa(const Navigation& navigation)
+{
+    const int fixType = gsaFixType(navigation.pvt.fixType);
+    const auto tail = [&](const uint8_t sysId) {
+        putFixed(navigation.dop.position, 1);
+        put(',');
+        putFixed(navigation.dop.horizontal, 1);
+        put(',');
+        putFixed(navigation.dop.vertical, 1);
+        put(',');
+        putInt(sysId);
+        end();
+    };
+
+    bool anyUsed = false;
+    for (uint8_t sysId = firstNmeaSystemId; sysId <= lastNmeaSystemId; sysId++)
+    {
+        int prns = 0;
+        for (const auto& sat : navigation.satellites)
+        {
+            if (!sat.usedInFix || sat.gnssId == EGnssId::IMES ||
+                gnssIdToNmeaSystemId(sat.gnssId) != sysId)
+                continue;
+
+            if (prns == 0)
+            {
+                begin("GNGSA,A,");
+                putInt(fixType);
+                put(',');
+            }
+            if (prns < maxGsaPrns)
+            {
+                putInt(satelliteToNmeaPrn(sat));
+                put(',');
+            }
+            prns++;
+        }
+
+        if (prns == 0)
+            continue;
+
+        anyUsed = true;
+        for (int i = prns; i < maxGsaPrns; i++)
+            put(',');
+        tail(sysId);
+    }
+
+    if (!anyUsed)
+    {
+        begin("GNGSA,A,");
+        putInt(fixType);
+        put(",,,,,,,,,,,,,");
+        tail(firstNmeaSystemId);
+    }
+}
+
+void NmeaFormatter::gsv(const Navigation& navigation)
+{
+    for (uint8_t sysId = firstNmeaSystemId; sysId <= lastNmeaSystemId; sysId++)
+    {
+        const auto inSystem = [sysId](const SatelliteInfo& sat) {
+            return sat.gnssId != EGnssId::IMES &&
+                gnssIdToNmeaSystemId(sat.gnssId) == sysId;
+        };
+
+        const auto& satellites = navigation.satellites;
+        const auto first = std::find_if(satellites.begin(), satellites.end(),
+            inSystem);
+        if (first == satellites.end())
+            continue;
+
+        const auto talkerId = gnssIdToGsvTalkerId(first->gnssId);
+        const int totalSvs = static_cast<int>(
+            std::count_if(first, satellites.end(), inSystem));
+        const int totalMsgs = (totalSvs + gsvSatellitesPerSentence - 1) /
+            gsvSatellitesPerSentence;
+
+        int index = 0;
+        for (auto sat = first; sat != satellites.end(); ++sat)
+        {
+            if (!inSystem(*sat))
+                continue;
+
+            if (index % gsvSatellitesPerSentence == 0)
+            {
+                if (index > 0)
+                    end();
+                begin(talkerId);
+                put("GSV,");
+                putInt(totalMsgs);
+                put(',');
+                putInt(index / gsvSatellitesPerSentence + 1);
+                put(',');
+                putInt(totalSvs);
+            }
+
+            put(',');
+            putInt(satelliteToNmeaPrn(*sat), 2);
+            put(',');
+            putInt(sat->elevation);
+            put(',');
+            putInt(sat->azimuth, 3);
+            put(',');
+            if (sat->cno > 0)
+                putInt(sat->cno, 2);
+            index++;
+        }
+        end();
+    }
+}
+
+void NmeaFormatter::gst(const Navigation& navigation)
+{
+    // hAcc = sqrt(stdLat^2 + stdLon^2), assuming stdLat ≈ stdLon
+    constexpr float invSqrt2 = 0.707107f;
+
+    const auto& pvt = navigation.pvt;
+    const float stdLatLon = pvt.horizontalAccuracy * invSqrt2;
+    begin("GNGST,");
+    putTime(pvt.utc);
+    // RMS, semi-major, semi-minor, orientation - not available from NAV-PVT
+    put(",,,,,");
+    putFixed(stdLatLon, 3);
+    put(',');
+    putFixed(stdLatLon, 3);
+    put(',');
+    putFixed(pvt.verticalAccuracy, 3);
+    end();
+}
+
+void NmeaFormatter::zda(const Navigation& navigation)
+{
+    const auto& date = navigation.pvt.date;
+    begin("GNZDA,");
+    putTime(navigation.pvt.utc);
+    put(',');
+    if (date.valid)
+    {
+        putInt(date.day, 2);
+        put(',');
+        putInt(date.month, 2);
+        put(',');
+        putInt(date.year);
+        put(',');
+    }
+    else
+    {
+        put(",,,");
+    }
+    // Local zone hours and minutes (UTC = 00,00)
+    put("00,00");
+    end();
+}
+
+void NmeaFormatter::epoch(const NavigationEpoch& epoch,
+    const NmeaOutputConfig& output)
+{
+    const auto due = [&epoch](const uint16_t every) {
+        return every != 0 && epoch.sequence % every == 0;
+    };
+
+    const auto& nav = epoch.navigation;
+    if (due(output.gga))
+        gga(nav);
+    if (due(output.gsa))
+        gsa(nav);
+    if (due(output.gsv))
+        gsv(nav);
+    if (due(output.gst))
+        gst(nav);
+    if (due(output.rmc))
+        rmc(nav);
+    if (due(output.zda))
+        zda(nav);
+}
+
+void NmeaFormatter::begin(std::string_view address)
+{
+    sentenceBegin_ = size_;
+    overflow_ = false;
+    put('$');
+    put(address);
+}
+
+void NmeaFormatter::end()
+{
+    uint8_t checksum = 0;
+    if (!overflow_)
+    {
+        for (std::size_t i = sentenceBegin_ + 1; i < size_; i++)
+            checksum ^= static_cast<uint8_t>(buffer_[i]);
+    }
+    put('*');
+    putHex(checksum);
+    put("\r\n");
+
+    if (overflow_)
+    {
+        size_ = sentenceBegin_;
+        dropped_++;
+    }
+}
+
+void NmeaFormatter::put(const char c)
+{
+    if (size_ < buffer_.size())
+        buffer_[size_++] = c;
+    else
+        overflow_ = true;
+}
+
+void NmeaFormatter::put(std::string_view text)
+{
+    if (text.size() > buffer_.size() - size_)
+    {
+        overflow_ = true;
+        return;
+    }
+    std::copy(text.begin(), text.end(), buffer_.begin() + size_);
+    size_ += text.size();
+}
+
+void NmeaFormatter::putInt(const int value, const int width)
+{
+    char digits[16];
+    const auto result = std::to_chars(std::begin(digits), std::end(digits),
+        value);
+    const int length = static_cast<int>(result.ptr - digits);
+    // Zero padding only makes sense for the unsigned fields it is used on
+    for (int i = value >= 0 ? length : width; i < width; i++)
+        put('0');
+    put(std::string_view(digits, length));
+}
+
+void NmeaFormatter::putFixed(const double value, const int precision,
+    const int width)
+{
+    char digits[64];
+    const auto result = std::to_chars(std::begin(digits), std::end(digits),
+        value, std::chars_format::fixed, precision);
+    if (result.ec != std::errc())
+    {
+        overflow_ = true;
+        return;
+    }
+    const int length = static_cast<int>(result.ptr - digits);
+    for (int i = length; i < width; i++)
+        put('0');
+    put(std::string_view(digits, length));
+}
+
+void NmeaFormatter::putHex(const uint8_t value)
+{
+    constexpr char hex[] = "0123456789ABCDEF";
+    put(hex[value >> 4]);
+    put(hex[value & 0x0F]);
+}
+
+void NmeaFormatter::putTime(const UTC& utc)
+{
+    if (!utc.valid)
+        return;
+
+    // hhmmss.ss: above 1 Hz every epoch of a second needs its own time.
+    // NAV-PVT's nano may be slightly negative at the top of the second,
+    // where ss has already been rounded up
+    const int centiseconds = std::clamp(
+        (utc.nano + 5'000'000) / 10'000'000, 0, 99);
+    putInt(utc.hh, 2);
+    putInt(utc.mm, 2);
+    putInt(utc.ss, 2);
+    put('.');
+    putInt(centiseconds, 2);
+}
+
+void NmeaFormatter::putLatitude(const double latitude)
+{
+    const double absLat = std::abs(latitude);
+    const int degrees = static_cast<int>(absLat);
+    putInt(degrees, 2);
+    putFixed((absLat - degrees) * 60.0, 5, 8);
+}
+
+void NmeaFormatter::putLongitude(const double longitude)
+{
+    const double absLon = std::abs(longitude);
+    const int degrees = static_cast<int>(absLon);
+    putInt(degrees, 3);
+    putFixed((absLon - degrees) * 60.0, 5, 8);
+}
+
+}  // JimmyPaputto
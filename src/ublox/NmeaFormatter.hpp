@@ -0,0 +1,66 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_NMEA_FORMATTER_HPP_
+#define JIMMY_PAPUTTO_NMEA_FORMATTER_HPP_
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "Navigation.hpp"
+#include "NavigationEpoch.hpp"
+#include "NmeaOutputConfig.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Writes NMEA 0183 sentences, checksum and CRLF included, straight into a
+// caller buffer with std::to_chars; nothing is allocated. Sentences are
+// appended whole: one that does not fit is rolled back and counted in
+// dropped(), and the ones before it stay.
+class NmeaFormatter
+{
+public:
+    explicit NmeaFormatter(std::span<char> buffer);
+
+    void gga(const Navigation& navigation);
+    void gsa(const Navigation& navigation);
+    void gsv(const Navigation& navigation);
+    void gst(const Navigation& navigation);
+    void rmc(const Navigation& navigation);
+    void zda(const Navigation& navigation);
+
+    // The sentences `output` has due on this epoch, GGA, GSA, GSV, GST,
+    // RMC and ZDA in that order
+    void epoch(const NavigationEpoch& epoch, const NmeaOutputConfig& output);
+
+    std::string_view sentences() const;
+    std::size_t dropped() const { return dropped_; }
+    void clear();
+
+private:
+    void begin(std::string_view address);
+    void end();
+
+    void put(char c);
+    void put(std::string_view text);
+    void putInt(int value, int width = 0);
+    void putFixed(double value, int precision, int width = 0);
+    void putHex(uint8_t value);
+    void putTime(const UTC& utc);
+    void putLatitude(double latitude);
+    void putLongitude(double longitude);
+
+    std::span<char> buffer_;
+    std::size_t size_;
+    std::size_t sentenceBegin_;
+    bool overflow_;
+    std::size_t dropped_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_NMEA_FORMATTER_HPP_
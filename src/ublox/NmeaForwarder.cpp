@@ -5,12 +5,10 @@
 #include "ublox/NmeaForwarder.hpp"
 
 #include <algorithm>
-#include <cmath>
-#include <iomanip>
-#include <map>
-#include <sstream>
+#include <array>
 #include <cstring>
-#include <chrono>
+
+#include "ublox/NmeaFormatter.hpp"
 
 
 namespace JimmyPaputto
@@ -19,49 +17,26 @@ namespace JimmyPaputto
 namespace
 {
 
-const char* gnssIdToGsvTalkerId(EGnssId id)
+uint64_t countSentences(std::string_view sentences)
 {
-    switch (id)
-    {
-        case EGnssId::GPS:
-        case EGnssId::SBAS:    return "GP";
-        case EGnssId::GLONASS: return "GL";
-        case EGnssId::Galileo: return "GA";
-        case EGnssId::BeiDou:  return "GB";
-        case EGnssId::QZSS:    return "GQ";
-        default:               return "GP";
-    }
+    return static_cast<uint64_t>(
+        std::count(sentences.begin(), sentences.end(), '\n'));
 }
 
-uint8_t gnssIdToNmeaSystemId(EGnssId id)
-{
-    switch (id)
-    {
-        case EGnssId::GPS:
-        case EGnssId::SBAS:    return 1;
-        case EGnssId::GLONASS: return 2;
-        case EGnssId::Galileo: return 3;
-        case EGnssId::BeiDou:  return 4;
-        case EGnssId::QZSS:    return 5;
-        default:               return 1;
-    }
-}
+}  // namespace
 
-int satelliteToNmeaPrn(const SatelliteInfo& sat)
+NmeaForwarder::NmeaForwarder()
+:   NmeaForwarder(-1)
 {
-    switch (sat.gnssId)
-    {
-        case EGnssId::GLONASS: return sat.svId + 64;
-        default:               return sat.svId;
-    }
 }
 
-}  // anonymous namespace
-
-NmeaForwarder::NmeaForwarder()
-:   masterFd_(-1),
-    slaveFd_(-1)
+NmeaForwarder::NmeaForwarder(int masterFd)
+:   masterFd_(masterFd),
+    slaveFd_(-1),
+    stats_{}
 {
+    // An NMEA sentence is at most 82 characters
+    unfinished_.reserve(128);
 }
 
 NmeaForwarder::~NmeaForwarder()
@@ -188,7 +163,7 @@ bool NmeaForwarder::createVirtualTty()
     return true;
 }
 
-void NmeaForwarder::startForwarding(const Gnss& gnss)
+void NmeaForwarder::startForwarding(Gnss& gnss, const NmeaOutputConfig& output)
 {
     if (forwardingThread_.joinable())
     {
@@ -210,9 +185,12 @@ void NmeaForwarder::startForwarding(const Gnss& gnss)
         return;
     }
 
+    // A reader that stops draining the PTY must not hold the receiver up,
+    // so only the freshest epochs are kept
+    subscription_ = gnss.subscribe(4, EOverflowPolicy::DropOldest);
     forwardingThread_ = std::jthread(
-        [this, &gnss](std::stop_token stoken) {
-            forwardingThread(gnss, stoken);
+        [this, output](std::stop_token stoken) {
+            forwardingThread(output, stoken);
         }
     );
 }
@@ -220,6 +198,8 @@ void NmeaForwarder::startForwarding(const Gnss& gnss)
 void NmeaForwarder::stopForwarding()
 {
     forwardingThread_.request_stop();
+    if (subscription_)
+        subscription_->unsubscribe();
 
     if (!devicePath_.empty())
         unlink(devicePath_.c_str());
@@ -237,391 +217,95 @@ bool NmeaForwarder::isRunning() const
         && !forwardingThread_.get_stop_token().stop_requested();
 }
 
-void NmeaForwarder::forwardingThread(const Gnss& gnss, std::stop_token stoken)
-{    
-    while (!stoken.stop_requested())
-    {
-        if (!gnss.lock())
-            continue;
-
-        const auto nav = gnss.navigation();
-        gnss.unlock();
-
-        const std::string gga = generateNmeaGGA(nav);
-        const std::string gsa = generateNmeaGSA(nav);
-        const std::string gsv = generateNmeaGSV(nav);
-        const std::string gst = generateNmeaGST(nav);
-        const std::string rmc = generateNmeaRMC(nav);
-        const std::string zda = generateNmeaZDA(nav);
-
-        const std::string combined = gga + gsa + gsv + gst + rmc + zda;
-
-        if (masterFd_ >= 0)
-        {
-            const ssize_t result = write(
-                masterFd_, combined.c_str(), combined.length()
-            );
-
-            if (result < 0)
-            {
-                if (errno != EAGAIN && errno != EWOULDBLOCK)
-                {
-                    fprintf(
-                        stderr,
-                        "[NmeaForwarder] Write error: %s\r\n",
-                        strerror(errno)
-                    );
-                }
-            }
-            else
-            {
-                // TODO: check for that, is this taking too much CPU?
-                fsync(masterFd_);
-            }
-        }
-
-        std::this_thread::sleep_for(updateInterval_);
-    }
-}
-
-std::string NmeaForwarder::generateNmeaGGA(const Navigation& navigation)
-{
-    std::ostringstream oss;
-    
-    std::string sentence = "GNGGA,";
-    
-    sentence += formatTime(navigation) + ",";
-    
-    sentence += formatLatitude(navigation.pvt.latitude) + ",";
-    sentence += (navigation.pvt.latitude >= 0 ? "N," : "S,");
-    
-    sentence += formatLongitude(navigation.pvt.longitude) + ",";
-    sentence += (navigation.pvt.longitude >= 0 ? "E," : "W,");
-
-    const int quality = static_cast<int>(navigation.pvt.fixQuality);
-    sentence += std::to_string(quality) + ",";
-
-    sentence += std::to_string(navigation.pvt.visibleSatellites) + ",";
-
-    oss.str("");
-    oss << std::fixed << std::setprecision(1) << navigation.dop.horizontal;
-    sentence += oss.str() + ",";
- 
-    oss.str("");
-    oss << std::fixed << std::setprecision(1) << navigation.pvt.altitudeMSL;
-    sentence += oss.str() + ",M,";
-
-    const float geoidSep = navigation.pvt.altitude - navigation.pvt.altitudeMSL;
-    oss.str("");
-    oss << std::fixed << std::setprecision(1) << geoidSep;
-    sentence += oss.str() + ",M,,";
-
-    const std::string checksum = calculateNmeaChecksum(sentence);
-    return "$" + sentence + "*" + checksum + "\r\n";
-}
-
-std::string NmeaForwarder::generateNmeaRMC(const Navigation& navigation)
+NmeaForwarderStats NmeaForwarder::stats() const
 {
-    std::ostringstream oss;
-
-    std::string sentence = "GNRMC,";
-
-    sentence += formatTime(navigation) + ",";
-    sentence += (navigation.pvt.fixStatus == EFixStatus::Active ? "A," : "V,");
-
-    sentence += formatLatitude(navigation.pvt.latitude) + ",";
-    sentence += (navigation.pvt.latitude >= 0 ? "N," : "S,");
-
-    sentence += formatLongitude(navigation.pvt.longitude) + ",";
-    sentence += (navigation.pvt.longitude >= 0 ? "E," : "W,");
-
-    // Speed m/s to knots
-    // 1 m/s = 1.94384 knots
-    constexpr float knotsConversionFactor = 1.94384f;
-    const float speedKnots =
-        navigation.pvt.speedOverGround * knotsConversionFactor;
-    oss.str("");
-    oss << std::fixed << std::setprecision(1) << speedKnots;
-    sentence += oss.str() + ",";
-
-    oss.str("");
-    oss << std::fixed << std::setprecision(1) << navigation.pvt.heading;
-    sentence += oss.str() + ",";
-
-    sentence += formatDate(navigation) + ",,,";
-
-    const std::string checksum = calculateNmeaChecksum(sentence);
-    return "$" + sentence + "*" + checksum + "\r\n";
+    return statsSnapshot_.read();
 }
 
-std::string NmeaForwarder::generateNmeaGSA(const Navigation& navigation)
+void NmeaForwarder::forwardingThread(const NmeaOutputConfig output,
+    std::stop_token stoken)
 {
-    int fixType = 1;
-    switch (navigation.pvt.fixType)
+    std::array<char, 4096> buffer;
+    NmeaFormatter formatter(buffer);
+    NavigationEpoch epoch;
+    while (subscription_->pop(epoch, stoken))
     {
-        case EFixType::Fix2D: fixType = 2; break;
-        case EFixType::Fix3D:
-        case EFixType::GnssWithDeadReckoning: fixType = 3; break;
-        default: fixType = 1; break;
+        formatter.clear();
+        formatter.epoch(epoch, output);
+        writeSentences(formatter.sentences());
     }
+}
 
-    std::map<uint8_t, std::vector<int>> usedPrnsBySystem;
+void NmeaForwarder::writeSentences(std::string_view sentences)
+{
+    if (masterFd_ < 0 || sentences.empty())
+        return;
 
-    for (const auto& sat : navigation.satellites)
+    // The PTY master is non-blocking; if the reader fell behind, what does
+    // not fit is dropped rather than queued behind stale epochs. A sentence
+    // cut by a short write is finished first, before anything newer, so the
+    // reader never gets half a sentence with the next one glued on.
+    if (!unfinished_.empty())
     {
-        if (!sat.usedInFix)
-            continue;
-
-        if (sat.gnssId == EGnssId::IMES)
-            continue;
-
-        const uint8_t sysId = gnssIdToNmeaSystemId(sat.gnssId);
-        const int prn = satelliteToNmeaPrn(sat);
-        usedPrnsBySystem[sysId].push_back(prn);
+        unfinished_.erase(0, writeSome(unfinished_));
+        if (!unfinished_.empty())
+        {
+            stats_.epochsDropped++;
+            stats_.sentencesDropped += countSentences(sentences);
+            statsSnapshot_.publish(stats_);
+            return;
+        }
     }
 
-    std::ostringstream ossPdop, ossHdop, ossVdop;
-    ossPdop << std::fixed << std::setprecision(1) << navigation.dop.position;
-    ossHdop << std::fixed << std::setprecision(1) << navigation.dop.horizontal;
-    ossVdop << std::fixed << std::setprecision(1) << navigation.dop.vertical;
-
-    std::string result;
-
-    if (usedPrnsBySystem.empty())
+    const auto written = writeSome(sentences);
+    if (written == sentences.size())
     {
-        std::string sentence = "GNGSA,A,"
-            + std::to_string(fixType) + ",";
-
-        for (int i = 0; i < 12; i++)
-            sentence += ",";
-
-        sentence += ossPdop.str() + ","
-                  + ossHdop.str() + ","
-                  + ossVdop.str() + ",1";
-
-        result += "$" + sentence + "*"
-               + calculateNmeaChecksum(sentence) + "\r\n";
+        stats_.epochsWritten++;
     }
     else
     {
-        for (const auto& [sysId, prns] : usedPrnsBySystem)
+        auto end = written;
+        if (written > 0 && sentences[written - 1] != '\n')
         {
-            std::string sentence = "GNGSA,A,"
-                + std::to_string(fixType) + ",";
-
-            for (int i = 0; i < 12; i++)
-            {
-                if (i < static_cast<int>(prns.size()))
-                    sentence += std::to_string(prns[i]);
-                sentence += ",";
-            }
-
-            sentence += ossPdop.str() + ","
-                      + ossHdop.str() + ","
-                      + ossVdop.str() + ","
-                      + std::to_string(sysId);
-
-            result += "$" + sentence + "*"
-                   + calculateNmeaChecksum(sentence) + "\r\n";
+            const auto newline = sentences.find('\n', written);
+            end = newline == std::string_view::npos
+                ? sentences.size() : newline + 1;
+            unfinished_.assign(sentences.substr(written, end - written));
         }
+        stats_.sentencesDropped += countSentences(sentences.substr(end));
+        if (written == 0)
+            stats_.epochsDropped++;
+        else
+            stats_.epochsCut++;
     }
-
-    return result;
+    statsSnapshot_.publish(stats_);
 }
 
-std::string NmeaForwarder::generateNmeaGSV(const Navigation& navigation)
+std::size_t NmeaForwarder::writeSome(std::string_view bytes)
 {
-    std::map<uint8_t, std::vector<const SatelliteInfo*>> groups;
-
-    for (const auto& sat : navigation.satellites)
+    std::size_t written = 0;
+    while (written < bytes.size())
     {
-        if (sat.gnssId == EGnssId::IMES)
+        const ssize_t result = write(masterFd_, bytes.data() + written,
+            bytes.size() - written);
+        if (result > 0)
+        {
+            written += static_cast<std::size_t>(result);
             continue;
-
-        const uint8_t sysId = gnssIdToNmeaSystemId(sat.gnssId);
-        groups[sysId].push_back(&sat);
-    }
-
-    std::string result;
-
-    for (const auto& [sysId, sats] : groups)
-    {
-        if (sats.empty())
+        }
+        if (result < 0 && errno == EINTR)
             continue;
-
-        const char* talkerId = gnssIdToGsvTalkerId(sats[0]->gnssId);
-        const int totalSvs = static_cast<int>(sats.size());
-        const int totalMsgs = (totalSvs + 3) / 4;
-
-        for (int msgNum = 1; msgNum <= totalMsgs; msgNum++)
+        if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
         {
-            std::string sentence = std::string(talkerId) + "GSV,"
-                + std::to_string(totalMsgs) + ","
-                + std::to_string(msgNum) + ","
-                + std::to_string(totalSvs);
-
-            const int startIdx = (msgNum - 1) * 4;
-            const int endIdx = std::min(startIdx + 4, totalSvs);
-
-            for (int i = startIdx; i < endIdx; i++)
-            {
-                const auto& sat = *sats[i];
-                const int prn = satelliteToNmeaPrn(sat);
-
-                std::ostringstream oss;
-                oss << std::setfill('0') << std::setw(2) << prn;
-                sentence += "," + oss.str();
-
-                sentence += "," + std::to_string(
-                    static_cast<int>(sat.elevation));
-
-                oss.str("");
-                oss << std::setfill('0') << std::setw(3)
-                    << sat.azimuth;
-                sentence += "," + oss.str();
-
-                sentence += ",";
-                if (sat.cno > 0)
-                {
-                    oss.str("");
-                    oss << std::setfill('0') << std::setw(2)
-                        << static_cast<int>(sat.cno);
-                    sentence += oss.str();
-                }
-            }
-
-            const std::string checksum =
-                calculateNmeaChecksum(sentence);
-            result += "$" + sentence + "*" + checksum + "\r\n";
+            fprintf(
+                stderr,
+                "[NmeaForwarder] Write error: %s\r\n",
+                strerror(errno)
+            );
         }
+        break;
     }
-
-    return result;
-}
-
-std::string NmeaForwarder::generateNmeaGST(const Navigation& navigation)
-{
-    std::string sentence = "GNGST,";
-
-    sentence += formatTime(navigation) + ",";
-
-    // RMS, semi-major, semi-minor, orientation - not available from UBX-NAV-PVT
-    sentence += ",,,,";
-
-    // hAcc = sqrt(stdLat^2 + stdLon^2), assuming stdLat ≈ stdLon
-    constexpr float invSqrt2 = 0.707107f;
-    const float stdLatLon = navigation.pvt.horizontalAccuracy * invSqrt2;
-
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(3) << stdLatLon;
-    sentence += oss.str() + ",";
-
-    oss.str("");
-    oss << std::fixed << std::setprecision(3) << stdLatLon;
-    sentence += oss.str() + ",";
-
-    oss.str("");
-    oss << std::fixed << std::setprecision(3) << navigation.pvt.verticalAccuracy;
-    sentence += oss.str();
-
-    const std::string checksum = calculateNmeaChecksum(sentence);
-    return "$" + sentence + "*" + checksum + "\r\n";
-}
-
-std::string NmeaForwarder::calculateNmeaChecksum(const std::string& sentence)
-{
-    uint8_t checksum = 0;
-    for (const char c : sentence)
-        checksum ^= c;
-
-    std::ostringstream oss;
-    oss << std::hex << std::uppercase << std::setfill('0')
-        << std::setw(2) << (int)checksum;
-    return oss.str();
-}
-
-std::string NmeaForwarder::formatLatitude(const double lat)
-{
-    const double absLat = std::abs(lat);
-    const int degrees = (int)absLat;
-    const double minutes = (absLat - degrees) * 60.0;
-
-    std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(2) << degrees;
-    oss << std::fixed << std::setprecision(5) << std::setfill('0')
-        << std::setw(8) << minutes;
-    return oss.str();
-}
-
-std::string NmeaForwarder::formatLongitude(double lon)
-{
-    const double absLon = std::abs(lon);
-    const int degrees = (int)absLon;
-    const double minutes = (absLon - degrees) * 60.0;
-
-    std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(3) << degrees;
-    oss << std::fixed << std::setprecision(5) << std::setfill('0')
-        << std::setw(8) << minutes;
-    return oss.str();
-}
-
-std::string NmeaForwarder::generateNmeaZDA(const Navigation& navigation)
-{
-    const auto& date = navigation.pvt.date;
-
-    std::string sentence = "GNZDA,";
-
-    sentence += formatTime(navigation) + ",";
-
-    if (date.valid)
-    {
-        std::ostringstream oss;
-        oss << std::setfill('0') << std::setw(2) << (int)date.day;
-        sentence += oss.str() + ",";
-
-        oss.str("");
-        oss << std::setfill('0') << std::setw(2) << (int)date.month;
-        sentence += oss.str() + ",";
-
-        sentence += std::to_string(date.year) + ",";
-    }
-    else
-    {
-        sentence += ",,,,";
-    }
-
-    // Local zone hours and minutes (UTC = 00,00)
-    sentence += "00,00";
-
-    const std::string checksum = calculateNmeaChecksum(sentence);
-    return "$" + sentence + "*" + checksum + "\r\n";
-}
-
-std::string NmeaForwarder::formatTime(const Navigation& navigation)
-{
-    const auto& utc = navigation.pvt.utc;
-    if (!utc.valid)
-        return "";
-
-    std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(2) << (int)utc.hh;
-    oss << std::setfill('0') << std::setw(2) << (int)utc.mm;
-    oss << std::setfill('0') << std::setw(2) << (int)utc.ss;
-    return oss.str();
-}
-
-std::string NmeaForwarder::formatDate(const Navigation& navigation)
-{
-    const auto& date = navigation.pvt.date;
-    if (!date.valid)
-        return "";
-    
-    std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(2) << (int)date.day;
-    oss << std::setfill('0') << std::setw(2) << (int)date.month;
-    oss << std::setfill('0') << std::setw(2) << (date.year % 100);
-    return oss.str();
+    return written;
 }
 
 }  // JimmyPaputto
@@ -6,6 +6,7 @@
 #define JIMMY_PAPUTTO_NMEA_FORWARDER_HPP_
 
 #include <string>
+#include <string_view>
 #include <thread>
 #include <memory>
 #include <pty.h>
@@ -15,8 +16,9 @@
 #include <sys/stat.h>
 
 #include "Gnss.hpp"
-#include "Navigation.hpp"
-#include "common/Notifier.hpp"
+#include "NmeaForwarderStats.hpp"
+#include "NmeaOutputConfig.hpp"
+#include "common/SnapshotBuffer.hpp"
 
 
 namespace JimmyPaputto
@@ -26,36 +28,38 @@ class NmeaForwarder
 {
 public:
     explicit NmeaForwarder();
+    // Writes to an already open, non-blocking pty master instead of
+    // creating one, e.g. a pty opened by a test
+    explicit NmeaForwarder(int masterFd);
     ~NmeaForwarder();
 
     bool createVirtualTty();
-    void startForwarding(const Gnss& gnss);
+    void startForwarding(Gnss& gnss, const NmeaOutputConfig& output = {});
     void stopForwarding();
     void joinForwarding();
 
     std::string getDevicePath() const { return devicePath_; }
     bool isRunning() const;
+    NmeaForwarderStats stats() const;
+
+    // One epoch of CRLF-terminated sentences; called by the forwarding
+    // thread only
+    void writeSentences(std::string_view sentences);
 
 private:
-    void forwardingThread(const Gnss& gnss, std::stop_token stoken);
-    std::string generateNmeaGGA(const Navigation& navigation);
-    std::string generateNmeaRMC(const Navigation& navigation);
-    std::string generateNmeaGSA(const Navigation& navigation);
-    std::string generateNmeaGSV(const Navigation& navigation);
-    std::string generateNmeaGST(const Navigation& navigation);
-    std::string generateNmeaZDA(const Navigation& navigation);
-    std::string calculateNmeaChecksum(const std::string& sentence);
-    std::string formatLatitude(const double lat);
-    std::string formatLongitude(const double lon);
-    std::string formatTime(const Navigation& navigation);
-    std::string formatDate(const Navigation& navigation);
+    void forwardingThread(const NmeaOutputConfig output,
+        std::stop_token stoken);
+    std::size_t writeSome(std::string_view bytes);
 
     int masterFd_;
     int slaveFd_;
     std::string devicePath_;
+    std::shared_ptr<NavigationSubscription> subscription_;
+    // Tail of a sentence the pty had no room for, sent before anything else
+    std::string unfinished_;
+    NmeaForwarderStats stats_;
+    SnapshotBuffer<NmeaForwarderStats> statsSnapshot_;
     std::jthread forwardingThread_;
-
-    std::chrono::milliseconds updateInterval_{1000};
 };
 
 }  // JimmyPaputto
@@ -0,0 +1,27 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_NMEA_FORWARDER_STATS_HPP_
+#define JIMMY_PAPUTTO_NMEA_FORWARDER_STATS_HPP_
+
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+// Epochs written to the gpsd pty. A reader that falls behind never gets
+// half a sentence: the pty is filled up to a sentence boundary and the
+// rest of the epoch is dropped.
+struct NmeaForwarderStats
+{
+    uint64_t epochsWritten = 0;  // every sentence went out
+    uint64_t epochsCut = 0;      // the first sentences went out, then full
+    uint64_t epochsDropped = 0;  // nothing went out, the pty was full
+    uint64_t sentencesDropped = 0;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_NMEA_FORWARDER_STATS_HPP_
@@ -0,0 +1,31 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef NMEA_OUTPUT_CONFIG_HPP_
+#define NMEA_OUTPUT_CONFIG_HPP_
+
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+// Which sentences the gpsd forwarder writes and how often. Each field is a
+// decimation: the sentence goes out on every Nth navigation epoch, counted
+// by NavigationEpoch::sequence, and 0 leaves it out. With the defaults a
+// 10 Hz receiver produces all six sentences at 10 Hz; { .gsv = 10 } keeps
+// the satellite view at 1 Hz while position stays at the full rate.
+struct NmeaOutputConfig
+{
+    uint16_t gga = 1;
+    uint16_t gsa = 1;
+    uint16_t gsv = 1;
+    uint16_t gst = 1;
+    uint16_t rmc = 1;
+    uint16_t zda = 1;
+};
+
+}  // JimmyPaputto
+
+#endif  // NMEA_OUTPUT_CONFIG_HPP_
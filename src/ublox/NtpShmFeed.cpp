@@ -0,0 +1,59 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "NtpShmFeed.hpp"
+
+
+namespace JimmyPaputto
+{
+
+NtpShmFeed::NtpShmFeed(Gnss& gnss, uint8_t unit)
+:   NtpShmFeed(gnss, std::make_unique<NtpShmSegment>(unit))
+{
+}
+
+NtpShmFeed::NtpShmFeed(Gnss& gnss, std::unique_ptr<NtpShmSegment> segment)
+:   segment_(std::move(segment)),
+    subscription_(gnss.subscribe(8, EOverflowPolicy::DropOldest))
+{
+    if (!segment_->isAttached())
+        return;
+
+    thread_ = std::jthread([this](std::stop_token stoken) {
+        run(stoken);
+    });
+}
+
+NtpShmFeed::~NtpShmFeed()
+{
+    thread_.request_stop();
+    subscription_->unsubscribe();
+}
+
+PpsOffsetStats NtpShmFeed::stats() const
+{
+    return stats_.read();
+}
+
+void NtpShmFeed::run(std::stop_token stoken)
+{
+    NavigationEpoch epoch;
+    PpsOffsetStats stats;
+    while (subscription_->pop(epoch, stoken))
+    {
+        const auto sample = estimator_.add(epoch);
+        if (sample)
+        {
+            segment_->publish(sample->utc_ns, sample->receive_ns, precision);
+            stats.published++;
+        }
+
+        const auto published = stats.published;
+        stats = estimator_.stats();
+        stats.published = published;
+        stats_.publish(stats);
+    }
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,53 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_NTP_SHM_FEED_HPP_
+#define JIMMY_PAPUTTO_NTP_SHM_FEED_HPP_
+
+#include <memory>
+#include <thread>
+
+#include "common/NtpShm.hpp"
+#include "common/SnapshotBuffer.hpp"
+#include "ublox/Gnss.hpp"
+#include "ublox/PpsOffsetEstimator.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Feeds chrony or ntpd from the timepulse: every epoch published by Gnss
+// goes through PpsOffsetEstimator on a thread of its own and each kept
+// sample is written to one NTP SHM refclock unit, e.g. for chrony
+//     refclock SHM 0 refid PPS precision 1e-7
+class NtpShmFeed
+{
+public:
+    NtpShmFeed(Gnss& gnss, uint8_t unit);
+    // Segment already made by the caller, for tests
+    NtpShmFeed(Gnss& gnss, std::unique_ptr<NtpShmSegment> segment);
+    ~NtpShmFeed();
+
+    NtpShmFeed(const NtpShmFeed&) = delete;
+    NtpShmFeed& operator=(const NtpShmFeed&) = delete;
+
+    bool isAttached() const { return segment_->isAttached(); }
+    PpsOffsetStats stats() const;
+
+    // Kernel GPIO stamps come within microseconds of the edge
+    static constexpr int precision = -20;
+
+private:
+    void run(std::stop_token stoken);
+
+    std::unique_ptr<NtpShmSegment> segment_;
+    std::shared_ptr<NavigationSubscription> subscription_;
+    PpsOffsetEstimator estimator_;
+    SnapshotBuffer<PpsOffsetStats> stats_;
+    std::jthread thread_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_NTP_SHM_FEED_HPP_
@@ -20,6 +20,7 @@ struct UTC
     uint8_t ss;
     bool valid;
     int32_t accuracy;
+    int32_t nano;  // [ns] -1e9..1e9, signed fraction added to hh:mm:ss
 };
 
 struct Date
@@ -0,0 +1,120 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "PpsOffsetEstimator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+
+namespace JimmyPaputto
+{
+
+namespace
+{
+
+constexpr int64_t nsPerSecond = 1'000'000'000;
+
+int64_t median(std::vector<int64_t> values)
+{
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+}  // namespace
+
+PpsOffsetEstimator::PpsOffsetEstimator(std::size_t window,
+    int64_t outlierFloor_ns)
+:   window_(std::max<std::size_t>(window, minSamplesToFilter)),
+    outlierFloor_ns_(outlierFloor_ns),
+    lastPulse_(0),
+    consecutiveOutliers_(0)
+{
+}
+
+std::optional<PpsOffsetSample> PpsOffsetEstimator::add(
+    const NavigationEpoch& epoch)
+{
+    const auto& pvt = epoch.navigation.pvt;
+    if (epoch.iTOW % 1000 != 0 || !pvt.utc.valid || !pvt.date.valid)
+        return std::nullopt;
+
+    // The pulse for this second comes before its NAV-PVT; anything older
+    // than a second belongs to an earlier epoch
+    const auto& pulse = epoch.timepulse;
+    const auto age_ns = epoch.published_ns - pulse.monotonic_ns;
+    if (!pulse.valid() || pulse.sequence == lastPulse_ ||
+        age_ns < 0 || age_ns >= nsPerSecond)
+    {
+        stats_.unpaired++;
+        return std::nullopt;
+    }
+    lastPulse_ = pulse.sequence;
+
+    const auto days = daysFromCivil(pvt.date.year, pvt.date.month,
+        pvt.date.day);
+    const auto seconds = days * 86400 + pvt.utc.hh * 3600 +
+        pvt.utc.mm * 60 + pvt.utc.ss;
+    // nano may be negative: 59 s - 20 ns is the top of the next second
+    const auto utc_ns = seconds * nsPerSecond + pvt.utc.nano;
+    const auto utcSecond_ns =
+        (utc_ns + nsPerSecond / 2) / nsPerSecond * nsPerSecond;
+
+    const PpsOffsetSample sample {
+        utcSecond_ns, pulse.realtime_ns, utcSecond_ns - pulse.realtime_ns
+    };
+    stats_.lastOffset_ns = sample.offset_ns;
+
+    if (isOutlier(sample.offset_ns))
+    {
+        stats_.rejected++;
+        if (++consecutiveOutliers_ < window_ / 2)
+            return std::nullopt;
+        offsets_.clear();
+    }
+    consecutiveOutliers_ = 0;
+
+    offsets_.push_back(sample.offset_ns);
+    if (offsets_.size() > window_)
+        offsets_.pop_front();
+    updateMedian();
+    stats_.samples++;
+    return sample;
+}
+
+int64_t PpsOffsetEstimator::daysFromCivil(int64_t year, unsigned month,
+    unsigned day)
+{
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear =
+        (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned dayOfEra =
+        yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+bool PpsOffsetEstimator::isOutlier(const int64_t offset_ns) const
+{
+    if (offsets_.size() < minSamplesToFilter)
+        return false;
+
+    const auto limit = std::max(outlierFloor_ns_,
+        outlierDeviations * stats_.jitter_ns);
+    return std::llabs(offset_ns - stats_.medianOffset_ns) > limit;
+}
+
+void PpsOffsetEstimator::updateMedian()
+{
+    std::vector<int64_t> values(offsets_.begin(), offsets_.end());
+    stats_.medianOffset_ns = median(values);
+    for (auto& value : values)
+        value = std::llabs(value - stats_.medianOffset_ns);
+    stats_.jitter_ns = median(std::move(values));
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,62 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_PPS_OFFSET_ESTIMATOR_HPP_
+#define JIMMY_PAPUTTO_PPS_OFFSET_ESTIMATOR_HPP_
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+#include "ublox/NavigationEpoch.hpp"
+#include "ublox/PpsOffsetStats.hpp"
+
+
+namespace JimmyPaputto
+{
+
+struct PpsOffsetSample
+{
+    int64_t utc_ns;      // [ns] UTC second the pulse marked
+    int64_t receive_ns;  // [ns] CLOCK_REALTIME at the pulse edge
+    int64_t offset_ns;   // utc_ns - receive_ns
+};
+
+// Pairs the timepulse edge carried by a top-of-second epoch with the UTC
+// second NAV-PVT reports for it. Expects a 1 Hz pulse whose rising edge
+// marks the top of the second, the receiver's default.
+//
+// Jitter is filtered by rejecting samples further from the window median
+// than a few median absolute deviations. Samples that keep landing off
+// the median mean the system clock was stepped, so the window restarts.
+class PpsOffsetEstimator
+{
+public:
+    explicit PpsOffsetEstimator(std::size_t window = 16,
+        int64_t outlierFloor_ns = 50'000);
+
+    std::optional<PpsOffsetSample> add(const NavigationEpoch& epoch);
+    const PpsOffsetStats& stats() const { return stats_; }
+
+    // Days since 1970-01-01 of a proleptic Gregorian date
+    static int64_t daysFromCivil(int64_t year, unsigned month, unsigned day);
+
+private:
+    bool isOutlier(int64_t offset_ns) const;
+    void updateMedian();
+
+    const std::size_t window_;
+    const int64_t outlierFloor_ns_;
+    std::deque<int64_t> offsets_;
+    uint64_t lastPulse_;
+    std::size_t consecutiveOutliers_;
+    PpsOffsetStats stats_;
+
+    static constexpr std::size_t minSamplesToFilter = 4;
+    static constexpr int64_t outlierDeviations = 5;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_PPS_OFFSET_ESTIMATOR_HPP_
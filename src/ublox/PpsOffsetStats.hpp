@@ -0,0 +1,30 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_PPS_OFFSET_STATS_HPP_
+#define JIMMY_PAPUTTO_PPS_OFFSET_STATS_HPP_
+
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+// Offsets are UTC minus the system clock at the timepulse edge, positive
+// when the system clock is behind
+struct PpsOffsetStats
+{
+    uint64_t samples = 0;   // pulses paired with a NAV-PVT second and kept
+    uint64_t rejected = 0;  // paired pulses dropped as jitter outliers
+    // Top-of-second epochs without a fresh pulse to pair with
+    uint64_t unpaired = 0;
+    uint64_t published = 0;  // samples written to the NTP SHM segment
+    int64_t lastOffset_ns = 0;
+    int64_t medianOffset_ns = 0;  // over the estimator window
+    int64_t jitter_ns = 0;        // median absolute deviation, same window
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_PPS_OFFSET_STATS_HPP_
@@ -20,14 +20,13 @@ public:
     std::vector<std::vector<uint8_t>> getFullCorrections() override;
     std::vector<std::vector<uint8_t>> getTinyCorrections() override;
     std::vector<uint8_t> getRtcm3Frame(const uint16_t id) override;
+    Rtcm3SnapshotPtr corrections() override;
+    std::vector<Rtcm3BundlePtr> waitForBundles(uint64_t& lastSequence,
+        std::stop_token stoken) override;
+    uint64_t incompleteBundles() override;
+    uint64_t skippedBundles() override;
 
 private:
-    const std::array<uint16_t, 6> tinyCorrectionIds = {
-        1005, 1074, 1084, 1094, 1124, 1230
-    };
-    const std::array<uint16_t, 6> fullCorrectionIds = {
-        1005, 1077, 1087, 1097, 1127, 1230
-    };
     const Rtcm3Store& rtcm3Store_;
 };
 
@@ -83,6 +82,27 @@ std::vector<uint8_t> Base::getRtcm3Frame(const uint16_t id)
     return rtcm3Store_.getFrame(id);
 }
 
+Rtcm3SnapshotPtr Base::corrections()
+{
+    return rtcm3Store_.snapshot();
+}
+
+std::vector<Rtcm3BundlePtr> Base::waitForBundles(uint64_t& lastSequence,
+    std::stop_token stoken)
+{
+    return rtcm3Store_.waitForBundles(lastSequence, stoken);
+}
+
+uint64_t Base::incompleteBundles()
+{
+    return rtcm3Store_.incompleteBundles();
+}
+
+uint64_t Base::skippedBundles()
+{
+    return rtcm3Store_.skippedBundles();
+}
+
 Rover::Rover(Rtcm3Store& rtcm3Store)
 :   rtcm3Store_(rtcm3Store)
 {
@@ -5,9 +5,13 @@
 #ifndef JP_RTK_HPP_
 #define JP_RTK_HPP_
 
+#include <array>
 #include <cstdint>
+#include <stop_token>
 #include <vector>
 
+#include "ublox/Rtcm3Snapshot.hpp"
+
 
 namespace JimmyPaputto
 {
@@ -15,10 +19,35 @@ namespace JimmyPaputto
 class IBase
 {
 public:
+    static constexpr std::array<uint16_t, 6> fullCorrectionIds = {  // M7M
+        1005, 1077, 1087, 1097, 1127, 1230
+    };
+    static constexpr std::array<uint16_t, 6> tinyCorrectionIds = {  // M4M
+        1005, 1074, 1084, 1094, 1124, 1230
+    };
+
     virtual std::vector<std::vector<uint8_t>> getFullCorrections() = 0;  // M7M
     virtual std::vector<std::vector<uint8_t>> getTinyCorrections() = 0;  // M4M
     virtual std::vector<uint8_t> getRtcm3Frame(const uint16_t id) = 0;
 
+    // Every message the receiver sent, shared instead of copied, e.g.
+    // corrections()->select(IBase::fullCorrectionIds) for NtripCaster::feed
+    virtual Rtcm3SnapshotPtr corrections() = 0;
+
+    // Per-epoch MSM bundles completed after `lastSequence`, which then
+    // moves to the newest; blocks until there is one, empty once stopped.
+    // Start from corrections()->lastBundleSequence() to skip old epochs.
+    virtual std::vector<Rtcm3BundlePtr> waitForBundles(
+        uint64_t& lastSequence, std::stop_token stoken) = 0;
+    // Epochs dropped because their last MSM never arrived. GLONASS epochs
+    // are matched to GPS time assuming GPS - UTC = 18 s
+    // (assumedGpsUtcLeapMs); a steady climb after a new leap second means
+    // that assumption no longer holds
+    virtual uint64_t incompleteBundles() = 0;
+    // Bundles waitForBundles() could not return because its caller fell
+    // more than Rtcm3Snapshot::bundleHistory epochs behind
+    virtual uint64_t skippedBundles() = 0;
+
     virtual ~IBase() = default;
 };
 
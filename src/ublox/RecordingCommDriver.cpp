@@ -0,0 +1,86 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "RecordingCommDriver.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "ublox/CommRecording.hpp"
+
+
+namespace JimmyPaputto
+{
+
+RecordingCommDriver::RecordingCommDriver(ICommDriver& commDriver,
+    const std::string& path)
+:   commDriver_(commDriver),
+    file_(path, std::ios::binary | std::ios::trunc)
+{
+    if (!file_.is_open())
+    {
+        fprintf(stderr, "[RecordingCommDriver] Cannot create %s\r\n",
+            path.c_str());
+        return;
+    }
+    CommRecording::writeHeader(file_);
+}
+
+RecordingCommDriver::~RecordingCommDriver()
+{
+    file_.flush();
+}
+
+bool RecordingCommDriver::isRecording() const
+{
+    return file_.is_open() && file_.good();
+}
+
+void RecordingCommDriver::transmitReceive(std::span<const uint8_t> txBuff,
+    std::vector<uint8_t>& rxBuff)
+{
+    commDriver_.transmitReceive(txBuff, rxBuff);
+    record(rxBuff);
+}
+
+void RecordingCommDriver::getRxBuff(uint8_t* rxBuff, const uint32_t size)
+{
+    commDriver_.getRxBuff(rxBuff, size);
+    record(std::span<const uint8_t>(rxBuff, size));
+}
+
+void RecordingCommDriver::getRxBuffs(
+    std::span<const std::span<uint8_t>> segments)
+{
+    commDriver_.getRxBuffs(segments);
+    for (const auto& segment : segments)
+        record(segment);
+}
+
+int RecordingCommDriver::epoll(uint8_t* rxBuff, const uint32_t size,
+    int timeoutMs)
+{
+    const auto incomingBytes = commDriver_.epoll(rxBuff, size, timeoutMs);
+    if (incomingBytes > 0)
+        record(std::span<const uint8_t>(rxBuff, incomingBytes));
+    return incomingBytes;
+}
+
+void RecordingCommDriver::record(std::span<const uint8_t> data)
+{
+    if (!isRecording())
+        return;
+
+    const bool idleFill = std::all_of(data.begin(), data.end(),
+        [](uint8_t byte) { return byte == 0xFF; });
+    if (idleFill)
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!start_.has_value())
+        start_ = now;
+    CommRecording::writeSegment(file_, now - *start_, data);
+}
+
+}  // JimmyPaputto
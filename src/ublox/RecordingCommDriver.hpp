@@ -0,0 +1,46 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_RECORDING_COMM_DRIVER_HPP_
+#define JIMMY_PAPUTTO_RECORDING_COMM_DRIVER_HPP_
+
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "ublox/ICommDriver.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Passes every call through to the real driver and tees what it read into
+// a CommRecording file that ReplayCommDriver can play back. Reads that are
+// nothing but SPI idle fill (0xFF) are not recorded.
+class RecordingCommDriver: public ICommDriver
+{
+public:
+    RecordingCommDriver(ICommDriver& commDriver, const std::string& path);
+    ~RecordingCommDriver() override;
+
+    bool isRecording() const;
+
+    void transmitReceive(std::span<const uint8_t> txBuff,
+        std::vector<uint8_t>& rxBuff) override;
+    void getRxBuff(uint8_t* rxBuff, const uint32_t size) override;
+    void getRxBuffs(std::span<const std::span<uint8_t>> segments) override;
+    int epoll(uint8_t* rxBuff, const uint32_t size, int timeoutMs) override;
+
+private:
+    void record(std::span<const uint8_t> data);
+
+    ICommDriver& commDriver_;
+    std::ofstream file_;
+    std::optional<std::chrono::steady_clock::time_point> start_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_RECORDING_COMM_DRIVER_HPP_
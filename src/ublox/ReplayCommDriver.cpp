@@ -0,0 +1,221 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "ReplayCommDriver.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+
+namespace JimmyPaputto
+{
+
+ReplayCommDriver::ReplayCommDriver(CommRecording recording,
+    const ReplayConfig& config)
+:   recording_(std::move(recording)),
+    config_(config),
+    loopOffset_(0),
+    segment_(0),
+    segmentOffset_(0),
+    bytesDelivered_(0),
+    drains_(0),
+    txReady_(nullptr)
+{
+}
+
+void ReplayCommDriver::transmitReceive(std::span<const uint8_t> txBuff,
+    std::vector<uint8_t>& rxBuff)
+{
+    {
+        std::lock_guard lock(mutex_);
+        transmitted_.insert(transmitted_.end(), txBuff.begin(), txBuff.end());
+    }
+    getRxBuff(rxBuff.data(), rxBuff.size());
+}
+
+void ReplayCommDriver::getRxBuff(uint8_t* rxBuff, const uint32_t size)
+{
+    std::lock_guard lock(mutex_);
+    start();
+    // One instant for the whole transfer, so the read and the drain check
+    // agree on what is due
+    const auto now = Clock::now();
+    const auto bytesRead = read(rxBuff, size, false, now);
+    std::memset(rxBuff + bytesRead, 0xFF, size - bytesRead);
+    skipIdleFill(now);
+
+    // The reader stops on idle fill whether or not more fell due while it
+    // was late, so the line drops there and rises again for what is left
+    const bool idleTail = bytesRead > 0 && rxBuff[bytesRead - 1] == 0xFF;
+    const bool drained = exhausted() || dueTime(segment_) > now || idleTail;
+    if (!drained)
+        return;
+
+    if (txReady_)
+        txReady_->setFlag(true);
+    drains_++;
+    drained_.notify_all();
+}
+
+int ReplayCommDriver::epoll(uint8_t* rxBuff, const uint32_t size,
+    int timeoutMs)
+{
+    const auto limit = config_.maxReadSize > 0
+        ? std::min(size, config_.maxReadSize)
+        : size;
+    const auto now = Clock::now();
+    // An idle UART never returns before the timeout; cap "forever" so a
+    // finished replay still lets the run loop look at its stop token
+    const auto deadline = now + std::chrono::milliseconds(
+        timeoutMs >= 0 ? timeoutMs : 100);
+
+    std::unique_lock lock(mutex_);
+    start();
+    while (true)
+    {
+        const auto wakeUp = exhausted()
+            ? deadline
+            : std::min(dueTime(segment_), deadline);
+        const auto current = Clock::now();
+        if (!exhausted() && dueTime(segment_) <= current)
+        {
+            return static_cast<int>(read(rxBuff, limit,
+                config_.chunking == EReplayChunking::UartRead, current));
+        }
+        if (current >= deadline)
+            return 0;
+
+        lock.unlock();
+        std::this_thread::sleep_until(wakeUp);
+        lock.lock();
+    }
+}
+
+void ReplayCommDriver::driveTxReady(Notifier& txReady, std::stop_token stoken)
+{
+    std::unique_lock lock(mutex_);
+    txReady_ = &txReady;
+    start();
+
+    while (!stoken.stop_requested() && !exhausted())
+    {
+        const auto due = dueTime(segment_);
+        drained_.wait_until(lock, stoken, due, [] { return false; });
+        if (stoken.stop_requested())
+            break;
+
+        // Rising edge, the run loop reads until getRxBuff() drops the line.
+        // Whatever fell due meanwhile gets the next edge.
+        const auto drains = drains_;
+        txReady.notify();
+        drained_.wait(lock, stoken, [this, drains] {
+            return drains_ != drains;
+        });
+    }
+    txReady_ = nullptr;
+}
+
+bool ReplayCommDriver::finished() const
+{
+    std::lock_guard lock(mutex_);
+    return exhausted();
+}
+
+uint64_t ReplayCommDriver::bytesDelivered() const
+{
+    std::lock_guard lock(mutex_);
+    return bytesDelivered_;
+}
+
+std::vector<uint8_t> ReplayCommDriver::transmitted() const
+{
+    std::lock_guard lock(mutex_);
+    return transmitted_;
+}
+
+void ReplayCommDriver::start()
+{
+    if (!start_.has_value())
+        start_ = Clock::now();
+}
+
+ReplayCommDriver::Clock::time_point ReplayCommDriver::dueTime(
+    std::size_t segment) const
+{
+    if (config_.speed <= 0)
+        return *start_;
+
+    const auto at = loopOffset_ + recording_.segments[segment].at;
+    return *start_ + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::nano>(at.count() / config_.speed));
+}
+
+uint32_t ReplayCommDriver::read(uint8_t* rxBuff, uint32_t size,
+    bool oneSegment, const Clock::time_point now)
+{
+    uint32_t copied = 0;
+    while (copied < size && !exhausted() && dueTime(segment_) <= now)
+    {
+        const auto& segment = recording_.segments[segment_];
+        const auto chunk = std::min(size - copied,
+            segment.size - segmentOffset_);
+        std::memcpy(rxBuff + copied,
+            recording_.bytes.data() + segment.offset + segmentOffset_, chunk);
+        copied += chunk;
+        segmentOffset_ += chunk;
+        if (segmentOffset_ < segment.size)
+            break;
+
+        segment_++;
+        segmentOffset_ = 0;
+        if (segment_ == recording_.segments.size() && config_.loop &&
+            !recording_.bytes.empty())
+        {
+            segment_ = 0;
+            loopOffset_ += recording_.duration();
+        }
+        if (oneSegment)
+            break;
+    }
+
+    bytesDelivered_ += copied;
+    return copied;
+}
+
+void ReplayCommDriver::skipIdleFill(const Clock::time_point now)
+{
+    // Recorded SPI reads end in the idle fill the receiver clocked out once
+    // it ran dry. A reader that stopped on that fill has read everything,
+    // so when nothing but 0xFF is due the TX-ready line must drop.
+    auto segment = segment_;
+    auto offset = segmentOffset_;
+    while (segment < recording_.segments.size() && dueTime(segment) <= now)
+    {
+        const auto& due = recording_.segments[segment];
+        const auto begin = recording_.bytes.begin() + due.offset;
+        const bool idleOnly = std::all_of(begin + offset, begin + due.size,
+            [](const uint8_t byte) { return byte == 0xFF; });
+        if (!idleOnly)
+            return;
+        segment++;
+        offset = 0;
+    }
+
+    if (segment == recording_.segments.size() && config_.loop &&
+        !recording_.bytes.empty())
+    {
+        segment = 0;
+        loopOffset_ += recording_.duration();
+    }
+    segment_ = segment;
+    segmentOffset_ = offset;
+}
+
+bool ReplayCommDriver::exhausted() const
+{
+    return segment_ >= recording_.segments.size();
+}
+
+}  // JimmyPaputto
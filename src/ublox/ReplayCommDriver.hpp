@@ -0,0 +1,92 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_REPLAY_COMM_DRIVER_HPP_
+#define JIMMY_PAPUTTO_REPLAY_COMM_DRIVER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+
+#include "common/Notifier.hpp"
+#include "ublox/CommRecording.hpp"
+#include "ublox/ICommDriver.hpp"
+
+
+namespace JimmyPaputto
+{
+
+enum class EReplayChunking : uint8_t
+{
+    SpiBatch = 0x00,  // fixed-size reads padded with 0xFF idle fill
+    UartRead = 0x01   // epoll() returns one recorded read at a time
+};
+
+struct ReplayConfig
+{
+    // 1 plays at recorded pace, N at N times that, 0 as fast as read
+    double speed = 1.0;
+    EReplayChunking chunking = EReplayChunking::SpiBatch;
+    // Upper bound of one epoll() read, 0 means no bound
+    uint32_t maxReadSize = 0;
+    bool loop = false;
+};
+
+// ICommDriver playing back a CommRecording instead of talking to the HAT,
+// so Run strategies, UbxParser and Gnss can be driven, benchmarked and
+// regression-tested on any Linux box.
+//
+// A recorded read becomes available once its timestamp, scaled by
+// `speed`, has elapsed since the first read from the driver. M9N-style
+// runs also need the TX-ready line: driveTxReady() raises it whenever
+// bytes are due and getRxBuff() drops it once they have all been read.
+class ReplayCommDriver: public ICommDriver
+{
+public:
+    ReplayCommDriver(CommRecording recording, const ReplayConfig& config);
+
+    void transmitReceive(std::span<const uint8_t> txBuff,
+        std::vector<uint8_t>& rxBuff) override;
+    void getRxBuff(uint8_t* rxBuff, const uint32_t size) override;
+    int epoll(uint8_t* rxBuff, const uint32_t size, int timeoutMs) override;
+
+    // TX-ready emulation, blocks until stopped or the replay is over
+    void driveTxReady(Notifier& txReady, std::stop_token stoken);
+
+    // Every recorded byte has been read (never true when looping)
+    bool finished() const;
+    uint64_t bytesDelivered() const;
+    std::vector<uint8_t> transmitted() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void start();
+    Clock::time_point dueTime(std::size_t segment) const;
+    uint32_t read(uint8_t* rxBuff, uint32_t size, bool oneSegment,
+        Clock::time_point now);
+    void skipIdleFill(Clock::time_point now);
+    bool exhausted() const;
+
+    const CommRecording recording_;
+    const ReplayConfig config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any drained_;
+    std::optional<Clock::time_point> start_;
+    std::chrono::nanoseconds loopOffset_;
+    std::size_t segment_;
+    uint32_t segmentOffset_;
+    uint64_t bytesDelivered_;
+    uint64_t drains_;
+    std::vector<uint8_t> transmitted_;
+    Notifier* txReady_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_REPLAY_COMM_DRIVER_HPP_
@@ -32,7 +32,6 @@ private:
         std::span<uint8_t> buffer,
         std::vector<uint8_t>& unfinishedFrame
     );
-    uint16_t getFrameId(std::span<const uint8_t> frame);
     bool checkFrame(std::span<const uint8_t> frame);
 
     constexpr static uint16_t maxNumberOfFrames_ = 30;
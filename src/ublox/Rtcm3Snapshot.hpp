@@ -0,0 +1,101 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JP_RTCM3_SNAPSHOT_HPP_
+#define JP_RTCM3_SNAPSHOT_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+
+namespace JimmyPaputto
+{
+
+// One RTCM3 frame as the base receiver sent it. Immutable once published,
+// so every consumer shares the same bytes.
+struct Rtcm3Message
+{
+    uint16_t id;
+    // Store version that published the frame: frames read from the same
+    // receiver burst share it
+    uint64_t version;
+    std::chrono::steady_clock::time_point receivedAt;
+    std::vector<uint8_t> frame;
+};
+
+using Rtcm3MessagePtr = std::shared_ptr<const Rtcm3Message>;
+
+// GPS - UTC in effect since 2017. MSM headers do not carry it, yet GLONASS
+// epochs count UTC(SU) and are moved onto GPS time with this value to be
+// bundled with the other constellations. Once a new leap second is
+// announced GLONASS MSMs stop matching and every epoch counts as
+// incomplete until this is updated.
+constexpr uint32_t assumedGpsUtcLeapMs = 18000;
+
+// Every MSM frame of one GNSS epoch, complete once an MSM arrived with the
+// multiple-message bit clear, plus the non-MSM frames (1005, 1230, ...)
+// received since the previous bundle, which go first. A bundle is sent
+// once; a sink that remembers the last sequence it sent never repeats a
+// frame or mixes epochs.
+struct Rtcm3Bundle
+{
+    // 1, 2, ... in order of completion
+    uint64_t sequence;
+    // Epoch time from the MSM headers as GPS milliseconds of day, GLONASS
+    // converted with assumedGpsUtcLeapMs
+    uint32_t epochMs;
+    std::vector<Rtcm3MessagePtr> messages;
+};
+
+using Rtcm3BundlePtr = std::shared_ptr<const Rtcm3Bundle>;
+
+// The latest frame of every message type and the last completed bundles
+// at one store version. Holding the pointer keeps those frames alive;
+// later updates publish a new snapshot instead of touching this one.
+class Rtcm3Snapshot
+{
+public:
+    // Completed bundles kept for consumers that fall behind
+    static constexpr std::size_t bundleHistory = 8;
+
+    Rtcm3Snapshot() = default;
+    Rtcm3Snapshot(uint64_t version, std::vector<Rtcm3MessagePtr> messages,
+        std::vector<Rtcm3BundlePtr> bundles = {});
+
+    uint64_t version() const;
+
+    // Ascending message id
+    const std::vector<Rtcm3MessagePtr>& messages() const;
+
+    Rtcm3MessagePtr find(const uint16_t id) const;
+
+    // In the order of `ids`; ids without a frame are skipped
+    std::vector<Rtcm3MessagePtr> select(std::span<const uint16_t> ids) const;
+
+    // Frames published after `version`, i.e. everything a consumer that
+    // last saw `version` has not sent yet
+    std::vector<Rtcm3MessagePtr> newerThan(const uint64_t version) const;
+
+    // Sequence of the latest completed bundle, 0 before the first
+    uint64_t lastBundleSequence() const;
+
+    // Completed bundles after `sequence`, oldest first; at most the last
+    // `bundleHistory` of them
+    std::vector<Rtcm3BundlePtr> bundlesAfter(const uint64_t sequence) const;
+
+private:
+    uint64_t version_ = 0;
+    std::vector<Rtcm3MessagePtr> messages_;
+    std::vector<Rtcm3BundlePtr> bundles_;
+};
+
+using Rtcm3SnapshotPtr = std::shared_ptr<const Rtcm3Snapshot>;
+
+}  // JimmyPaputto
+
+#endif  // JP_RTCM3_SNAPSHOT_HPP_
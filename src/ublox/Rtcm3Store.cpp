@@ -4,13 +4,102 @@
 
 #include "Rtcm3Store.hpp"
 
+#include <algorithm>
 
-#define SEMAPHORE_TIMEOUT 100
 
 namespace JimmyPaputto
 {
 
+namespace
+{
+
+template<typename Messages>
+auto lowerBoundById(Messages& messages, const uint16_t id)
+{
+    return std::lower_bound(messages.begin(), messages.end(), id,
+        [](const Rtcm3MessagePtr& message, const uint16_t key) {
+            return message->id < key;
+        }
+    );
+}
+
+}  // namespace
+
+Rtcm3Snapshot::Rtcm3Snapshot(uint64_t version,
+    std::vector<Rtcm3MessagePtr> messages,
+    std::vector<Rtcm3BundlePtr> bundles)
+:   version_(version),
+    messages_(std::move(messages)),
+    bundles_(std::move(bundles))
+{
+}
+
+uint64_t Rtcm3Snapshot::version() const
+{
+    return version_;
+}
+
+const std::vector<Rtcm3MessagePtr>& Rtcm3Snapshot::messages() const
+{
+    return messages_;
+}
+
+Rtcm3MessagePtr Rtcm3Snapshot::find(const uint16_t id) const
+{
+    const auto messageIt = lowerBoundById(messages_, id);
+    if (messageIt == messages_.end() || (*messageIt)->id != id)
+        return nullptr;
+    return *messageIt;
+}
+
+std::vector<Rtcm3MessagePtr> Rtcm3Snapshot::select(
+    std::span<const uint16_t> ids) const
+{
+    std::vector<Rtcm3MessagePtr> result;
+    result.reserve(ids.size());
+    for (const auto id : ids)
+    {
+        if (auto message = find(id))
+            result.push_back(std::move(message));
+    }
+    return result;
+}
+
+std::vector<Rtcm3MessagePtr> Rtcm3Snapshot::newerThan(
+    const uint64_t version) const
+{
+    std::vector<Rtcm3MessagePtr> result;
+    for (const auto& message : messages_)
+    {
+        if (message->version > version)
+            result.push_back(message);
+    }
+    return result;
+}
+
+uint64_t Rtcm3Snapshot::lastBundleSequence() const
+{
+    return bundles_.empty() ? 0 : bundles_.back()->sequence;
+}
+
+std::vector<Rtcm3BundlePtr> Rtcm3Snapshot::bundlesAfter(
+    const uint64_t sequence) const
+{
+    std::vector<Rtcm3BundlePtr> result;
+    for (const auto& bundle : bundles_)
+    {
+        if (bundle->sequence > sequence)
+            result.push_back(bundle);
+    }
+    return result;
+}
+
 Rtcm3Store::Rtcm3Store()
+:   snapshot_(std::make_shared<const Rtcm3Snapshot>()),
+    openEpochMs_(0),
+    bundleSequence_(0),
+    incompleteBundles_(0),
+    skippedBundles_(0)
 {
     incomingFrames_.reserve(10);
 }
@@ -18,105 +107,273 @@ Rtcm3Store::Rtcm3Store()
 void Rtcm3Store::updateFrame(const uint16_t id,
     const std::vector<uint8_t>& newFrame)
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
+    std::vector<Rtcm3Message> updates;
+    updates.push_back({ id, 0, std::chrono::steady_clock::now(), newFrame });
+    publish(std::move(updates));
+}
+
+void Rtcm3Store::updateFrames(std::span<const std::vector<uint8_t>> newFrames)
+{
+    const auto receivedAt = std::chrono::steady_clock::now();
+    std::vector<Rtcm3Message> updates;
+    updates.reserve(newFrames.size());
+    for (const auto& frame : newFrames)
     {
-        auto frameIt = frames_.find(id);
-        if (frameIt == frames_.end())
-        {
-            frames_[id] = newFrame;
-            xSemaphore_.releaseResource();
-            return;
-        }
+        if (!frame.empty())
+            updates.push_back({ messageId(frame), 0, receivedAt, frame });
+    }
+    if (!updates.empty())
+        publish(std::move(updates));
+}
 
-        auto& frame = frameIt->second;
+Rtcm3SnapshotPtr Rtcm3Store::snapshot() const
+{
+    return snapshot_.load();
+}
 
-        if (frame.size() != newFrame.size())
-        {
-            frame = newFrame;
-            xSemaphore_.releaseResource();
-            return;
-        }
+uint64_t Rtcm3Store::version() const
+{
+    return snapshot_.load()->version();
+}
+
+std::vector<Rtcm3BundlePtr> Rtcm3Store::waitForBundles(
+    uint64_t& lastSequence, std::stop_token stoken) const
+{
+    {
+        std::unique_lock lock(publishMutex_);
+        const bool completed = bundleCv_.wait(lock, stoken, [&] {
+            return snapshot_.load()->lastBundleSequence() > lastSequence;
+        });
+        if (!completed)
+            return {};
+    }
+
+    auto bundles = snapshot_.load()->bundlesAfter(lastSequence);
+    if (bundles.empty())
+        return bundles;
 
-        std::copy(newFrame.begin(), newFrame.end(), frame.begin());
-        xSemaphore_.releaseResource();
+    // The snapshot already let go of the bundles right after the cursor
+    const auto first = bundles.front()->sequence;
+    if (lastSequence != 0 && first > lastSequence + 1)
+    {
+        skippedBundles_.fetch_add(first - lastSequence - 1,
+            std::memory_order_relaxed);
     }
+    lastSequence = bundles.back()->sequence;
+    return bundles;
+}
+
+uint64_t Rtcm3Store::incompleteBundles() const
+{
+    return incompleteBundles_.load(std::memory_order_relaxed);
+}
+
+uint64_t Rtcm3Store::skippedBundles() const
+{
+    return skippedBundles_.load(std::memory_order_relaxed);
+}
+
+std::vector<uint8_t> Rtcm3Store::getFrame(const uint16_t id) const
+{
+    const auto message = snapshot_.load()->find(id);
+    return message ? message->frame : std::vector<uint8_t>{};
+}
+
+std::vector<std::vector<uint8_t>> Rtcm3Store::getFrames(
+    std::span<const uint16_t> ids) const
+{
+    std::vector<std::vector<uint8_t>> result;
+    for (const auto& message : snapshot_.load()->select(ids))
+        result.push_back(message->frame);
+    return result;
 }
 
 void Rtcm3Store::updateFramesAndNotify(
     const std::vector<std::vector<uint8_t>>& newFrames
 )
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
     {
+        std::lock_guard lock(incomingMutex_);
         incomingFrames_ = newFrames;
-        xSemaphore_.releaseResource();
-        roverNotifier_.notify();
     }
+    roverNotifier_.notify();
 }
 
-std::vector<uint8_t> Rtcm3Store::getFrame(const uint16_t id) const
+std::vector<std::vector<uint8_t>> Rtcm3Store::waitForFrames()
 {
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
-    {
-        auto frameIt = frames_.find(id);
-        if (frameIt == frames_.end())
-        {
-            xSemaphore_.releaseResource();
-            return {};
-        }
-
-        const auto result = frameIt->second;
-        xSemaphore_.releaseResource();
-        return result;
-    }
-    return {};
+    roverNotifier_.wait();
+    std::lock_guard lock(incomingMutex_);
+    auto result = std::move(incomingFrames_);
+    incomingFrames_.clear();
+    return result;
 }
 
-std::vector<std::vector<uint8_t>> Rtcm3Store::getFrames(
-    std::span<const uint16_t> ids) const
+std::vector<std::vector<uint8_t>> Rtcm3Store::waitForFrames(
+    std::stop_token stoken)
 {
     std::vector<std::vector<uint8_t>> result;
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
+    takeFrames(result, stoken);
+    return result;
+}
+
+bool Rtcm3Store::takeFrames(std::vector<std::vector<uint8_t>>& batch,
+    std::stop_token stoken)
+{
+    if (!roverNotifier_.wait(stoken))
+        return false;
+    batch.clear();
+    std::lock_guard lock(incomingMutex_);
+    batch.swap(incomingFrames_);
+    return !batch.empty();
+}
+
+uint16_t Rtcm3Store::messageId(std::span<const uint8_t> frame)
+{
+    if (frame.size() < 6 || frame[0] != 0xD3)
+        return 0;
+
+    return static_cast<uint16_t>((uint16_t(frame[3]) << 4) | (frame[4] >> 4));
+}
+
+std::optional<Rtcm3Store::MsmHeader> Rtcm3Store::msmHeader(
+    std::span<const uint8_t> frame)
+{
+    // Message number 12, reference station 12, epoch time 30 and the
+    // multiple-message bit: 55 bits of payload
+    constexpr size_t headerBytes = 3;
+    constexpr size_t msmHeaderBytes = 7;
+    if (frame.size() < headerBytes || frame[0] != 0xD3)
+        return std::nullopt;
+    const size_t payloadLength = (size_t(frame[1] & 0x03) << 8) | frame[2];
+    if (payloadLength < msmHeaderBytes ||
+        frame.size() < headerBytes + payloadLength)
+        return std::nullopt;
+
+    const auto payload = frame.subspan(headerBytes);
+    const auto bits = [payload](const size_t position, const size_t length) {
+        uint32_t value = 0;
+        for (size_t bit = position; bit < position + length; bit++)
+            value = (value << 1) | ((payload[bit / 8] >> (7 - bit % 8)) & 1);
+        return value;
+    };
+
+    const uint16_t id = static_cast<uint16_t>(bits(0, 12));
+    const uint16_t system = id / 10;
+    const uint16_t type = id % 10;
+    if (system < 107 || system > 113 || type < 1 || type > 7)
+        return std::nullopt;
+
+    return MsmHeader {
+        .stationId = static_cast<uint16_t>(bits(12, 12)),
+        .epochTime = bits(24, 30),
+        .multipleMessage = bits(54, 1) != 0
+    };
+}
+
+uint32_t Rtcm3Store::gpsTimeOfDayMs(const uint16_t id,
+    const uint32_t epochTime)
+{
+    constexpr uint32_t dayMs = 86400000;
+
+    switch (id / 10)
     {
-        for (const auto& id : ids)
+        case 108:
         {
-            auto frameIt = frames_.find(id);
-            if (frameIt != frames_.end())
-            {
-                result.push_back(frameIt->second);
-            }
+            // GLONASS: 3 bit day of week, 27 bit ms of day in UTC(SU) + 3 h
+            const uint32_t glonassMs = epochTime & 0x7FFFFFF;
+            return (glonassMs + dayMs - 3 * 3600000 + assumedGpsUtcLeapMs)
+                % dayMs;
         }
-        xSemaphore_.releaseResource();
+        case 112:
+            // BeiDou: BDT runs 14 s behind GPS time
+            return (epochTime + 14000) % dayMs;
+        default:
+            // GPS, Galileo, SBAS, QZSS, NavIC: GPS ms of week
+            return epochTime % dayMs;
     }
-    return result;
 }
 
-std::vector<std::vector<uint8_t>> Rtcm3Store::waitForFrames()
+void Rtcm3Store::publish(std::vector<Rtcm3Message> updates)
 {
-    roverNotifier_.wait();
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
+    // Writers copy the pointer vector of the current snapshot, a few dozen
+    // entries, never the frames; readers keep whatever they loaded
+    std::unique_lock lock(publishMutex_);
+    const auto current = snapshot_.load();
+    const uint64_t version = current->version() + 1;
+    const uint64_t lastBundle = bundleSequence_;
+
+    std::vector<Rtcm3MessagePtr> messages = current->messages();
+    std::vector<Rtcm3BundlePtr> bundles = current->bundlesAfter(0);
+    for (auto& update : updates)
     {
-        const auto result = incomingFrames_;
-        incomingFrames_.clear();
-        xSemaphore_.releaseResource();
-        return result;
+        update.version = version;
+        const uint16_t id = update.id;
+        auto published =
+            std::make_shared<const Rtcm3Message>(std::move(update));
+        const auto messageIt = lowerBoundById(messages, id);
+        assembleBundle(published, bundles);
+        if (messageIt != messages.end() && (*messageIt)->id == id)
+            *messageIt = std::move(published);
+        else
+            messages.insert(messageIt, std::move(published));
     }
-    return {};
+
+    snapshot_.store(std::make_shared<const Rtcm3Snapshot>(
+        version, std::move(messages), std::move(bundles)));
+    const bool bundleCompleted = bundleSequence_ != lastBundle;
+    lock.unlock();
+
+    if (bundleCompleted)
+        bundleCv_.notify_all();
 }
 
-std::vector<std::vector<uint8_t>> Rtcm3Store::waitForFrames(
-    std::stop_token stoken)
+void Rtcm3Store::assembleBundle(const Rtcm3MessagePtr& message,
+    std::vector<Rtcm3BundlePtr>& bundles)
 {
-    if (!roverNotifier_.wait(stoken))
-        return {};
-    if (xSemaphore_.takeResource(SEMAPHORE_TIMEOUT))
+    const auto header = msmHeader(message->frame);
+    if (!header)
+    {
+        // 1005, 1230, ...: the latest of each rides with the next bundle
+        const auto extraIt = std::find_if(
+            pendingExtras_.begin(), pendingExtras_.end(),
+            [&message](const Rtcm3MessagePtr& extra) {
+                return extra->id == message->id;
+            }
+        );
+        if (extraIt != pendingExtras_.end())
+            *extraIt = message;
+        else
+            pendingExtras_.push_back(message);
+        return;
+    }
+
+    const uint32_t epochMs = gpsTimeOfDayMs(message->id, header->epochTime);
+    if (!openBundle_.empty() && epochMs != openEpochMs_)
     {
-        const auto result = incomingFrames_;
-        incomingFrames_.clear();
-        xSemaphore_.releaseResource();
-        return result;
+        // The last MSM of that epoch never arrived; rovers are better off
+        // without half an epoch
+        incompleteBundles_.fetch_add(1, std::memory_order_relaxed);
+        openBundle_.clear();
     }
-    return {};
+    openEpochMs_ = epochMs;
+    openBundle_.push_back(message);
+    if (header->multipleMessage)
+        return;
+
+    auto bundle = std::make_shared<Rtcm3Bundle>();
+    bundle->sequence = ++bundleSequence_;
+    bundle->epochMs = epochMs;
+    bundle->messages.reserve(pendingExtras_.size() + openBundle_.size());
+    bundle->messages.insert(bundle->messages.end(),
+        pendingExtras_.begin(), pendingExtras_.end());
+    bundle->messages.insert(bundle->messages.end(),
+        openBundle_.begin(), openBundle_.end());
+    pendingExtras_.clear();
+    openBundle_.clear();
+
+    bundles.push_back(std::move(bundle));
+    if (bundles.size() > Rtcm3Snapshot::bundleHistory)
+        bundles.erase(bundles.begin());
 }
 
 }  // JimmyPaputto
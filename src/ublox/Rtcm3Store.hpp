@@ -5,14 +5,18 @@
 #ifndef JP_RTCM3_STORE_HPP_
 #define JP_RTCM3_STORE_HPP_
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <stop_token>
-#include <unordered_map>
 #include <vector>
 
-#include "common/JPGuard.hpp"
 #include "common/Notifier.hpp"
+#include "ublox/Rtcm3Snapshot.hpp"
 
 
 namespace JimmyPaputto
@@ -23,22 +27,75 @@ class Rtcm3Store final
 public:
     explicit Rtcm3Store();
 
+    // Base: each call publishes one new snapshot version
     void updateFrame(const uint16_t id, const std::vector<uint8_t>& newFrame);
-    void updateFramesAndNotify(
-        const std::vector<std::vector<uint8_t>>& newFrames
-    );
+    void updateFrames(std::span<const std::vector<uint8_t>> newFrames);
+
+    // Lock-free; the snapshot never changes after it is returned
+    Rtcm3SnapshotPtr snapshot() const;
+    uint64_t version() const;
+
+    // Blocks until a bundle after `lastSequence` completes, then returns
+    // every one still held, oldest first, and advances `lastSequence`.
+    // Empty when stopped.
+    std::vector<Rtcm3BundlePtr> waitForBundles(uint64_t& lastSequence,
+        std::stop_token stoken) const;
+    // Bundles dropped because the next epoch started before their last
+    // MSM (multiple-message bit clear) arrived; see assumedGpsUtcLeapMs
+    uint64_t incompleteBundles() const;
+    // Bundles a waitForBundles() caller never got because it fell more
+    // than Rtcm3Snapshot::bundleHistory behind; a cursor of 0 starts fresh
+    // and skips nothing
+    uint64_t skippedBundles() const;
 
     std::vector<uint8_t> getFrame(const uint16_t id) const;
     std::vector<std::vector<uint8_t>> getFrames(
         std::span<const uint16_t> ids) const;
 
+    // Rover
+    void updateFramesAndNotify(
+        const std::vector<std::vector<uint8_t>>& newFrames
+    );
+
     std::vector<std::vector<uint8_t>> waitForFrames();
     std::vector<std::vector<uint8_t>> waitForFrames(std::stop_token stoken);
+    // Swaps the pending corrections into `batch` instead of copying them;
+    // false when stopped or when nothing was pending
+    bool takeFrames(std::vector<std::vector<uint8_t>>& batch,
+        std::stop_token stoken);
+
+    static uint16_t messageId(std::span<const uint8_t> frame);
+
+    struct MsmHeader
+    {
+        uint16_t stationId;
+        // Epoch time field as sent: ms of week, GLONASS day + ms of day
+        uint32_t epochTime;
+        bool multipleMessage;
+    };
+    static std::optional<MsmHeader> msmHeader(std::span<const uint8_t> frame);
+    // MSM epoch time of any constellation as GPS milliseconds of day
+    static uint32_t gpsTimeOfDayMs(const uint16_t id, const uint32_t epochTime);
 
 private:
-    std::unordered_map<uint16_t, std::vector<uint8_t>> frames_;
+    void publish(std::vector<Rtcm3Message> updates);
+    void assembleBundle(const Rtcm3MessagePtr& message,
+        std::vector<Rtcm3BundlePtr>& bundles);
+
+    mutable std::mutex publishMutex_;
+    mutable std::condition_variable_any bundleCv_;
+    std::atomic<Rtcm3SnapshotPtr> snapshot_;
+
+    // Bundle assembly, under publishMutex_
+    std::vector<Rtcm3MessagePtr> openBundle_;
+    uint32_t openEpochMs_;
+    std::vector<Rtcm3MessagePtr> pendingExtras_;
+    uint64_t bundleSequence_;
+    std::atomic<uint64_t> incompleteBundles_;
+    mutable std::atomic<uint64_t> skippedBundles_;
+
+    std::mutex incomingMutex_;
     std::vector<std::vector<uint8_t>> incomingFrames_;
-    mutable JPGuard xSemaphore_;
     Notifier roverNotifier_;
 };
 
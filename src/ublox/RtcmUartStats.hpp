@@ -0,0 +1,33 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_RTCM_UART_STATS_HPP_
+#define JIMMY_PAPUTTO_RTCM_UART_STATS_HPP_
+
+#include <cstdint>
+
+#include "common/LatencyHistogram.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Corrections forwarded by an RTK rover to the receiver's UART
+struct RtcmUartStats
+{
+    uint64_t batches = 0;
+    uint64_t framesWritten = 0;
+    // Did not fit into what the line can send before the next corrections,
+    // or were cut or left out by a write that gave up
+    uint64_t framesDropped = 0;
+    uint64_t bytesQueued = 0;  // handed to the kernel TTY buffer
+    uint64_t writeCalls = 0;   // writev() syscalls
+    uint64_t stalls = 0;       // waits for a full TTY buffer to take more
+    // One batch, from its first writev() until the kernel took all of it
+    LatencySnapshot writeLatency {};
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_RTCM_UART_STATS_HPP_
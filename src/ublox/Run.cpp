@@ -4,7 +4,11 @@
 
 #include "Run.hpp"
 
+#include <algorithm>
+#include <array>
+
 #include "UartDriver.hpp"
+#include "common/Utils.hpp"
 
 
 namespace JimmyPaputto
@@ -22,76 +26,180 @@ M9NRun::M9NRun(ICommDriver& commDriver, UbxParser& ubxParser,
     Notifier& txReadyNotifier, Notifier& navigationNotifier)
 :   RunBase(commDriver, ubxParser),
     txReadyNotifier_(txReadyNotifier),
-    navigationNotifier_(navigationNotifier)
+    navigationNotifier_(navigationNotifier),
+    expectedEpochSize_(1024)
 {
 }
 
 void M9NRun::execute(std::stop_token stoken)
 {
-    constexpr uint32_t rxBatchSize = 1024;
-    uint32_t counter = runRxBuffOffset_;
     if (!txReadyNotifier_.wait(stoken))
         return;
+    // Reading stops on idle fill now, a falling edge that comes in after
+    // that belongs to the previous epoch
+    txReadyNotifier_.setFlag(false);
 
-    while (!txReadyNotifier_.getFlag())
+    SpiEpochDrain drain;
+    uint32_t counter = 0;
+    uint32_t idleRun = 0;
+    uint32_t transferSize = firstTransferSize();
+    while (idleRun < idleFillThreshold)
     {
-        if (counter + rxBatchSize > runRxBuffSize)
+        if (counter + transferSize > runRxBuffSize)
+        {
+            // Hand over what is here instead of overwriting it, the parser
+            // carries a frame cut at the end
+            ubxParser_.parse(
+                std::span<const uint8_t>(runRxBuff_.data(), counter));
             counter = 0;
-        commDriver_.getRxBuff(runRxBuff_.data() + counter, rxBatchSize);
-        counter += rxBatchSize;
+            drain.overruns++;
+        }
+
+        const std::span<uint8_t> rx(runRxBuff_.data() + counter, transferSize);
+        transfer(rx);
+        counter += transferSize;
+        drain.ioctls++;
+        drain.bytesClocked += transferSize;
+
+        const auto lastData = std::find_if(rx.rbegin(), rx.rend(),
+            [](const uint8_t byte) { return byte != 0xFF; });
+        const auto idleTail =
+            static_cast<uint32_t>(std::distance(rx.rbegin(), lastData));
+        idleRun = (idleTail == rx.size()) ? idleRun + idleTail : idleTail;
+
+        if (txReadyNotifier_.getFlag())
+            break;
+        transferSize = drainSegmentSize;
     }
+    drain.usefulBytes = drain.bytesClocked - std::min(idleRun,
+        drain.bytesClocked);
 
-    const auto unfinishedFrame = ubxParser_.parse(
-        std::vector<uint8_t>(runRxBuff_.data(), runRxBuff_.data() + counter)
-    );
-    txReadyNotifier_.setFlag(false);
-    std::copy(
-        unfinishedFrame.begin(), unfinishedFrame.end(), runRxBuff_.begin()
-    );
-    runRxBuffOffset_ = unfinishedFrame.size();
+    const auto parsed = counter - std::min(idleRun, counter);
+    ubxParser_.parse(std::span<const uint8_t>(runRxBuff_.data(), parsed));
+    account(drain);
 
     navigationNotifier_.notify();
 }
 
+SpiDrainStats M9NRun::drainStats() const
+{
+    return drainSnapshot_.read();
+}
+
+uint32_t M9NRun::firstTransferSize() const
+{
+    // The expected epoch plus room to see the idle fill behind it, so a
+    // typical epoch is drained by a single ioctl
+    const uint32_t wanted = expectedEpochSize_ + idleFillThreshold;
+    const uint32_t segments = std::clamp(
+        (wanted + drainSegmentSize - 1) / drainSegmentSize,
+        1u, maxDrainSegments);
+    return segments * drainSegmentSize;
+}
+
+void M9NRun::transfer(std::span<uint8_t> rxBuff)
+{
+    std::array<std::span<uint8_t>, maxDrainSegments> segments;
+    std::size_t count = 0;
+    for (std::size_t offset = 0; offset < rxBuff.size();
+        offset += drainSegmentSize)
+    {
+        segments[count++] = rxBuff.subspan(offset,
+            std::min<std::size_t>(drainSegmentSize, rxBuff.size() - offset));
+    }
+    commDriver_.getRxBuffs(std::span(segments.data(), count));
+}
+
+void M9NRun::account(const SpiEpochDrain& drain)
+{
+    if (drain.usefulBytes >= expectedEpochSize_)
+        expectedEpochSize_ = drain.usefulBytes;
+    else
+        expectedEpochSize_ -= (expectedEpochSize_ - drain.usefulBytes) / 8;
+
+    drainStats_.epochs++;
+    drainStats_.bytesClocked += drain.bytesClocked;
+    drainStats_.usefulBytes += drain.usefulBytes;
+    drainStats_.ioctls += drain.ioctls;
+    drainStats_.overruns += drain.overruns;
+    drainStats_.lastEpoch = drain;
+    drainSnapshot_.publish(drainStats_);
+}
+
 F10TRun::F10TRun(ICommDriver& commDriver, UbxParser& ubxParser)
-:   RunBase(commDriver, ubxParser)
+:   RunBase(commDriver, ubxParser),
+    baudrate_(UartDriver::expectedBaudrate),
+    burstBytes_(0)
 {
+    linkStats_.baudrate = baudrate_;
 }
 
 void F10TRun::execute(std::stop_token)
-{    
-    auto& uartDriver = static_cast<UartDriver&>(commDriver_);
-    constexpr uint32_t parseThreshold = 100;
-    const int epollTimeoutMs = (runRxBuffOffset_ > 0) ? 10 : 500;
+{
+    // Only bounds how long a stop request waits on a silent receiver
+    constexpr int epollTimeoutMs = 500;
 
-    const auto incomingBytes = uartDriver.epoll(
-        runRxBuff_.data() + runRxBuffOffset_,
-        runRxBuffSize - runRxBuffOffset_,
+    const auto incomingBytes = commDriver_.epoll(
+        runRxBuff_.data(),
+        runRxBuffSize,
         epollTimeoutMs
     );
+    if (incomingBytes <= 0)
+        return;
 
-    if (incomingBytes > 0)
-        runRxBuffOffset_ += incomingBytes;
+    const auto rxTimestamp = monotonicRawNow();
+    account(incomingBytes);
 
-    const bool shouldParse =
-        (runRxBuffOffset_ >= parseThreshold) ||
-        (incomingBytes <= 0 && runRxBuffOffset_ > 0);
+    // Every read goes to the parser straight away: frames it completes are
+    // dispatched now, a frame still arriving waits in the parser's carry
+    // until the bytes its length field promises are in
+    ubxParser_.parse(
+        std::span<const uint8_t>(runRxBuff_.data(), incomingBytes),
+        rxTimestamp
+    );
+}
 
-    if (!shouldParse)
-        return;
+void F10TRun::setBaudrate(const uint32_t baudrate)
+{
+    baudrate_ = baudrate;
+    linkStats_.baudrate = baudrate;
+    linkSnapshot_.publish(linkStats_);
+}
 
-    // TODO: ogar tej alokacji, std::span
-    const auto unfinishedFrame = ubxParser_.parse(
-        std::vector<uint8_t>(
-            runRxBuff_.data(),
-            runRxBuff_.data() + runRxBuffOffset_
-        )
-    );
+UartLinkStats F10TRun::linkStats() const
+{
+    return linkSnapshot_.read();
+}
 
-    std::copy(
-        unfinishedFrame.begin(), unfinishedFrame.end(), runRxBuff_.begin()
-    );
-    runRxBuffOffset_ = unfinishedFrame.size();
+void F10TRun::account(const uint32_t bytes)
+{
+    const auto now = Clock::now();
+    if (burstBytes_ > 0 && now - lastRead_ > epochGap)
+        closeEpoch(now);
+
+    if (burstBytes_ == 0)
+        burstStart_ = now;
+    burstBytes_ += bytes;
+    lastRead_ = now;
+}
+
+void F10TRun::closeEpoch(const Clock::time_point nextBurst)
+{
+    UartEpochLoad load;
+    load.bytes = burstBytes_;
+    load.lineTime_us = static_cast<uint32_t>(
+        uint64_t(burstBytes_) * 10'000'000 / baudrate_);
+    load.period_us = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            nextBurst - burstStart_).count());
+
+    linkStats_.epochs++;
+    linkStats_.bytes += load.bytes;
+    linkStats_.peakUtilization = std::max(linkStats_.peakUtilization,
+        load.utilization());
+    linkStats_.lastEpoch = load;
+    linkSnapshot_.publish(linkStats_);
+    burstBytes_ = 0;
 }
 
 F9PRun::F9PRun(ICommDriver& commDriver, UbxParser& ubxParser,
@@ -102,8 +210,15 @@ F9PRun::F9PRun(ICommDriver& commDriver, UbxParser& ubxParser,
     rtcm3Parser_(rtcm3Store),
     rtcm3Store_(rtcm3Store),
     uartBuff_(uartBuffSize),
-    uartBuffOffset_(0)
+    uartBuffOffset_(0),
+    roverPacer_(UartDriver::expectedBaudrate)
 {
+    if (config.maxUartBaudrate.has_value())
+    {
+        static_cast<UartDriver&>(*uartDriver_).reinit(
+            *config.maxUartBaudrate);
+    }
+
     if (!config.rtk.has_value())
         return;
 
@@ -176,11 +291,46 @@ void F9PRun::executeUartBase()
 void F9PRun::executeUartRover(std::stop_token stoken)
 {
     auto& uartDriver = static_cast<UartDriver&>(*uartDriver_);
-    const auto incomingFrames = rtcm3Store_.waitForFrames(stoken);
-    for (const auto& frame : incomingFrames)
+    if (!rtcm3Store_.takeFrames(roverBatch_, stoken))
+        return;
+
+    // Whatever the line cannot send before the next corrections arrive
+    // is dropped here rather than left to age in the TTY buffer
+    roverPacer_.setBaudrate(uartDriver.currentBaudrate());
+    const auto now = UartLinePacer::Clock::now();
+    roverSpans_.clear();
+    std::size_t admitted = 0;
+    for (const auto& frame : roverBatch_)
     {
-        uartDriver.transmit(frame);
+        if (roverPacer_.admit(frame.size(), now))
+        {
+            roverSpans_.emplace_back(frame);
+            admitted += frame.size();
+        }
+        else
+            roverStats_.framesDropped++;
     }
+
+    const auto result = uartDriver.transmitv(roverSpans_);
+    roverWriteLatency_.record(UartLinePacer::Clock::now() - now);
+
+    // A short write leaves the line with less to send than was booked
+    roverPacer_.refund(admitted - result.bytesWritten);
+
+    roverStats_.batches++;
+    roverStats_.framesWritten += result.buffersWritten;
+    roverStats_.framesDropped += roverSpans_.size() - result.buffersWritten;
+    roverStats_.bytesQueued += result.bytesWritten;
+    roverStats_.writeCalls += result.writeCalls;
+    roverStats_.stalls += result.stalls;
+    roverSnapshot_.publish(roverStats_);
+}
+
+RtcmUartStats F9PRun::roverUartStats() const
+{
+    auto stats = roverSnapshot_.read();
+    stats.writeLatency = roverWriteLatency_.snapshot();
+    return stats;
 }
 
 }  // JimmyPaputto
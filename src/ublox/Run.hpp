@@ -5,10 +5,18 @@
 #ifndef JIMMY_PAPUTTO_RUN_HPP_
 #define JIMMY_PAPUTTO_RUN_HPP_
 
+#include <chrono>
 #include <thread>
 
+#include "common/LatencyHistogram.hpp"
+#include "common/PageAlignedBuffer.hpp"
+#include "common/SnapshotBuffer.hpp"
 #include "ublox/ICommDriver.hpp"
 #include "ublox/Rtcm3Parser.hpp"
+#include "ublox/RtcmUartStats.hpp"
+#include "ublox/SpiDrainStats.hpp"
+#include "ublox/UartLinePacer.hpp"
+#include "ublox/UartLinkStats.hpp"
 #include "ublox/UbxParser.hpp"
 
 
@@ -34,7 +42,7 @@ protected:
     UbxParser& ubxParser_;
 
     static constexpr uint32_t runRxBuffSize = 8192;
-    std::vector<uint8_t> runRxBuff_;
+    PageAlignedBuffer runRxBuff_;
     uint32_t runRxBuffOffset_;
 };
 
@@ -47,9 +55,28 @@ public:
 
     void execute(std::stop_token stoken) override;
 
+    SpiDrainStats drainStats() const;
+
 private:
+    uint32_t firstTransferSize() const;
+    void transfer(std::span<uint8_t> rxBuff);
+    void account(const SpiEpochDrain& drain);
+
     Notifier& txReadyNotifier_;
     Notifier& navigationNotifier_;
+
+    // Useful bytes per epoch, grows at once and decays slowly so a burst
+    // (MON-SPAN, NAV-SAT with many SVs) does not cost an extra ioctl twice
+    uint32_t expectedEpochSize_;
+    SpiDrainStats drainStats_;
+    SnapshotBuffer<SpiDrainStats> drainSnapshot_;
+
+    static constexpr uint32_t drainSegmentSize = 256;
+    // 4 KiB per message, spidev's default bufsiz
+    static constexpr uint32_t maxDrainSegments = 16;
+    // The receiver clocks out 0xFF once its TX buffer is empty; this many
+    // in a row means it has nothing more (u-blox integration manual)
+    static constexpr uint32_t idleFillThreshold = 50;
 };
 
 class F10TRun : public IRunStrategy, public RunBase
@@ -59,6 +86,27 @@ public:
     ~F10TRun() override = default;
 
     void execute(std::stop_token stoken) override;
+
+    // Rate the link load is measured against, whatever startup settled on
+    void setBaudrate(const uint32_t baudrate);
+    UartLinkStats linkStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void account(const uint32_t bytes);
+    void closeEpoch(const Clock::time_point nextBurst);
+
+    uint32_t baudrate_;
+    uint32_t burstBytes_;
+    Clock::time_point burstStart_;
+    Clock::time_point lastRead_;
+    UartLinkStats linkStats_;
+    SnapshotBuffer<UartLinkStats> linkSnapshot_;
+
+    // Longer than a receiver pauses within an epoch's output, shorter than
+    // the quiet time between epochs at 25 Hz
+    static constexpr auto epochGap = std::chrono::milliseconds(10);
 };
 
 class F9PRun : public M9NRun
@@ -70,6 +118,8 @@ public:
 
     ~F9PRun() override;
 
+    RtcmUartStats roverUartStats() const;
+
 private:
     void executeUartBase();
     void executeUartRover(std::stop_token stoken);
@@ -85,6 +135,14 @@ private:
 
     static constexpr uint32_t unfinishedFrameBuffMaxSize = 1024;
     std::vector<uint8_t> unfinishedFrameBuff_;
+
+    // Rover: reused across batches, the store swaps frames in
+    std::vector<std::vector<uint8_t>> roverBatch_;
+    std::vector<std::span<const uint8_t>> roverSpans_;
+    UartLinePacer roverPacer_;
+    RtcmUartStats roverStats_;
+    LatencyHistogram roverWriteLatency_;
+    SnapshotBuffer<RtcmUartStats> roverSnapshot_;
 };
 
 }  // JimmyPaputto
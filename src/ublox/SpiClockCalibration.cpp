@@ -0,0 +1,130 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "ublox/SpiClockCalibration.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+#include "ublox/ubxmsg/UBX_MON_VER.hpp"
+
+
+namespace JimmyPaputto
+{
+
+namespace
+{
+
+// After the poll the bus is read in chunks until the reply shows up. A
+// receiver answers within a few milliseconds; a reply later than
+// replyTimeout counts as lost.
+constexpr uint32_t readChunkSize = 256;
+constexpr auto replyTimeout = std::chrono::milliseconds(100);
+
+}  // namespace
+
+bool SpiCalibrationStep::clean() const
+{
+    return checksumFailures == 0 &&
+        replies == SpiClockCalibration::pollsPerStep;
+}
+
+SpiClockCalibration::SpiClockCalibration(SpiDriver& spiDriver)
+:   spiDriver_(spiDriver),
+    rxBuff_()
+{
+}
+
+SpiCalibrationResult SpiClockCalibration::run()
+{
+    const auto initialClock_Hz = spiDriver_.profile().clock_Hz;
+    SpiCalibrationResult result{ initialClock_Hz, {} };
+
+    for (const auto clock_Hz : clockSteps(spiDriver_.profile()))
+    {
+        result.steps.push_back(probe(clock_Hz));
+        if (!result.steps.back().clean())
+            break;
+        result.clock_Hz = clock_Hz;
+    }
+
+    if (!result.steps.empty() && !result.steps.front().clean())
+    {
+        fprintf(stderr,
+            "[SpiCalibration] Errors already at %u Hz, keeping it\r\n",
+            initialClock_Hz);
+    }
+    spiDriver_.setClock(result.clock_Hz);
+    return result;
+}
+
+std::vector<uint32_t> SpiClockCalibration::clockSteps(
+    const SpiProfile& profile)
+{
+    std::vector<uint32_t> steps;
+    uint64_t clock_Hz = profile.clock_Hz;
+    while (clock_Hz < profile.maxClock_Hz)
+    {
+        steps.push_back(static_cast<uint32_t>(clock_Hz));
+        clock_Hz += clock_Hz / 8;
+    }
+    steps.push_back(profile.maxClock_Hz);
+    return steps;
+}
+
+SpiCalibrationStep SpiClockCalibration::probe(const uint32_t clock_Hz)
+{
+    spiDriver_.setClock(clock_Hz);
+
+    SpiCalibrationStep step{ clock_Hz, 0, 0 };
+    const auto pollFrame = ubxmsg::UBX_MON_VER::poll();
+    for (uint32_t poll = 0; poll < pollsPerStep; poll++)
+    {
+        rxBuff_.resize(pollFrame.size());
+        spiDriver_.transmitReceive(pollFrame, rxBuff_);
+
+        UbxScanner scanner;
+        const bool replied = awaitReply(scanner);
+        step.replies += replied ? 1 : 0;
+        step.checksumFailures += scanner.stats().checksumFailures;
+    }
+    return step;
+}
+
+bool SpiClockCalibration::awaitReply(UbxScanner& scanner)
+{
+    const auto deadline = std::chrono::steady_clock::now() + replyTimeout;
+    std::size_t from = 0;
+    while (true)
+    {
+        while (true)
+        {
+            const auto candidate = scanner.next(rxBuff_, from);
+            if (candidate.type == UbxScanner::ECandidate::Frame)
+            {
+                if (rxBuff_[candidate.offset + 2] == 0x0A &&
+                    rxBuff_[candidate.offset + 3] == 0x04)
+                {
+                    return true;
+                }
+                from = candidate.offset + candidate.size;
+                continue;
+            }
+            // Keep a frame that runs past the end, drop everything else
+            from = candidate.offset;
+            break;
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+
+        rxBuff_.erase(rxBuff_.begin(), rxBuff_.begin() + from);
+        from = 0;
+        const auto used = rxBuff_.size();
+        rxBuff_.resize(used + readChunkSize);
+        spiDriver_.getRxBuff(rxBuff_.data() + used, readChunkSize);
+    }
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,63 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_SPI_CLOCK_CALIBRATION_HPP_
+#define JIMMY_PAPUTTO_SPI_CLOCK_CALIBRATION_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "ublox/SpiDriver.hpp"
+#include "ublox/UbxScanner.hpp"
+
+
+namespace JimmyPaputto
+{
+
+struct SpiCalibrationStep
+{
+    uint32_t clock_Hz;
+    uint32_t replies;           // MON-VER replies that came back intact
+    uint32_t checksumFailures;
+
+    bool clean() const;
+};
+
+struct SpiCalibrationResult
+{
+    uint32_t clock_Hz;
+    std::vector<SpiCalibrationStep> steps;
+};
+
+// Raises the SPI clock in ~12.5% steps from the profile clock up to
+// maxClock_Hz, polling UBX-MON-VER a few times at each step and reading
+// until each reply arrives. The first step that loses a reply or sees a
+// checksum failure ends the climb and the driver is left at the last clean
+// clock.
+//
+// Meant for startup: whatever the receiver sends meanwhile is read and
+// thrown away.
+class SpiClockCalibration final
+{
+public:
+    explicit SpiClockCalibration(SpiDriver& spiDriver);
+
+    SpiCalibrationResult run();
+
+    static std::vector<uint32_t> clockSteps(const SpiProfile& profile);
+
+    static constexpr uint32_t pollsPerStep = 4;
+
+private:
+    SpiCalibrationStep probe(const uint32_t clock_Hz);
+    // Reads after a poll until its reply is in rxBuff_ or the timeout
+    bool awaitReply(UbxScanner& scanner);
+
+    SpiDriver& spiDriver_;
+    std::vector<uint8_t> rxBuff_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_SPI_CLOCK_CALIBRATION_HPP_
@@ -0,0 +1,45 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_SPI_DRAIN_STATS_HPP_
+#define JIMMY_PAPUTTO_SPI_DRAIN_STATS_HPP_
+
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+// One TX-ready cycle of the SPI run loop
+struct SpiEpochDrain
+{
+    uint32_t bytesClocked = 0;  // shifted over the bus, idle fill included
+    uint32_t usefulBytes = 0;   // clocked minus the trailing 0xFF idle fill
+    uint32_t ioctls = 0;
+    // The run buffer filled before the receiver ran dry and what was read
+    // so far went to the parser mid-epoch
+    uint32_t overruns = 0;
+};
+
+struct SpiDrainStats
+{
+    uint64_t epochs = 0;
+    uint64_t bytesClocked = 0;
+    uint64_t usefulBytes = 0;
+    uint64_t ioctls = 0;
+    uint64_t overruns = 0;
+    SpiEpochDrain lastEpoch;
+
+    // Share of the bus time that carried receiver data
+    double efficiency() const
+    {
+        return bytesClocked > 0
+            ? static_cast<double>(usefulBytes) / bytesClocked
+            : 0.0;
+    }
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_SPI_DRAIN_STATS_HPP_
@@ -4,27 +4,95 @@
 
 #include "ublox/SpiDriver.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
 #include <linux/spi/spidev.h>
-#include <fcntl.h>
-#include <sys/ioctl.h>
-#include <unistd.h>
 
 
 namespace JimmyPaputto
 {
 
-SpiDriver::SpiDriver()
-:	spiFd_(-1),
-    spiDevice_(UBX_SPI_DEV)
+// One SPI_IOC_MESSAGE being assembled. Transfers are appended until the
+// message would exceed the profile's chunk size or segment limit, then it
+// is sent and a new one started.
+class SpiDriver::Message
+{
+public:
+    explicit Message(SpiDriver& driver)
+    :   driver_(driver),
+        transfers_{},
+        count_(0),
+        bytes_(0)
+    {
+    }
+
+    // A null txBuff shifts out idle fill, a null rxBuff discards what comes
+    // back (both allowed by spidev)
+    void append(const uint8_t* txBuff, uint8_t* rxBuff, uint32_t size)
+    {
+        const auto chunkSize = driver_.profile_.chunkSize;
+        while (size > 0)
+        {
+            if (count_ == maxSegments_ || bytes_ == chunkSize)
+                send();
+
+            const auto len = std::min(size, chunkSize - bytes_);
+            auto& transfer = transfers_[count_++];
+            transfer = {};
+            transfer.tx_buf = reinterpret_cast<unsigned long>(
+                txBuff ? txBuff : driver_.idleBank_.data());
+            transfer.rx_buf = reinterpret_cast<unsigned long>(rxBuff);
+            transfer.len = len;
+            transfer.speed_hz = driver_.profile_.clock_Hz;
+            transfer.bits_per_word = driver_.profile_.bitsPerWord;
+
+            bytes_ += len;
+            size -= len;
+            if (txBuff)
+                txBuff += len;
+            if (rxBuff)
+                rxBuff += len;
+        }
+    }
+
+    void send()
+    {
+        if (count_ == 0)
+            return;
+
+        // SPI_IOC_MESSAGE(n) spelled out, the macro wants a compile-time n
+        const auto request = _IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0,
+            SPI_MSGSIZE(count_));
+        if (driver_.spidev_->ioctl(request, transfers_.data()) < 0)
+        {
+            fprintf(stderr, "[SpiDriver] SPI transfer failed\r\n");
+            perror("ioctl");
+            exit(EXIT_FAILURE);
+        }
+        count_ = 0;
+        bytes_ = 0;
+    }
+
+private:
+    SpiDriver& driver_;
+    std::array<struct spi_ioc_transfer, maxSegments_> transfers_;
+    uint32_t count_;
+    uint32_t bytes_;
+};
+
+SpiDriver::SpiDriver(const SpiProfile& profile,
+    std::unique_ptr<ISpidev> spidev)
+:   profile_(profile),
+    spidev_(std::move(spidev)),
+    spiDevice_(UBX_SPI_DEV),
+    idleBank_(profile.chunkSize, 0xFF)
 {
     currentSpiMode_ = expectedSpiMode;
     init(convertSpiMode(currentSpiMode_));
-    std::memset(txBank_, 0xFF, sizeof(txBank_));
 }
 
 SpiDriver::~SpiDriver()
@@ -39,65 +107,59 @@ void SpiDriver::reinit(const ESpiMode spiMode)
     init(convertSpiMode(currentSpiMode_));
 }
 
-void SpiDriver::transmitReceive(std::span<const uint8_t> txBuff,
-    std::vector<uint8_t>& rxBuff)
+void SpiDriver::setProfile(const SpiProfile& profile)
 {
-    if (rxBuff.size() > sizeof(txBank_))
-    {
-        fprintf(stderr,
-            "[SpiDriver] transmitReceive: rxBuff size (%zu) exceeds txBank "
-            "capacity (%zu)\r\n", rxBuff.size(), sizeof(txBank_));
-        exit(EXIT_FAILURE);
-    }
-    if (txBuff.size() > sizeof(txBank_))
-    {
-        fprintf(stderr,
-            "[SpiDriver] transmitReceive: txBuff size (%zu) exceeds txBank "
-            "capacity (%zu)\r\n", txBuff.size(), sizeof(txBank_));
-        exit(EXIT_FAILURE);
-    }
-
-    std::memcpy(txBank_, txBuff.data(), txBuff.size());
-
-    struct spi_ioc_transfer spiTransfer = {};
-    spiTransfer.tx_buf = reinterpret_cast<unsigned long>(txBank_);
-    spiTransfer.rx_buf = reinterpret_cast<unsigned long>(rxBuff.data());
-    spiTransfer.len = rxBuff.size();
-    spiTransfer.speed_hz = spiSpeed_;
-    spiTransfer.bits_per_word = spiBitsPerWord_;
-
-    if (ioctl(spiFd_, SPI_IOC_MESSAGE(1), &spiTransfer) < 0)
-    {
-        fprintf(stderr, "[SpiDriver] SPI transmit/receive failed\r\n");
-        perror("ioctl");
-        exit(EXIT_FAILURE);
-    }
+    if (profile.chunkSize > idleBank_.size())
+        idleBank_ = PageAlignedBuffer(profile.chunkSize, 0xFF);
+    profile_ = profile;
+    configureBus();
+}
 
-    std::memset(txBank_, 0xFF, txBuff.size());
+void SpiDriver::setClock(const uint32_t clock_Hz)
+{
+    profile_.clock_Hz = clock_Hz;
+    configureBus();
 }
 
-struct spi_ioc_transfer spiTransfer;
+void SpiDriver::transmitReceive(std::span<const uint8_t> txBuff,
+    std::vector<uint8_t>& rxBuff)
+{
+    // The frame goes out straight from the caller's buffer, the rest of the
+    // read clocks idle fill
+    const auto txSize = static_cast<uint32_t>(txBuff.size());
+    const auto rxSize = static_cast<uint32_t>(rxBuff.size());
+    const auto shared = std::min(txSize, rxSize);
+
+    Message message(*this);
+    message.append(txBuff.data(), rxBuff.data(), shared);
+    if (txSize > shared)
+        message.append(txBuff.data() + shared, nullptr, txSize - shared);
+    else
+        message.append(nullptr, rxBuff.data() + shared, rxSize - shared);
+    message.send();
+}
 
 void SpiDriver::getRxBuff(uint8_t* rxBuff, const uint32_t size)
 {
-    spiTransfer.tx_buf = reinterpret_cast<unsigned long>(txBank_);
-    spiTransfer.rx_buf = reinterpret_cast<unsigned long>(rxBuff);
-    spiTransfer.len = size;
-    spiTransfer.speed_hz = spiSpeed_;
-    spiTransfer.bits_per_word = spiBitsPerWord_;
+    Message message(*this);
+    message.append(nullptr, rxBuff, size);
+    message.send();
+}
 
-    if (ioctl(spiFd_, SPI_IOC_MESSAGE(1), &spiTransfer) < 0)
+void SpiDriver::getRxBuffs(std::span<const std::span<uint8_t>> segments)
+{
+    Message message(*this);
+    for (const auto& segment : segments)
     {
-        fprintf(stderr, "[SpiDriver] getRxBuff SPI transfer failed\r\n");
-        perror("ioctl");
-        exit(EXIT_FAILURE);
+        message.append(nullptr, segment.data(),
+            static_cast<uint32_t>(segment.size()));
     }
+    message.send();
 }
 
 void SpiDriver::init(const uint8_t spiMode)
 {
-    spiFd_ = open(spiDevice_, O_RDWR);
-    if (spiFd_ < 0)
+    if (!spidev_->open(spiDevice_))
     {
         fprintf(stderr, "[SpiDriver] Failed to open SPI device %s\r\n",
             spiDevice_);
@@ -105,21 +167,26 @@ void SpiDriver::init(const uint8_t spiMode)
         exit(EXIT_FAILURE);
     }
 
-    if (ioctl(spiFd_, SPI_IOC_WR_MODE, &spiMode) < 0)
+    if (spidev_->ioctl(SPI_IOC_WR_MODE, const_cast<uint8_t*>(&spiMode)) < 0)
     {
         fprintf(stderr, "[SpiDriver] Failed to set SPI mode\r\n");
         perror("ioctl SPI_IOC_WR_MODE");
         exit(EXIT_FAILURE);
     }
 
-    if (ioctl(spiFd_, SPI_IOC_WR_BITS_PER_WORD, &spiBitsPerWord_) < 0)
+    configureBus();
+}
+
+void SpiDriver::configureBus()
+{
+    if (spidev_->ioctl(SPI_IOC_WR_BITS_PER_WORD, &profile_.bitsPerWord) < 0)
     {
         fprintf(stderr, "[SpiDriver] Failed to set SPI bits per word\r\n");
         perror("ioctl SPI_IOC_WR_BITS_PER_WORD");
         exit(EXIT_FAILURE);
     }
 
-    if (ioctl(spiFd_, SPI_IOC_WR_MAX_SPEED_HZ, &spiSpeed_) < 0)
+    if (spidev_->ioctl(SPI_IOC_WR_MAX_SPEED_HZ, &profile_.clock_Hz) < 0)
     {
         fprintf(stderr, "[SpiDriver] Failed to set SPI speed\r\n");
         perror("ioctl SPI_IOC_WR_MAX_SPEED_HZ");
@@ -129,10 +196,7 @@ void SpiDriver::init(const uint8_t spiMode)
 
 void SpiDriver::deinit() const
 {
-    if (spiFd_ >= 0)
-    {
-        close(spiFd_);
-    }
+    spidev_->close();
 }
 
 uint8_t SpiDriver::convertSpiMode(const ESpiMode spiMode) const
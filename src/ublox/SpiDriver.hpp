@@ -6,10 +6,14 @@
 #define SPI_DRIVER_HPP_
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "common/PageAlignedBuffer.hpp"
 #include "ublox/ESpiMode.hpp"
 #include "ublox/ICommDriver.hpp"
+#include "ublox/SpiProfile.hpp"
+#include "ublox/Spidev.hpp"
 
 #define UBX_SPI_DEV "/dev/spidev0.0"
 
@@ -20,30 +24,42 @@ namespace JimmyPaputto
 class SpiDriver: public ICommDriver
 {
 public:
-    explicit SpiDriver();
+    explicit SpiDriver(const SpiProfile& profile = SpiProfile{},
+        std::unique_ptr<ISpidev> spidev = std::make_unique<Spidev>());
     ~SpiDriver();
 
     void transmitReceive(std::span<const uint8_t> txBuff,
         std::vector<uint8_t>& rxBuff) override;
     void getRxBuff(uint8_t* rxBuff, const uint32_t size) override;
+    void getRxBuffs(std::span<const std::span<uint8_t>> segments) override;
 
     void reinit(const ESpiMode spiMode);
     ESpiMode currentSpiMode() const { return currentSpiMode_; }
 
+    // Takes effect with the next transfer, no reopen needed
+    void setProfile(const SpiProfile& profile);
+    void setClock(const uint32_t clock_Hz);
+    const SpiProfile& profile() const { return profile_; }
+
     static constexpr ESpiMode expectedSpiMode = ESpiMode::SpiMode0;
 
 private:
+    class Message;
+
     void init(const uint8_t spiMode);
     void deinit() const;
+    void configureBus();
     uint8_t convertSpiMode(const ESpiMode spiMode) const;
 
     ESpiMode currentSpiMode_;
+    SpiProfile profile_;
 
-    int spiFd_;
+    std::unique_ptr<ISpidev> spidev_;
     const char* spiDevice_;
-    uint8_t txBank_[4096];
-    static constexpr uint32_t spiSpeed_ = 5'000'000; // 5'000'000 = 5MHz
-    static constexpr uint8_t spiBitsPerWord_ = 8;
+    // Shifted out whenever the host has nothing to send; filled once, never
+    // written again
+    PageAlignedBuffer idleBank_;
+    static constexpr uint32_t maxSegments_ = 16;
 };
 
 }  // JimmyPaputto
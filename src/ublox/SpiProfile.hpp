@@ -0,0 +1,36 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef SPI_PROFILE_HPP_
+#define SPI_PROFILE_HPP_
+
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+struct SpiProfile final
+{
+    // SPI slave limit of the M9N/F9P modules on the SPI HATs
+    static constexpr uint32_t moduleMaxClock_Hz = 5'500'000;
+    static constexpr uint32_t minClock_Hz = 100'000;
+
+    uint32_t clock_Hz{5'000'000};
+    // UBX is a byte stream, the receiver only speaks 8-bit words
+    uint8_t bitsPerWord{8};
+    // Bytes per SPI_IOC_MESSAGE; spidev rejects messages larger than its
+    // `bufsiz` module parameter (4096 unless raised)
+    uint32_t chunkSize{4096};
+
+    // At startup, step the clock up from clock_Hz to maxClock_Hz and keep
+    // the fastest setting that still reads UBX frames without checksum
+    // errors
+    bool autoCalibrate{false};
+    uint32_t maxClock_Hz{moduleMaxClock_Hz};
+};
+
+}  // JimmyPaputto
+
+#endif  // SPI_PROFILE_HPP_
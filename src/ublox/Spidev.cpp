@@ -0,0 +1,43 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "ublox/Spidev.hpp"
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+
+namespace JimmyPaputto
+{
+
+Spidev::Spidev()
+:   fd_(-1)
+{
+}
+
+Spidev::~Spidev()
+{
+    close();
+}
+
+bool Spidev::open(const char* path)
+{
+    fd_ = ::open(path, O_RDWR);
+    return fd_ >= 0;
+}
+
+void Spidev::close()
+{
+    if (fd_ >= 0)
+        ::close(fd_);
+    fd_ = -1;
+}
+
+int Spidev::ioctl(unsigned long request, void* arg)
+{
+    return ::ioctl(fd_, request, arg);
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,42 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_SPIDEV_HPP_
+#define JIMMY_PAPUTTO_SPIDEV_HPP_
+
+
+namespace JimmyPaputto
+{
+
+// The file-descriptor end of /dev/spidevX.Y. SpiDriver issues every
+// SPI_IOC_* request through it, so the driver can run against a simulated
+// device.
+class ISpidev
+{
+public:
+    virtual ~ISpidev() = default;
+
+    virtual bool open(const char* path) = 0;
+    virtual void close() = 0;
+    // Same contract as ioctl(2): -1 and errno on failure
+    virtual int ioctl(unsigned long request, void* arg) = 0;
+};
+
+class Spidev final : public ISpidev
+{
+public:
+    Spidev();
+    ~Spidev() override;
+
+    bool open(const char* path) override;
+    void close() override;
+    int ioctl(unsigned long request, void* arg) override;
+
+private:
+    int fd_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_SPIDEV_HPP_
@@ -15,7 +15,9 @@
 #include "common/Utils.hpp"
 #include "ublox/Geofencing.hpp"
 #include "ublox/Gnss.hpp"
+#include "ublox/SpiClockCalibration.hpp"
 #include "ublox/SpiDriver.hpp"
+#include "ublox/UartBaudEscalation.hpp"
 #include "ublox/UartDriver.hpp"
 #include "ublox/UbxCfgKeys.hpp"
 #include "ublox/ubxmsg/UBX_CFG_CFG.hpp"
@@ -28,11 +30,14 @@ namespace JimmyPaputto
 {
 
 StartupBase::StartupBase(ICommDriver& commDriver,
-    IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser)
+    IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser,
+    const Gnss& gnss)
 :   commDriver_(commDriver),
     configRegistry_(configRegistry),
     ubxParser_(ubxParser),
-    rxBuff_(rxBuffSize)
+    gnss_(gnss),
+    rxBuff_(rxBuffSize),
+    expectedConfigValues_(defaultConfigValues_)
 {
     timepulsePinConfigKeys_.reserve(11);
     timepulsePinConfigKeys_.push_back(UbxCfgKeys::CFG_TP_TP1_ENA);
@@ -327,8 +332,9 @@ void StartupBase::baseConfig2Registers(const BaseConfig& baseConfig)
 }
 
 M9NStartup::M9NStartup(ICommDriver& commDriver,
-    IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser)
-:	StartupBase(commDriver, configRegistry, ubxParser)
+    IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser,
+    const Gnss& gnss)
+:	StartupBase(commDriver, configRegistry, ubxParser, gnss)
 {
     const auto& config = configRegistry.getGnssConfig();
     auto& ecv = StartupBase::expectedConfigValues_;
@@ -481,6 +487,10 @@ bool M9NStartup::execute()
         return false;
     }
 
+    const auto& spiProfile = configRegistry_.getGnssConfig().spi;
+    if (spiProfile.has_value() && spiProfile->autoCalibrate)
+        calibrateSpiClock();
+
     constexpr std::array<uint32_t, 5> txReadyKeys = {
         UbxCfgKeys::CFG_TXREADY_ENABLED,
         UbxCfgKeys::CFG_TXREADY_POLARITY,
@@ -625,8 +635,10 @@ bool M9NStartup::reconfigureCommPort()
     for (const auto& spiMode : spiModesToCheck)
     {
         spiDriver.reinit(spiMode);
+        ubxParser_.reset();
         try3times([this, &spiKeys](){ return configure(spiKeys); });
         spiDriver.reinit(SpiDriver::expectedSpiMode);
+        ubxParser_.reset();
         result = try3times([this, &spiKeys](){ return configure(spiKeys); });
         if (result)
             break;
@@ -635,6 +647,16 @@ bool M9NStartup::reconfigureCommPort()
     return result;
 }
 
+void M9NStartup::calibrateSpiClock()
+{
+    auto& spiDriver = static_cast<SpiDriver&>(commDriver_);
+    const auto result = SpiClockCalibration(spiDriver).run();
+    ubxParser_.reset();
+
+    printf("[Startup] SPI clock calibrated to %u Hz (%zu steps)\r\n",
+        result.clock_Hz, result.steps.size());
+}
+
 static std::vector<uint32_t> baseConfig2Keys(const BaseConfig& baseConfig)
 {
     std::vector<uint32_t> tmodeKeys = { UbxCfgKeys::CFG_TMODE_MODE };
@@ -692,7 +714,8 @@ enum class E_CFG_TXREADY_INTERFACE : uint8_t
     SPI = 0x01
 };
 
-std::unordered_map<uint32_t, std::vector<uint8_t>> StartupBase::expectedConfigValues_ = {
+const std::unordered_map<uint32_t, std::vector<uint8_t>>
+    StartupBase::defaultConfigValues_ = {
     {UbxCfgKeys::CFG_SPI_MAXFF,           {0x3F}},  // 63
     {UbxCfgKeys::CFG_SPI_CPOLARITY,       {0x00}},
     {UbxCfgKeys::CFG_SPI_CPHASE,          {0x00}},
@@ -774,7 +797,7 @@ bool StartupBase::awaitAck(std::span<const uint8_t> payload, EUbxMsg msgType)
     ack = false;
     std::ranges::fill(rxBuff_, 0);
     commDriver_.transmitReceive(payload, rxBuff_);
-    auto unfinished = ubxParser_.parse(rxBuff_);
+    ubxParser_.parse(rxBuff_);
 
     if (ack)
         return true;
@@ -783,20 +806,16 @@ bool StartupBase::awaitAck(std::span<const uint8_t> payload, EUbxMsg msgType)
     const auto deadline = std::chrono::steady_clock::now() + timeout;
     do
     {
-        std::copy(unfinished.begin(), unfinished.end(), rxBuff_.begin());
-        const uint32_t offset = unfinished.size();
         const int bytesRead = pollRxData(
-            rxBuff_.data() + offset,
-            rxBuff_.size() - offset,
+            rxBuff_.data(),
+            rxBuff_.size(),
             static_cast<int>(timeout.count())
         );
 
         if (bytesRead <= 0)
             continue;
 
-        unfinished = ubxParser_.parse(
-            std::span<const uint8_t>(rxBuff_.data(), offset + bytesRead)
-        );
+        ubxParser_.parse(std::span<const uint8_t>(rxBuff_.data(), bytesRead));
 
         if (ack)
             return true;
@@ -817,35 +836,31 @@ bool StartupBase::pollMonVer(int timeoutMs)
 {
     // UBX-MON-VER is poll-only (not periodically emitted). Send the poll and
     // feed any received bytes through the parser so the registered MON-VER
-    // callback updates Gnss::instance() with the receiver/firmware version.
+    // callback updates gnss_ with the receiver/firmware version.
     const auto pollFrame = ubxmsg::UBX_MON_VER::poll();
     std::ranges::fill(rxBuff_, 0);
     commDriver_.transmitReceive(pollFrame, rxBuff_);
-    auto unfinished = ubxParser_.parse(rxBuff_);
+    ubxParser_.parse(rxBuff_);
 
-    if (!Gnss::instance().swVersion().empty())
+    if (!gnss_.swVersion().empty())
         return true;
 
     const auto deadline = std::chrono::steady_clock::now()
         + std::chrono::milliseconds(timeoutMs);
     do
     {
-        std::copy(unfinished.begin(), unfinished.end(), rxBuff_.begin());
-        const uint32_t offset = unfinished.size();
         const int bytesRead = pollRxData(
-            rxBuff_.data() + offset,
-            rxBuff_.size() - offset,
+            rxBuff_.data(),
+            rxBuff_.size(),
             timeoutMs
         );
 
         if (bytesRead <= 0)
             continue;
 
-        unfinished = ubxParser_.parse(
-            std::span<const uint8_t>(rxBuff_.data(), offset + bytesRead)
-        );
+        ubxParser_.parse(std::span<const uint8_t>(rxBuff_.data(), bytesRead));
 
-        if (!Gnss::instance().swVersion().empty())
+        if (!gnss_.swVersion().empty())
             return true;
     }
     while (std::chrono::steady_clock::now() < deadline);
@@ -967,8 +982,9 @@ bool StartupBase::configure(std::span<const uint32_t> keys)
 }
 
 F10TStartup::F10TStartup(ICommDriver& commDriver,
-    IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser)
-:	StartupBase(commDriver, configRegistry, ubxParser)
+    IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser,
+    const Gnss& gnss)
+:	StartupBase(commDriver, configRegistry, ubxParser, gnss)
 {
     const auto& config = configRegistry.getGnssConfig();
     auto& ecv = StartupBase::expectedConfigValues_;
@@ -1085,6 +1101,12 @@ bool F10TStartup::execute()
         }
     }
 
+    // After the flash save, so a receiver that loses power comes back at
+    // the rate reconfigureCommPort() starts from
+    const auto maxBaudrate = configRegistry_.getGnssConfig().maxUartBaudrate;
+    if (maxBaudrate.has_value() && !escalateBaudrate(*maxBaudrate))
+        return false;
+
     pollMonVer();
     return true;
 }
@@ -1093,9 +1115,14 @@ bool F10TStartup::reconfigureCommPort()
 {
     bool result = false;
 
-    constexpr std::array<uint32_t, 2> baudratesToCheck = {
+    // Factory default, ours, then whatever an earlier escalation left in
+    // RAM of a receiver that was not power-cycled since
+    constexpr std::array<uint32_t, 5> baudratesToCheck = {
         38400,
         115200,
+        921600,
+        460800,
+        230400,
     };
 
     auto& uartDriver = static_cast<UartDriver&>(commDriver_);
@@ -1111,8 +1138,10 @@ bool F10TStartup::reconfigureCommPort()
     for (const auto& baudrate : baudratesToCheck)
     {
         uartDriver.reinit(baudrate);
+        ubxParser_.reset();
         try3times([this, &uart1Keys](){ return configure(uart1Keys); });
         uartDriver.reinit(UartDriver::expectedBaudrate);
+        ubxParser_.reset();
         result = try3times([this, &uart1Keys](){
             return configure(uart1Keys);
         });
@@ -1123,6 +1152,45 @@ bool F10TStartup::reconfigureCommPort()
     return result;
 }
 
+bool F10TStartup::escalateBaudrate(const uint32_t maxBaudrate)
+{
+    auto& uartDriver = static_cast<UartDriver&>(commDriver_);
+    UartBaudEscalation escalation(uartDriver,
+        [&uartDriver](const uint32_t baudrate) {
+            // Goes out at the current rate; the receiver acknowledges at
+            // that rate too and only then switches, so there is no ACK to
+            // wait for on this side
+            uartDriver.transmit(ubxmsg::UBX_CFG_VALSET::setU4(
+                UbxCfgKeys::CFG_UART1_BAUDRATE, baudrate));
+            uartDriver.drain();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            return true;
+        });
+    const auto result = escalation.run(maxBaudrate);
+    ubxParser_.reset();
+
+    if (result.linkLost)
+    {
+        fprintf(stderr, "[Startup] UART link lost during baud rate "
+            "escalation, rescanning\r\n");
+        return reconfigureCommPort();
+    }
+
+    const auto& steps = result.steps;
+    const auto last = std::find_if(steps.rbegin(), steps.rend(),
+        [](const UartLinkTest& test) { return test.passed(); });
+    printf("[Startup] UART running at %u baud (%zu steps",
+        result.baudrate, steps.size());
+    if (last != steps.rend())
+    {
+        printf(", MON-VER round trip %lld us, %.0f B/s",
+            static_cast<long long>(last->roundTrip.count()),
+            last->throughput_Bps);
+    }
+    printf(")\r\n");
+    return true;
+}
+
 int F10TStartup::pollRxData(uint8_t* rxBuff, const uint32_t size,
     int timeoutMs)
 {
@@ -1148,8 +1216,9 @@ bool F10TStartup::timeBaseStartup()
 }
 
 F9PStartup::F9PStartup(ICommDriver& commDriver,
-    IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser)
-:   M9NStartup(commDriver, configRegistry, ubxParser)
+    IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser,
+    const Gnss& gnss)
+:   M9NStartup(commDriver, configRegistry, ubxParser, gnss)
 {
     auto config = configRegistry.getGnssConfig();
 
@@ -1164,6 +1233,14 @@ F9PStartup::F9PStartup(ICommDriver& commDriver,
 
     ecv[UbxCfgKeys::CFG_MSGOUT_UBX_MON_SYS_SPI] = {0x01};
 
+    // UART2 carries RTCM3 only and is configured over SPI, so the rate is
+    // set straight away and confirmed by the VALGET read-back
+    if (config.maxUartBaudrate.has_value())
+    {
+        ecv[UbxCfgKeys::CFG_UART2_BAUDRATE] =
+            serializeInt2LittleEndian<uint32_t>(*config.maxUartBaudrate);
+    }
+
     if (config.rtk == std::nullopt)
     {
         ecv[UbxCfgKeys::CFG_TMODE_MODE] =
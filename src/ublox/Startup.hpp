@@ -8,6 +8,7 @@
 #include <span>
 #include <vector>
 
+#include "ublox/Gnss.hpp"
 #include "ublox/ICommDriver.hpp"
 #include "ublox/IUbloxConfigRegistry.hpp"
 #include "ublox/UbxParser.hpp"
@@ -28,7 +29,8 @@ class StartupBase
 {
 public:
     explicit StartupBase(ICommDriver& commDriver,
-        IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser);
+        IUbloxConfigRegistry& configRegistry, UbxParser& ubxParser,
+        const Gnss& gnss);
     virtual ~StartupBase() = default;
 
 protected:
@@ -51,7 +53,7 @@ protected:
     bool verifyConfig(std::span<const uint32_t> keys);
     // Sends UBX-MON-VER poll and feeds the reply (or any pending data) to the
     // parser for up to `timeoutMs`. The MON-VER callback registered with
-    // UbxParser populates Gnss::instance().swVersion()/hwVersion()/extensions.
+    // UbxParser populates gnss_.swVersion()/hwVersion()/extensions.
     // Always returns true (best-effort: missing MON-VER must not abort
     // startup).
     bool pollMonVer(int timeoutMs = 500);
@@ -60,32 +62,36 @@ protected:
     ICommDriver& commDriver_;
     IUbloxConfigRegistry& configRegistry_;
     UbxParser& ubxParser_;
+    const Gnss& gnss_;
     std::vector<uint32_t> timepulsePinConfigKeys_;
     std::vector<uint32_t> navigationFilterKeys_;
     static constexpr uint32_t rxBuffSize = 1024;
     std::vector<uint8_t> rxBuff_;
-    static std::unordered_map<uint32_t, std::vector<uint8_t>>
-        expectedConfigValues_;
+    // Per instance: startups of several receivers may run at once
+    std::unordered_map<uint32_t, std::vector<uint8_t>> expectedConfigValues_;
+    static const std::unordered_map<uint32_t, std::vector<uint8_t>>
+        defaultConfigValues_;
 };
 
 class M9NStartup: public StartupBase, public IStartupStrategy
 {
 public:
     M9NStartup(ICommDriver& commDriver, IUbloxConfigRegistry& configRegistry,
-        UbxParser& ubxParser);
+        UbxParser& ubxParser, const Gnss& gnss);
     virtual ~M9NStartup() = default;
 
     bool execute() override;
 
 private:
     bool reconfigureCommPort() override;
+    void calibrateSpiClock();
 };
 
 class F10TStartup: public StartupBase, public IStartupStrategy
 {
 public:
     F10TStartup(ICommDriver& commDriver, IUbloxConfigRegistry& configRegistry,
-        UbxParser& ubxParser);
+        UbxParser& ubxParser, const Gnss& gnss);
     virtual ~F10TStartup() = default;
 
     bool execute() override;
@@ -94,6 +100,7 @@ private:
     bool reconfigureCommPort() override;
     int pollRxData(uint8_t* rxBuff, uint32_t size, int timeoutMs) override;
     bool timeBaseStartup();
+    bool escalateBaudrate(const uint32_t maxBaudrate);
 
     bool timeBaseEnabled_{false};
 };
@@ -102,7 +109,7 @@ class F9PStartup: public M9NStartup
 {
 public:
     F9PStartup(ICommDriver& commDriver, IUbloxConfigRegistry& configRegistry,
-        UbxParser& ubxParser);
+        UbxParser& ubxParser, const Gnss& gnss);
     virtual ~F9PStartup() = default;
 
     bool execute() override;
@@ -0,0 +1,673 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "ublox/StreamServer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "common/Utils.hpp"
+#include "ublox/NmeaFormatter.hpp"
+
+
+namespace JimmyPaputto
+{
+
+namespace
+{
+
+constexpr std::size_t epochRecordHeaderSize = 92;
+constexpr std::size_t epochRecordSatelliteSize = 8;
+constexpr std::size_t maxCommandLine = 256;
+constexpr std::size_t maxIovecs = 16;
+constexpr int maxEvents = 32;
+constexpr int listenBacklog = 16;
+// A UBX batch is posted early once it reaches this, or a quarter of a
+// client queue, so it stays small next to what a client may hold
+constexpr std::size_t maxUbxBatchBytes = 16 * 1024;
+
+template<typename T>
+T scaled(const double value, const double scale)
+{
+    const double rounded = std::round(value * scale);
+    if (!(rounded > std::numeric_limits<T>::lowest()))
+        return std::numeric_limits<T>::lowest();
+    if (!(rounded < std::numeric_limits<T>::max()))
+        return std::numeric_limits<T>::max();
+    return static_cast<T>(rounded);
+}
+
+uint8_t streamsFromCommand(std::string_view line)
+{
+    uint8_t streams = 0;
+    std::size_t begin = 0;
+    while (begin < line.size())
+    {
+        const auto end = std::min(line.find_first_of(" ,\t\r", begin),
+            line.size());
+        std::string token(line.substr(begin, end - begin));
+        std::transform(token.begin(), token.end(), token.begin(),
+            [](const unsigned char c) { return std::toupper(c); });
+
+        if (token == "NMEA")
+            streams |= StreamServer::Nmea;
+        else if (token == "UBX")
+            streams |= StreamServer::Ubx;
+        else if (token == "EPOCH")
+            streams |= StreamServer::Epoch;
+        begin = end + 1;
+    }
+    return streams;
+}
+
+}  // anonymous namespace
+
+void StreamServer::encodeEpoch(const NavigationEpoch& epoch,
+    std::vector<uint8_t>& out)
+{
+    const auto& nav = epoch.navigation;
+    const auto& pvt = nav.pvt;
+    const auto satellites = std::min<std::size_t>(nav.satellites.size(),
+        std::numeric_limits<uint8_t>::max());
+    const uint8_t flags = (epoch.complete ? 0x01 : 0) |
+        (pvt.utc.valid ? 0x02 : 0) | (pvt.date.valid ? 0x04 : 0);
+
+    out.reserve(out.size() + epochRecordHeaderSize +
+        satellites * epochRecordSatelliteSize);
+    out.insert(out.end(), { 'J', 'P', 'E', '1' });
+    appendLE<uint16_t>(static_cast<uint16_t>(epochRecordHeaderSize +
+        satellites * epochRecordSatelliteSize), out);
+    appendLE<uint8_t>(flags, out);
+    appendLE<uint8_t>(to_underlying(pvt.fixType), out);
+    appendLE<uint64_t>(epoch.sequence, out);
+    appendLE<uint32_t>(epoch.iTOW, out);
+    appendLE<int32_t>(scaled<int32_t>(pvt.latitude, 1e7), out);
+    appendLE<int32_t>(scaled<int32_t>(pvt.longitude, 1e7), out);
+    appendLE<int32_t>(scaled<int32_t>(pvt.altitudeMSL, 1e3), out);
+    appendLE<int32_t>(scaled<int32_t>(pvt.altitude, 1e3), out);
+    appendLE<uint32_t>(scaled<uint32_t>(pvt.horizontalAccuracy, 1e3), out);
+    appendLE<uint32_t>(scaled<uint32_t>(pvt.verticalAccuracy, 1e3), out);
+    appendLE<int32_t>(scaled<int32_t>(pvt.speedOverGround, 1e3), out);
+    appendLE<int32_t>(scaled<int32_t>(pvt.heading, 1e5), out);
+    appendLE<uint16_t>(scaled<uint16_t>(nav.dop.position, 1e2), out);
+    appendLE<uint16_t>(scaled<uint16_t>(nav.dop.horizontal, 1e2), out);
+    appendLE<uint16_t>(scaled<uint16_t>(nav.dop.vertical, 1e2), out);
+    appendLE<uint8_t>(to_underlying(pvt.fixQuality), out);
+    appendLE<uint8_t>(pvt.visibleSatellites, out);
+    appendLE<uint16_t>(pvt.date.year, out);
+    appendLE<uint8_t>(pvt.date.month, out);
+    appendLE<uint8_t>(pvt.date.day, out);
+    appendLE<uint8_t>(pvt.utc.hh, out);
+    appendLE<uint8_t>(pvt.utc.mm, out);
+    appendLE<uint8_t>(pvt.utc.ss, out);
+    appendLE<uint8_t>(0, out);
+    appendLE<int32_t>(pvt.utc.nano, out);
+    appendLE<int64_t>(epoch.timepulse.valid() ?
+        epoch.timepulse.realtime_ns : 0, out);
+    appendLE<int64_t>(epoch.published_ns, out);
+    appendLE<uint8_t>(static_cast<uint8_t>(satellites), out);
+    out.insert(out.end(), 3, 0);
+
+    for (std::size_t i = 0; i < satellites; i++)
+    {
+        const auto& sat = nav.satellites[i];
+        appendLE<uint8_t>(to_underlying(sat.gnssId), out);
+        appendLE<uint8_t>(sat.svId, out);
+        appendLE<uint8_t>(sat.cno, out);
+        appendLE<int8_t>(sat.elevation, out);
+        appendLE<int16_t>(sat.azimuth, out);
+        appendLE<uint8_t>((sat.usedInFix ? 0x01 : 0) |
+            (sat.healthy ? 0x02 : 0), out);
+        appendLE<uint8_t>(0, out);
+    }
+}
+
+StreamServer::Inbox::~Inbox()
+{
+    if (wakeFd >= 0)
+        close(wakeFd);
+}
+
+void StreamServer::Inbox::post(const EStream stream, Buffer bytes)
+{
+    {
+        std::lock_guard lock(mutex);
+        messages.push_back({ stream, std::move(bytes) });
+    }
+    const uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+        perror("[StreamServer] eventfd write failed");
+}
+
+void StreamServer::Inbox::collectUbx(std::span<const uint8_t> frame)
+{
+    std::lock_guard lock(ubxMutex);
+    if (!ubxBatch.empty() && ubxBatch.size() + frame.size() > ubxBatchBytes)
+    {
+        post(EStream::Ubx,
+            std::make_shared<const std::vector<uint8_t>>(
+                std::exchange(ubxBatch, {})));
+    }
+    ubxBatch.insert(ubxBatch.end(), frame.begin(), frame.end());
+}
+
+void StreamServer::Inbox::flushUbx()
+{
+    std::lock_guard lock(ubxMutex);
+    if (ubxBatch.empty())
+        return;
+
+    const auto size = ubxBatch.size();
+    post(EStream::Ubx,
+        std::make_shared<const std::vector<uint8_t>>(
+            std::exchange(ubxBatch, {})));
+    ubxBatch.reserve(size);
+}
+
+StreamServer::StreamServer(Gnss& gnss, UbxDispatcher& dispatcher,
+    StreamServerConfig config)
+:   gnss_(gnss),
+    dispatcher_(dispatcher),
+    config_(std::move(config)),
+    tcpFd_(-1),
+    unixFd_(-1),
+    epollFd_(-1),
+    inbox_(std::make_shared<Inbox>()),
+    stats_{}
+{
+    inbox_->ubxBatchBytes =
+        std::min(maxUbxBatchBytes, config_.clientQueueBytes / 4);
+}
+
+StreamServer::~StreamServer()
+{
+    server_.request_stop();
+    producer_.request_stop();
+    if (subscription_)
+        subscription_->unsubscribe();
+    if (server_.joinable())
+        server_.join();
+    if (producer_.joinable())
+        producer_.join();
+
+    if (ubxSubscription_)
+        dispatcher_.unsubscribe(*ubxSubscription_);
+
+    for (const auto& [fd, client] : clients_)
+        close(fd);
+    if (tcpFd_ >= 0)
+        close(tcpFd_);
+    if (unixFd_ >= 0)
+    {
+        close(unixFd_);
+        unlink(config_.unixPath.c_str());
+    }
+    if (epollFd_ >= 0)
+        close(epollFd_);
+}
+
+bool StreamServer::start()
+{
+    if (server_.joinable())
+        return true;
+
+    if (config_.tcpPort == 0 && config_.unixPath.empty())
+    {
+        fprintf(stderr,
+            "[StreamServer] Neither a TCP port nor a Unix path given\r\n");
+        return false;
+    }
+
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    inbox_->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || inbox_->wakeFd < 0)
+    {
+        fprintf(stderr, "[StreamServer] epoll/eventfd setup failed: %s\r\n",
+            strerror(errno));
+        return false;
+    }
+
+    if (!watch(inbox_->wakeFd, EPOLLIN, true))
+        return false;
+    if (config_.tcpPort != 0 && !listenTcp())
+        return false;
+    if (!config_.unixPath.empty() && !listenUnix())
+        return false;
+
+    subscription_ = gnss_.subscribe(8, EOverflowPolicy::DropOldest);
+    producer_ = std::jthread([this](std::stop_token stoken) {
+        produce(stoken);
+    });
+    server_ = std::jthread([this](std::stop_token stoken) {
+        serve(stoken);
+    });
+    return true;
+}
+
+StreamServerStats StreamServer::stats() const
+{
+    return statsSnapshot_.read();
+}
+
+bool StreamServer::listenTcp()
+{
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.tcpPort);
+    if (inet_pton(AF_INET, config_.tcpAddress.c_str(),
+        &address.sin_addr) != 1)
+    {
+        fprintf(stderr, "[StreamServer] Invalid TCP address %s\r\n",
+            config_.tcpAddress.c_str());
+        return false;
+    }
+
+    tcpFd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    const int reuse = 1;
+    if (tcpFd_ < 0 ||
+        setsockopt(tcpFd_, SOL_SOCKET, SO_REUSEADDR, &reuse,
+            sizeof(reuse)) < 0 ||
+        bind(tcpFd_, reinterpret_cast<const sockaddr*>(&address),
+            sizeof(address)) < 0 ||
+        listen(tcpFd_, listenBacklog) < 0)
+    {
+        fprintf(stderr, "[StreamServer] Cannot listen on %s:%u: %s\r\n",
+            config_.tcpAddress.c_str(), config_.tcpPort, strerror(errno));
+        return false;
+    }
+
+    printf("[StreamServer] Listening on %s:%u\r\n",
+        config_.tcpAddress.c_str(), config_.tcpPort);
+    return watch(tcpFd_, EPOLLIN, true);
+}
+
+bool StreamServer::listenUnix()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (config_.unixPath.size() >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "[StreamServer] Unix socket path too long: %s\r\n",
+            config_.unixPath.c_str());
+        return false;
+    }
+    std::memcpy(address.sun_path, config_.unixPath.c_str(),
+        config_.unixPath.size());
+
+    // A socket file left behind by a previous run refuses the bind
+    unlink(config_.unixPath.c_str());
+    unixFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (unixFd_ < 0 ||
+        bind(unixFd_, reinterpret_cast<const sockaddr*>(&address),
+            sizeof(address)) < 0 ||
+        listen(unixFd_, listenBacklog) < 0)
+    {
+        fprintf(stderr, "[StreamServer] Cannot listen on %s: %s\r\n",
+            config_.unixPath.c_str(), strerror(errno));
+        if (unixFd_ >= 0)
+        {
+            close(unixFd_);
+            unixFd_ = -1;
+        }
+        return false;
+    }
+
+    printf("[StreamServer] Listening on %s\r\n", config_.unixPath.c_str());
+    return watch(unixFd_, EPOLLIN, true);
+}
+
+bool StreamServer::watch(const int fd, const uint32_t events, const bool add)
+{
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd_, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd,
+        &event) < 0)
+    {
+        perror("[StreamServer] epoll_ctl failed");
+        return false;
+    }
+    return true;
+}
+
+void StreamServer::produce(std::stop_token stoken)
+{
+    std::array<char, 4096> text;
+    NmeaFormatter formatter(text);
+    NavigationEpoch epoch;
+    while (subscription_->pop(epoch, stoken))
+    {
+        inbox_->flushUbx();
+
+        const auto wanted = inbox_->wanted.load(std::memory_order_relaxed);
+        if (wanted & EStream::Nmea)
+        {
+            formatter.clear();
+            formatter.epoch(epoch, config_.nmea);
+            const auto sentences = formatter.sentences();
+            if (!sentences.empty())
+            {
+                inbox_->post(EStream::Nmea,
+                    std::make_shared<const std::vector<uint8_t>>(
+                        sentences.begin(), sentences.end()));
+            }
+        }
+
+        if (wanted & EStream::Epoch)
+        {
+            auto record = std::make_shared<std::vector<uint8_t>>();
+            encodeEpoch(epoch, *record);
+            inbox_->post(EStream::Epoch, std::move(record));
+        }
+    }
+}
+
+void StreamServer::serve(std::stop_token stoken)
+{
+    std::stop_callback wakeOnStop(stoken, [this] {
+        const uint64_t one = 1;
+        [[maybe_unused]] const auto written =
+            write(inbox_->wakeFd, &one, sizeof(one));
+    });
+
+    std::array<epoll_event, maxEvents> events;
+    publishStats();
+    while (!stoken.stop_requested())
+    {
+        const int ready = epoll_wait(epollFd_, events.data(), maxEvents, -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("[StreamServer] epoll_wait failed");
+            break;
+        }
+
+        bool inbox = false;
+        for (int i = 0; i < ready; i++)
+        {
+            const int fd = events[i].data.fd;
+            const auto revents = events[i].events;
+            if (fd == inbox_->wakeFd)
+            {
+                uint64_t count;
+                [[maybe_unused]] const auto drained =
+                    read(fd, &count, sizeof(count));
+                inbox = true;
+                continue;
+            }
+            if (fd == tcpFd_ || fd == unixFd_)
+            {
+                accept(fd);
+                continue;
+            }
+
+            const auto client = clients_.find(fd);
+            if (client == clients_.end())
+                continue;
+
+            const bool keep = !(revents & (EPOLLERR | EPOLLHUP)) &&
+                (!(revents & EPOLLIN) || receive(client->second, fd)) &&
+                (!(revents & EPOLLOUT) || flush(client->second, fd));
+            if (!keep)
+                disconnect(fd);
+        }
+
+        if (inbox)
+            dispatchInbox();
+        publishStats();
+    }
+}
+
+void StreamServer::accept(const int listenFd)
+{
+    while (true)
+    {
+        const int fd = accept4(listenFd, nullptr, nullptr,
+            SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                perror("[StreamServer] accept failed");
+            return;
+        }
+
+        if (clients_.size() >= config_.maxClients)
+        {
+            close(fd);
+            stats_.rejected++;
+            continue;
+        }
+
+        if (listenFd == tcpFd_)
+        {
+            const int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay,
+                sizeof(noDelay));
+        }
+
+        if (!watch(fd, EPOLLIN, true))
+        {
+            close(fd);
+            continue;
+        }
+        clients_.emplace(fd, Client{});
+        stats_.accepted++;
+        updateWantedStreams();
+    }
+}
+
+bool StreamServer::receive(Client& client, const int fd)
+{
+    std::array<char, maxCommandLine> buffer;
+    while (true)
+    {
+        const ssize_t received = recv(fd, buffer.data(), buffer.size(),
+            MSG_DONTWAIT);
+        if (received == 0)
+            return false;
+        if (received < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        client.input.append(buffer.data(), received);
+        std::size_t newline;
+        while ((newline = client.input.find('\n')) != std::string::npos)
+        {
+            command(client, std::string_view(client.input).substr(0,
+                newline));
+            client.input.erase(0, newline + 1);
+        }
+        if (client.input.size() > maxCommandLine)
+            return false;
+    }
+}
+
+void StreamServer::command(Client& client, std::string_view line)
+{
+    const auto streams = streamsFromCommand(line);
+    if (streams == 0)
+        return;
+
+    client.streams = streams;
+    updateWantedStreams();
+}
+
+void StreamServer::dispatchInbox()
+{
+    {
+        std::lock_guard lock(inbox_->mutex);
+        delivering_.swap(inbox_->messages);
+    }
+
+    std::vector<int> evicted;
+    for (const auto& message : delivering_)
+    {
+        stats_.messages++;
+        for (auto& [fd, client] : clients_)
+        {
+            if (!(client.streams & message.stream))
+                continue;
+            if (!enqueue(client, message.bytes) &&
+                std::find(evicted.begin(), evicted.end(), fd) ==
+                    evicted.end())
+            {
+                evicted.push_back(fd);
+            }
+        }
+    }
+    delivering_.clear();
+
+    for (auto& [fd, client] : clients_)
+    {
+        const bool isEvicted =
+            std::find(evicted.begin(), evicted.end(), fd) != evicted.end();
+        if (!isEvicted && !client.waitingForOut && !flush(client, fd))
+            evicted.push_back(fd);
+    }
+
+    for (const int fd : evicted)
+    {
+        stats_.evicted++;
+        disconnect(fd);
+    }
+}
+
+bool StreamServer::enqueue(Client& client, const Buffer& bytes)
+{
+    if (client.queuedBytes + bytes->size() > config_.clientQueueBytes)
+        return false;
+
+    client.queue.push_back({ bytes, 0 });
+    client.queuedBytes += bytes->size();
+    return true;
+}
+
+bool StreamServer::flush(Client& client, const int fd)
+{
+    while (!client.queue.empty())
+    {
+        std::array<iovec, maxIovecs> iov;
+        std::size_t count = 0;
+        for (const auto& pending : client.queue)
+        {
+            if (count == iov.size())
+                break;
+            iov[count].iov_base = const_cast<uint8_t*>(
+                pending.bytes->data() + pending.offset);
+            iov[count].iov_len = pending.bytes->size() - pending.offset;
+            count++;
+        }
+
+        msghdr message{};
+        message.msg_iov = iov.data();
+        message.msg_iovlen = count;
+        // MSG_NOSIGNAL: a client gone mid-write is an error, not SIGPIPE
+        const ssize_t sent = sendmsg(fd, &message,
+            MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                return false;
+
+            // Socket buffer full: EPOLLOUT says when it has room again
+            if (!client.waitingForOut)
+            {
+                client.waitingForOut = true;
+                return watch(fd, EPOLLIN | EPOLLOUT, false);
+            }
+            return true;
+        }
+
+        stats_.bytesSent += sent;
+        client.queuedBytes -= sent;
+        auto remaining = static_cast<std::size_t>(sent);
+        while (remaining > 0)
+        {
+            auto& front = client.queue.front();
+            const auto left = front.bytes->size() - front.offset;
+            if (remaining < left)
+            {
+                front.offset += remaining;
+                break;
+            }
+            remaining -= left;
+            client.queue.pop_front();
+        }
+    }
+
+    if (client.waitingForOut)
+    {
+        client.waitingForOut = false;
+        return watch(fd, EPOLLIN, false);
+    }
+    return true;
+}
+
+void StreamServer::disconnect(const int fd)
+{
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    clients_.erase(fd);
+    updateWantedStreams();
+}
+
+void StreamServer::updateWantedStreams()
+{
+    uint8_t wanted = 0;
+    for (const auto& [fd, client] : clients_)
+        wanted |= client.streams;
+    inbox_->wanted.store(wanted, std::memory_order_relaxed);
+
+    // The dispatcher copies every frame while anyone is subscribed raw,
+    // so stay subscribed only while a client reads UBX
+    if ((wanted & EStream::Ubx) && !ubxSubscription_)
+    {
+        ubxSubscription_ = dispatcher_.subscribeRaw(
+            [inbox = inbox_](std::span<const uint8_t> frame) {
+                if (inbox->wanted.load(std::memory_order_relaxed) &
+                    EStream::Ubx)
+                {
+                    inbox->collectUbx(frame);
+                }
+            });
+    }
+    else if (!(wanted & EStream::Ubx) && ubxSubscription_)
+    {
+        dispatcher_.unsubscribe(*ubxSubscription_);
+        ubxSubscription_.reset();
+    }
+}
+
+void StreamServer::publishStats()
+{
+    stats_.clients = static_cast<uint32_t>(clients_.size());
+    statsSnapshot_.publish(stats_);
+}
+
+}  // JimmyPaputto
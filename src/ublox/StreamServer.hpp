@@ -0,0 +1,173 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_STREAM_SERVER_HPP_
+#define JIMMY_PAPUTTO_STREAM_SERVER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Gnss.hpp"
+#include "StreamServerConfig.hpp"
+#include "UbxDispatcher.hpp"
+#include "common/SnapshotBuffer.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Serves receiver output to any number of local TCP and Unix socket
+// clients, so one receiver can feed several consumers without gpsd in
+// between.
+//
+// A client gets NMEA until it sends a line naming the streams it wants,
+// any of "NMEA", "UBX" and "EPOCH" separated by spaces; "UBX" is every
+// checksum-verified frame as received, "EPOCH" one binary record per
+// navigation epoch (see encodeEpoch()). Each message is formatted once
+// and shared by every client that asked for it; UBX frames are gathered
+// and sent as one message per navigation epoch.
+//
+// All socket I/O runs on one epoll thread with non-blocking writes. Every
+// client has its own send queue bounded by clientQueueBytes; a client
+// that lets it overflow is disconnected rather than slowing the others.
+class StreamServer
+{
+public:
+    enum EStream : uint8_t
+    {
+        Nmea  = 0x01,
+        Ubx   = 0x02,
+        Epoch = 0x04
+    };
+
+    // Little-endian record, 92 bytes plus 8 per satellite:
+    //   0 "JPE1"             4 u16 record size     6 u8 flags  7 u8 fixType
+    //   8 u64 sequence      16 u32 iTOW
+    //  20 i32 lat [1e-7 deg] 24 i32 lon [1e-7 deg]
+    //  28 i32 altitudeMSL [mm]  32 i32 altitude [mm]
+    //  36 u32 hAcc [mm]     40 u32 vAcc [mm]
+    //  44 i32 speed [mm/s]  48 i32 heading [1e-5 deg]
+    //  52 u16 pDOP, hDOP, vDOP [0.01]      58 u8 fixQuality  59 u8 numSV
+    //  60 u16 year  62 u8 month, day, hour, min, sec  67 reserved
+    //  68 i32 nano [ns]
+    //  72 i64 timepulse CLOCK_REALTIME [ns], 0 without a pulse
+    //  80 i64 published CLOCK_MONOTONIC [ns]
+    //  88 u8 satellites     89 reserved[3]
+    //  92 per satellite: u8 gnssId, svId, cno, i8 elevation,
+    //     i16 azimuth, u8 flags (bit 0 used in fix, bit 1 healthy), reserved
+    // flags: bit 0 epoch complete, bit 1 UTC time valid, bit 2 date valid
+    static void encodeEpoch(const NavigationEpoch& epoch,
+        std::vector<uint8_t>& out);
+
+    StreamServer(Gnss& gnss, UbxDispatcher& dispatcher,
+        StreamServerConfig config);
+    ~StreamServer();
+
+    StreamServer(const StreamServer&) = delete;
+    StreamServer& operator=(const StreamServer&) = delete;
+
+    bool start();
+    StreamServerStats stats() const;
+
+private:
+    using Buffer = std::shared_ptr<const std::vector<uint8_t>>;
+
+    struct Message
+    {
+        EStream stream;
+        Buffer bytes;
+    };
+
+    struct Pending
+    {
+        Buffer bytes;
+        std::size_t offset;
+    };
+
+    // Shared with the UBX callback, which the dispatcher may still run
+    // once after it was unsubscribed
+    struct Inbox
+    {
+        ~Inbox();
+        void post(EStream stream, Buffer bytes);
+        // Dispatcher worker: adds a frame to the current UBX batch
+        void collectUbx(std::span<const uint8_t> frame);
+        // Producer, once per epoch: posts the batch with one wakeup
+        void flushUbx();
+
+        std::mutex mutex;
+        std::vector<Message> messages;
+        int wakeFd = -1;
+        // Locked before mutex; posting under it keeps batches in order
+        std::mutex ubxMutex;
+        std::vector<uint8_t> ubxBatch;
+        std::size_t ubxBatchBytes = 0;
+        // Union of what connected clients asked for; nobody formats or
+        // copies a stream no client reads
+        std::atomic<uint8_t> wanted = 0;
+    };
+
+    struct Client
+    {
+        uint8_t streams = EStream::Nmea;
+        std::deque<Pending> queue;
+        std::size_t queuedBytes = 0;
+        bool waitingForOut = false;
+        std::string input;
+    };
+
+    bool listenTcp();
+    bool listenUnix();
+    bool watch(int fd, uint32_t events, bool add);
+
+    // Producer thread: epochs in, shared NMEA bursts and records out
+    void produce(std::stop_token stoken);
+
+    // Epoll thread
+    void serve(std::stop_token stoken);
+    void accept(int listenFd);
+    bool receive(Client& client, int fd);
+    void command(Client& client, std::string_view line);
+    void dispatchInbox();
+    bool enqueue(Client& client, const Buffer& bytes);
+    bool flush(Client& client, int fd);
+    void disconnect(int fd);
+    void updateWantedStreams();
+    void publishStats();
+
+    Gnss& gnss_;
+    UbxDispatcher& dispatcher_;
+    const StreamServerConfig config_;
+
+    int tcpFd_;
+    int unixFd_;
+    int epollFd_;
+
+    std::shared_ptr<Inbox> inbox_;
+    std::shared_ptr<NavigationSubscription> subscription_;
+    std::optional<UbxSubscriptionId> ubxSubscription_;
+
+    std::unordered_map<int, Client> clients_;
+    std::vector<Message> delivering_;
+    StreamServerStats stats_;
+    SnapshotBuffer<StreamServerStats> statsSnapshot_;
+
+    std::jthread producer_;
+    std::jthread server_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_STREAM_SERVER_HPP_
@@ -0,0 +1,42 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef STREAM_SERVER_CONFIG_HPP_
+#define STREAM_SERVER_CONFIG_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "NmeaOutputConfig.hpp"
+
+
+namespace JimmyPaputto
+{
+
+struct StreamServerConfig
+{
+    uint16_t tcpPort = 0;                   // 0 leaves TCP off
+    // Loopback by default, the streams carry no authentication
+    std::string tcpAddress = "127.0.0.1";
+    std::string unixPath;                   // empty leaves the socket off
+    std::size_t maxClients = 16;
+    // A client with this much unsent data is evicted, not waited for
+    std::size_t clientQueueBytes = 256 * 1024;
+    NmeaOutputConfig nmea;
+};
+
+struct StreamServerStats
+{
+    uint32_t clients = 0;    // connected now
+    uint64_t accepted = 0;
+    uint64_t rejected = 0;   // refused over maxClients
+    uint64_t evicted = 0;    // send queue overflowed
+    uint64_t messages = 0;   // NMEA bursts, UBX batches and epoch records
+    uint64_t bytesSent = 0;
+};
+
+}  // JimmyPaputto
+
+#endif  // STREAM_SERVER_CONFIG_HPP_
@@ -10,6 +10,7 @@
 
 #include "common/GpioInterruptLine.hpp"
 #include "common/Notifier.hpp"
+#include "ublox/Gnss.hpp"
 
 
 #define TIMEPULSE_PIN 5
@@ -20,8 +21,9 @@ namespace JimmyPaputto
 class Timepulse
 {
 public:
-    explicit Timepulse(Notifier& notifier)
+    Timepulse(Notifier& notifier, Gnss& gnss)
     :   notifier_(notifier),
+        gnss_(gnss),
         gpioLine_(TIMEPULSE_PIN,
             GpioInterruptLine::Edge::Rising, "ublox_timepulse")
     {
@@ -49,6 +51,8 @@ private:
             auto event = gpioLine_.waitEvent(0);
             if (event == GpioInterruptLine::EventType::Rising)
             {
+                // Published first, timepulse() returns it once woken
+                gnss_.timepulseEdge(gpioLine_.lastEdge());
                 notifier_.notify();
             }
             else if (event == GpioInterruptLine::EventType::Error)
@@ -59,6 +63,7 @@ private:
     }
 
     Notifier& notifier_;
+    Gnss& gnss_;
     GpioInterruptLine gpioLine_;
     std::jthread interruptHandler_;
 };
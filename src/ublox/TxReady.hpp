@@ -11,6 +11,7 @@
 
 #include "common/GpioInterruptLine.hpp"
 #include "common/Notifier.hpp"
+#include "ublox/Gnss.hpp"
 
 #define TX_READY_PIN 17
 
@@ -20,8 +21,10 @@ namespace JimmyPaputto
 class TxReadyInterrupt
 {
 public:
-    explicit TxReadyInterrupt(Notifier& notifier, const uint8_t navigationFrequency)
+    TxReadyInterrupt(Notifier& notifier, Gnss& gnss,
+        const uint8_t navigationFrequency)
     :   notifier_(notifier),
+        gnss_(gnss),
         gpioLine_(TX_READY_PIN,
             GpioInterruptLine::Edge::Both, "ublox_txready"),
         timeoutNs_(navigationFrequency > 0
@@ -62,6 +65,7 @@ private:
 
             if (event == GpioInterruptLine::EventType::Rising)
             {
+                gnss_.txReadyEdge(gpioLine_.lastEdge());
                 notifier_.notify();
             }
             else if (event == GpioInterruptLine::EventType::Falling)
@@ -76,6 +80,7 @@ private:
     }
 
     Notifier& notifier_;
+    Gnss& gnss_;
     GpioInterruptLine gpioLine_;
     int64_t timeoutNs_;
     std::jthread interruptHandler_;
@@ -0,0 +1,139 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "ublox/UartBaudEscalation.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+#include "ublox/UbxScanner.hpp"
+#include "ublox/ubxmsg/UBX_MON_VER.hpp"
+
+
+namespace JimmyPaputto
+{
+
+namespace
+{
+
+// Room for the whole burst of replies plus whatever else the receiver
+// sends meanwhile
+constexpr uint32_t selfTestBuffSize = 8192;
+
+}  // namespace
+
+bool UartLinkTest::passed() const
+{
+    return checksumFailures == 0 &&
+        replies == UartBaudEscalation::pollsPerTest;
+}
+
+UartBaudEscalation::UartBaudEscalation(UartDriver& uartDriver,
+    SetBaudrate setBaudrate)
+:   uartDriver_(uartDriver),
+    setBaudrate_(std::move(setBaudrate)),
+    rxBuff_(selfTestBuffSize)
+{
+}
+
+UartEscalationResult UartBaudEscalation::run(const uint32_t maxBaudrate)
+{
+    UartEscalationResult result{ uartDriver_.currentBaudrate(), {}, false };
+
+    for (const auto baudrate : baudSteps(result.baudrate, maxBaudrate))
+    {
+        if (switchTo(baudrate))
+        {
+            result.steps.push_back(selfTest());
+            if (result.steps.back().passed())
+            {
+                result.baudrate = baudrate;
+                continue;
+            }
+        }
+
+        fprintf(stderr,
+            "[UartEscalation] Link unstable at %u baud, back to %u\r\n",
+            baudrate, result.baudrate);
+        result.linkLost = !switchTo(result.baudrate) ||
+            !selfTest().passed();
+        break;
+    }
+    return result;
+}
+
+UartLinkTest UartBaudEscalation::selfTest()
+{
+    UartLinkTest test{ uartDriver_.currentBaudrate(), 0, 0, {}, 0.0 };
+
+    const auto pollFrame = ubxmsg::UBX_MON_VER::poll();
+    const std::vector<std::span<const uint8_t>> polls(pollsPerTest,
+        pollFrame);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + replyTimeout;
+    auto lastByte = start;
+    std::size_t received = 0;
+    uartDriver_.transmitv(polls);
+
+    UbxScanner scanner;
+    while (test.replies < pollsPerTest && received < rxBuff_.size())
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+            break;
+
+        const auto bytesRead = uartDriver_.epoll(rxBuff_.data() + received,
+            rxBuff_.size() - received,
+            static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - now).count()));
+        if (bytesRead <= 0)
+            continue;
+
+        received += bytesRead;
+        lastByte = std::chrono::steady_clock::now();
+
+        scanner = UbxScanner();
+        const auto replies = static_cast<uint32_t>(scanner.count(
+            std::span<const uint8_t>(rxBuff_.data(), received), 0x0A, 0x04));
+        if (test.replies == 0 && replies > 0)
+        {
+            test.roundTrip = std::chrono::duration_cast<
+                std::chrono::microseconds>(lastByte - start);
+        }
+        test.replies = replies;
+    }
+
+    test.checksumFailures =
+        static_cast<uint32_t>(scanner.stats().checksumFailures);
+    const std::chrono::duration<double> elapsed = lastByte - start;
+    test.throughput_Bps = elapsed.count() > 0
+        ? received / elapsed.count()
+        : 0.0;
+    return test;
+}
+
+std::vector<uint32_t> UartBaudEscalation::baudSteps(const uint32_t from,
+    const uint32_t maxBaudrate)
+{
+    std::vector<uint32_t> steps;
+    std::copy_if(UartDriver::highSpeedBaudrates.begin(),
+        UartDriver::highSpeedBaudrates.end(), std::back_inserter(steps),
+        [from, maxBaudrate](const uint32_t baudrate) {
+            return baudrate > from && baudrate <= maxBaudrate;
+        });
+    return steps;
+}
+
+bool UartBaudEscalation::switchTo(const uint32_t baudrate)
+{
+    if (!setBaudrate_(baudrate))
+        return false;
+
+    uartDriver_.reinit(baudrate);
+    return uartDriver_.isOpen();
+}
+
+}  // JimmyPaputto
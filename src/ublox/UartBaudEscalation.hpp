@@ -0,0 +1,72 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_UART_BAUD_ESCALATION_HPP_
+#define JIMMY_PAPUTTO_UART_BAUD_ESCALATION_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "ublox/UartDriver.hpp"
+
+
+namespace JimmyPaputto
+{
+
+struct UartLinkTest
+{
+    uint32_t baudrate;
+    uint32_t replies;           // MON-VER replies that came back intact
+    uint32_t checksumFailures;
+    std::chrono::microseconds roundTrip;  // until the first reply
+    double throughput_Bps;      // reply bytes over the whole burst
+
+    bool passed() const;
+};
+
+struct UartEscalationResult
+{
+    uint32_t baudrate;
+    std::vector<UartLinkTest> steps;
+    // Neither the failed rate nor the one before it answers any more
+    bool linkLost;
+};
+
+// Raises the receiver UART through UartDriver::highSpeedBaudrates up to a
+// limit. At each rate the receiver is switched first, then the host, and a
+// burst of UBX-MON-VER polls has to come back complete and intact; the
+// first rate that fails sends both sides back to the last good one.
+//
+// How the receiver is told to switch is up to the caller: over the very
+// same UART (F10T) the VALSET has to go out at the old rate, over SPI it
+// can be acknowledged.
+class UartBaudEscalation final
+{
+public:
+    using SetBaudrate = std::function<bool(uint32_t baudrate)>;
+
+    UartBaudEscalation(UartDriver& uartDriver, SetBaudrate setBaudrate);
+
+    UartEscalationResult run(const uint32_t maxBaudrate);
+    UartLinkTest selfTest();
+
+    static std::vector<uint32_t> baudSteps(const uint32_t from,
+        const uint32_t maxBaudrate);
+
+    static constexpr uint32_t pollsPerTest = 8;
+    static constexpr auto replyTimeout = std::chrono::milliseconds(500);
+
+private:
+    bool switchTo(const uint32_t baudrate);
+
+    UartDriver& uartDriver_;
+    SetBaudrate setBaudrate_;
+    std::vector<uint8_t> rxBuff_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_UART_BAUD_ESCALATION_HPP_
@@ -4,6 +4,8 @@
 
 #include "ublox/UartDriver.hpp"
 
+#include <algorithm>
+#include <climits>
 #include <cstring>
 
 #include <fcntl.h>
@@ -16,11 +18,13 @@
 namespace JimmyPaputto
 {
 
-UartDriver::UartDriver()
+UartDriver::UartDriver(const char* device)
 :   baudrate_(expectedBaudrate),
     uartFd_(-1),
-    uartDevice_(UBX_UART_DEV),
-    epollFd_(-1)
+    uartDevice_(device),
+    epollFd_(-1),
+    txEpollFd_(-1),
+    rxPending_(false)
 {
     init(baudrate_);
     initEpoll();
@@ -128,6 +132,9 @@ void UartDriver::init(const uint32_t baudrate)
         case 38400U:  speed = B38400;  break;
         case 57600U:  speed = B57600;  break;
         case 115200U: speed = B115200; break;
+        case 230400U: speed = B230400; break;
+        case 460800U: speed = B460800; break;
+        case 921600U: speed = B921600; break;
         default:
             printf("[UART] Error: Unsupported baud rate: %u\n", baudrate);
             close(uartFd_);
@@ -186,29 +193,108 @@ void UartDriver::deinit() const
 
 void UartDriver::transmit(std::span<const uint8_t> txBuff)
 {
-    if (uartFd_ < 0)
-    {
-        printf("[UART] Error: UART not initialized\r\n");
-        return;
-    }
-
     if (txBuff.empty())
     {
         return;
     }
 
-    const ssize_t written = write(uartFd_, txBuff.data(), txBuff.size());
-    if (written != static_cast<ssize_t>(txBuff.size()))
+    const std::span<const uint8_t> buffers[] = { txBuff };
+    const auto result = transmitv(buffers);
+    if (!result.complete)
     {
         printf(
             "[UART] Error: Failed to write all data, expected: %zu, "
-            "written: %ld\n",
+            "written: %zu\n",
             txBuff.size(),
-            written
+            result.bytesWritten
         );
     }
 }
 
+void UartDriver::drain() const
+{
+    if (uartFd_ >= 0)
+        tcdrain(uartFd_);
+}
+
+UartWriteResult UartDriver::transmitv(
+    std::span<const std::span<const uint8_t>> buffers, int timeoutMs)
+{
+    UartWriteResult result;
+    if (uartFd_ < 0)
+    {
+        printf("[UART] Error: UART not initialized\r\n");
+        return result;
+    }
+
+    iov_.clear();
+    std::size_t total = 0;
+    for (const auto& buffer : buffers)
+    {
+        if (!buffer.empty())
+            iov_.push_back({ const_cast<uint8_t*>(buffer.data()),
+                buffer.size() });
+        total += buffer.size();
+    }
+
+    std::size_t first = 0;
+    while (first < iov_.size())
+    {
+        const auto count = std::min<std::size_t>(iov_.size() - first, IOV_MAX);
+        const ssize_t written = writev(uartFd_, iov_.data() + first, count);
+        result.writeCalls++;
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                perror("[UART] writev failed");
+                break;
+            }
+
+            result.stalls++;
+            if (!waitWritable(timeoutMs))
+            {
+                fprintf(stderr,
+                    "[UART] Line did not drain within %d ms, %zu bytes "
+                    "not written\r\n",
+                    timeoutMs, total - result.bytesWritten);
+                break;
+            }
+            continue;
+        }
+
+        result.bytesWritten += written;
+        // Drop whatever went out, a partial write leaves the tail of one
+        // iovec for the next call
+        auto left = static_cast<std::size_t>(written);
+        while (first < iov_.size() && left >= iov_[first].iov_len)
+        {
+            left -= iov_[first].iov_len;
+            first++;
+        }
+        if (left > 0)
+        {
+            iov_[first].iov_base = static_cast<uint8_t*>(
+                iov_[first].iov_base) + left;
+            iov_[first].iov_len -= left;
+        }
+    }
+
+    result.complete = first == iov_.size();
+    // Buffers that went out whole; the first one short of that was cut
+    auto left = result.bytesWritten;
+    for (const auto& buffer : buffers)
+    {
+        if (buffer.size() > left)
+            break;
+        left -= buffer.size();
+        result.buffersWritten++;
+    }
+    return result;
+}
+
 void UartDriver::initEpoll()
 {
     if (uartFd_ < 0)
@@ -224,8 +310,9 @@ void UartDriver::initEpoll()
         return;
     }
 
+    rxPending_ = false;
     struct epoll_event event;
-    event.events = EPOLLIN;
+    event.events = EPOLLIN | EPOLLET;
     event.data.fd = uartFd_;
     
     if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, uartFd_, &event) < 0)
@@ -235,6 +322,24 @@ void UartDriver::initEpoll()
         epollFd_ = -1;
         return;
     }
+
+    // Separate instance, so waiting for room to write never consumes a
+    // read-ready event the run loop is waiting for
+    txEpollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (txEpollFd_ < 0)
+    {
+        perror("[UART] Failed to create TX epoll instance");
+        return;
+    }
+
+    event.events = EPOLLOUT;
+    event.data.fd = uartFd_;
+    if (epoll_ctl(txEpollFd_, EPOLL_CTL_ADD, uartFd_, &event) < 0)
+    {
+        perror("[UART] Failed to add UART fd to TX epoll");
+        close(txEpollFd_);
+        txEpollFd_ = -1;
+    }
 }
 
 void UartDriver::deinitEpoll()
@@ -244,6 +349,28 @@ void UartDriver::deinitEpoll()
         close(epollFd_);
         epollFd_ = -1;
     }
+    if (txEpollFd_ >= 0)
+    {
+        close(txEpollFd_);
+        txEpollFd_ = -1;
+    }
+}
+
+bool UartDriver::waitWritable(int timeoutMs) const
+{
+    if (txEpollFd_ < 0)
+        return false;
+
+    struct epoll_event event;
+    while (true)
+    {
+        const int numEvents = epoll_wait(txEpollFd_, &event, 1, timeoutMs);
+        if (numEvents < 0 && errno == EINTR)
+            continue;
+        if (numEvents < 0)
+            perror("[UART] epoll_wait for EPOLLOUT failed");
+        return numEvents > 0;
+    }
 }
 
 int UartDriver::epoll(uint8_t* rxBuff, const uint32_t size, int timeoutMs)
@@ -254,47 +381,53 @@ int UartDriver::epoll(uint8_t* rxBuff, const uint32_t size, int timeoutMs)
         return -1;
     }
 
-    constexpr int maxEvents = 12;
-    struct epoll_event events[maxEvents];
-    const int numEvents = epoll_wait(epollFd_, events, maxEvents, timeoutMs);
-
-    if (numEvents < 0)
+    if (!rxPending_)
     {
-        if (errno != EINTR)
-            perror("[UART] epoll_wait failed");
-        return -1;
-    }
+        constexpr int maxEvents = 12;
+        struct epoll_event events[maxEvents];
+        const int numEvents = epoll_wait(epollFd_, events, maxEvents,
+            timeoutMs);
+
+        if (numEvents < 0)
+        {
+            if (errno != EINTR)
+                perror("[UART] epoll_wait failed");
+            return -1;
+        }
 
-    if (numEvents == 0)
-        return 0;
+        if (numEvents == 0)
+            return 0;
 
+        if (events[0].data.fd != uartFd_ || !(events[0].events & EPOLLIN))
+            return 0;
+    }
+
+    // Edge-triggered, so read until EAGAIN or the buffer is full
     ssize_t totalBytesRead = 0;
-    if (events[0].data.fd == uartFd_ && (events[0].events & EPOLLIN))
+    while (static_cast<uint32_t>(totalBytesRead) < size)
     {
-        while (static_cast<uint32_t>(totalBytesRead) < size)
-        {
-            const auto bytesRead = read(
-                uartFd_,
-                rxBuff + totalBytesRead,
-                size - totalBytesRead
-            );
-
-            if (bytesRead > 0)
-            {
-                totalBytesRead += bytesRead;
-                continue;
-            }
+        const auto bytesRead = read(
+            uartFd_,
+            rxBuff + totalBytesRead,
+            size - totalBytesRead
+        );
 
-            if (bytesRead == 0)
-                break;
+        if (bytesRead > 0)
+        {
+            totalBytesRead += bytesRead;
+            continue;
+        }
 
-            if (errno == EAGAIN || errno == EWOULDBLOCK)
-                break;
+        if (bytesRead == 0)
+            break;
 
-            perror("[UART] Read error in epoll");
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
             break;
-        }
+
+        perror("[UART] Read error in epoll");
+        break;
     }
+    rxPending_ = static_cast<uint32_t>(totalBytesRead) == size;
 
     return totalBytesRead;
 }
@@ -5,9 +5,14 @@
 #ifndef JIMMY_PAPUTTO_UART_DRIVER_HPP_
 #define JIMMY_PAPUTTO_UART_DRIVER_HPP_
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
+#include <sys/uio.h>
+
 #include "ublox/ICommDriver.hpp"
 #include "ublox/ubxmsg/UBX_CFG_PRT.hpp"
 
@@ -17,10 +22,21 @@
 namespace JimmyPaputto
 {
 
+struct UartWriteResult
+{
+    std::size_t bytesWritten = 0;
+    // Leading buffers written in full, the rest were cut or never sent
+    std::size_t buffersWritten = 0;
+    uint32_t writeCalls = 0;
+    // EAGAIN from a full TTY buffer, each one waited out on EPOLLOUT
+    uint32_t stalls = 0;
+    bool complete = false;
+};
+
 class UartDriver: public ICommDriver
 {
 public:
-    explicit UartDriver();
+    explicit UartDriver(const char* device = UBX_UART_DEV);
     ~UartDriver();
 
     void transmitReceive(std::span<const uint8_t> txBuff,
@@ -29,17 +45,32 @@ public:
 
     void reinit(const uint32_t baudrate);
     uint32_t currentBaudrate() const { return baudrate_; }
+    bool isOpen() const { return uartFd_ >= 0; }
 
     void transmit(std::span<const uint8_t> txBuff);
-    int epoll(uint8_t* rxBuff, const uint32_t size, int timeoutMs = -1);
+    // Blocks until everything written so far has left the UART
+    void drain() const;
+    // Gathers all buffers into as few writev() calls as IOV_MAX allows,
+    // carries on after partial writes and waits up to timeoutMs for the
+    // line to take more whenever the TTY buffer is full
+    UartWriteResult transmitv(
+        std::span<const std::span<const uint8_t>> buffers,
+        int timeoutMs = 1000);
+    int epoll(uint8_t* rxBuff, const uint32_t size,
+        int timeoutMs = -1) override;
 
     static constexpr uint32_t expectedBaudrate = 115200;
+    // Rates the receiver may be escalated to, ascending
+    static constexpr std::array<uint32_t, 4> highSpeedBaudrates = {
+        115200, 230400, 460800, 921600
+    };
 
 private:
     void init(const uint32_t baudrate);
     void deinit() const;
     void initEpoll();
     void deinitEpoll();
+    bool waitWritable(int timeoutMs) const;
 
     uint32_t baudrate_;
 
@@ -47,6 +78,11 @@ private:
     const char* uartDevice_;
 
     int epollFd_;
+    int txEpollFd_;
+    // Edge-triggered: the last read filled the caller's buffer before
+    // EAGAIN, so bytes are left that no new edge will announce
+    bool rxPending_;
+    std::vector<iovec> iov_;
 };
 
 }  // JimmyPaputto
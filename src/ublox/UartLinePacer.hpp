@@ -0,0 +1,75 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_UART_LINE_PACER_HPP_
+#define JIMMY_PAPUTTO_UART_LINE_PACER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+// Books written bytes against the UART line rate. The kernel TTY buffer
+// takes far more than the line sends in a second, and a correction queued
+// behind older ones there reaches the receiver stale; anything that would
+// wait longer than maxBacklog is refused instead.
+class UartLinePacer final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit UartLinePacer(uint32_t baudrate,
+        std::chrono::nanoseconds maxBacklog = std::chrono::seconds(1))
+    :   baudrate_(baudrate),
+        maxBacklog_(maxBacklog)
+    {
+    }
+
+    void setBaudrate(const uint32_t baudrate) { baudrate_ = baudrate; }
+
+    // 8N1 puts 10 bits on the wire per byte
+    std::chrono::nanoseconds lineTime(const std::size_t bytes) const
+    {
+        return std::chrono::nanoseconds(
+            bytes * bitsPerByte * 1'000'000'000ull / baudrate_);
+    }
+
+    // What is still to be shifted out of the bytes admitted so far
+    std::chrono::nanoseconds backlog(const Clock::time_point now) const
+    {
+        return lineIdleAt_ > now
+            ? std::chrono::nanoseconds(lineIdleAt_ - now)
+            : std::chrono::nanoseconds(0);
+    }
+
+    bool admit(const std::size_t bytes, const Clock::time_point now)
+    {
+        const auto backlogAfter = backlog(now) + lineTime(bytes);
+        if (backlogAfter > maxBacklog_)
+            return false;
+
+        lineIdleAt_ = now + backlogAfter;
+        return true;
+    }
+
+    // Gives back the line time of admitted bytes that were never written
+    void refund(const std::size_t bytes)
+    {
+        lineIdleAt_ -= lineTime(bytes);
+    }
+
+private:
+    static constexpr uint64_t bitsPerByte = 10;
+
+    uint32_t baudrate_;
+    std::chrono::nanoseconds maxBacklog_;
+    Clock::time_point lineIdleAt_ {};
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_UART_LINE_PACER_HPP_
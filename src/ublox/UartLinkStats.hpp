@@ -0,0 +1,41 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_UART_LINK_STATS_HPP_
+#define JIMMY_PAPUTTO_UART_LINK_STATS_HPP_
+
+#include <cstdint>
+
+
+namespace JimmyPaputto
+{
+
+// One epoch's burst from the receiver over its UART
+struct UartEpochLoad
+{
+    uint32_t bytes = 0;
+    uint32_t lineTime_us = 0;  // what the line needs for them, 8N1
+    uint32_t period_us = 0;    // from this burst to the next one
+
+    // Near 1 the line never idles between epochs and they arrive late
+    double utilization() const
+    {
+        return period_us > 0
+            ? static_cast<double>(lineTime_us) / period_us
+            : 0.0;
+    }
+};
+
+struct UartLinkStats
+{
+    uint32_t baudrate = 0;
+    uint64_t epochs = 0;
+    uint64_t bytes = 0;
+    double peakUtilization = 0.0;
+    UartEpochLoad lastEpoch;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_UART_LINK_STATS_HPP_
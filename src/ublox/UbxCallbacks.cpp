@@ -4,171 +4,136 @@
 
 #include "UbxCallbacks.hpp"
 
-#include "ublox/Gnss.hpp"
-#include "ublox/Ublox.hpp"
+#include "ublox/UbxClassMsgId.hpp"
 #include "common/Utils.hpp"
-#include "GnssHat.hpp"
-
-#include "ubxmsg/UBX_ACK_ACK.hpp"
-#include "ubxmsg/UBX_ACK_NAK.hpp"
-#include "ubxmsg/UBX_CFG_VALSET.hpp"
-#include "ubxmsg/UBX_CFG_VALGET.hpp"
-#include "ubxmsg/UBX_MON_RF.hpp"
-#include "ubxmsg/UBX_MON_SPAN.hpp"
-#include "ubxmsg/UBX_MON_SYS.hpp"
-#include "ubxmsg/UBX_MON_VER.hpp"
-#include "ubxmsg/UBX_NAV_DOP.hpp"
-#include "ubxmsg/UBX_NAV_GEOFENCE.hpp"
-#include "ubxmsg/UBX_NAV_PVT.hpp"
-#include "ubxmsg/UBX_NAV_SAT.hpp"
-#include "ubxmsg/UBX_TIM_TM2.hpp"
 
 
 namespace JimmyPaputto
 {
 
-UbxCallbacks::UbxCallbacks(IUbloxConfigRegistry& configRegistry,
+UbxCallbacks::UbxCallbacks(IUbloxConfigRegistry& configRegistry, Gnss& gnss,
     Notifier& navigationNotifier, Notifier& timeMarkNotifier,
     bool callbackNotificationEnabled)
-:	navigationNotifier_(navigationNotifier),
+:	configRegistry_(configRegistry),
+    gnss_(gnss),
+    navigationNotifier_(navigationNotifier),
     timeMarkNotifier_(timeMarkNotifier),
     callbackNotificationEnabled_(callbackNotificationEnabled)
+{
+}
+
+void UbxCallbacks::dispatch(std::span<const uint8_t> frame)
 {
     using enum EUbxMsg;
-    callbacks_[to_underlying(UBX_ACK_ACK)] = std::bind(
-        &UbxCallbacks::ackNakCb,
-        this,
-        std::placeholders::_1,
-        EUbxMsg::UBX_ACK_ACK,
-        std::ref(configRegistry)
-    );
-
-    callbacks_[to_underlying(UBX_ACK_NAK)] = std::bind(
-        &UbxCallbacks::ackNakCb,
-        this,
-        std::placeholders::_1,
-        EUbxMsg::UBX_ACK_NAK,
-        std::ref(configRegistry)
-    );
-
-    callbacks_[to_underlying(UBX_CFG_CFG)] = [](ubxmsg::IUbxMsg&) -> void {
-        // empty callback
-    };
-
-    callbacks_[to_underlying(UBX_CFG_GEOFENCE)] =
-        [](ubxmsg::IUbxMsg&) -> void {
-            // Deprecated: geofencing migrated to CFG-GEOFENCE-* via VALSET
-        };
-
-    callbacks_[to_underlying(UBX_CFG_MSG)] = [](ubxmsg::IUbxMsg&) -> void {
-        // Deprecated: message output migrated to CFG-MSGOUT-* via VALSET
-    };
-
-    callbacks_[to_underlying(UBX_CFG_NAV5)] = [](ubxmsg::IUbxMsg&) -> void {
-        // Deprecated: dynamic model migrated to CFG-NAVSPG-DYNMODEL via VALSET
-    };
-
-    callbacks_[to_underlying(UBX_CFG_PRT)] = [](ubxmsg::IUbxMsg&) -> void {
-        // Deprecated: port configuration migrated to CFG-VALSET/VALGET
-    };
-
-    callbacks_[to_underlying(UBX_CFG_RATE)] = [](ubxmsg::IUbxMsg&) -> void {
-        // Deprecated: rate configuration migrated to CFG-RATE-* via VALSET
-    };
-
-    callbacks_[to_underlying(UBX_CFG_TP5)] = [](ubxmsg::IUbxMsg&) -> void {
-        // Deprecated: timepulse configuration migrated to CFG-TP-* via VALSET
-    };
-
-    callbacks_[to_underlying(UBX_CFG_VALSET)] = [](ubxmsg::IUbxMsg&) -> void {
-        // empty callback
-    };
-
-    callbacks_[to_underlying(UBX_CFG_VALGET)] = [&configRegistry](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxCfgValget = static_cast<ubxmsg::UBX_CFG_VALGET&>(ubxMsg);
-        for (const auto& config : ubxCfgValget.configData())
-            configRegistry.storeConfigValue(config.key, config.value);
-    };
-
-    callbacks_[to_underlying(UBX_MON_RF)] = [](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxMonRf = static_cast<ubxmsg::UBX_MON_RF&>(ubxMsg);
-        Gnss::instance().rfBlocks(ubxMonRf.rfBlocks());
-    };
-
-    callbacks_[to_underlying(UBX_MON_SPAN)] = [](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxMonSpan = static_cast<ubxmsg::UBX_MON_SPAN&>(ubxMsg);
-        Gnss::instance().rfBlocksSpectrumData(ubxMonSpan.rfBlocksSpectrumData());
-    };
-
-    callbacks_[to_underlying(UBX_MON_VER)] = [](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxMonVer = static_cast<ubxmsg::UBX_MON_VER&>(ubxMsg);
-        Gnss::instance().monVer(ubxMonVer.swVersion(), ubxMonVer.hwVersion(),
-                                ubxMonVer.extensions());
-    };
-
-    callbacks_[to_underlying(UBX_MON_SYS)] = [](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxMonSys = static_cast<ubxmsg::UBX_MON_SYS&>(ubxMsg);
-        Gnss::instance().systemHealth(ubxMonSys.systemHealth());
-    };
-
-    callbacks_[to_underlying(UBX_NAV_DOP)] = [](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxNavDop = static_cast<ubxmsg::UBX_NAV_DOP&>(ubxMsg);
-        Gnss::instance().dop(ubxNavDop.dop());
-    };
-
-    callbacks_[to_underlying(UBX_NAV_GEOFENCE)] = [](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxNavGeofence =
-            static_cast<ubxmsg::UBX_NAV_GEOFENCE&>(ubxMsg);
-        Gnss::instance().geofencingNav(ubxNavGeofence.nav());
-    };
-
-    callbacks_[to_underlying(UBX_NAV_PVT)] = [this](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxNavPvt = static_cast<ubxmsg::UBX_NAV_PVT&>(ubxMsg);
-        Gnss::instance().pvt(ubxNavPvt.pvt());
-        if (callbackNotificationEnabled_)
-            navigationNotifier_.notify();
-    };
-
-    callbacks_[to_underlying(UBX_NAV_SAT)] = [](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxNavSat = static_cast<ubxmsg::UBX_NAV_SAT&>(ubxMsg);
-        Gnss::instance().satellites(ubxNavSat.satellites());
-    };
-
-    callbacks_[to_underlying(UBX_TIM_TM2)] = [this](ubxmsg::IUbxMsg& ubxMsg) -> void {
-        const auto& ubxTimTm2 = static_cast<ubxmsg::UBX_TIM_TM2&>(ubxMsg);
-        Gnss::instance().timeMark(ubxTimTm2.timeMark());
-        timeMarkNotifier_.notify();
-    };
-}
-
-void UbxCallbacks::ackNakCb(ubxmsg::IUbxMsg& ubxMsg, EUbxMsg eUbxMsg,
-    IUbloxConfigRegistry& configRegistry)
-{
-    if (eUbxMsg == EUbxMsg::UBX_ACK_ACK)
+    switch (UbxClassMsgId::lookup(frame[2], frame[3]))
+    {
+    case UBX_ACK_ACK:      return decode<ubxmsg::UBX_ACK_ACK>(frame);
+    case UBX_ACK_NAK:      return decode<ubxmsg::UBX_ACK_NAK>(frame);
+    case UBX_CFG_VALGET:   return decode<ubxmsg::UBX_CFG_VALGET>(frame);
+    case UBX_MON_RF:       return decode<ubxmsg::UBX_MON_RF>(frame);
+    case UBX_MON_SPAN:     return decode<ubxmsg::UBX_MON_SPAN>(frame);
+    case UBX_MON_SYS:      return decode<ubxmsg::UBX_MON_SYS>(frame);
+    case UBX_MON_VER:      return decode<ubxmsg::UBX_MON_VER>(frame);
+    case UBX_NAV_DOP:      return decode<ubxmsg::UBX_NAV_DOP>(frame);
+    case UBX_NAV_GEOFENCE: return decode<ubxmsg::UBX_NAV_GEOFENCE>(frame);
+    case UBX_NAV_PVT:      return decode<ubxmsg::UBX_NAV_PVT>(frame);
+    case UBX_NAV_SAT:      return decode<ubxmsg::UBX_NAV_SAT>(frame);
+    case UBX_TIM_TM2:      return decode<ubxmsg::UBX_TIM_TM2>(frame);
+    default:
+        // CFG-CFG/MSG/NAV5/PRT/RATE/TP5/GEOFENCE/VALSET replies carry
+        // nothing we keep: configuration moved to VALSET/VALGET
+        return;
+    }
+}
+
+template<typename UbxMsg>
+void UbxCallbacks::decode(std::span<const uint8_t> frame)
+{
+    auto& ubxMsg = std::get<UbxMsg>(decoders_);
+    // Qualified call binds statically, no trip through the IUbxMsg vtable
+    ubxMsg.UbxMsg::deserialize(frame);
+    on(ubxMsg);
+}
+
+void UbxCallbacks::epochClosed(const bool closed)
+{
+    if (closed && callbackNotificationEnabled_)
+        navigationNotifier_.notify();
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_ACK_ACK& ubxAckAck)
+{
+    const auto eUbxMsgFromAck =
+        UbxClassMsgId::instance().translate(ubxAckAck.classMsgId());
+    if (eUbxMsgFromAck != EUbxMsg::END_UBX)
     {
-        const auto& ackMsg = static_cast<ubxmsg::UBX_ACK_ACK&>(ubxMsg);
-        const auto eUbxMsgFromNakOrAck =
-            UbxClassMsgId::instance().translate(ackMsg.classMsgId());
-        if (eUbxMsgFromNakOrAck != EUbxMsg::END_UBX)
-        {
-            configRegistry.ack(eUbxMsgFromNakOrAck);
-        }
+        configRegistry_.ack(eUbxMsgFromAck);
     }
-    else if (eUbxMsg == EUbxMsg::UBX_ACK_NAK)
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_ACK_NAK& ubxAckNak)
+{
+    const auto eUbxMsgFromNak =
+        UbxClassMsgId::instance().translate(ubxAckNak.classMsgId());
+    if (eUbxMsgFromNak != EUbxMsg::END_UBX)
     {
-        const auto& ackMsg = static_cast<ubxmsg::UBX_ACK_NAK&>(ubxMsg);
-        const auto eUbxMsgFromNakOrAck =
-            UbxClassMsgId::instance().translate(ackMsg.classMsgId());
-        if (eUbxMsgFromNakOrAck != EUbxMsg::END_UBX)
-        {
-            configRegistry.nak(eUbxMsgFromNakOrAck);
-        }
+        configRegistry_.nak(eUbxMsgFromNak);
     }
 }
 
-void UbxCallbacks::run(ubxmsg::IUbxMsg& ubxMsg, const EUbxMsg& eUbxMsg)
+void UbxCallbacks::on(const ubxmsg::UBX_CFG_VALGET& ubxCfgValget)
+{
+    for (const auto& config : ubxCfgValget.configData())
+        configRegistry_.storeConfigValue(config.key, config.value);
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_MON_RF& ubxMonRf)
+{
+    epochClosed(gnss_.rfBlocks(ubxMonRf.rfBlocks()));
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_MON_SPAN& ubxMonSpan)
+{
+    epochClosed(gnss_.rfBlocksSpectrumData(
+        ubxMonSpan.rfBlocksSpectrumData()));
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_MON_SYS& ubxMonSys)
+{
+    gnss_.systemHealth(ubxMonSys.systemHealth());
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_MON_VER& ubxMonVer)
+{
+    gnss_.monVer(ubxMonVer.swVersion(), ubxMonVer.hwVersion(),
+                 ubxMonVer.extensions());
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_NAV_DOP& ubxNavDop)
+{
+    epochClosed(gnss_.dop(ubxNavDop.dop(), ubxNavDop.iTOW()));
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_NAV_GEOFENCE& ubxNavGeofence)
+{
+    epochClosed(gnss_.geofencingNav(ubxNavGeofence.nav()));
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_NAV_PVT& ubxNavPvt)
+{
+    epochClosed(gnss_.pvt(ubxNavPvt.pvt(), ubxNavPvt.iTOW()));
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_NAV_SAT& ubxNavSat)
+{
+    epochClosed(gnss_.satellites(ubxNavSat.satellites(),
+        ubxNavSat.iTOW()));
+}
+
+void UbxCallbacks::on(const ubxmsg::UBX_TIM_TM2& ubxTimTm2)
 {
-    callbacks_[to_underlying(eUbxMsg)](ubxMsg);
+    gnss_.timeMark(ubxTimTm2.timeMark());
+    timeMarkNotifier_.notify();
 }
 
 }  // JimmyPaputto
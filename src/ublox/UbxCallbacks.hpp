@@ -5,15 +5,27 @@
 #ifndef JP_UBX_CALLBACKS_HPP_
 #define JP_UBX_CALLBACKS_HPP_
 
-#include <array>
-#include <functional>
-#include <memory>
+#include <span>
+#include <tuple>
 
 #include "EUbxMsg.hpp"
+#include "Gnss.hpp"
 #include "IUbloxConfigRegistry.hpp"
-#include "ubxmsg/IUbxMsg.hpp"
 #include "common/Notifier.hpp"
 
+#include "ubxmsg/UBX_ACK_ACK.hpp"
+#include "ubxmsg/UBX_ACK_NAK.hpp"
+#include "ubxmsg/UBX_CFG_VALGET.hpp"
+#include "ubxmsg/UBX_MON_RF.hpp"
+#include "ubxmsg/UBX_MON_SPAN.hpp"
+#include "ubxmsg/UBX_MON_SYS.hpp"
+#include "ubxmsg/UBX_MON_VER.hpp"
+#include "ubxmsg/UBX_NAV_DOP.hpp"
+#include "ubxmsg/UBX_NAV_GEOFENCE.hpp"
+#include "ubxmsg/UBX_NAV_PVT.hpp"
+#include "ubxmsg/UBX_NAV_SAT.hpp"
+#include "ubxmsg/UBX_TIM_TM2.hpp"
+
 
 namespace JimmyPaputto
 {
@@ -21,17 +33,49 @@ namespace JimmyPaputto
 class UbxCallbacks
 {
 public:
-    explicit UbxCallbacks(IUbloxConfigRegistry& configRegistry,
+    explicit UbxCallbacks(IUbloxConfigRegistry& configRegistry, Gnss& gnss,
         Notifier& navigationNotifier, Notifier& timeMarkNotifier,
         const bool callbackNotificationEnabled);
 
-    void run(ubxmsg::IUbxMsg& ubxMsg, const EUbxMsg& eUbxMsg);
+    // Decodes a checksum-verified frame into its concrete message and runs
+    // the matching handler; frames of unknown or ignored messages are
+    // dropped without being decoded.
+    void dispatch(std::span<const uint8_t> frame);
 
 private:
-    void ackNakCb(ubxmsg::IUbxMsg& ubxMsg, EUbxMsg eUbxMsg,
-        IUbloxConfigRegistry& configRegistry);
+    template<typename UbxMsg>
+    void decode(std::span<const uint8_t> frame);
+    void epochClosed(bool closed);
+
+    void on(const ubxmsg::UBX_ACK_ACK& ubxAckAck);
+    void on(const ubxmsg::UBX_ACK_NAK& ubxAckNak);
+    void on(const ubxmsg::UBX_CFG_VALGET& ubxCfgValget);
+    void on(const ubxmsg::UBX_MON_RF& ubxMonRf);
+    void on(const ubxmsg::UBX_MON_SPAN& ubxMonSpan);
+    void on(const ubxmsg::UBX_MON_SYS& ubxMonSys);
+    void on(const ubxmsg::UBX_MON_VER& ubxMonVer);
+    void on(const ubxmsg::UBX_NAV_DOP& ubxNavDop);
+    void on(const ubxmsg::UBX_NAV_GEOFENCE& ubxNavGeofence);
+    void on(const ubxmsg::UBX_NAV_PVT& ubxNavPvt);
+    void on(const ubxmsg::UBX_NAV_SAT& ubxNavSat);
+    void on(const ubxmsg::UBX_TIM_TM2& ubxTimTm2);
 
-    std::array<std::function<void(ubxmsg::IUbxMsg&)>, numberOfUbxMsgs> callbacks_;
+    std::tuple<
+        ubxmsg::UBX_ACK_ACK,
+        ubxmsg::UBX_ACK_NAK,
+        ubxmsg::UBX_CFG_VALGET,
+        ubxmsg::UBX_MON_RF,
+        ubxmsg::UBX_MON_SPAN,
+        ubxmsg::UBX_MON_SYS,
+        ubxmsg::UBX_MON_VER,
+        ubxmsg::UBX_NAV_DOP,
+        ubxmsg::UBX_NAV_GEOFENCE,
+        ubxmsg::UBX_NAV_PVT,
+        ubxmsg::UBX_NAV_SAT,
+        ubxmsg::UBX_TIM_TM2
+    > decoders_;
+    IUbloxConfigRegistry& configRegistry_;
+    Gnss& gnss_;
     Notifier& navigationNotifier_;
     Notifier& timeMarkNotifier_;
     const bool callbackNotificationEnabled_;
@@ -0,0 +1,77 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JP_UBX_CHECKSUM_HPP_
+#define JP_UBX_CHECKSUM_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace JimmyPaputto
+{
+
+// 8-bit Fletcher running sum used by UBX (class, id, length and payload).
+// Can be fed in arbitrary pieces, so a frame arriving in several reads is
+// summed once as its bytes come in.
+class UbxChecksum final
+{
+public:
+    void update(std::span<const uint8_t> bytes)
+    {
+        // Over a block of n bytes: a += sum(x[i]), b += n * a +
+        // sum((n - i) * x[i]). Everything is mod 256 and 2^32 is a multiple
+        // of it, so plain uint32 wraparound needs no reduction; the fixed
+        // 16-byte inner loop is vectorised by the compiler.
+        constexpr std::size_t block = 16;
+        const auto* data = bytes.data();
+        std::size_t i = 0;
+
+        if (bytes.size() >= largeFrame)
+        {
+            for (; i + block <= bytes.size(); i += block)
+            {
+                uint32_t sum = 0;
+                uint32_t weighted = 0;
+                for (std::size_t j = 0; j < block; j++)
+                {
+                    sum += data[i + j];
+                    weighted += static_cast<uint32_t>(block - j) * data[i + j];
+                }
+                b_ += block * a_ + weighted;
+                a_ += sum;
+            }
+        }
+
+        for (; i < bytes.size(); i++)
+        {
+            a_ += data[i];
+            b_ += a_;
+        }
+    }
+
+    std::array<uint8_t, 2> value() const
+    {
+        return { static_cast<uint8_t>(a_), static_cast<uint8_t>(b_) };
+    }
+
+    bool matches(std::span<const uint8_t> ck) const
+    {
+        return static_cast<uint8_t>(a_) == ck[0] &&
+            static_cast<uint8_t>(b_) == ck[1];
+    }
+
+    // Below this the scalar loop wins, typical NAV frames stay on it
+    static constexpr std::size_t largeFrame = 128;
+
+private:
+    uint32_t a_ = 0;
+    uint32_t b_ = 0;
+};
+
+}  // JimmyPaputto
+
+#endif  // JP_UBX_CHECKSUM_HPP_
@@ -5,7 +5,7 @@
 #ifndef UBX_CLASS_MSG_ID_HPP_
 #define UBX_CLASS_MSG_ID_HPP_
 
-#include <algorithm>
+#include <cstddef>
 #include <array>
 #include <cstdint>
 #include <utility>
@@ -18,59 +18,112 @@
 namespace JimmyPaputto
 {
 
-class UbxClassMsgId: public GenericSingleton<UbxClassMsgId>
+// Single source of the (class, id) pair of every EUbxMsg
+constexpr auto ubxClassMsgIds = [] {
+    std::array<std::pair<uint8_t, uint8_t>, numberOfUbxMsgs> ids {};
+    using enum EUbxMsg;
+    ids[to_underlying(UBX_ACK_ACK)] = { 0x05, 0x01 };
+    ids[to_underlying(UBX_ACK_NAK)] = { 0x05, 0x00 };
+    ids[to_underlying(UBX_CFG_CFG)] = { 0x06, 0x09 };
+    ids[to_underlying(UBX_CFG_GEOFENCE)] = { 0x06, 0x69 };
+    ids[to_underlying(UBX_CFG_MSG)] = { 0x06, 0x01 };
+    ids[to_underlying(UBX_CFG_NAV5)] = { 0x06, 0x24 };
+    ids[to_underlying(UBX_CFG_PRT)] = { 0x06, 0x00 };
+    ids[to_underlying(UBX_CFG_RATE)] = { 0x06, 0x08 };
+    ids[to_underlying(UBX_CFG_TP5)] = { 0x06, 0x31 };
+    ids[to_underlying(UBX_CFG_VALSET)] = { 0x06, 0x8A };
+    ids[to_underlying(UBX_CFG_VALGET)] = { 0x06, 0x8B };
+    ids[to_underlying(UBX_MON_RF)] = { 0x0A, 0x38 };
+    ids[to_underlying(UBX_MON_SPAN)] = { 0x0A, 0x31 };
+    ids[to_underlying(UBX_MON_VER)] = { 0x0A, 0x04 };
+    ids[to_underlying(UBX_MON_SYS)] = { 0x0A, 0x39 };
+    ids[to_underlying(UBX_NAV_DOP)] = { 0x01, 0x04 };
+    ids[to_underlying(UBX_NAV_GEOFENCE)] = { 0x01, 0x39 };
+    ids[to_underlying(UBX_NAV_PVT)] = { 0x01, 0x07 };
+    ids[to_underlying(UBX_NAV_SAT)] = { 0x01, 0x35 };
+    ids[to_underlying(UBX_TIM_TM2)] = { 0x0D, 0x03 };
+    return ids;
+}();
+
+constexpr std::size_t numberOfUbxClasses()
 {
-public:
-    explicit UbxClassMsgId()
+    std::array<bool, 256> seen {};
+    std::size_t count = 0;
+    for (const auto& [msgClass, msgId] : ubxClassMsgIds)
+    {
+        if (!seen[msgClass])
+            count++;
+        seen[msgClass] = true;
+    }
+    return count;
+}
+
+// Reverse of ubxClassMsgIds as two table hops, class byte -> row and
+// id byte -> EUbxMsg, so the per-frame cost does not grow with the number
+// of known messages.
+struct UbxMsgLookupTable
+{
+    static constexpr uint8_t noRow = 0xFF;
+
+    std::array<uint8_t, 256> rows;
+    std::array<std::array<EUbxMsg, 256>, numberOfUbxClasses()> ids;
+};
+
+constexpr auto ubxMsgLookupTable = [] {
+    UbxMsgLookupTable table {};
+    table.rows.fill(UbxMsgLookupTable::noRow);
+    for (auto& row : table.ids)
+        row.fill(EUbxMsg::END_UBX);
+
+    uint8_t usedRows = 0;
+    for (uint8_t i = 0; i < numberOfUbxMsgs; i++)
     {
-        using enum EUbxMsg;
-        ubxClassMsgIdMap_[to_underlying(UBX_ACK_ACK)] = { 0x05, 0x01 };
-        ubxClassMsgIdMap_[to_underlying(UBX_ACK_NAK)] = { 0x05, 0x00 };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_CFG)] = { 0x06, 0x09 };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_GEOFENCE)] = { 0x06, 0x69 };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_MSG)] = { 0x06, 0x01 };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_NAV5)] = { 0x06, 0x24 };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_PRT)] = { 0x06, 0x00 };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_RATE)] = { 0x06, 0x08 };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_TP5)] = { 0x06, 0x31 };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_VALSET)] = { 0x06, 0x8A };
-        ubxClassMsgIdMap_[to_underlying(UBX_CFG_VALGET)] = { 0x06, 0x8B };
-        ubxClassMsgIdMap_[to_underlying(UBX_MON_RF)] = { 0x0A, 0x38 };
-        ubxClassMsgIdMap_[to_underlying(UBX_MON_SPAN)] = { 0x0A, 0x31 };
-        ubxClassMsgIdMap_[to_underlying(UBX_MON_VER)] = { 0x0A, 0x04 };
-        ubxClassMsgIdMap_[to_underlying(UBX_MON_SYS)] = { 0x0A, 0x39 };
-        ubxClassMsgIdMap_[to_underlying(UBX_NAV_DOP)] = { 0x01, 0x04 };
-        ubxClassMsgIdMap_[to_underlying(UBX_NAV_GEOFENCE)] = { 0x01, 0x39 };
-        ubxClassMsgIdMap_[to_underlying(UBX_NAV_PVT)] = { 0x01, 0x07 };
-        ubxClassMsgIdMap_[to_underlying(UBX_NAV_SAT)] = { 0x01, 0x35 };
-        ubxClassMsgIdMap_[to_underlying(UBX_TIM_TM2)] = { 0x0D, 0x03 };
+        const auto [msgClass, msgId] = ubxClassMsgIds[i];
+        if (table.rows[msgClass] == UbxMsgLookupTable::noRow)
+            table.rows[msgClass] = usedRows++;
+        table.ids[table.rows[msgClass]][msgId] = static_cast<EUbxMsg>(i);
     }
+    return table;
+}();
+
+class UbxClassMsgId: public GenericSingleton<UbxClassMsgId>
+{
+public:
+    explicit UbxClassMsgId() = default;
 
     std::pair<uint8_t, uint8_t> translate(const EUbxMsg& eUbxMsg) const
     {
-        return ubxClassMsgIdMap_[to_underlying(eUbxMsg)];
+        return ubxClassMsgIds[to_underlying(eUbxMsg)];
     }
 
     EUbxMsg translate(const std::pair<uint8_t, uint8_t>& rawUbxClassMsgid) const
     {
-        const auto ubxClassMsgIdIt = std::find(
-            ubxClassMsgIdMap_.begin(),
-            ubxClassMsgIdMap_.end(),
-            rawUbxClassMsgid
-        );
-        if (ubxClassMsgIdIt != ubxClassMsgIdMap_.end())
-        {
-            return static_cast<EUbxMsg>(std::distance(ubxClassMsgIdMap_.begin(),
-                ubxClassMsgIdIt));
-        }
-
-        return EUbxMsg::END_UBX;
+        return lookup(rawUbxClassMsgid.first, rawUbxClassMsgid.second);
     }
 
-private:
-    std::array<std::pair<uint8_t, uint8_t>, numberOfUbxMsgs> ubxClassMsgIdMap_;
+    static constexpr EUbxMsg lookup(const uint8_t msgClass, const uint8_t msgId)
+    {
+        const auto row = ubxMsgLookupTable.rows[msgClass];
+        return row == UbxMsgLookupTable::noRow
+            ? EUbxMsg::END_UBX
+            : ubxMsgLookupTable.ids[row][msgId];
+    }
 };
 
+static_assert(
+    [] {
+        for (uint8_t i = 0; i < numberOfUbxMsgs; i++)
+        {
+            const auto [msgClass, msgId] = ubxClassMsgIds[i];
+            if (msgClass == 0x00 ||
+                UbxClassMsgId::lookup(msgClass, msgId) != static_cast<EUbxMsg>(i))
+                return false;
+        }
+        return true;
+    }(),
+    "every EUbxMsg needs a distinct class/id pair in ubxClassMsgIds"
+);
+
 }  // JimmyPaputto
 
 #endif  // UBX_CLASS_MSG_ID_HPP_
@@ -0,0 +1,262 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "UbxDispatcher.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <tuple>
+
+#include "UbxClassMsgId.hpp"
+
+#include "ubxmsg/UBX_MON_RF.hpp"
+#include "ubxmsg/UBX_MON_SPAN.hpp"
+#include "ubxmsg/UBX_MON_SYS.hpp"
+#include "ubxmsg/UBX_NAV_DOP.hpp"
+#include "ubxmsg/UBX_NAV_GEOFENCE.hpp"
+#include "ubxmsg/UBX_NAV_PVT.hpp"
+#include "ubxmsg/UBX_NAV_SAT.hpp"
+#include "ubxmsg/UBX_TIM_TM2.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Each worker decodes into its own messages, they keep state between frames
+struct UbxDispatcher::Decoders
+{
+    std::tuple<
+        ubxmsg::UBX_MON_RF,
+        ubxmsg::UBX_MON_SPAN,
+        ubxmsg::UBX_MON_SYS,
+        ubxmsg::UBX_NAV_DOP,
+        ubxmsg::UBX_NAV_GEOFENCE,
+        ubxmsg::UBX_NAV_PVT,
+        ubxmsg::UBX_NAV_SAT,
+        ubxmsg::UBX_TIM_TM2
+    > messages;
+};
+
+UbxDispatcher::UbxDispatcher(std::size_t queueCapacity,
+    uint8_t numberOfWorkers)
+:   queue_(queueCapacity),
+    numberOfWorkers_(numberOfWorkers > 0 ? numberOfWorkers : 1),
+    pending_(0),
+    typedListeners_ {},
+    rawListeners_(0),
+    posted_(0),
+    dropped_(0),
+    callbacks_(0),
+    subscribers_(std::make_shared<const Subscribers>()),
+    nextId_(1)
+{
+}
+
+UbxDispatcher::~UbxDispatcher()
+{
+    for (auto& worker : workers_)
+        worker.request_stop();
+    wake();
+    workers_.clear();
+}
+
+UbxSubscriptionId UbxDispatcher::subscribeRaw(UbxRawCallback callback)
+{
+    return add(EUbxMsg::END_UBX, {}, std::move(callback));
+}
+
+UbxSubscriptionId UbxDispatcher::add(EUbxMsg msg,
+    std::function<void(const void*)> typed, UbxRawCallback raw)
+{
+    std::lock_guard lock(subscribersMutex_);
+    auto subscriber = std::make_shared<const Subscriber>(
+        Subscriber{ nextId_++, msg, std::move(typed), std::move(raw) });
+
+    auto subscribers = std::make_shared<Subscribers>(*subscribers_.load());
+    subscribers->push_back(subscriber);
+    subscribers_.store(std::move(subscribers));
+
+    if (subscriber->raw)
+        rawListeners_++;
+    else
+        typedListeners_[static_cast<uint8_t>(msg)]++;
+
+    // No threads for a hat nobody subscribes to
+    if (workers_.empty())
+    {
+        for (uint8_t i = 0; i < numberOfWorkers_; i++)
+            workers_.emplace_back([this](std::stop_token stoken) {
+                run(stoken);
+            });
+    }
+    return subscriber->id;
+}
+
+void UbxDispatcher::unsubscribe(UbxSubscriptionId id)
+{
+    std::lock_guard lock(subscribersMutex_);
+    auto subscribers = std::make_shared<Subscribers>(*subscribers_.load());
+    const auto it = std::find_if(subscribers->begin(), subscribers->end(),
+        [id](const auto& subscriber) { return subscriber->id == id; });
+    if (it == subscribers->end())
+        return;
+
+    if ((*it)->raw)
+        rawListeners_--;
+    else
+        typedListeners_[static_cast<uint8_t>((*it)->msg)]--;
+
+    subscribers->erase(it);
+    subscribers_.store(std::move(subscribers));
+}
+
+UbxDispatchStats UbxDispatcher::stats() const
+{
+    return {
+        posted_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed),
+        callbacks_.load(std::memory_order_relaxed),
+        latency_.snapshot()
+    };
+}
+
+void UbxDispatcher::post(std::span<const uint8_t> frame)
+{
+    const auto msg = UbxClassMsgId::lookup(frame[2], frame[3]);
+    const bool typedWanted = msg != EUbxMsg::END_UBX &&
+        typedListeners_[static_cast<uint8_t>(msg)].load() > 0;
+    if (!typedWanted && rawListeners_.load() == 0)
+        return;
+
+    const auto received = std::chrono::steady_clock::now();
+    const bool queued = queue_.tryPushWith([&](Frame& cell) {
+        cell.msg = msg;
+        cell.received = received;
+        cell.bytes.assign(frame.begin(), frame.end());
+    });
+    if (!queued)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    posted_.fetch_add(1, std::memory_order_relaxed);
+    wake();
+}
+
+void UbxDispatcher::run(std::stop_token stoken)
+{
+    Decoders decoders;
+    Frame frame;
+    while (true)
+    {
+        const auto seen = pending_.load();
+        if (queue_.tryPop(frame))
+        {
+            deliver(frame, decoders);
+            continue;
+        }
+        if (stoken.stop_requested())
+            return;
+        pending_.wait(seen);
+    }
+}
+
+void UbxDispatcher::deliver(const Frame& frame, Decoders& decoders)
+{
+    const auto subscribers = subscribers_.load();
+    for (const auto& subscriber : *subscribers)
+    {
+        if (subscriber->raw)
+            invoke(frame, [&] { subscriber->raw(frame.bytes); });
+    }
+
+    if (frame.msg == EUbxMsg::END_UBX ||
+        typedListeners_[static_cast<uint8_t>(frame.msg)].load() == 0)
+        return;
+
+    auto& m = decoders.messages;
+    using enum EUbxMsg;
+    switch (frame.msg)
+    {
+    case UBX_MON_RF:
+        return deliverTyped<UBX_MON_RF>(frame, *subscribers,
+            std::get<ubxmsg::UBX_MON_RF>(m),
+            [](const auto& msg) -> decltype(auto) { return msg.rfBlocks(); });
+    case UBX_MON_SPAN:
+        return deliverTyped<UBX_MON_SPAN>(frame, *subscribers,
+            std::get<ubxmsg::UBX_MON_SPAN>(m),
+            [](const auto& msg) -> decltype(auto) {
+                return msg.rfBlocksSpectrumData();
+            });
+    case UBX_MON_SYS:
+        return deliverTyped<UBX_MON_SYS>(frame, *subscribers,
+            std::get<ubxmsg::UBX_MON_SYS>(m),
+            [](const auto& msg) -> decltype(auto) {
+                return msg.systemHealth();
+            });
+    case UBX_NAV_DOP:
+        return deliverTyped<UBX_NAV_DOP>(frame, *subscribers,
+            std::get<ubxmsg::UBX_NAV_DOP>(m),
+            [](const auto& msg) { return msg.dop(); });
+    case UBX_NAV_GEOFENCE:
+        return deliverTyped<UBX_NAV_GEOFENCE>(frame, *subscribers,
+            std::get<ubxmsg::UBX_NAV_GEOFENCE>(m),
+            [](const auto& msg) { return msg.nav(); });
+    case UBX_NAV_PVT:
+        return deliverTyped<UBX_NAV_PVT>(frame, *subscribers,
+            std::get<ubxmsg::UBX_NAV_PVT>(m),
+            [](const auto& msg) { return msg.pvt(); });
+    case UBX_NAV_SAT:
+        return deliverTyped<UBX_NAV_SAT>(frame, *subscribers,
+            std::get<ubxmsg::UBX_NAV_SAT>(m),
+            [](const auto& msg) -> decltype(auto) {
+                return msg.satellites();
+            });
+    case UBX_TIM_TM2:
+        return deliverTyped<UBX_TIM_TM2>(frame, *subscribers,
+            std::get<ubxmsg::UBX_TIM_TM2>(m),
+            [](const auto& msg) { return msg.timeMark(); });
+    default:
+        // No UbxPayload for it, raw subscribers already had it
+        return;
+    }
+}
+
+template<EUbxMsg Msg, typename UbxMsg, typename ReadFn>
+void UbxDispatcher::deliverTyped(const Frame& frame,
+    const Subscribers& subscribers, UbxMsg& ubxMsg, ReadFn&& read)
+{
+    ubxMsg.UbxMsg::deserialize(frame.bytes);
+    const UbxPayload_t<Msg>& payload = read(ubxMsg);
+    for (const auto& subscriber : subscribers)
+    {
+        if (!subscriber->raw && subscriber->msg == Msg)
+            invoke(frame, [&] { subscriber->typed(&payload); });
+    }
+}
+
+template<typename Fn>
+void UbxDispatcher::invoke(const Frame& frame, Fn&& callback)
+{
+    latency_.record(std::chrono::steady_clock::now() - frame.received);
+    callbacks_.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+        callback();
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "[UbxDispatcher] Callback threw: %s\r\n", e.what());
+    }
+}
+
+void UbxDispatcher::wake()
+{
+    pending_.fetch_add(1);
+    pending_.notify_all();
+}
+
+}  // JimmyPaputto
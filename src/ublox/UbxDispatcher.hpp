@@ -0,0 +1,134 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef UBX_DISPATCHER_HPP_
+#define UBX_DISPATCHER_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "EUbxMsg.hpp"
+#include "UbxPayload.hpp"
+#include "common/BoundedQueue.hpp"
+#include "common/LatencyHistogram.hpp"
+
+
+namespace JimmyPaputto
+{
+
+using UbxSubscriptionId = uint64_t;
+using UbxRawCallback = std::function<void(std::span<const uint8_t> frame)>;
+
+struct UbxDispatchStats
+{
+    uint64_t posted;          // frames queued for the workers
+    uint64_t dropped;         // frames lost because the queue was full
+    uint64_t callbacks;       // callback invocations
+    LatencySnapshot latency;  // frame parsed -> callback invoked
+};
+
+// Hands parsed UBX frames to user callbacks on worker threads.
+//
+// The receiver thread only copies a frame into a lock-free queue, and only
+// when someone subscribed to it; decoding and the callbacks run on the
+// workers, so a slow callback costs queued frames (counted as dropped),
+// never a stalled SPI/UART read loop. With more than one worker callbacks
+// for consecutive frames may run concurrently and complete out of order.
+class UbxDispatcher final
+{
+public:
+    static constexpr std::size_t defaultQueueCapacity = 256;
+
+    explicit UbxDispatcher(std::size_t queueCapacity = defaultQueueCapacity,
+        uint8_t numberOfWorkers = 1);
+    ~UbxDispatcher();
+
+    UbxDispatcher(const UbxDispatcher&) = delete;
+    UbxDispatcher& operator=(const UbxDispatcher&) = delete;
+
+    // Callback gets const UbxPayload_t<Msg>&
+    template<EUbxMsg Msg, typename Callback>
+    UbxSubscriptionId subscribe(Callback&& callback)
+    {
+        static_assert(
+            std::is_invocable_v<Callback&, const UbxPayload_t<Msg>&>);
+        return add(Msg,
+            [callback = std::forward<Callback>(callback)](
+                const void* payload) mutable {
+                callback(*static_cast<const UbxPayload_t<Msg>*>(payload));
+            },
+            {});
+    }
+
+    // Every checksum-verified frame, known to the parser or not
+    UbxSubscriptionId subscribeRaw(UbxRawCallback callback);
+
+    // A callback already picked up by a worker may still run once
+    void unsubscribe(UbxSubscriptionId id);
+
+    UbxDispatchStats stats() const;
+
+    // Receiver thread side, never waits
+    void post(std::span<const uint8_t> frame);
+
+private:
+    struct Frame
+    {
+        EUbxMsg msg;
+        std::chrono::steady_clock::time_point received;
+        std::vector<uint8_t> bytes;
+    };
+
+    struct Subscriber
+    {
+        UbxSubscriptionId id;
+        EUbxMsg msg;
+        std::function<void(const void*)> typed;
+        UbxRawCallback raw;
+    };
+
+    using Subscribers = std::vector<std::shared_ptr<const Subscriber>>;
+
+    struct Decoders;
+
+    UbxSubscriptionId add(EUbxMsg msg,
+        std::function<void(const void*)> typed, UbxRawCallback raw);
+    void run(std::stop_token stoken);
+    void deliver(const Frame& frame, Decoders& decoders);
+    template<EUbxMsg Msg, typename UbxMsg, typename ReadFn>
+    void deliverTyped(const Frame& frame, const Subscribers& subscribers,
+        UbxMsg& ubxMsg, ReadFn&& read);
+    template<typename Fn>
+    void invoke(const Frame& frame, Fn&& callback);
+    void wake();
+
+    BoundedQueue<Frame> queue_;
+    const uint8_t numberOfWorkers_;
+    std::atomic<uint32_t> pending_;
+    std::array<std::atomic<uint32_t>,
+        static_cast<std::size_t>(EUbxMsg::END_UBX)> typedListeners_;
+    std::atomic<uint32_t> rawListeners_;
+    std::atomic<uint64_t> posted_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> callbacks_;
+    LatencyHistogram latency_;
+
+    std::mutex subscribersMutex_;
+    std::atomic<std::shared_ptr<const Subscribers>> subscribers_;
+    UbxSubscriptionId nextId_;
+    std::vector<std::jthread> workers_;
+};
+
+}  // JimmyPaputto
+
+#endif  // UBX_DISPATCHER_HPP_
@@ -0,0 +1,136 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "UbxFrameSinks.hpp"
+
+#include <cstdio>
+
+
+namespace JimmyPaputto
+{
+
+UbxFileSink::UbxFileSink(const std::string& path,
+    std::size_t queueCapacity)
+:   buffer_(bufferSize),
+    ring_(queueCapacity),
+    open_(false),
+    pending_(0),
+    frames_(0),
+    bytes_(0)
+{
+    // Has to be set before open() to take effect
+    file_.rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+    file_.open(path, std::ios::binary | std::ios::app);
+    if (!file_)
+    {
+        fprintf(stderr, "[UbxFileSink] Cannot open %s\r\n", path.c_str());
+        return;
+    }
+
+    open_.store(true, std::memory_order_relaxed);
+    writer_ = std::jthread([this](std::stop_token stoken) {
+        run(stoken);
+    });
+}
+
+UbxFileSink::~UbxFileSink()
+{
+    writer_.request_stop();
+    wake();
+    if (writer_.joinable())
+        writer_.join();
+    file_.close();
+}
+
+bool UbxFileSink::isOpen() const
+{
+    return open_.load(std::memory_order_relaxed);
+}
+
+uint64_t UbxFileSink::frames() const
+{
+    return frames_.load(std::memory_order_relaxed);
+}
+
+uint64_t UbxFileSink::bytes() const
+{
+    return bytes_.load(std::memory_order_relaxed);
+}
+
+uint64_t UbxFileSink::dropped() const
+{
+    return ring_.dropped();
+}
+
+void UbxFileSink::onFrame(std::span<const uint8_t> frame)
+{
+    if (!open_.load(std::memory_order_relaxed))
+        return;
+
+    ring_.onFrame(frame);
+    wake();
+}
+
+void UbxFileSink::run(std::stop_token stoken)
+{
+    std::vector<uint8_t> frame;
+    while (true)
+    {
+        const auto seen = pending_.load();
+        if (ring_.tryPop(frame))
+        {
+            file_.write(reinterpret_cast<const char*>(frame.data()),
+                frame.size());
+            if (!file_)
+            {
+                fprintf(stderr, "[UbxFileSink] Write failed, closing\r\n");
+                open_.store(false, std::memory_order_relaxed);
+                return;
+            }
+            frames_.fetch_add(1, std::memory_order_relaxed);
+            bytes_.fetch_add(frame.size(), std::memory_order_relaxed);
+            continue;
+        }
+        if (stoken.stop_requested())
+            return;
+        pending_.wait(seen);
+    }
+}
+
+void UbxFileSink::wake()
+{
+    pending_.fetch_add(1);
+    pending_.notify_one();
+}
+
+UbxFrameRing::UbxFrameRing(std::size_t capacity)
+:   queue_(capacity),
+    dropped_(0)
+{
+}
+
+bool UbxFrameRing::tryPop(std::vector<uint8_t>& frame)
+{
+    return queue_.tryPop(frame);
+}
+
+uint64_t UbxFrameRing::dropped() const
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void UbxFrameRing::onFrame(std::span<const uint8_t> frame)
+{
+    const auto write = [frame](std::vector<uint8_t>& cell) {
+        cell.assign(frame.begin(), frame.end());
+    };
+
+    while (!queue_.tryPushWith(write))
+    {
+        if (queue_.discard())
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,87 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_UBX_FRAME_SINKS_HPP_
+#define JIMMY_PAPUTTO_UBX_FRAME_SINKS_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "UbxFrameTap.hpp"
+#include "common/BoundedQueue.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Keeps the latest frames for another thread to collect with tryPop(); a
+// full ring drops its oldest frame. Frames are copied into the ring's own
+// vectors, which stop allocating once they have held a frame that large.
+class UbxFrameRing final : public IUbxFrameSink
+{
+public:
+    explicit UbxFrameRing(std::size_t capacity);
+
+    bool tryPop(std::vector<uint8_t>& frame);
+    uint64_t dropped() const;
+
+    void onFrame(std::span<const uint8_t> frame) override;
+
+private:
+    BoundedQueue<std::vector<uint8_t>> queue_;
+    std::atomic<uint64_t> dropped_;
+};
+
+// Appends frames to a raw .ubx file, what u-center and RTKLIB's convbin
+// read, e.g. RXM-RAWX and RXM-SFRBX for post-processed kinematics.
+//
+// onFrame() only copies the frame into a ring; a writer thread of its own
+// does the file I/O, so a slow disk costs the oldest queued frames
+// (counted as dropped), never a stalled receiver. Frames collect in a
+// 64 KiB buffer, so the file sees one write per buffer rather than one per
+// frame. frames() and bytes() count what the file accepted; the destructor
+// writes out whatever is still queued.
+class UbxFileSink final : public IUbxFrameSink
+{
+public:
+    static constexpr std::size_t defaultQueueCapacity = 1024;
+
+    explicit UbxFileSink(const std::string& path,
+        std::size_t queueCapacity = defaultQueueCapacity);
+    ~UbxFileSink() override;
+
+    UbxFileSink(const UbxFileSink&) = delete;
+    UbxFileSink& operator=(const UbxFileSink&) = delete;
+
+    bool isOpen() const;
+    uint64_t frames() const;
+    uint64_t bytes() const;
+    uint64_t dropped() const;
+
+    void onFrame(std::span<const uint8_t> frame) override;
+
+private:
+    static constexpr std::size_t bufferSize = 64 * 1024;
+
+    void run(std::stop_token stoken);
+    void wake();
+
+    std::vector<char> buffer_;
+    std::ofstream file_;
+    UbxFrameRing ring_;
+    std::atomic<bool> open_;
+    std::atomic<uint32_t> pending_;
+    std::atomic<uint64_t> frames_;
+    std::atomic<uint64_t> bytes_;
+    std::jthread writer_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_UBX_FRAME_SINKS_HPP_
@@ -0,0 +1,95 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "UbxFrameTap.hpp"
+
+#include <algorithm>
+
+#include "common/Utils.hpp"
+
+
+namespace JimmyPaputto
+{
+
+namespace
+{
+
+bool alwaysDecoded(const EUbxMsg msg)
+{
+    using enum EUbxMsg;
+    switch (msg)
+    {
+    case UBX_ACK_ACK:
+    case UBX_ACK_NAK:
+    case UBX_CFG_VALGET:
+    case UBX_MON_VER:
+    case UBX_NAV_PVT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+}  // anonymous namespace
+
+UbxFrameTap::UbxFrameTap()
+:   sinks_(std::make_shared<const Sinks>()),
+    numberOfSinks_(0),
+    skipped_(0)
+{
+}
+
+void UbxFrameTap::add(std::shared_ptr<IUbxFrameSink> sink)
+{
+    if (!sink)
+        return;
+
+    std::lock_guard lock(sinksMutex_);
+    auto sinks = std::make_shared<Sinks>(*sinks_.load());
+    sinks->push_back(std::move(sink));
+    numberOfSinks_.store(sinks->size());
+    sinks_.store(std::move(sinks));
+}
+
+void UbxFrameTap::remove(const std::shared_ptr<IUbxFrameSink>& sink)
+{
+    std::lock_guard lock(sinksMutex_);
+    auto sinks = std::make_shared<Sinks>(*sinks_.load());
+    std::erase(*sinks, sink);
+    numberOfSinks_.store(sinks->size());
+    sinks_.store(std::move(sinks));
+}
+
+bool UbxFrameTap::skipDecode(const EUbxMsg msg, const bool skip)
+{
+    if (msg >= EUbxMsg::END_UBX || (skip && alwaysDecoded(msg)))
+        return false;
+
+    const uint32_t bit = 1u << to_underlying(msg);
+    if (skip)
+        skipped_.fetch_or(bit);
+    else
+        skipped_.fetch_and(~bit);
+    return true;
+}
+
+bool UbxFrameTap::decodes(const EUbxMsg msg) const
+{
+    return msg >= EUbxMsg::END_UBX ||
+        !(skipped_.load(std::memory_order_relaxed) &
+            (1u << to_underlying(msg)));
+}
+
+void UbxFrameTap::forward(std::span<const uint8_t> frame)
+{
+    // No atomic shared_ptr load per frame while nobody taps
+    if (numberOfSinks_.load(std::memory_order_relaxed) == 0)
+        return;
+
+    const auto sinks = sinks_.load();
+    for (const auto& sink : *sinks)
+        sink->onFrame(frame);
+}
+
+}  // JimmyPaputto
@@ -0,0 +1,72 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JIMMY_PAPUTTO_UBX_FRAME_TAP_HPP_
+#define JIMMY_PAPUTTO_UBX_FRAME_TAP_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "EUbxMsg.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Receives every checksum-verified frame, known to the library or not
+// (RXM-RAWX, RXM-SFRBX, ...), on the receiver thread before it is decoded.
+// The span points into the parser's read buffer and is only valid during
+// the call: copy what you keep, and never block, the SPI/UART loop waits.
+class IUbxFrameSink
+{
+public:
+    virtual ~IUbxFrameSink() = default;
+    virtual void onFrame(std::span<const uint8_t> frame) = 0;
+};
+
+// Where UbxParser hands raw frames to sinks and asks whether to decode them.
+//
+// Unlike UbxDispatcher::subscribeRaw() nothing is copied or queued for a
+// worker: sinks run inline, so a logger sees every frame in receiver order
+// and none is dropped for a full queue.
+class UbxFrameTap final
+{
+public:
+    UbxFrameTap();
+
+    UbxFrameTap(const UbxFrameTap&) = delete;
+    UbxFrameTap& operator=(const UbxFrameTap&) = delete;
+
+    void add(std::shared_ptr<IUbxFrameSink> sink);
+    // The sink may still be inside onFrame() when this returns
+    void remove(const std::shared_ptr<IUbxFrameSink>& sink);
+
+    // Frames of `msg` still reach the sinks and the dispatcher, but the
+    // library stops decoding them and the state they feed (satellites, RF
+    // blocks, ...) stops updating. ACK/NAK, CFG-VALGET, MON-VER and NAV-PVT
+    // drive startup and epochs and are always decoded; false for those.
+    bool skipDecode(EUbxMsg msg, bool skip = true);
+    bool decodes(EUbxMsg msg) const;
+
+    // Receiver thread side
+    void forward(std::span<const uint8_t> frame);
+
+private:
+    using Sinks = std::vector<std::shared_ptr<IUbxFrameSink>>;
+
+    static_assert(static_cast<std::size_t>(EUbxMsg::END_UBX) <= 32);
+
+    std::mutex sinksMutex_;
+    std::atomic<std::shared_ptr<const Sinks>> sinks_;
+    std::atomic<uint32_t> numberOfSinks_;
+    std::atomic<uint32_t> skipped_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JIMMY_PAPUTTO_UBX_FRAME_TAP_HPP_
@@ -5,11 +5,12 @@
 #include "UbxParser.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 #include "EUbxMsg.hpp"
 #include "Gnss.hpp"
-#include "UbxFactory.hpp"
 #include "Ublox.hpp"
+#include "UbxClassMsgId.hpp"
 
 #include "ubxmsg/UBX_ACK_ACK.hpp"
 #include "ubxmsg/UBX_ACK_NAK.hpp"
@@ -24,110 +25,163 @@
 namespace JimmyPaputto
 {
 
-UbxParser::UbxParser(IUbloxConfigRegistry& configRegistry,
+UbxParser::UbxParser(IUbloxConfigRegistry& configRegistry, Gnss& gnss,
     Notifier& navigationNotifier, Notifier& timeMarkNotifier,
-    bool callbackNotificationEnabled)
-:   endFrameIt_(frames_.end()),
+    bool callbackNotificationEnabled, UbxDispatcher* ubxDispatcher,
+    UbxFrameTap* frameTap)
+:   carrySize_(0),
+    carryChecksummed_(0),
     configRegistry_(configRegistry),
-    ubxCallbacks_(configRegistry, navigationNotifier, timeMarkNotifier,
-        callbackNotificationEnabled)
+    ubxCallbacks_(configRegistry, gnss, navigationNotifier, timeMarkNotifier,
+        callbackNotificationEnabled),
+    ubxDispatcher_(ubxDispatcher),
+    frameTap_(frameTap),
+    rxTimestamp_(0)
 {
-    constexpr uint16_t maxFrameSize = 1024;
-    unfinishedFrameFromBuffer_.reserve(maxFrameSize);
-    for (auto& frame: frames_)
+}
+
+void UbxParser::parse(std::span<const uint8_t> buffer,
+    std::chrono::nanoseconds rxTimestamp)
+{
+    rxTimestamp_ = rxTimestamp;
+    parse(buffer);
+    rxTimestamp_ = std::chrono::nanoseconds(0);
+}
+
+void UbxParser::parse(std::span<const uint8_t> buffer)
+{
+    while (carrySize_ > 0)
     {
-        frame.reserve(maxFrameSize);
+        if (buffer.empty())
+            return;
+        buffer = completeCarriedFrame(buffer);
     }
+    scan(buffer);
+}
+
+void UbxParser::reset()
+{
+    if (carrySize_ > 0)
+        scanner_.countTruncatedFrame();
+    carrySize_ = 0;
+}
+
+const UbxScanStats& UbxParser::scanStats() const
+{
+    return scanner_.stats();
 }
 
-std::vector<uint8_t> UbxParser::parse(std::span<const uint8_t> buffer)
+LatencySnapshot UbxParser::ingressLatency(EUbxMsg msg) const
 {
-    unfinishedFrameFromBuffer_.clear();
-    extractFrames(buffer);
-    for (auto frameIt = frames_.begin(); frameIt != endFrameIt_; frameIt++)
+    if (msg >= EUbxMsg::END_UBX)
+        return {};
+    return ingressLatency_[static_cast<std::size_t>(msg)].snapshot();
+}
+
+void UbxParser::scan(std::span<const uint8_t> buffer)
+{
+    using enum UbxScanner::ECandidate;
+
+    std::size_t offset = 0;
+    while (true)
     {
-        if (frameIt->empty())
-            continue;
-
-        const auto& frame = *frameIt;
-        const auto eUbxMsg = UbxClassMsgId::instance().translate(
-            { frame[2], frame[3] }
-        );
-        if (eUbxMsg != EUbxMsg::END_UBX)
+        const auto candidate = scanner_.next(buffer, offset);
+        if (candidate.type == None)
+            return;
+
+        if (candidate.type == Incomplete)
         {
-            ubxCallbacks_.run(UbxFactory::create(eUbxMsg, frame), eUbxMsg);
+            carry(buffer.subspan(candidate.offset));
+            return;
         }
+
+        dispatch(buffer.subspan(candidate.offset, candidate.size));
+        offset = candidate.offset + candidate.size;
     }
-    return unfinishedFrameFromBuffer_;
 }
 
-void UbxParser::extractFrames(std::span<const uint8_t> buffer)
+std::span<const uint8_t> UbxParser::completeCarriedFrame(
+    std::span<const uint8_t> buffer)
 {
-    std::array<uint8_t, 2> pattern {0xB5, 0x62};
-    auto bufferBegin = buffer.begin();
-    for (auto frameIt = frames_.begin(); frameIt != endFrameIt_; frameIt++)
+    std::size_t consumed = 0;
+    const auto takeUpTo = [&](const uint32_t size) {
+        const auto toTake = std::min<std::size_t>(
+            size - carrySize_, buffer.size() - consumed);
+        std::memcpy(carry_.data() + carrySize_, buffer.data() + consumed,
+            toTake);
+        carrySize_ += toTake;
+        consumed += toTake;
+    };
+
+    constexpr auto headerSize = UbxScanner::headerSize;
+    if (carrySize_ < headerSize)
+        takeUpTo(headerSize);
+    if (carrySize_ < headerSize)
+        return buffer.subspan(consumed);
+
+    const bool validHeader =
+        UbxScanner::plausibleHeader(std::span(carry_.data(), headerSize));
+    const uint32_t frameSize =
+        readLE<uint16_t>(carry_.data() + 4) + UbxScanner::frameOverhead;
+    if (validHeader)
     {
-        frameIt->clear();
+        takeUpTo(frameSize);
+
+        // Sum only what arrived since the last chunk, a frame trickling in
+        // over many reads is still walked once
+        const uint32_t summable = std::min(carrySize_, frameSize - 2);
+        carryChecksum_.update(std::span(carry_.data() + carryChecksummed_,
+            summable - carryChecksummed_));
+        carryChecksummed_ = summable;
+        if (carrySize_ < frameSize)
+            return buffer.subspan(consumed);
+
+        if (carryChecksum_.matches(std::span(carry_.data() + frameSize - 2, 2)))
+        {
+            dispatch(std::span(carry_.data(), frameSize));
+            carrySize_ = 0;
+            return buffer.subspan(consumed);
+        }
+        scanner_.countChecksumFailure();
     }
+    else if (carry_[1] == UbxScanner::syncChar2)
+    {
+        scanner_.countFalseSync();
+    }
+
+    // False sync: everything after the carried 0xB5 may still hold frames,
+    // including the bytes just taken from `buffer`, so rescan it.
+    const uint32_t toRescan = carrySize_ - 1;
+    std::memcpy(resync_.data(), carry_.data() + 1, toRescan);
+    carrySize_ = 0;
+    scan(std::span<const uint8_t>(resync_.data(), toRescan));
+    return buffer.subspan(consumed);
+}
 
-    endFrameIt_ = frames_.begin();
+void UbxParser::carry(std::span<const uint8_t> bytes)
+{
+    std::memcpy(carry_.data(), bytes.data(), bytes.size());
+    carrySize_ = bytes.size();
+    carryChecksum_ = UbxChecksum();
+    carryChecksummed_ = 2;
+}
 
-    for (uint16_t frameIndex = 0; frameIndex < maxNumberOfFrames_; frameIndex++)
+void UbxParser::dispatch(std::span<const uint8_t> frame)
+{
+    const auto msg = UbxClassMsgId::lookup(frame[2], frame[3]);
+    if (frameTap_)
+        frameTap_->forward(frame);
+    if (ubxDispatcher_)
+        ubxDispatcher_->post(frame);
+    if (!frameTap_ || frameTap_->decodes(msg))
+        ubxCallbacks_.dispatch(frame);
+
+    if (rxTimestamp_.count() == 0)
+        return;
+    if (msg != EUbxMsg::END_UBX)
     {
-        const auto beginFrameIterator = std::search(
-            bufferBegin,
-            buffer.end(),
-            pattern.begin(),
-            pattern.end()
-        );
-
-        if (beginFrameIterator != buffer.end() &&
-            std::distance(beginFrameIterator, buffer.end()) > 5)
-        {
-            auto endFrameIterator = beginFrameIterator + 4;
-            uint16_t dataLength;
-            std::memcpy(&dataLength, &(*endFrameIterator), sizeof(uint16_t));
-            if (std::distance(++endFrameIterator, buffer.end()) < dataLength + 3)
-            {
-                std::copy(
-                    beginFrameIterator,
-                    buffer.end(),
-                    std::back_inserter(unfinishedFrameFromBuffer_)
-                );
-                break;
-            }
-            else
-            {
-                endFrameIterator += dataLength + 3;
-                std::copy(
-                    beginFrameIterator,
-                    endFrameIterator,
-                    std::back_inserter(frames_[frameIndex])
-                );
-                if (!checkFrame(frames_[frameIndex]))
-                {
-                    frames_[frameIndex].clear();
-                }
-                endFrameIt_++;
-                bufferBegin = endFrameIterator;
-            }
-        }
-        else if (
-            std::distance(beginFrameIterator, buffer.end()) <= 5 &&
-            beginFrameIterator != buffer.end()
-        )
-        {
-            std::copy(
-                beginFrameIterator,
-                buffer.end(),
-                std::back_inserter(unfinishedFrameFromBuffer_)
-            );
-            break;
-        }
-        else
-        {
-            break;
-        }
+        ingressLatency_[static_cast<std::size_t>(msg)].record(
+            monotonicRawNow() - rxTimestamp_);
     }
 }
 
@@ -135,45 +189,25 @@ void UbxParser::addChecksum(std::vector<uint8_t>& frame)
 {
     const auto ck = UbxParser::checksum(frame, 0);
     frame.insert(frame.end(), ck.begin(), ck.end());
-
-    if (!UbxParser::checkFrame(frame))
-    {
-        frame = { 0xFF };
-    }
 }
 
 std::array<uint8_t, 2> UbxParser::checksum(std::span<const uint8_t> frame,
     uint8_t offset)
 {
-    uint8_t cka = 0;
-    uint8_t ckb = 0;
-
-    for (std::size_t i = 2; i < frame.size() - offset; i++)
-    {
-        cka += frame[i];
-        ckb += cka;
-    }
-
-    return { cka, ckb };
+    UbxChecksum checksum;
+    if (frame.size() > 2u + offset)
+        checksum.update(frame.subspan(2, frame.size() - 2 - offset));
+    return checksum.value();
 }
 
 bool UbxParser::checkFrame(std::span<const uint8_t> frame)
 {
-    uint8_t cka = 0;
-    uint8_t ckb = 0;
-
-    for (std::size_t i = 2; i < frame.size() - 2; i++)
-    {
-        cka += frame[i];
-        ckb += cka;
-    }
-
-    if (cka == frame[frame.size() - 2] && ckb == frame[frame.size() - 1])
-    {
-        return true;
-    }
+    if (frame.size() < 4)
+        return false;
 
-    return false;
+    UbxChecksum checksum;
+    checksum.update(frame.subspan(2, frame.size() - 4));
+    return checksum.matches(frame.last(2));
 }
 
 }  // JimmyPaputto
@@ -12,6 +12,11 @@
 
 #include "IUbloxConfigRegistry.hpp"
 #include "UbxCallbacks.hpp"
+#include "UbxChecksum.hpp"
+#include "UbxDispatcher.hpp"
+#include "UbxFrameTap.hpp"
+#include "UbxScanner.hpp"
+#include "common/LatencyHistogram.hpp"
 #include "common/Notifier.hpp"
 #include "ubxmsg/IUbxMsg.hpp"
 
@@ -22,26 +27,53 @@ namespace JimmyPaputto
 class UbxParser final
 {
 public:
-    explicit UbxParser(IUbloxConfigRegistry& configRegistry,
+    explicit UbxParser(IUbloxConfigRegistry& configRegistry, Gnss& gnss,
         Notifier& navigationNotifier, Notifier& timeMarkNotifier,
-        bool callbackNotificationEnabled = true);
+        bool callbackNotificationEnabled = true,
+        UbxDispatcher* ubxDispatcher = nullptr,
+        UbxFrameTap* frameTap = nullptr);
 
-    std::vector<uint8_t> parse(std::span<const uint8_t> buffer);
+    // Feeds the next chunk of the receiver byte stream. Complete frames are
+    // dispatched as spans straight into `buffer`, a frame cut at the end of
+    // the chunk is kept by the parser and completed by the following call,
+    // so callers never have to copy leftovers back themselves.
+    void parse(std::span<const uint8_t> buffer);
+    // Same, for bytes read at rxTimestamp (monotonicRawNow()): every frame
+    // completed by them counts the time from the read until its callbacks
+    // are done as its ingress latency
+    void parse(std::span<const uint8_t> buffer,
+        std::chrono::nanoseconds rxTimestamp);
+    void reset();
+    const UbxScanStats& scanStats() const;
+    LatencySnapshot ingressLatency(EUbxMsg msg) const;
 
     static void addChecksum(std::vector<uint8_t>& frame);
     static std::array<uint8_t, 2> checksum(std::span<const uint8_t> frame,
         uint8_t offset = 2);
     static bool checkFrame(std::span<const uint8_t> frame);
 
+    static constexpr uint32_t maxFrameSize = UbxScanner::maxFrameSize;
+
 private:
-    void extractFrames(std::span<const uint8_t> buffer);
+    void scan(std::span<const uint8_t> buffer);
+    std::span<const uint8_t> completeCarriedFrame(
+        std::span<const uint8_t> buffer);
+    void carry(std::span<const uint8_t> bytes);
+    void dispatch(std::span<const uint8_t> frame);
 
-    constexpr static uint16_t maxNumberOfFrames_ = 300;
-    std::array<std::vector<uint8_t>, maxNumberOfFrames_> frames_;
-    std::array<std::vector<uint8_t>, maxNumberOfFrames_>::iterator endFrameIt_;
-    std::vector<uint8_t> unfinishedFrameFromBuffer_;
+    UbxScanner scanner_;
+    std::array<uint8_t, maxFrameSize> carry_;
+    uint32_t carrySize_;
+    UbxChecksum carryChecksum_;
+    uint32_t carryChecksummed_;
+    std::array<uint8_t, maxFrameSize> resync_;
     IUbloxConfigRegistry& configRegistry_;
     UbxCallbacks ubxCallbacks_;
+    UbxDispatcher* ubxDispatcher_;
+    UbxFrameTap* frameTap_;
+    std::chrono::nanoseconds rxTimestamp_;
+    std::array<LatencyHistogram, static_cast<std::size_t>(EUbxMsg::END_UBX)>
+        ingressLatency_;
 };
 
 }  // JimmyPaputto
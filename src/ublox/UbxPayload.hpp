@@ -0,0 +1,64 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef UBX_PAYLOAD_HPP_
+#define UBX_PAYLOAD_HPP_
+
+#include <vector>
+
+#include "DilutionOverPrecision.hpp"
+#include "EUbxMsg.hpp"
+#include "Geofencing.hpp"
+#include "PositionVelocityTime.hpp"
+#include "RFBlock.hpp"
+#include "RFBlockSpectrumData.hpp"
+#include "SatelliteInfo.hpp"
+#include "SystemHealth.hpp"
+#include "TimeMark.hpp"
+
+
+namespace JimmyPaputto
+{
+
+// Decoded type handed to subscribe<EUbxMsg>() callbacks. Messages without
+// a specialization are only reachable through raw-frame subscriptions.
+template<EUbxMsg Msg>
+struct UbxPayload;
+
+template<>
+struct UbxPayload<EUbxMsg::UBX_NAV_PVT> { using type = PositionVelocityTime; };
+
+template<>
+struct UbxPayload<EUbxMsg::UBX_NAV_DOP> { using type = DilutionOverPrecision; };
+
+template<>
+struct UbxPayload<EUbxMsg::UBX_NAV_SAT>
+{
+    using type = std::vector<SatelliteInfo>;
+};
+
+template<>
+struct UbxPayload<EUbxMsg::UBX_NAV_GEOFENCE> { using type = Geofencing::Nav; };
+
+template<>
+struct UbxPayload<EUbxMsg::UBX_MON_RF> { using type = std::vector<RfBlock>; };
+
+template<>
+struct UbxPayload<EUbxMsg::UBX_MON_SPAN>
+{
+    using type = std::vector<RfBlockSpectrumData>;
+};
+
+template<>
+struct UbxPayload<EUbxMsg::UBX_MON_SYS> { using type = SystemHealth; };
+
+template<>
+struct UbxPayload<EUbxMsg::UBX_TIM_TM2> { using type = TimeMark; };
+
+template<EUbxMsg Msg>
+using UbxPayload_t = typename UbxPayload<Msg>::type;
+
+}  // JimmyPaputto
+
+#endif  // UBX_PAYLOAD_HPP_
@@ -0,0 +1,183 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#include "UbxScanner.hpp"
+
+#include <array>
+#include <cstring>
+
+#include "UbxChecksum.hpp"
+#include "UbxClassMsgId.hpp"
+
+#include "common/Utils.hpp"
+
+
+namespace JimmyPaputto
+{
+
+UbxScanner::UbxScanner()
+:   stats_{}
+{
+}
+
+UbxScanner::Candidate UbxScanner::next(std::span<const uint8_t> buffer,
+    std::size_t from)
+{
+    while (true)
+    {
+        const auto offset = findSyncChar(buffer, from);
+        stats_.bytesSkipped += offset - from;
+        if (offset == buffer.size())
+            return { ECandidate::None, offset, 0 };
+
+        const auto remaining = buffer.size() - offset;
+        if (remaining > 1 && buffer[offset + 1] != syncChar2)
+        {
+            stats_.bytesSkipped++;
+            from = offset + 1;
+            continue;
+        }
+
+        if (remaining < headerSize)
+            return { ECandidate::Incomplete, offset, 0 };
+
+        const auto header = buffer.subspan(offset, headerSize);
+        if (!plausibleHeader(header))
+        {
+            countFalseSync();
+            stats_.bytesSkipped += 2;
+            from = offset + 2;
+            continue;
+        }
+
+        const uint32_t size = readLE<uint16_t>(header, 4) + frameOverhead;
+        if (remaining < size)
+            return { ECandidate::Incomplete, offset, size };
+
+        const auto frame = buffer.subspan(offset, size);
+        UbxChecksum checksum;
+        checksum.update(frame.subspan(2, size - 4));
+        if (!checksum.matches(frame.last(2)))
+        {
+            countChecksumFailure();
+            stats_.bytesSkipped += 2;
+            from = offset + 2;
+            continue;
+        }
+
+        return { ECandidate::Frame, offset, size };
+    }
+}
+
+std::size_t UbxScanner::count(std::span<const uint8_t> buffer,
+    const uint8_t msgClass, const uint8_t msgId)
+{
+    std::size_t frames = 0;
+    std::size_t offset = 0;
+    while (true)
+    {
+        const auto candidate = next(buffer, offset);
+        if (candidate.type != ECandidate::Frame)
+            return frames;
+
+        frames += buffer[candidate.offset + 2] == msgClass &&
+            buffer[candidate.offset + 3] == msgId;
+        offset = candidate.offset + candidate.size;
+    }
+}
+
+void UbxScanner::countFalseSync()
+{
+    stats_.falseSyncs++;
+}
+
+void UbxScanner::countChecksumFailure()
+{
+    stats_.checksumFailures++;
+}
+
+void UbxScanner::countTruncatedFrame()
+{
+    stats_.truncatedFrames++;
+}
+
+const UbxScanStats& UbxScanner::stats() const
+{
+    return stats_;
+}
+
+std::size_t UbxScanner::findSyncChar(std::span<const uint8_t> buffer,
+    std::size_t from)
+{
+    // libc memchr is word/SIMD-vectorised (SSE2/AVX2 on x86, ASIMD on
+    // aarch64), so runs of 0xFF SPI idle fill are skipped 16+ bytes a step.
+    if (from >= buffer.size())
+        return buffer.size();
+
+    const auto* found = static_cast<const uint8_t*>(std::memchr(
+        buffer.data() + from, syncChar1, buffer.size() - from));
+    return found ? static_cast<std::size_t>(found - buffer.data())
+        : buffer.size();
+}
+
+bool UbxScanner::knownClass(uint8_t msgClass)
+{
+    switch (msgClass)
+    {
+        case 0x01:  // NAV
+        case 0x02:  // RXM
+        case 0x04:  // INF
+        case 0x05:  // ACK
+        case 0x06:  // CFG
+        case 0x09:  // UPD
+        case 0x0A:  // MON
+        case 0x0D:  // TIM
+        case 0x10:  // ESF
+        case 0x13:  // MGA
+        case 0x21:  // LOG
+        case 0x27:  // SEC
+        case 0x28:  // HNR
+        case 0x29:  // NAV2
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32_t UbxScanner::maxPayloadLength(uint8_t msgClass, uint8_t msgId)
+{
+    // Keyed by EUbxMsg, so the class/id bytes come from ubxClassMsgIds like
+    // they do for the dispatcher
+    constexpr auto maxPayloadLengths = [] {
+        std::array<uint32_t, numberOfUbxMsgs + 1> lengths {};
+        lengths.fill(maxFrameSize - frameOverhead);
+        using enum EUbxMsg;
+        lengths[to_underlying(UBX_ACK_ACK)] = 2;
+        lengths[to_underlying(UBX_ACK_NAK)] = 2;
+        lengths[to_underlying(UBX_NAV_DOP)] = 18;
+        lengths[to_underlying(UBX_NAV_PVT)] = 92;
+        lengths[to_underlying(UBX_NAV_SAT)] = 8 + 12 * 255;  // numSvs is U1
+        // numFences is U1
+        lengths[to_underlying(UBX_NAV_GEOFENCE)] = 8 + 2 * 255;
+        lengths[to_underlying(UBX_MON_RF)] = 4 + 24 * 255;   // nBlocks is U1
+        lengths[to_underlying(UBX_MON_SYS)] = 24;
+        lengths[to_underlying(UBX_TIM_TM2)] = 28;
+        return lengths;
+    }();
+
+    // Unknown ids land on the END_UBX slot, which stays unbounded so that
+    // e.g. RXM-RAWX passes through; unknown classes never get this far
+    return maxPayloadLengths[
+        to_underlying(UbxClassMsgId::lookup(msgClass, msgId))];
+}
+
+bool UbxScanner::plausibleHeader(std::span<const uint8_t> header)
+{
+    // A false sync with a junk class and a long length would otherwise
+    // hold every frame behind it until that many bytes arrived
+    return header[1] == syncChar2 && knownClass(header[2]) &&
+        readLE<uint16_t>(header, 4) <= maxPayloadLength(header[2], header[3]);
+}
+
+}  // JimmyPaputto
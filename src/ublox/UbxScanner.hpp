@@ -0,0 +1,79 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JP_UBX_SCANNER_HPP_
+#define JP_UBX_SCANNER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace JimmyPaputto
+{
+
+struct UbxScanStats
+{
+    uint64_t bytesSkipped;
+    uint64_t falseSyncs;
+    uint64_t checksumFailures;
+    uint64_t truncatedFrames;
+};
+
+// Sync stage of UbxParser: finds frames in the raw byte stream, rejects
+// headers with an undocumented class or a length field that cannot belong
+// to the message they announce before any checksum work is done, and
+// verifies the checksum of complete frames in the same pass.
+class UbxScanner final
+{
+public:
+    enum class ECandidate
+    {
+        Frame,
+        Incomplete,
+        None
+    };
+
+    struct Candidate
+    {
+        ECandidate type;
+        std::size_t offset;
+        uint32_t size;
+    };
+
+    explicit UbxScanner();
+
+    // Next candidate at or after `from`. `Frame` is a checksum-verified
+    // frame of `size` bytes inside `buffer`, `Incomplete` starts at `offset`
+    // and runs past its end.
+    Candidate next(std::span<const uint8_t> buffer, std::size_t from);
+    // Checksum-verified frames of one message in `buffer`
+    std::size_t count(std::span<const uint8_t> buffer, uint8_t msgClass,
+        uint8_t msgId);
+
+    void countFalseSync();
+    void countChecksumFailure();
+    void countTruncatedFrame();
+    const UbxScanStats& stats() const;
+
+    static std::size_t findSyncChar(std::span<const uint8_t> buffer,
+        std::size_t from);
+    // One of the message classes u-blox documents for UBX
+    static bool knownClass(uint8_t msgClass);
+    static uint32_t maxPayloadLength(uint8_t msgClass, uint8_t msgId);
+    static bool plausibleHeader(std::span<const uint8_t> header);
+
+    static constexpr uint8_t syncChar1 = 0xB5;
+    static constexpr uint8_t syncChar2 = 0x62;
+    static constexpr uint8_t headerSize = 6;
+    static constexpr uint8_t frameOverhead = 8;
+    static constexpr uint32_t maxFrameSize = 8192;
+
+private:
+    UbxScanStats stats_;
+};
+
+}  // JimmyPaputto
+
+#endif  // JP_UBX_SCANNER_HPP_
@@ -30,6 +30,7 @@ public:
 
     void deserialize(std::span<const uint8_t> serialized) override
     {
+        iTOW_ = readLE<uint32_t>(serialized, 6);
         dop_.geometric = readLE<uint16_t>(serialized, 10) * 0.01;
         dop_.position = readLE<uint16_t>(serialized, 12) * 0.01;
         dop_.time = readLE<uint16_t>(serialized, 14) * 0.01;
@@ -39,12 +40,18 @@ public:
         dop_.easting = readLE<uint16_t>(serialized, 22) * 0.01;
     }
 
+    uint32_t iTOW() const
+    {
+        return iTOW_;
+    }
+
     DilutionOverPrecision dop() const
     {
         return dop_;
     }
 
 private:
+    uint32_t iTOW_;
     DilutionOverPrecision dop_;
 };
 
@@ -31,6 +31,7 @@ public:
 
     void deserialize(std::span<const uint8_t> serialized) override
     {
+        iTOW_ = readLE<uint32_t>(serialized, 6);
         pvt_.date.day = serialized[13];
         pvt_.date.month = serialized[12];
         pvt_.date.year = readLE<uint16_t>(serialized, 10);
@@ -41,6 +42,7 @@ public:
         pvt_.utc.ss = serialized[16];
         pvt_.utc.valid = getBit(serialized[17], 0);
         pvt_.utc.accuracy = readLE<int32_t>(serialized, 18);
+        pvt_.utc.nano = readLE<int32_t>(serialized, 22);
 
         const auto fixType = EFixType(serialized[26]);
         pvt_.fixType = fixType;
@@ -82,12 +84,18 @@ public:
         pvt_.headingAccuracy = readLE<uint32_t>(serialized, 78) / 100000.0;
     }
 
+    uint32_t iTOW() const
+    {
+        return iTOW_;
+    }
+
     PositionVelocityTime pvt() const
     {
         return pvt_;
     }
 
 private:
+    uint32_t iTOW_;
     PositionVelocityTime pvt_;
 };
 
@@ -32,6 +32,7 @@ public:
 
     void deserialize(std::span<const uint8_t> serialized) override
     {
+        iTOW_ = readLE<uint32_t>(serialized, 6);
         const uint8_t numSvs = serialized[11];
 
         satellites_.clear();
@@ -67,12 +68,18 @@ public:
         }
     }
 
+    uint32_t iTOW() const
+    {
+        return iTOW_;
+    }
+
     const std::vector<SatelliteInfo>& satellites() const
     {
         return satellites_;
     }
 
 private:
+    uint32_t iTOW_;
     std::vector<SatelliteInfo> satellites_;
 };
 
@@ -0,0 +1,174 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JP_TESTS_SIMULATED_SPIDEV_HPP_
+#define JP_TESTS_SIMULATED_SPIDEV_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <linux/spi/spidev.h>
+
+#include "UbxCapture.hpp"
+#include "ublox/Spidev.hpp"
+
+
+namespace JimmyPaputto::test
+{
+
+// spidev with a u-blox receiver behind it: answers UBX-MON-VER polls
+// `replyDelay` SPI messages after the one carrying the poll, clocks out
+// 0xFF when it has nothing to send and, above errorAbove_Hz, flips a bit
+// in every `errorInterval`-th byte it returns.
+class SimulatedSpidev final : public ISpidev
+{
+public:
+    struct Transfer
+    {
+        uint32_t len;
+        uint32_t speed_Hz;
+        bool idleTx;    // tx_buf was not a caller buffer
+        uintptr_t txAddress;
+    };
+
+    explicit SimulatedSpidev(const uint32_t errorAbove_Hz = UINT32_MAX,
+        const uint32_t errorInterval = 31, const uint32_t replyDelay = 0)
+    :   errorAbove_Hz_(errorAbove_Hz),
+        errorInterval_(errorInterval),
+        replyDelay_(replyDelay)
+    {
+    }
+
+    bool open(const char*) override
+    {
+        return true;
+    }
+
+    void close() override
+    {
+    }
+
+    int ioctl(unsigned long request, void* arg) override
+    {
+        if (request == SPI_IOC_WR_MODE)
+            return 0;
+        if (request == SPI_IOC_WR_BITS_PER_WORD)
+        {
+            bitsPerWord = *static_cast<uint8_t*>(arg);
+            return 0;
+        }
+        if (request == SPI_IOC_WR_MAX_SPEED_HZ)
+        {
+            maxSpeed_Hz = *static_cast<uint32_t*>(arg);
+            return 0;
+        }
+
+        const bool message = _IOC_TYPE(request) == SPI_IOC_MAGIC &&
+            _IOC_NR(request) == 0 && _IOC_DIR(request) == _IOC_WRITE;
+        if (!message)
+            return -1;
+
+        const auto count = _IOC_SIZE(request) / sizeof(spi_ioc_transfer);
+        const auto* transfers = static_cast<const spi_ioc_transfer*>(arg);
+        messages.emplace_back();
+        releaseReplies();
+        int total = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            transfer(transfers[i]);
+            total += transfers[i].len;
+        }
+        return total;
+    }
+
+    // Filler the receiver sends on its own before any poll is answered
+    void queue(const std::vector<uint8_t>& bytes)
+    {
+        pending_.insert(pending_.end(), bytes.begin(), bytes.end());
+    }
+
+    uint8_t bitsPerWord = 8;
+    uint32_t maxSpeed_Hz = 0;
+    std::vector<std::vector<Transfer>> messages;
+    std::vector<uint8_t> received;
+
+private:
+    void transfer(const spi_ioc_transfer& transfer)
+    {
+        const auto speed_Hz = transfer.speed_hz ? transfer.speed_hz
+            : maxSpeed_Hz;
+        const auto* tx = reinterpret_cast<const uint8_t*>(transfer.tx_buf);
+        auto* rx = reinterpret_cast<uint8_t*>(transfer.rx_buf);
+        const bool idleTx = std::all_of(tx, tx + transfer.len,
+            [](const uint8_t byte) { return byte == 0xFF; });
+        messages.back().push_back(
+            { transfer.len, speed_Hz, idleTx, transfer.tx_buf });
+
+        for (uint32_t i = 0; i < transfer.len; i++)
+        {
+            uint8_t out = 0xFF;
+            if (!pending_.empty())
+            {
+                out = pending_.front();
+                pending_.pop_front();
+            }
+            if (speed_Hz > errorAbove_Hz_ && ++clocked_ % errorInterval_ == 0)
+                out ^= 0x10;
+            if (rx)
+                rx[i] = out;
+
+            if (tx[i] != 0xFF)
+                received.push_back(tx[i]);
+            answerPoll();
+        }
+    }
+
+    void answerPoll()
+    {
+        static const std::vector<uint8_t> monVerPoll =
+            { 0xB5, 0x62, 0x0A, 0x04, 0x00, 0x00, 0x0E, 0x34 };
+        if (received.size() < monVerPoll.size() ||
+            !std::equal(monVerPoll.begin(), monVerPoll.end(),
+                received.end() - monVerPoll.size()))
+        {
+            return;
+        }
+
+        std::vector<uint8_t> payload(40 + 10 + 30, 0);
+        const std::string sw = "ROM SPG 5.10 (7b202e)";
+        const std::string hw = "000A0000";
+        std::copy(sw.begin(), sw.end(), payload.begin());
+        std::copy(hw.begin(), hw.end(), payload.begin() + 40);
+        delayed_.push_back({ replyDelay_, ubxFrame(0x0A, 0x04, payload) });
+        received.clear();
+        if (replyDelay_ == 0)
+            releaseReplies();
+    }
+
+    // Replies whose delay ran out go out from this message on
+    void releaseReplies()
+    {
+        while (!delayed_.empty() && delayed_.front().first == 0)
+        {
+            queue(delayed_.front().second);
+            delayed_.pop_front();
+        }
+        for (auto& reply : delayed_)
+            reply.first--;
+    }
+
+    const uint32_t errorAbove_Hz_;
+    const uint32_t errorInterval_;
+    const uint32_t replyDelay_;
+    std::deque<std::pair<uint32_t, std::vector<uint8_t>>> delayed_;
+    uint64_t clocked_ = 0;
+    std::deque<uint8_t> pending_;
+};
+
+}  // JimmyPaputto::test
+
+#endif  // JP_TESTS_SIMULATED_SPIDEV_HPP_
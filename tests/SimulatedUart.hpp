@@ -0,0 +1,155 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JP_TESTS_SIMULATED_UART_HPP_
+#define JP_TESTS_SIMULATED_UART_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "UbxCapture.hpp"
+#include "common/Utils.hpp"
+#include "ublox/UbxCfgKeys.hpp"
+#include "ublox/UbxScanner.hpp"
+
+
+namespace JimmyPaputto::test
+{
+
+// Pseudo-terminal standing in for /dev/ttyAMA0: UartDriver opens the
+// slave side, the test reads and writes the master side
+class Pty
+{
+public:
+    Pty()
+    :   master_(posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK))
+    {
+        if (master_ >= 0 && grantpt(master_) == 0 && unlockpt(master_) == 0)
+            slave_ = ptsname(master_);
+    }
+
+    ~Pty()
+    {
+        if (master_ >= 0)
+            close(master_);
+    }
+
+    bool isOpen() const { return !slave_.empty(); }
+    const char* slave() const { return slave_.c_str(); }
+    int master() const { return master_; }
+
+    // Reads until `size` bytes came or nothing came for `idleMs`
+    std::vector<uint8_t> read(std::size_t size,
+        std::chrono::microseconds pause = {}, int idleMs = 200)
+    {
+        std::vector<uint8_t> out;
+        uint8_t chunk[512];
+        while (out.size() < size)
+        {
+            pollfd pfd { master_, POLLIN, 0 };
+            if (poll(&pfd, 1, idleMs) <= 0)
+                break;
+            const auto bytes = ::read(master_, chunk, sizeof(chunk));
+            if (bytes <= 0)
+                break;
+            out.insert(out.end(), chunk, chunk + bytes);
+            std::this_thread::sleep_for(pause);
+        }
+        return out;
+    }
+
+private:
+    int master_;
+    std::string slave_;
+};
+
+// u-blox receiver behind a Pty: answers UBX-MON-VER polls and follows
+// CFG-UART1-BAUDRATE from CFG-VALSET. A pty has no line rate, so above
+// errorAbove it corrupts every reply the way a too fast line would.
+class SimulatedUartReceiver final
+{
+public:
+    explicit SimulatedUartReceiver(Pty& pty,
+        const uint32_t errorAbove = UINT32_MAX)
+    :   pty_(pty),
+        errorAbove_(errorAbove),
+        baudrate_(115200),
+        thread_([this](std::stop_token stoken) { serve(stoken); })
+    {
+    }
+
+    uint32_t baudrate() const { return baudrate_; }
+    uint32_t baudrateChanges() const { return baudrateChanges_; }
+
+private:
+    void serve(std::stop_token stoken)
+    {
+        std::vector<uint8_t> inbox;
+        while (!stoken.stop_requested())
+        {
+            const auto bytes = pty_.read(SIZE_MAX, {}, 10);
+            inbox.insert(inbox.end(), bytes.begin(), bytes.end());
+
+            UbxScanner scanner;
+            std::size_t offset = 0;
+            while (true)
+            {
+                const auto candidate = scanner.next(inbox, offset);
+                if (candidate.type != UbxScanner::ECandidate::Frame)
+                {
+                    offset = candidate.offset;
+                    break;
+                }
+                handle(std::span<const uint8_t>(inbox).subspan(
+                    candidate.offset, candidate.size));
+                offset = candidate.offset + candidate.size;
+            }
+            inbox.erase(inbox.begin(), inbox.begin() + offset);
+        }
+    }
+
+    void handle(std::span<const uint8_t> frame)
+    {
+        const bool monVerPoll = frame[2] == 0x0A && frame[3] == 0x04;
+        if (monVerPoll)
+        {
+            std::vector<uint8_t> payload(40 + 10 + 30, 0);
+            const std::string sw = "ROM SPG 5.10 (7b202e)";
+            std::copy(sw.begin(), sw.end(), payload.begin());
+            auto reply = ubxFrame(0x0A, 0x04, payload);
+            if (baudrate_ > errorAbove_)
+                reply[20] ^= 0x10;
+            ::write(pty_.master(), reply.data(), reply.size());
+            return;
+        }
+
+        // version, layer, 2 reserved, then key-value pairs
+        const bool valset = frame[2] == 0x06 && frame[3] == 0x8A;
+        if (valset && frame.size() >= 6 + 4 + 8 + 2 &&
+            readLE<uint32_t>(frame, 10) == UbxCfgKeys::CFG_UART1_BAUDRATE)
+        {
+            baudrate_ = readLE<uint32_t>(frame, 14);
+            baudrateChanges_++;
+        }
+    }
+
+    Pty& pty_;
+    const uint32_t errorAbove_;
+    std::atomic<uint32_t> baudrate_;
+    std::atomic<uint32_t> baudrateChanges_ = 0;
+    std::jthread thread_;
+};
+
+}  // JimmyPaputto::test
+
+#endif  // JP_TESTS_SIMULATED_UART_HPP_
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "common/GpioInterruptLine.hpp"
+#include "common/Utils.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+// gpio-sim chip set up through configfs; without the gpio-sim module and
+// root the tests are skipped
+class GpioSim
+{
+public:
+    GpioSim()
+    {
+        namespace fs = std::filesystem;
+        const fs::path root = "/sys/kernel/config/gpio-sim";
+        std::error_code ec;
+        if (!fs::is_directory(root, ec))
+            return;
+
+        dir_ = root / ("gnsshat-" + std::to_string(getpid()));
+        if (!fs::create_directory(dir_, ec) ||
+            !fs::create_directory(dir_ / "bank0", ec))
+        {
+            return;
+        }
+        if (!write(dir_ / "bank0" / "num_lines", "4") ||
+            !write(dir_ / "live", "1"))
+        {
+            return;
+        }
+        devName_ = readLine(dir_ / "dev_name");
+        chipName_ = readLine(dir_ / "bank0" / "chip_name");
+    }
+
+    ~GpioSim()
+    {
+        if (dir_.empty())
+            return;
+        std::error_code ec;
+        write(dir_ / "live", "0");
+        std::filesystem::remove(dir_ / "bank0", ec);
+        std::filesystem::remove(dir_, ec);
+    }
+
+    bool isLive() const { return !devName_.empty() && !chipName_.empty(); }
+
+    std::string chip() const
+    {
+#if LIBGPIOD_VERSION >= 2
+        return "/dev/" + chipName_;
+#else
+        return chipName_;
+#endif
+    }
+
+    // Pulling the input line up gives an edge as if from outside
+    bool pull(unsigned int line, bool up) const
+    {
+        return write(std::filesystem::path("/sys/devices/platform") /
+            devName_ / chipName_ / ("sim_gpio" + std::to_string(line)) /
+            "pull", up ? "pull-up" : "pull-down");
+    }
+
+private:
+    static bool write(const std::filesystem::path& path,
+        const std::string& value)
+    {
+        std::ofstream file(path);
+        file << value;
+        file.flush();
+        return file.good();
+    }
+
+    static std::string readLine(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    std::filesystem::path dir_;
+    std::string devName_;
+    std::string chipName_;
+};
+
+constexpr int64_t oneSecond_ns = 1'000'000'000;
+
+}  // namespace
+
+TEST(GpioInterruptLine, StampsEdgeWithKernelTimestamp)
+{
+    GpioSim sim;
+    if (!sim.isLive())
+        GTEST_SKIP() << "gpio-sim not available";
+
+    const auto chip = sim.chip();
+    GpioInterruptLine line(1, GpioInterruptLine::Edge::Rising,
+        "gnsshat-test", chip.c_str());
+    EXPECT_FALSE(line.lastEdge().valid());
+
+    const auto before = monotonicNow().count();
+    ASSERT_TRUE(sim.pull(1, true));
+    ASSERT_EQ(line.waitEvent(oneSecond_ns),
+        GpioInterruptLine::EventType::Rising);
+
+    const auto edge = line.lastEdge();
+    EXPECT_EQ(edge.sequence, 1u);
+    EXPECT_GE(edge.monotonic_ns, before);
+    EXPECT_LE(edge.monotonic_ns, edge.handled_ns);
+    EXPECT_GE(edge.wakeupLatency_ns(), 0);
+
+    const auto realtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    EXPECT_LE(edge.realtime_ns, realtime);
+    EXPECT_GT(edge.realtime_ns, realtime - oneSecond_ns);
+}
+
+TEST(GpioInterruptLine, CountsEdgesInOrder)
+{
+    GpioSim sim;
+    if (!sim.isLive())
+        GTEST_SKIP() << "gpio-sim not available";
+
+    const auto chip = sim.chip();
+    GpioInterruptLine line(2, GpioInterruptLine::Edge::Both,
+        "gnsshat-test", chip.c_str());
+
+    ASSERT_TRUE(sim.pull(2, true));
+    ASSERT_EQ(line.waitEvent(oneSecond_ns),
+        GpioInterruptLine::EventType::Rising);
+    const auto rising = line.lastEdge();
+
+    ASSERT_TRUE(sim.pull(2, false));
+    ASSERT_EQ(line.waitEvent(oneSecond_ns),
+        GpioInterruptLine::EventType::Falling);
+    const auto falling = line.lastEdge();
+
+    EXPECT_EQ(falling.sequence, rising.sequence + 1);
+    EXPECT_GT(falling.monotonic_ns, rising.monotonic_ns);
+    EXPECT_EQ(line.waitEvent(oneSecond_ns / 20),
+        GpioInterruptLine::EventType::Timeout);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "UbxCapture.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::test;
+
+// Base and rover in one process: each receiver keeps its own state
+TEST(MultiInstance, ConcurrentReceiversKeepSeparateState)
+{
+    struct Setup
+    {
+        uint8_t numSvs;
+        uint32_t epochPeriodMs;
+        uint32_t readSize;
+    };
+    const std::vector<Setup> setups = {
+        { 12, 100, 1024 },
+        { 30, 40, 100 },
+        { 5, 1000, 7 },
+        { 20, 200, 1024 }
+    };
+
+    std::vector<UbxCapture> captures;
+    std::vector<std::unique_ptr<ReplayReceiver>> receivers;
+    std::vector<std::shared_ptr<NavigationSubscription>> subscriptions;
+    for (const auto& setup : setups)
+    {
+        captures.push_back(syntheticCapture(500,
+            setup.readSize == 1024 ? 1024 : 0, setup.numSvs,
+            setup.epochPeriodMs));
+        receivers.push_back(std::make_unique<ReplayReceiver>());
+        subscriptions.push_back(receivers.back()->gnss.subscribe(1024,
+            EOverflowPolicy::DropOldest));
+    }
+
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t i = 0; i < setups.size(); i++)
+        {
+            threads.emplace_back([&, i] {
+                receivers[i]->replay(captures[i].bytes, setups[i].readSize);
+            });
+        }
+    }
+
+    for (std::size_t i = 0; i < setups.size(); i++)
+    {
+        const auto& gnss = receivers[i]->gnss;
+        const auto epoch = gnss.navigationEpoch();
+        EXPECT_EQ(epoch.sequence, captures[i].epochs) << i;
+        EXPECT_EQ(epoch.iTOW,
+            (captures[i].epochs - 1) * setups[i].epochPeriodMs) << i;
+        EXPECT_TRUE(epoch.complete) << i;
+        EXPECT_EQ(epoch.navigation.satellites.size(), setups[i].numSvs) << i;
+        EXPECT_EQ(epoch.navigation.pvt.visibleSatellites, setups[i].numSvs)
+            << i;
+
+        const auto stats = subscriptions[i]->stats();
+        EXPECT_EQ(stats.delivered, captures[i].epochs) << i;
+        EXPECT_EQ(stats.dropped, 0u) << i;
+        EXPECT_EQ(receivers[i]->parser.scanStats().checksumFailures, 0u) << i;
+    }
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "ublox/Gnss.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+PositionVelocityTime pvtWithSatellites(uint8_t visibleSatellites)
+{
+    PositionVelocityTime pvt {};
+    pvt.visibleSatellites = visibleSatellites;
+    return pvt;
+}
+
+}  // namespace
+
+
+TEST(NavigationEpoch, GroupsMessagesByITowAndFlagsPartialEpochs)
+{
+    Gnss gnss;
+    const auto startSequence = gnss.navigationEpoch().sequence;
+    const std::vector<SatelliteInfo> satellites(5);
+
+    // First epoch: its message set is not known yet, so only the first
+    // message of the next epoch closes it
+    EXPECT_FALSE(gnss.pvt(pvtWithSatellites(5), 1000));
+    EXPECT_FALSE(gnss.dop({}, 1000));
+    EXPECT_FALSE(gnss.satellites(satellites, 1000));
+    EXPECT_EQ(gnss.navigationEpoch().sequence, startSequence);
+
+    EXPECT_TRUE(gnss.pvt(pvtWithSatellites(6), 2000));
+    auto epoch = gnss.navigationEpoch();
+    EXPECT_EQ(epoch.sequence, startSequence + 1);
+    EXPECT_EQ(epoch.iTOW, 1000u);
+    EXPECT_EQ(epoch.navigation.pvt.visibleSatellites, 5);
+    EXPECT_TRUE(epoch.arrived(EUbxMsg::UBX_NAV_PVT));
+    EXPECT_TRUE(epoch.arrived(EUbxMsg::UBX_NAV_SAT));
+    EXPECT_FALSE(epoch.arrived(EUbxMsg::UBX_MON_RF));
+
+    // The second epoch closes once complete, without waiting for a third
+    EXPECT_FALSE(gnss.dop({}, 2000));
+    EXPECT_TRUE(gnss.satellites(satellites, 2000));
+    epoch = gnss.navigationEpoch();
+    EXPECT_EQ(epoch.sequence, startSequence + 2);
+    EXPECT_EQ(epoch.iTOW, 2000u);
+    EXPECT_TRUE(epoch.complete);
+    EXPECT_EQ(epoch.navigation.pvt.visibleSatellites, 6);
+
+    // No NAV-SAT: epoch 3000 goes out as incomplete
+    EXPECT_FALSE(gnss.pvt(pvtWithSatellites(7), 3000));
+    EXPECT_FALSE(gnss.dop({}, 3000));
+    EXPECT_FALSE(gnss.rfBlocks({}));
+    EXPECT_TRUE(gnss.pvt(pvtWithSatellites(8), 4000));
+    epoch = gnss.navigationEpoch();
+    EXPECT_EQ(epoch.iTOW, 3000u);
+    EXPECT_FALSE(epoch.complete);
+    EXPECT_FALSE(epoch.arrived(EUbxMsg::UBX_NAV_SAT));
+    EXPECT_TRUE(epoch.arrived(EUbxMsg::UBX_MON_RF));
+    EXPECT_EQ(epoch.navigation.pvt.visibleSatellites, 7);
+    EXPECT_EQ(gnss.navigation().pvt.visibleSatellites, 7);
+}
+
+// TX-ready edge from when the epoch opened, timepulse from when it closed
+TEST(NavigationEpoch, CarriesGpioEdgesIntoEpoch)
+{
+    Gnss gnss;
+    const std::vector<SatelliteInfo> satellites(5);
+    const auto edge = [](uint64_t sequence, int64_t monotonic_ns) {
+        EdgeTimestamp timestamp;
+        timestamp.sequence = sequence;
+        timestamp.monotonic_ns = monotonic_ns;
+        return timestamp;
+    };
+
+    gnss.txReadyEdge(edge(1, 1'000));
+    EXPECT_FALSE(gnss.pvt({}, 1000));
+    gnss.txReadyEdge(edge(2, 2'000));
+    gnss.timepulseEdge(edge(7, 1'500));
+    EXPECT_FALSE(gnss.satellites(satellites, 1000));
+    EXPECT_TRUE(gnss.pvt({}, 2000));
+
+    const auto epoch = gnss.navigationEpoch();
+    EXPECT_EQ(epoch.iTOW, 1000u);
+    EXPECT_EQ(epoch.txReady.sequence, 1u);
+    EXPECT_EQ(epoch.txReady.monotonic_ns, 1'000);
+    EXPECT_EQ(epoch.timepulse.sequence, 7u);
+    EXPECT_GT(epoch.published_ns, 0);
+    EXPECT_EQ(gnss.timepulseEdge().monotonic_ns, 1'500);
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/BoundedQueue.hpp"
+#include "ublox/Gnss.hpp"
+#include "ublox/NavigationSubscription.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+NavigationEpoch epochNumber(uint64_t sequence)
+{
+    NavigationEpoch epoch;
+    epoch.sequence = sequence;
+    return epoch;
+}
+
+}  // namespace
+
+
+TEST(BoundedQueue, FifoUpToCapacity)
+{
+    BoundedQueue<int> queue(3);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_TRUE(queue.tryPush(3));
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = 0;
+    EXPECT_TRUE(queue.discard());
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(queue.tryPush(5));
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 5);
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(BoundedQueue, HoldsAtLeastTwoEntries)
+{
+    BoundedQueue<int> queue(1);
+    EXPECT_EQ(queue.capacity(), 2u);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+}
+
+TEST(NavigationSubscription, DropOldestKeepsLatestEpochs)
+{
+    NavigationSubscription subscription(2, EOverflowPolicy::DropOldest);
+    for (uint64_t i = 1; i <= 5; i++)
+        subscription.push(epochNumber(i));
+
+    NavigationEpoch epoch;
+    ASSERT_TRUE(subscription.tryPop(epoch));
+    EXPECT_EQ(epoch.sequence, 4u);
+    ASSERT_TRUE(subscription.tryPop(epoch));
+    EXPECT_EQ(epoch.sequence, 5u);
+    EXPECT_FALSE(subscription.tryPop(epoch));
+
+    const auto stats = subscription.stats();
+    EXPECT_EQ(stats.delivered, 5u);
+    EXPECT_EQ(stats.consumed, 2u);
+    EXPECT_EQ(stats.dropped, 3u);
+    EXPECT_EQ(stats.lag, 0u);
+    EXPECT_EQ(stats.maxLag, 2u);
+}
+
+TEST(NavigationSubscription, DropNewestKeepsQueuedEpochs)
+{
+    NavigationSubscription subscription(2, EOverflowPolicy::DropNewest);
+    for (uint64_t i = 1; i <= 5; i++)
+        subscription.push(epochNumber(i));
+
+    NavigationEpoch epoch;
+    ASSERT_TRUE(subscription.tryPop(epoch));
+    EXPECT_EQ(epoch.sequence, 1u);
+
+    const auto stats = subscription.stats();
+    EXPECT_EQ(stats.delivered, 2u);
+    EXPECT_EQ(stats.dropped, 3u);
+    EXPECT_EQ(stats.lag, 1u);
+}
+
+TEST(NavigationSubscription, BlockWaitsForConsumer)
+{
+    NavigationSubscription subscription(2, EOverflowPolicy::Block);
+    std::jthread producer([&] {
+        for (uint64_t i = 1; i <= 100; i++)
+            subscription.push(epochNumber(i));
+    });
+
+    NavigationEpoch epoch;
+    for (uint64_t i = 1; i <= 100; i++)
+    {
+        ASSERT_TRUE(subscription.pop(epoch));
+        EXPECT_EQ(epoch.sequence, i);
+    }
+    producer.join();
+    EXPECT_EQ(subscription.stats().dropped, 0u);
+}
+
+TEST(NavigationSubscription, PopReturnsOnStop)
+{
+    NavigationSubscription subscription(4, EOverflowPolicy::DropOldest);
+    std::stop_source stopSource;
+    std::jthread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        stopSource.request_stop();
+    });
+
+    NavigationEpoch epoch;
+    EXPECT_FALSE(subscription.pop(epoch, stopSource.get_token()));
+}
+
+TEST(NavigationSubscription, EverySubscriberGetsEveryEpoch)
+{
+    Gnss gnss;
+    auto fast = gnss.subscribe(4, EOverflowPolicy::DropOldest);
+    auto slow = gnss.subscribe(64, EOverflowPolicy::DropOldest);
+    const auto startSequence = gnss.navigationEpoch().sequence;
+
+    for (uint32_t i = 0; i < 10; i++)
+        gnss.pvt({}, 1000 + i * 50);
+
+    NavigationEpoch epoch;
+    uint32_t fastCount = 0;
+    while (fast->tryPop(epoch))
+        fastCount++;
+    uint32_t slowCount = 0;
+    while (slow->tryPop(epoch))
+        slowCount++;
+
+    const auto published = gnss.navigationEpoch().sequence - startSequence;
+    EXPECT_GE(published, 9u);
+    EXPECT_EQ(slowCount, published);
+    EXPECT_EQ(fastCount, 4u);
+    EXPECT_EQ(fast->stats().dropped, published - 4);
+    EXPECT_EQ(epoch.sequence, gnss.navigationEpoch().sequence);
+
+    fast->unsubscribe();
+    gnss.pvt({}, 2000);
+    EXPECT_FALSE(fast->tryPop(epoch));
+    slow->unsubscribe();
+}
+
+TEST(NavigationSubscription, DroppedBlockSubscriptionDoesNotStall)
+{
+    Gnss gnss;
+    auto blocking = gnss.subscribe(2, EOverflowPolicy::Block);
+    auto other = gnss.subscribe(64, EOverflowPolicy::DropOldest);
+    const auto startSequence = gnss.navigationEpoch().sequence;
+
+    std::jthread receiver([&gnss] {
+        for (uint32_t i = 0; i < 10; i++)
+            gnss.pvt({}, 1000 + i * 50);
+    });
+    // Let the receiver fill the queue and block on it
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    blocking.reset();
+    receiver.join();
+
+    gnss.pvt({}, 2000);
+    const auto published = gnss.navigationEpoch().sequence - startSequence;
+    EXPECT_GE(published, 10u);
+
+    NavigationEpoch epoch;
+    uint32_t received = 0;
+    while (other->tryPop(epoch))
+        received++;
+    EXPECT_EQ(received, published);
+}
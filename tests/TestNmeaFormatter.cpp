@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <functional>
+#include <string>
+
+#include "ublox/NmeaFormatter.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+SatelliteInfo sat(EGnssId gnssId, uint8_t svId, int8_t elevation,
+    int16_t azimuth, uint8_t cno, bool usedInFix)
+{
+    SatelliteInfo info {};
+    info.gnssId = gnssId;
+    info.svId = svId;
+    info.elevation = elevation;
+    info.azimuth = azimuth;
+    info.cno = cno;
+    info.usedInFix = usedInFix;
+    return info;
+}
+
+// Warsaw, 2025-03-15 12:30:45 UTC
+Navigation navigation()
+{
+    Navigation nav;
+    nav.pvt = {};
+    nav.dop = {};
+    nav.pvt.fixQuality = EFixQuality::GpsFix2D3D;
+    nav.pvt.fixStatus = EFixStatus::Active;
+    nav.pvt.fixType = EFixType::Fix3D;
+    nav.pvt.utc = { 12, 30, 45, true, 20, 0 };
+    nav.pvt.date = { 15, 3, 2025, true };
+    nav.pvt.latitude = 52.2297;
+    nav.pvt.longitude = 21.0122;
+    nav.pvt.altitude = 150.61f;
+    nav.pvt.altitudeMSL = 110.27f;
+    nav.pvt.speedOverGround = 2.5f;
+    nav.pvt.heading = 87.3f;
+    nav.pvt.visibleSatellites = 14;
+    nav.pvt.horizontalAccuracy = 1.5f;
+    nav.pvt.verticalAccuracy = 2.25f;
+    nav.dop.position = 1.47f;
+    nav.dop.horizontal = 0.84f;
+    nav.dop.vertical = 1.21f;
+    nav.satellites = {
+        sat(EGnssId::GPS, 5, 45, 120, 42, true),
+        sat(EGnssId::GPS, 12, 8, 45, 0, true),
+        sat(EGnssId::GLONASS, 3, 60, 310, 38, true),
+        sat(EGnssId::SBAS, 123, 30, 200, 35, false),
+        sat(EGnssId::GPS, 29, 70, 300, 44, false),
+        sat(EGnssId::Galileo, 11, 5, 7, 20, true),
+        sat(EGnssId::IMES, 1, 10, 10, 10, true),
+        sat(EGnssId::GPS, 31, 15, 80, 30, false)
+    };
+    return nav;
+}
+
+template<typename Format>
+std::string format(const Navigation& nav, Format&& sentence)
+{
+    std::array<char, 1024> buffer;
+    NmeaFormatter formatter(buffer);
+    std::invoke(sentence, formatter, nav);
+    EXPECT_EQ(formatter.dropped(), 0u);
+    return std::string(formatter.sentences());
+}
+
+}  // namespace
+
+TEST(NmeaFormatter, Gga)
+{
+    EXPECT_EQ(format(navigation(), &NmeaFormatter::gga),
+        "$GNGGA,123045.00,5213.78200,N,02100.73200,E,1,14,0.8,110.3,M,"
+        "40.3,M,,*77\r\n");
+}
+
+TEST(NmeaFormatter, GgaSouthWestWithoutFix)
+{
+    auto nav = navigation();
+    nav.pvt.fixQuality = EFixQuality::Invalid;
+    nav.pvt.visibleSatellites = 0;
+    nav.pvt.utc = { 23, 59, 59, true, 20, 100'000'000 };
+    nav.pvt.latitude = -33.8688;
+    nav.pvt.longitude = -151.2093;
+    EXPECT_EQ(format(nav, &NmeaFormatter::gga),
+        "$GNGGA,235959.10,3352.12800,S,15112.55800,W,0,0,0.8,110.3,M,"
+        "40.3,M,,*42\r\n");
+}
+
+TEST(NmeaFormatter, Rmc)
+{
+    EXPECT_EQ(format(navigation(), &NmeaFormatter::rmc),
+        "$GNRMC,123045.00,A,5213.78200,N,02100.73200,E,4.9,87.3,150325,,,"
+        "*3C\r\n");
+}
+
+// One sentence per system, GLONASS PRNs offset by 64, IMES skipped
+TEST(NmeaFormatter, GsaPerSystem)
+{
+    EXPECT_EQ(format(navigation(), &NmeaFormatter::gsa),
+        "$GNGSA,A,3,5,12,,,,,,,,,,,1.5,0.8,1.2,1*08\r\n"
+        "$GNGSA,A,3,67,,,,,,,,,,,,1.5,0.8,1.2,2*3C\r\n"
+        "$GNGSA,A,3,11,,,,,,,,,,,,1.5,0.8,1.2,3*3C\r\n");
+}
+
+TEST(NmeaFormatter, GsaWithoutUsedSatellites)
+{
+    auto nav = navigation();
+    nav.pvt.fixType = EFixType::NoFix;
+    nav.satellites.clear();
+    EXPECT_EQ(format(nav, &NmeaFormatter::gsa),
+        "$GNGSA,A,1,,,,,,,,,,,,,1.5,0.8,1.2,1*3C\r\n");
+}
+
+// Four satellites per sentence, SBAS with GPS, no C/N0 is an empty field
+TEST(NmeaFormatter, GsvSplitsEveryFourSatellites)
+{
+    EXPECT_EQ(format(navigation(), &NmeaFormatter::gsv),
+        "$GPGSV,2,1,5,05,45,120,42,12,8,045,,123,30,200,35,29,70,300,44"
+        "*4C\r\n"
+        "$GPGSV,2,2,5,31,15,080,30*71\r\n"
+        "$GLGSV,1,1,1,67,60,310,38*6A\r\n"
+        "$GAGSV,1,1,1,11,5,007,20*59\r\n");
+}
+
+TEST(NmeaFormatter, Gst)
+{
+    EXPECT_EQ(format(navigation(), &NmeaFormatter::gst),
+        "$GNGST,123045.00,,,,,1.061,1.061,2.250*4D\r\n");
+}
+
+TEST(NmeaFormatter, Zda)
+{
+    auto nav = navigation();
+    EXPECT_EQ(format(nav, &NmeaFormatter::zda),
+        "$GNZDA,123045.00,15,03,2025,00,00*7B\r\n");
+
+    nav.pvt.date.valid = false;
+    EXPECT_EQ(format(nav, &NmeaFormatter::zda),
+        "$GNZDA,123045.00,,,,00,00*79\r\n");
+}
+
+// nano just below zero: ss is already rounded up
+TEST(NmeaFormatter, TimeRoundsNanoToHundredths)
+{
+    auto nav = navigation();
+    nav.pvt.utc.nano = -20;
+    EXPECT_EQ(format(nav, &NmeaFormatter::zda).substr(0, 17),
+        "$GNZDA,123045.00,");
+
+    nav.pvt.utc.nano = 849'999'999;
+    EXPECT_EQ(format(nav, &NmeaFormatter::zda).substr(0, 17),
+        "$GNZDA,123045.85,");
+
+    nav.pvt.utc.nano = 999'999'000;
+    EXPECT_EQ(format(nav, &NmeaFormatter::zda).substr(0, 17),
+        "$GNZDA,123045.99,");
+}
+
+// A sentence that does not fit is rolled back whole
+TEST(NmeaFormatter, DropsSentenceThatDoesNotFit)
+{
+    const auto nav = navigation();
+    std::array<char, 100> buffer;
+    NmeaFormatter formatter(buffer);
+
+    formatter.gst(nav);
+    const auto gst = formatter.sentences().size();
+    formatter.gga(nav);
+    formatter.zda(nav);
+
+    EXPECT_EQ(formatter.dropped(), 1u);
+    EXPECT_EQ(formatter.sentences(),
+        "$GNGST,123045.00,,,,,1.061,1.061,2.250*4D\r\n"
+        "$GNZDA,123045.00,15,03,2025,00,00*7B\r\n");
+    EXPECT_LT(gst, formatter.sentences().size());
+
+    formatter.clear();
+    EXPECT_TRUE(formatter.sentences().empty());
+    EXPECT_EQ(formatter.dropped(), 0u);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "ublox/NmeaForwarder.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+const std::string gga =
+    "$GNGGA,123045.00,5213.8160,N,02100.7300,E,1,12,0.8,110.5,M,34.2,M,,"
+    "*58\r\n";
+const std::string gsa =
+    "$GNGSA,A,3,5,12,,,,,,,,,,,1.5,0.8,1.2,1*08\r\n";
+const std::string zda =
+    "$GNZDA,123045.00,15,03,2025,00,00*7B\r\n";
+
+class Pty
+{
+public:
+    Pty()
+    {
+        EXPECT_EQ(openpty(&master_, &slave_, nullptr, nullptr, nullptr), 0);
+        termios tty {};
+        tcgetattr(slave_, &tty);
+        cfmakeraw(&tty);
+        tcsetattr(slave_, TCSANOW, &tty);
+        tcgetattr(master_, &tty);
+        cfmakeraw(&tty);
+        tcsetattr(master_, TCSANOW, &tty);
+        fcntl(master_, F_SETFL, fcntl(master_, F_GETFL) | O_NONBLOCK);
+        fcntl(slave_, F_SETFL, fcntl(slave_, F_GETFL) | O_NONBLOCK);
+    }
+
+    ~Pty()
+    {
+        if (slave_ >= 0)
+            close(slave_);
+    }
+
+    // The forwarder owns and closes the master
+    int releaseMaster() { return std::exchange(master_, -1); }
+
+    std::string drain()
+    {
+        std::string received;
+        char chunk[1024];
+        for (;;)
+        {
+            const auto n = read(slave_, chunk, sizeof(chunk));
+            if (n > 0)
+                received.append(chunk, static_cast<std::size_t>(n));
+            else if (n < 0 && errno == EINTR)
+                continue;
+            else
+                return received;
+        }
+    }
+
+private:
+    int master_ = -1;
+    int slave_ = -1;
+};
+
+}  // namespace
+
+// The reader stops draining; what reaches it must still be whole sentences
+TEST(NmeaForwarder, LaggingReaderGetsOnlyWholeSentences)
+{
+    Pty pty;
+    NmeaForwarder forwarder(pty.releaseMaster());
+    const auto epoch = gga + gsa + zda;
+
+    for (int i = 0; i < 10'000 && forwarder.stats().epochsDropped == 0; ++i)
+        forwarder.writeSentences(epoch);
+
+    auto stats = forwarder.stats();
+    ASSERT_GT(stats.epochsDropped, 0u);
+    EXPECT_GT(stats.epochsWritten, 0u);
+    EXPECT_GE(stats.sentencesDropped, 3 * stats.epochsDropped);
+
+    auto received = pty.drain();
+    forwarder.writeSentences(epoch);
+    received += pty.drain();
+
+    stats = forwarder.stats();
+    EXPECT_GT(stats.epochsWritten, 0u);
+
+    const std::set<std::string_view> known { gga, gsa, zda };
+    std::string_view rest(received);
+    ASSERT_FALSE(rest.empty());
+    std::size_t lines = 0;
+    while (!rest.empty())
+    {
+        const auto end = rest.find("\r\n");
+        ASSERT_NE(end, std::string_view::npos) << rest;
+        const auto line = rest.substr(0, end + 2);
+        EXPECT_TRUE(known.count(line)) << line;
+        rest.remove_prefix(end + 2);
+        ++lines;
+    }
+
+    const auto total = 3 * (stats.epochsWritten + stats.epochsCut
+        + stats.epochsDropped);
+    EXPECT_EQ(lines + stats.sentencesDropped, total);
+}
+
+TEST(NmeaForwarder, WritesWholeEpochWhenReaderKeepsUp)
+{
+    Pty pty;
+    NmeaForwarder forwarder(pty.releaseMaster());
+
+    forwarder.writeSentences(gga + zda);
+    EXPECT_EQ(pty.drain(), gga + zda);
+
+    const auto stats = forwarder.stats();
+    EXPECT_EQ(stats.epochsWritten, 1u);
+    EXPECT_EQ(stats.epochsCut, 0u);
+    EXPECT_EQ(stats.epochsDropped, 0u);
+    EXPECT_EQ(stats.sentencesDropped, 0u);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <iterator>
 #include <cstring>
 #include <chrono>
 #include <thread>
@@ -12,10 +14,13 @@
 #include <unistd.h>
 
 #include "common/Utils.hpp"
+#include "ntrip/HttpChunkedDecoder.hpp"
 #include "ntrip/NtripCaster.hpp"
 #include "ntrip/NtripClient.hpp"
 #include "ntrip/NtripServer.hpp"
+#include "ntrip/Rtcm3FrameExtractor.hpp"
 #include "ublox/Rtcm3Parser.hpp"
+#include "ublox/Rtcm3Store.hpp"
 
 using namespace JimmyPaputto;
 
@@ -325,6 +330,34 @@ TEST_F(NtripCasterTest, SourcetableOnRootRequest)
     caster.stop();
 }
 
+TEST_F(NtripCasterTest, FeedSharedStoreMessages)
+{
+    const uint16_t port = testPort(24);
+    NtripCaster caster("127.0.0.1", port, "GNSS");
+    ASSERT_TRUE(caster.start());
+
+    int fd = ntripHandshake(port, "GNSS");
+    ASSERT_GE(fd, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Rtcm3Store store;
+    for (const auto& frame : buildMockCorrections())
+        store.updateFrame(Rtcm3Store::messageId(frame), frame);
+    const auto messages = store.snapshot()->messages();
+    caster.feed(messages);
+
+    std::vector<uint8_t> expected;
+    for (const auto& message : messages)
+        expected.insert(expected.end(), message->frame.begin(),
+                        message->frame.end());
+    auto received = recvWithTimeout(fd, 4096, 1000);
+    EXPECT_EQ(received, expected);
+    EXPECT_EQ(caster.getStats().framesTx, messages.size());
+
+    close(fd);
+    caster.stop();
+}
+
 TEST_F(NtripCasterTest, FeedEmptyFramesNoOp)
 {
     const uint16_t port = testPort(9);
@@ -443,6 +476,33 @@ TEST_F(NtripClientCasterTest, ReceiveFramesDrainsQueue)
     caster.stop();
 }
 
+TEST_F(NtripClientCasterTest, ReceiveFramesIntoBatch)
+{
+    const uint16_t port = testPort(18);
+    NtripCaster caster("127.0.0.1", port, "GNSS");
+    ASSERT_TRUE(caster.start());
+
+    NtripClient client("127.0.0.1", port, "GNSS");
+    ASSERT_TRUE(client.connect());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto corrections = buildMockCorrections();
+    caster.feed(corrections);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    RtcmFrameBatch batch;
+    client.receiveFrames(batch);
+    ASSERT_EQ(batch.size(), corrections.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+        EXPECT_TRUE(std::ranges::equal(batch[i], corrections[i]));
+
+    client.receiveFrames(batch);
+    EXPECT_TRUE(batch.empty());
+
+    client.disconnect();
+    caster.stop();
+}
+
 TEST_F(NtripClientCasterTest, WrongMountpointFails)
 {
     const uint16_t port = testPort(14);
@@ -508,6 +568,327 @@ TEST_F(NtripClientCasterTest, MultipleClientsReceiveAll)
 }
 
 
+// ═══════════════════════════════════════════════════════════════════════════
+//  Rtcm3FrameExtractor Tests
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace
+{
+
+    /// Valid RTCM3 frame with a `payloadLen` byte payload of message type 4072.
+    std::vector<uint8_t> buildLongRtcm3Frame(uint16_t payloadLen, uint8_t fill)
+    {
+        std::vector<uint8_t> frame = {
+            0xD3,
+            static_cast<uint8_t>(payloadLen >> 8),
+            static_cast<uint8_t>(payloadLen & 0xFF),
+            0xFE,
+            0x80
+        };
+        frame.resize(3u + payloadLen, fill);
+        uint32_t crc = Rtcm3Parser::crc24q(frame.data(), frame.size());
+        frame.push_back((crc >> 16) & 0xFF);
+        frame.push_back((crc >> 8) & 0xFF);
+        frame.push_back(crc & 0xFF);
+        return frame;
+    }
+
+    void expectFrames(const RtcmFrameBatch& batch,
+                      const std::vector<std::vector<uint8_t>>& expected)
+    {
+        ASSERT_EQ(batch.size(), expected.size());
+        for (size_t i = 0; i < batch.size(); ++i)
+            EXPECT_TRUE(std::ranges::equal(batch[i], expected[i])) << i;
+    }
+
+}
+
+TEST(Rtcm3FrameExtractor, FramesSplitAtEveryByte)
+{
+    const auto corrections = buildMockCorrections();
+    std::vector<uint8_t> stream;
+    for (const auto& frame : corrections)
+        stream.insert(stream.end(), frame.begin(), frame.end());
+
+    Rtcm3FrameExtractor extractor;
+    RtcmFrameBatch batch;
+    size_t frames = 0;
+    for (uint8_t byte : stream)
+        frames += extractor.feed({&byte, 1}, batch);
+
+    EXPECT_EQ(frames, corrections.size());
+    expectFrames(batch, corrections);
+    EXPECT_EQ(extractor.buffered(), 0u);
+}
+
+TEST(Rtcm3FrameExtractor, ResyncsAfterNoiseAndBadCrc)
+{
+    const auto good = buildRtcm3Frame(1005);
+    auto corrupted = buildRtcm3Frame(1077);
+    corrupted[5] ^= 0x01;
+
+    // HTTP noise, a preamble with reserved bits set, a frame failing the
+    // CRC, then frames behind a stray preamble
+    const std::string noise = "HTTP/1.1 200 OK\r\n\r\n";
+    std::vector<uint8_t> stream(noise.begin(), noise.end());
+    stream.insert(stream.end(), {0xD3, 0xFF, 0x12});
+    stream.insert(stream.end(), corrupted.begin(), corrupted.end());
+    stream.push_back(0xD3);
+    stream.insert(stream.end(), good.begin(), good.end());
+    stream.insert(stream.end(), good.begin(), good.end());
+
+    Rtcm3FrameExtractor extractor;
+    RtcmFrameBatch batch;
+    EXPECT_EQ(extractor.feed(stream, batch), 2u);
+    expectFrames(batch, {good, good});
+}
+
+TEST(Rtcm3FrameExtractor, FramesWrappingTheRing)
+{
+    // Reads of 1500 bytes against a 16 KiB ring: frames regularly continue
+    // across the wrap
+    std::vector<std::vector<uint8_t>> expected;
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 64; ++i)
+    {
+        expected.push_back(buildLongRtcm3Frame(
+            static_cast<uint16_t>(700 + i * 5), static_cast<uint8_t>(i)));
+        stream.insert(stream.end(), expected.back().begin(),
+                      expected.back().end());
+        stream.insert(stream.end(), static_cast<size_t>(i % 7), 0x00);
+    }
+
+    Rtcm3FrameExtractor extractor;
+    RtcmFrameBatch batch;
+    for (size_t offset = 0; offset < stream.size(); offset += 1500)
+    {
+        const size_t len = std::min<size_t>(1500, stream.size() - offset);
+        extractor.feed({stream.data() + offset, len}, batch);
+    }
+    expectFrames(batch, expected);
+
+    // One read larger than the ring
+    RtcmFrameBatch whole;
+    extractor.clear();
+    EXPECT_EQ(extractor.feed(stream, whole), expected.size());
+    expectFrames(whole, expected);
+}
+
+TEST(RtcmFrameBatch, SwapMovesFramesAndClearKeepsArena)
+{
+    const auto corrections = buildMockCorrections();
+    RtcmFrameBatch filled;
+    for (const auto& frame : corrections)
+        filled.append(frame);
+
+    RtcmFrameBatch drained;
+    drained.swap(filled);
+    EXPECT_TRUE(filled.empty());
+    expectFrames(drained, corrections);
+    EXPECT_EQ(drained.toVectors(), corrections);
+
+    const uint8_t* arena = drained[0].data();
+    drained.clear();
+    drained.append(corrections[0]);
+    EXPECT_EQ(drained[0].data(), arena);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+//  HttpChunkedDecoder Tests
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace
+{
+
+    /// One HTTP chunk: hex size line (with optional extension), data, CRLF.
+    std::string httpChunk(const std::vector<uint8_t>& data,
+                          const std::string& extension = {})
+    {
+        char size[16];
+        snprintf(size, sizeof(size), "%zX", data.size());
+        return std::string(size) + extension + "\r\n" +
+               std::string(data.begin(), data.end()) + "\r\n";
+    }
+
+    /// RTCM3 corrections cut into chunks that do not line up with frames.
+    struct ChunkedBody
+    {
+        std::vector<uint8_t> payload;
+        std::vector<uint8_t> encoded;
+    };
+
+    ChunkedBody buildChunkedBody()
+    {
+        ChunkedBody body;
+        for (const auto& frame : buildMockCorrections())
+            body.payload.insert(body.payload.end(), frame.begin(), frame.end());
+        const auto longFrame = buildLongRtcm3Frame(300, 0xA5);
+        body.payload.insert(body.payload.end(), longFrame.begin(),
+                            longFrame.end());
+
+        std::string encoded;
+        const size_t cuts[] = {0, 7, 30, 31, 200, body.payload.size()};
+        for (size_t i = 0; i + 1 < std::size(cuts); ++i)
+        {
+            encoded += httpChunk(
+                {body.payload.begin() + static_cast<ptrdiff_t>(cuts[i]),
+                 body.payload.begin() + static_cast<ptrdiff_t>(cuts[i + 1])},
+                i == 2 ? ";src=base" : "");
+        }
+        encoded += "0\r\nX-Trailer: 1\r\n\r\n";
+        body.encoded.assign(encoded.begin(), encoded.end());
+        return body;
+    }
+
+    /// Decode `encoded` delivered in pieces ending at `splits`.
+    std::vector<uint8_t> decodeSplit(HttpChunkedDecoder& decoder,
+                                     const std::vector<uint8_t>& encoded,
+                                     const std::vector<size_t>& splits)
+    {
+        std::vector<uint8_t> out;
+        size_t begin = 0;
+        for (size_t end : splits)
+        {
+            std::span<const uint8_t> piece(encoded.data() + begin, end - begin);
+            while (!piece.empty())
+            {
+                const auto payload = decoder.next(piece);
+                // Payload is a view into the received bytes, not a copy
+                if (!payload.empty())
+                {
+                    EXPECT_GE(payload.data(), encoded.data());
+                    EXPECT_LE(payload.data() + payload.size(),
+                              encoded.data() + encoded.size());
+                }
+                out.insert(out.end(), payload.begin(), payload.end());
+            }
+            begin = end;
+        }
+        return out;
+    }
+
+}
+
+TEST(HttpChunkedDecoder, EveryTwoWaySplit)
+{
+    const auto body = buildChunkedBody();
+    for (size_t split = 0; split <= body.encoded.size(); ++split)
+    {
+        HttpChunkedDecoder decoder;
+        EXPECT_EQ(decodeSplit(decoder, body.encoded,
+                              {split, body.encoded.size()}),
+                  body.payload) << "split at " << split;
+        EXPECT_TRUE(decoder.finished());
+        EXPECT_FALSE(decoder.failed());
+    }
+}
+
+TEST(HttpChunkedDecoder, OneByteReads)
+{
+    const auto body = buildChunkedBody();
+    std::vector<size_t> splits;
+    for (size_t i = 1; i <= body.encoded.size(); ++i)
+        splits.push_back(i);
+
+    HttpChunkedDecoder decoder;
+    EXPECT_EQ(decodeSplit(decoder, body.encoded, splits), body.payload);
+    EXPECT_TRUE(decoder.finished());
+}
+
+TEST(HttpChunkedDecoder, ExtractorSeesOnlyFrames)
+{
+    // Chunk headers land inside frames; with the decoder in front every
+    // frame comes out on the first pass, whatever the read sizes
+    const auto body = buildChunkedBody();
+    for (size_t readSize : {1u, 3u, 13u, 64u, 4096u})
+    {
+        HttpChunkedDecoder decoder;
+        Rtcm3FrameExtractor extractor;
+        RtcmFrameBatch batch;
+        for (size_t offset = 0; offset < body.encoded.size();
+             offset += readSize)
+        {
+            std::span<const uint8_t> read(
+                body.encoded.data() + offset,
+                std::min(readSize, body.encoded.size() - offset));
+            while (!read.empty())
+                extractor.feed(decoder.next(read), batch);
+        }
+        EXPECT_EQ(batch.size(), 6u) << "read size " << readSize;
+        EXPECT_EQ(batch.bytes(), body.payload.size());
+        EXPECT_EQ(extractor.buffered(), 0u);
+    }
+}
+
+TEST(HttpChunkedDecoder, MalformedBodyPassesThrough)
+{
+    const std::string text = "5\r\nhello\r\nzz\r\nrest";
+    const std::vector<uint8_t> encoded(text.begin(), text.end());
+
+    HttpChunkedDecoder decoder;
+    const auto out = decodeSplit(decoder, encoded, {encoded.size()});
+    EXPECT_TRUE(decoder.failed());
+    EXPECT_EQ(std::string(out.begin(), out.end()), "helloz\r\nrest");
+
+    decoder.reset();
+    EXPECT_FALSE(decoder.failed());
+}
+
+TEST_F(NtripClientCasterTest, ChunkedCasterResponse)
+{
+    // Minimal NTRIP v2 caster answering with Transfer-Encoding: chunked
+    // and sending the body in small, unaligned pieces
+    const uint16_t port = testPort(19);
+    int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(listenFd, 0);
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    ASSERT_EQ(bind(listenFd, reinterpret_cast<sockaddr*>(&addr),
+                   sizeof(addr)), 0);
+    ASSERT_EQ(listen(listenFd, 1), 0);
+
+    const auto body = buildChunkedBody();
+    std::thread caster([&] {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        char request[1024];
+        recv(fd, request, sizeof(request), 0);
+
+        const std::string header = "HTTP/1.1 200 OK\r\n"
+                                   "Ntrip-Version: Ntrip/2.0\r\n"
+                                   "Transfer-Encoding: chunked\r\n\r\n";
+        std::vector<uint8_t> response(header.begin(), header.end());
+        response.insert(response.end(), body.encoded.begin(),
+                        body.encoded.end());
+        for (size_t offset = 0; offset < response.size(); offset += 11)
+        {
+            send(fd, response.data() + offset,
+                 std::min<size_t>(11, response.size() - offset), 0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        close(fd);
+    });
+
+    NtripClient client("127.0.0.1", port, "GNSS");
+    ASSERT_TRUE(client.connect());
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    RtcmFrameBatch batch;
+    client.receiveFrames(batch);
+    EXPECT_EQ(batch.size(), 6u);
+    EXPECT_EQ(batch.bytes(), body.payload.size());
+
+    client.disconnect();
+    caster.join();
+    close(listenFd);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 //  NtripLoggable Tests
 // ═══════════════════════════════════════════════════════════════════════════
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include "common/NtpShm.hpp"
+#include "common/Utils.hpp"
+#include "ublox/Gnss.hpp"
+#include "ublox/NtpShmFeed.hpp"
+#include "ublox/PpsOffsetEstimator.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+constexpr int64_t nsPerSecond = 1'000'000'000;
+// 2025-03-15 12:30:45 UTC
+constexpr int64_t utcSecond = 1'742'041'845;
+
+PositionVelocityTime pvtAt(uint8_t ss, int32_t nano = 0)
+{
+    PositionVelocityTime pvt {};
+    pvt.date = { 15, 3, 2025, true };
+    pvt.utc = { 12, 30, ss, true, 20, nano };
+    return pvt;
+}
+
+// Epoch at the top of a second with a pulse 100 ms before it, the system
+// clock behind UTC by offset_ns
+NavigationEpoch epochAt(uint8_t ss, uint64_t pulse, int64_t offset_ns,
+    int32_t nano = 0)
+{
+    NavigationEpoch epoch;
+    epoch.iTOW = 1000u * ss;
+    epoch.navigation.pvt = pvtAt(ss, nano);
+    const auto second_ns = (utcSecond - 45 + ss) * nsPerSecond;
+    epoch.timepulse.sequence = pulse;
+    epoch.timepulse.monotonic_ns = 5 * nsPerSecond + pulse * nsPerSecond;
+    epoch.timepulse.realtime_ns = second_ns - offset_ns;
+    epoch.published_ns = epoch.timepulse.monotonic_ns + nsPerSecond / 10;
+    return epoch;
+}
+
+struct PrivateShm
+{
+    PrivateShm()
+    :   segment(std::make_unique<NtpShmSegment>(IPC_PRIVATE, 0600))
+    {
+    }
+
+    ~PrivateShm()
+    {
+        if (id >= 0)
+            shmctl(id, IPC_RMID, nullptr);
+    }
+
+    NtpShmTime read() const
+    {
+        auto* shm = static_cast<NtpShmTime*>(shmat(id, nullptr, SHM_RDONLY));
+        NtpShmTime copy = *shm;
+        shmdt(shm);
+        return copy;
+    }
+
+    std::unique_ptr<NtpShmSegment> segment;
+    int id = segment->shmId();
+};
+
+}  // namespace
+
+TEST(PpsOffsetEstimator, DaysFromCivil)
+{
+    EXPECT_EQ(PpsOffsetEstimator::daysFromCivil(1970, 1, 1), 0);
+    EXPECT_EQ(PpsOffsetEstimator::daysFromCivil(1969, 12, 31), -1);
+    EXPECT_EQ(PpsOffsetEstimator::daysFromCivil(2000, 3, 1), 11017);
+    EXPECT_EQ(PpsOffsetEstimator::daysFromCivil(2026, 10, 17), 20743);
+}
+
+TEST(PpsOffsetEstimator, PairsPulseWithPvtSecond)
+{
+    PpsOffsetEstimator estimator;
+
+    const auto sample = estimator.add(epochAt(45, 1, 1'500'000));
+    ASSERT_TRUE(sample.has_value());
+    EXPECT_EQ(sample->utc_ns, utcSecond * nsPerSecond);
+    EXPECT_EQ(sample->offset_ns, 1'500'000);
+
+    // 45 s + 999999980 ns is already 46 s
+    auto late = epochAt(46, 2, 1'500'000);
+    late.navigation.pvt = pvtAt(45, 999'999'980);
+    const auto roundedUp = estimator.add(late);
+    ASSERT_TRUE(roundedUp.has_value());
+    EXPECT_EQ(roundedUp->utc_ns, (utcSecond + 1) * nsPerSecond);
+
+    // 47 s - 20 ns is still 47 s
+    const auto roundedDown = estimator.add(epochAt(47, 3, 1'500'000, -20));
+    ASSERT_TRUE(roundedDown.has_value());
+    EXPECT_EQ(roundedDown->utc_ns, (utcSecond + 2) * nsPerSecond);
+    EXPECT_EQ(estimator.stats().samples, 3u);
+}
+
+TEST(PpsOffsetEstimator, SkipsEpochsWithoutFreshPulse)
+{
+    PpsOffsetEstimator estimator;
+    ASSERT_TRUE(estimator.add(epochAt(45, 1, 0)).has_value());
+
+    // The same pulse a second time
+    auto repeated = epochAt(46, 1, 0);
+    EXPECT_FALSE(estimator.add(repeated).has_value());
+
+    // Pulse older than a second
+    auto stale = epochAt(47, 2, 0);
+    stale.published_ns += nsPerSecond;
+    EXPECT_FALSE(estimator.add(stale).has_value());
+
+    // An epoch in the middle of a second is neither paired nor counted
+    auto mid = epochAt(48, 3, 0);
+    mid.iTOW += 200;
+    EXPECT_FALSE(estimator.add(mid).has_value());
+
+    EXPECT_EQ(estimator.stats().unpaired, 2u);
+    EXPECT_EQ(estimator.stats().samples, 1u);
+}
+
+TEST(PpsOffsetEstimator, RejectsOutliersAndFollowsClockStep)
+{
+    PpsOffsetEstimator estimator(8, 50'000);
+    uint64_t pulse = 0;
+    for (uint8_t ss = 0; ss < 8; ss++)
+    {
+        const int64_t jitter = (ss % 2 ? 1 : -1) * 2'000;
+        ASSERT_TRUE(estimator.add(epochAt(ss, ++pulse, 1'000'000 + jitter)));
+    }
+    EXPECT_EQ(estimator.stats().medianOffset_ns, 1'002'000);
+    EXPECT_EQ(estimator.stats().jitter_ns, 4'000);
+
+    // A single 1 ms jump is rejected
+    EXPECT_FALSE(estimator.add(epochAt(8, ++pulse, 2'000'000)));
+    EXPECT_EQ(estimator.stats().rejected, 1u);
+    EXPECT_TRUE(estimator.add(epochAt(9, ++pulse, 1'001'000)));
+
+    // Clock stepped by 0.5 s: the new level is taken after half a window
+    const int64_t stepped = 500'000'000;
+    EXPECT_FALSE(estimator.add(epochAt(10, ++pulse, stepped)));
+    EXPECT_FALSE(estimator.add(epochAt(11, ++pulse, stepped)));
+    EXPECT_FALSE(estimator.add(epochAt(12, ++pulse, stepped)));
+    EXPECT_TRUE(estimator.add(epochAt(13, ++pulse, stepped)));
+    EXPECT_EQ(estimator.stats().medianOffset_ns, stepped);
+    EXPECT_TRUE(estimator.add(epochAt(14, ++pulse, stepped + 1'000)));
+}
+
+TEST(NtpShmSegment, PublishesSampleForMode1Reader)
+{
+    PrivateShm shm;
+    if (!shm.segment->isAttached())
+        GTEST_SKIP() << "SysV shared memory not available";
+
+    shm.segment->publish(utcSecond * nsPerSecond + 250,
+        utcSecond * nsPerSecond - 1'234'567, -20);
+
+    const auto sample = shm.read();
+    EXPECT_EQ(sample.mode, 1);
+    EXPECT_EQ(sample.valid, 1);
+    EXPECT_EQ(sample.count % 2, 0);
+    EXPECT_EQ(sample.count, 2);
+    EXPECT_EQ(sample.clockTimeStampSec, utcSecond);
+    EXPECT_EQ(sample.clockTimeStampUSec, 0);
+    EXPECT_EQ(sample.clockTimeStampNSec, 250u);
+    EXPECT_EQ(sample.receiveTimeStampSec, utcSecond - 1);
+    EXPECT_EQ(sample.receiveTimeStampUSec, 998'765);
+    EXPECT_EQ(sample.receiveTimeStampNSec, 998'765'433u);
+    EXPECT_EQ(sample.precision, -20);
+    EXPECT_EQ(sample.leap, NtpShmSegment::leapNoWarning);
+}
+
+// Pulse and NAV-PVT go through Gnss and the sample lands in the segment
+TEST(NtpShmFeed, WritesPairedPulseToSegment)
+{
+    PrivateShm shm;
+    if (!shm.segment->isAttached())
+        GTEST_SKIP() << "SysV shared memory not available";
+
+    Gnss gnss;
+    NtpShmFeed feed(gnss, std::move(shm.segment));
+    ASSERT_TRUE(feed.isAttached());
+
+    EdgeTimestamp pulse;
+    pulse.sequence = 1;
+    pulse.monotonic_ns = monotonicNow().count();
+    pulse.realtime_ns = utcSecond * nsPerSecond - 3'000;
+    gnss.timepulseEdge(pulse);
+    gnss.pvt(pvtAt(45), 45'000);
+    gnss.pvt(pvtAt(46), 46'000);
+
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::seconds(2);
+    while (feed.stats().published == 0 &&
+        std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto stats = feed.stats();
+    EXPECT_EQ(stats.published, 1u);
+    EXPECT_EQ(stats.lastOffset_ns, 3'000);
+    const auto sample = shm.read();
+    EXPECT_EQ(sample.clockTimeStampSec, utcSecond);
+    EXPECT_EQ(sample.receiveTimeStampNSec, 999'997'000u);
+}
@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "UbxCapture.hpp"
+
+#include "ublox/CommRecording.hpp"
+#include "ublox/RecordingCommDriver.hpp"
+#include "ublox/ReplayCommDriver.hpp"
+#include "ublox/Run.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::test;
+
+namespace
+{
+
+std::string tempPath(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() /
+        ("gnsshat-" + name)).string();
+}
+
+CommRecording threeReads()
+{
+    CommRecording recording;
+    const std::vector<uint8_t> a = { 1, 2, 3 };
+    const std::vector<uint8_t> b = { 4, 5 };
+    const std::vector<uint8_t> c = { 6, 7, 8, 9 };
+    recording.append(std::chrono::milliseconds(0), a);
+    recording.append(std::chrono::milliseconds(20), b);
+    recording.append(std::chrono::milliseconds(40), c);
+    return recording;
+}
+
+}  // namespace
+
+TEST(CommRecording, SaveLoadRoundtrip)
+{
+    const auto path = tempPath("roundtrip.rec");
+    const auto recording = threeReads();
+    ASSERT_TRUE(recording.save(path));
+
+    const auto loaded = CommRecording::load(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->bytes, recording.bytes);
+    ASSERT_EQ(loaded->segments.size(), 3u);
+    EXPECT_EQ(loaded->segments[1].at, std::chrono::milliseconds(20));
+    EXPECT_EQ(loaded->segments[2].offset, 5u);
+    EXPECT_EQ(loaded->segments[2].size, 4u);
+    EXPECT_EQ(loaded->duration(), std::chrono::milliseconds(40));
+    std::filesystem::remove(path);
+}
+
+// A file without a header is a raw stream dump
+TEST(CommRecording, RawDumpLoadsAsOneUntimedRead)
+{
+    const auto path = tempPath("raw.ubx");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "\xB5\x62raw";
+    }
+
+    const auto loaded = CommRecording::load(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->bytes.size(), 5u);
+    ASSERT_EQ(loaded->segments.size(), 1u);
+    EXPECT_EQ(loaded->segments[0].at.count(), 0);
+    std::filesystem::remove(path);
+}
+
+TEST(ReplayCommDriver, SpiReadsArePaddedWithIdleFill)
+{
+    ReplayCommDriver driver(threeReads(), { .speed = 0 });
+
+    std::vector<uint8_t> rx(12);
+    driver.getRxBuff(rx.data(), rx.size());
+    EXPECT_EQ(rx, std::vector<uint8_t>(
+        { 1, 2, 3, 4, 5, 6, 7, 8, 9, 0xFF, 0xFF, 0xFF }));
+    EXPECT_TRUE(driver.finished());
+    EXPECT_EQ(driver.bytesDelivered(), 9u);
+
+    const std::vector<uint8_t> tx = { 0xB5, 0x62 };
+    driver.transmitReceive(tx, rx);
+    EXPECT_EQ(rx, std::vector<uint8_t>(12, 0xFF));
+    EXPECT_EQ(driver.transmitted(), tx);
+}
+
+TEST(ReplayCommDriver, UartReadsFollowRecordedReads)
+{
+    ReplayCommDriver driver(threeReads(), {
+        .speed = 0, .chunking = EReplayChunking::UartRead });
+
+    std::vector<uint8_t> rx(16);
+    EXPECT_EQ(driver.epoll(rx.data(), rx.size(), 10), 3);
+    EXPECT_EQ(driver.epoll(rx.data(), rx.size(), 10), 2);
+    EXPECT_EQ(driver.epoll(rx.data(), 3, 10), 3);
+    EXPECT_EQ(driver.epoll(rx.data(), rx.size(), 10), 1);
+    EXPECT_EQ(rx[0], 9);
+    EXPECT_EQ(driver.epoll(rx.data(), rx.size(), 10), 0);
+    EXPECT_TRUE(driver.finished());
+}
+
+TEST(ReplayCommDriver, MaxReadSizeCapsSpiBatchReads)
+{
+    ReplayCommDriver driver(threeReads(), { .speed = 0, .maxReadSize = 4 });
+
+    std::vector<uint8_t> rx(16);
+    EXPECT_EQ(driver.epoll(rx.data(), rx.size(), 10), 4);
+    EXPECT_EQ(driver.epoll(rx.data(), rx.size(), 10), 4);
+    EXPECT_EQ(driver.epoll(rx.data(), rx.size(), 10), 1);
+}
+
+// 40 ms of recording takes 4 ms at 10x and at least 40 ms at 1x
+TEST(ReplayCommDriver, PacesReadsByRecordedTime)
+{
+    const auto replayTime = [](double speed) {
+        ReplayCommDriver driver(threeReads(), { .speed = speed });
+        std::vector<uint8_t> rx(16);
+        const auto begin = std::chrono::steady_clock::now();
+        while (!driver.finished())
+            driver.epoll(rx.data(), rx.size(), 100);
+        return std::chrono::steady_clock::now() - begin;
+    };
+
+    EXPECT_GE(replayTime(1.0), std::chrono::milliseconds(40));
+    EXPECT_LT(replayTime(10.0), std::chrono::milliseconds(40));
+}
+
+TEST(ReplayCommDriver, LoopStartsOverWithShiftedTimestamps)
+{
+    ReplayCommDriver driver(threeReads(), { .speed = 0, .loop = true });
+
+    std::vector<uint8_t> rx(18);
+    driver.getRxBuff(rx.data(), rx.size());
+    EXPECT_EQ(rx[9], 1);
+    EXPECT_EQ(rx[17], 9);
+    EXPECT_FALSE(driver.finished());
+    EXPECT_EQ(driver.bytesDelivered(), 18u);
+}
+
+TEST(ReplayCommDriver, F10TRunParsesEveryEpoch)
+{
+    const auto capture = syntheticCapture(200, 0, 20);
+    ReplayCommDriver driver(CommRecording::untimed(capture.bytes), {
+        .speed = 0, .maxReadSize = 333 });
+    ReplayReceiver receiver;
+    F10TRun run(driver, receiver.parser);
+
+    while (!driver.finished())
+        run.execute({});
+    run.execute({});
+
+    const auto epoch = receiver.gnss.navigationEpoch();
+    EXPECT_EQ(epoch.sequence, capture.epochs);
+    EXPECT_EQ(epoch.navigation.satellites.size(), 20u);
+    EXPECT_EQ(receiver.parser.scanStats().checksumFailures, 0u);
+}
+
+// One burst per epoch every 50 ms, load measured against 115200 baud
+TEST(ReplayCommDriver, F10TRunReportsUartLinkLoad)
+{
+    const auto capture = syntheticCapture(10, 0, 20);
+    ReplayCommDriver driver(timedRecording(capture, 50), {
+        .speed = 1, .chunking = EReplayChunking::UartRead });
+    ReplayReceiver receiver;
+    F10TRun run(driver, receiver.parser);
+    run.setBaudrate(115200);
+
+    while (!driver.finished())
+        run.execute({});
+
+    const auto stats = run.linkStats();
+    const auto epochSize = capture.bytes.size() / capture.epochs;
+    EXPECT_EQ(stats.baudrate, 115200u);
+    EXPECT_EQ(stats.epochs, capture.epochs - 1);
+    EXPECT_EQ(stats.lastEpoch.bytes, epochSize);
+    EXPECT_EQ(stats.lastEpoch.lineTime_us, epochSize * 10'000'000 / 115200);
+    EXPECT_GE(stats.lastEpoch.period_us, 45'000u);
+    EXPECT_LT(stats.lastEpoch.period_us, 80'000u);
+    EXPECT_GT(stats.lastEpoch.utilization(), 0.0);
+    EXPECT_LT(stats.lastEpoch.utilization(), 1.0);
+    EXPECT_GE(stats.peakUtilization, stats.lastEpoch.utilization());
+}
+
+// A frame split across two reads reaches the parser with the second one,
+// without waiting for a threshold or a timeout
+TEST(ReplayCommDriver, F10TRunDispatchesOnTheReadThatCompletesFrame)
+{
+    const std::vector<uint8_t> payload(28, 0);
+    const auto frame = ubxFrame(0x0D, 0x03, payload);
+    const std::span<const uint8_t> all(frame);
+    CommRecording recording;
+    recording.append(std::chrono::milliseconds(0), all.first(20));
+    recording.append(std::chrono::milliseconds(0), all.subspan(20));
+    recording.append(std::chrono::milliseconds(0), all);
+
+    ReplayCommDriver driver(std::move(recording), {
+        .speed = 0, .chunking = EReplayChunking::UartRead });
+    ReplayReceiver receiver;
+    F10TRun run(driver, receiver.parser);
+    const auto dispatched = [&receiver] {
+        return receiver.parser.ingressLatency(EUbxMsg::UBX_TIM_TM2).count;
+    };
+
+    run.execute({});
+    EXPECT_EQ(dispatched(), 0u);
+    run.execute({});
+    EXPECT_EQ(dispatched(), 1u);
+    run.execute({});
+    EXPECT_EQ(dispatched(), 2u);
+    EXPECT_EQ(receiver.parser.scanStats().checksumFailures, 0u);
+}
+
+TEST(ReplayCommDriver, M9NRunDrainsOnEmulatedTxReady)
+{
+    const auto capture = syntheticCapture(50, 1024, 20);
+    ReplayCommDriver driver(timedRecording(capture, 100), { .speed = 20 });
+    ReplayReceiver receiver;
+    Notifier txReady;
+    M9NRun run(driver, receiver.parser, txReady, receiver.navigationNotifier);
+
+    std::jthread txReadyLine([&](std::stop_token stoken) {
+        driver.driveTxReady(txReady, stoken);
+    });
+    std::stop_source stopSource;
+    while (!driver.finished())
+        run.execute(stopSource.get_token());
+
+    const auto epoch = receiver.gnss.navigationEpoch();
+    EXPECT_EQ(epoch.sequence, capture.epochs);
+    EXPECT_EQ(epoch.navigation.satellites.size(), 20u);
+    EXPECT_EQ(receiver.parser.scanStats().checksumFailures, 0u);
+
+    const auto stats = run.drainStats();
+    EXPECT_GT(stats.epochs, 0u);
+    EXPECT_EQ(stats.overruns, 0u);
+    EXPECT_LE(stats.usefulBytes, stats.bytesClocked);
+}
+
+// The drain stops at 0xFF idle fill, without waiting for a TX-ready edge
+TEST(ReplayCommDriver, M9NRunStopsOnIdleFill)
+{
+    const auto capture = syntheticCapture(3, 0);
+    ReplayCommDriver driver(CommRecording::untimed(capture.bytes),
+        { .speed = 0 });
+    ReplayReceiver receiver;
+    Notifier txReady;
+    M9NRun run(driver, receiver.parser, txReady, receiver.navigationNotifier);
+
+    txReady.notify();
+    run.execute({});
+
+    EXPECT_EQ(receiver.gnss.navigationEpoch().sequence, capture.epochs);
+    const auto stats = run.drainStats();
+    EXPECT_EQ(stats.epochs, 1u);
+    EXPECT_EQ(stats.ioctls, 4u);
+    EXPECT_EQ(stats.bytesClocked, 2048u);
+    EXPECT_EQ(stats.usefulBytes, capture.bytes.size());
+    EXPECT_EQ(stats.overruns, 0u);
+    EXPECT_EQ(stats.lastEpoch.ioctls, 4u);
+}
+
+// More than 8 KiB per edge: nothing is lost and an overrun is counted
+TEST(ReplayCommDriver, M9NRunStreamsEpochsLargerThanItsBuffer)
+{
+    const auto capture = syntheticCapture(60, 0);
+    ASSERT_GT(capture.bytes.size(), 8192u * 4);
+    ReplayCommDriver driver(CommRecording::untimed(capture.bytes),
+        { .speed = 0 });
+    ReplayReceiver receiver;
+    Notifier txReady;
+    M9NRun run(driver, receiver.parser, txReady, receiver.navigationNotifier);
+
+    txReady.notify();
+    run.execute({});
+
+    EXPECT_EQ(receiver.gnss.navigationEpoch().sequence, capture.epochs);
+    EXPECT_EQ(receiver.parser.scanStats().checksumFailures, 0u);
+    const auto stats = run.drainStats();
+    EXPECT_GE(stats.overruns, 4u);
+    EXPECT_EQ(stats.usefulBytes, capture.bytes.size());
+}
+
+// A recording made during replay replays the same way
+TEST(RecordingCommDriver, RecordsWhatReplayDelivers)
+{
+    const auto path = tempPath("recorded.rec");
+    const auto capture = syntheticCapture(20, 0, 8);
+    {
+        ReplayCommDriver source(timedRecording(capture, 100), { .speed = 0 });
+        RecordingCommDriver recorder(source, path);
+        ASSERT_TRUE(recorder.isRecording());
+
+        std::vector<uint8_t> rx(256);
+        while (!source.finished())
+            recorder.epoll(rx.data(), rx.size(), 10);
+
+        std::vector<uint8_t> idle(64);
+        recorder.getRxBuff(idle.data(), idle.size());
+    }
+
+    const auto loaded = CommRecording::load(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->bytes, capture.bytes);
+    EXPECT_EQ(loaded->segments.size(),
+        (capture.bytes.size() + 255) / 256);
+    EXPECT_EQ(loaded->segments.front().at.count(), 0);
+    std::filesystem::remove(path);
+}
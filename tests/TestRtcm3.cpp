@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <thread>
 #include <vector>
 #include <cstring>
 
+#include "common/Crc24q.hpp"
 #include "ublox/Rtcm3Parser.hpp"
 #include "ublox/Rtcm3Store.hpp"
 
@@ -11,6 +15,20 @@ using namespace JimmyPaputto;
 namespace
 {
 
+// Bit by bit, no tables: the reference for slicing-by-8 and PCLMULQDQ
+uint32_t crc24qBitwise(const uint8_t* data, size_t length)
+{
+    uint32_t crc = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= static_cast<uint32_t>(data[i]) << 16;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc & 0x800000) ? ((crc << 1) ^ 0x1864CFB) & 0xFFFFFF
+                                   : (crc << 1) & 0xFFFFFF;
+    }
+    return crc;
+}
+
 std::vector<uint8_t> buildValidRtcm3Frame(uint16_t msgId)
 {
     uint16_t dataLength = 4;
@@ -36,6 +54,36 @@ std::vector<uint8_t> buildValidRtcm3Frame(uint16_t msgId)
     return frame;
 }
 
+// MSM header (message number, station, epoch time, multiple-message bit)
+// followed by zeroed satellite masks
+std::vector<uint8_t> buildMsmFrame(uint16_t msgId, uint32_t epochTime,
+    bool multipleMessage)
+{
+    constexpr uint16_t dataLength = 20;
+    std::vector<uint8_t> frame = { 0xD3, 0x00, dataLength };
+    frame.resize(3 + dataLength, 0x00);
+
+    size_t position = 0;
+    const auto put = [&frame, &position](uint32_t value, size_t length) {
+        for (size_t bit = length; bit-- > 0; position++)
+        {
+            if ((value >> bit) & 1)
+                frame[3 + position / 8] |= 0x80 >> (position % 8);
+        }
+    };
+    put(msgId, 12);
+    put(1, 12);
+    put(epochTime, 30);
+    put(multipleMessage ? 1 : 0, 1);
+
+    const uint32_t crc = Rtcm3Parser::crc24q(frame.data(), frame.size());
+    frame.push_back((crc >> 16) & 0xFF);
+    frame.push_back((crc >> 8) & 0xFF);
+    frame.push_back(crc & 0xFF);
+
+    return frame;
+}
+
 }  // namespace
 
 
@@ -55,6 +103,22 @@ TEST(Crc24q, Deterministic)
     EXPECT_EQ(crc1, crc2);
 }
 
+TEST(Crc24q, MatchesBitwiseUpToMaxFrame)
+{
+    std::vector<uint8_t> data(1029 + 1);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+
+    // Offset by one byte: unaligned loads
+    for (size_t length = 0; length <= 1029; length++)
+    {
+        ASSERT_EQ(crc24q(data.data() + 1, length),
+            crc24qBitwise(data.data() + 1, length)) << length;
+    }
+    EXPECT_EQ(Rtcm3Parser::crc24q(data.data(), 1029),
+        crc24qBitwise(data.data(), 1029));
+}
+
 TEST(Crc24q, DifferentInputsDifferentCrc)
 {
     uint8_t data1[] = { 0xD3, 0x00, 0x01, 0xAA };
@@ -176,3 +240,241 @@ TEST(Rtcm3Store, GetFramesMultipleIds)
 
     ASSERT_EQ(frames.size(), 2u);
 }
+
+TEST(Rtcm3Store, TakeFramesSwapsPendingBatch)
+{
+    Rtcm3Store store;
+    const std::vector<std::vector<uint8_t>> corrections = {
+        { 0xD3, 0x00, 0x01 }, { 0xD3, 0x00, 0x02 } };
+    store.updateFramesAndNotify(corrections);
+
+    std::vector<std::vector<uint8_t>> batch = { { 0x42 } };
+    ASSERT_TRUE(store.takeFrames(batch, {}));
+    EXPECT_EQ(batch, corrections);
+
+    std::stop_source stopSource;
+    stopSource.request_stop();
+    EXPECT_FALSE(store.takeFrames(batch, stopSource.get_token()));
+}
+
+TEST(Rtcm3Store, ParserBurstIsOneVersion)
+{
+    std::vector<uint8_t> buffer;
+    for (const uint16_t id : { 1077, 1005, 1087 })
+    {
+        const auto frame = buildValidRtcm3Frame(id);
+        buffer.insert(buffer.end(), frame.begin(), frame.end());
+    }
+
+    Rtcm3Store store;
+    Rtcm3Parser parser(store);
+    std::vector<uint8_t> unfinished;
+    parser.parse(buffer, unfinished);
+
+    const auto snapshot = store.snapshot();
+    EXPECT_EQ(snapshot->version(), 1u);
+    ASSERT_EQ(snapshot->messages().size(), 3u);
+    EXPECT_EQ(snapshot->messages()[0]->id, 1005);
+    EXPECT_EQ(snapshot->messages()[2]->id, 1087);
+    for (const auto& message : snapshot->messages())
+    {
+        EXPECT_EQ(message->version, 1u);
+        EXPECT_NE(message->receivedAt,
+            std::chrono::steady_clock::time_point{});
+    }
+}
+
+TEST(Rtcm3Store, SnapshotIsNotChangedByLaterUpdates)
+{
+    Rtcm3Store store;
+    store.updateFrame(1005, { 0x01 });
+    store.updateFrame(1077, { 0x02 });
+    const auto before = store.snapshot();
+
+    store.updateFrame(1005, { 0x03 });
+    const auto after = store.snapshot();
+
+    EXPECT_EQ(before->version(), 2u);
+    EXPECT_EQ(before->find(1005)->frame, (std::vector<uint8_t>{ 0x01 }));
+    EXPECT_EQ(after->version(), 3u);
+    EXPECT_EQ(after->find(1005)->frame, (std::vector<uint8_t>{ 0x03 }));
+    // Untouched types are shared, not copied
+    EXPECT_EQ(before->find(1077), after->find(1077));
+    EXPECT_EQ(after->find(1230), nullptr);
+}
+
+TEST(Rtcm3Store, NewerThanReturnsOnlyUnsentFrames)
+{
+    Rtcm3Store store;
+    store.updateFrame(1005, { 0x01 });
+    store.updateFrame(1077, { 0x02 });
+    const uint64_t sent = store.version();
+    store.updateFrame(1087, { 0x03 });
+    store.updateFrame(1077, { 0x04 });
+
+    const auto newer = store.snapshot()->newerThan(sent);
+    ASSERT_EQ(newer.size(), 2u);
+    EXPECT_EQ(newer[0]->id, 1077);
+    EXPECT_EQ(newer[0]->version, 4u);
+    EXPECT_EQ(newer[1]->id, 1087);
+    EXPECT_TRUE(store.snapshot()->newerThan(store.version()).empty());
+
+    const std::array<uint16_t, 3> ids = { 1087, 9999, 1005 };
+    const auto selected = store.snapshot()->select(ids);
+    ASSERT_EQ(selected.size(), 2u);
+    EXPECT_EQ(selected[0]->id, 1087);
+    EXPECT_EQ(selected[1]->id, 1005);
+}
+
+TEST(Rtcm3Store, MsmHeaderDecodesEpoch)
+{
+    const auto header = Rtcm3Store::msmHeader(
+        buildMsmFrame(1077, 345600000, true));
+    ASSERT_TRUE(header.has_value());
+    EXPECT_EQ(header->stationId, 1);
+    EXPECT_EQ(header->epochTime, 345600000u);
+    EXPECT_TRUE(header->multipleMessage);
+
+    EXPECT_FALSE(Rtcm3Store::msmHeader(buildValidRtcm3Frame(1005)));
+    // Too short to hold an MSM header
+    EXPECT_FALSE(Rtcm3Store::msmHeader(buildValidRtcm3Frame(1077)));
+}
+
+TEST(Rtcm3Store, EpochsOfAllSystemsAlign)
+{
+    // Tuesday 12:00:00 GPS time
+    const uint32_t gpsTow = 2 * 86400000 + 12 * 3600000;
+    const uint32_t expected = 12 * 3600000;
+    EXPECT_EQ(Rtcm3Store::gpsTimeOfDayMs(1077, gpsTow), expected);
+    EXPECT_EQ(Rtcm3Store::gpsTimeOfDayMs(1097, gpsTow), expected);
+    EXPECT_EQ(Rtcm3Store::gpsTimeOfDayMs(1127, gpsTow - 14000), expected);
+    // GLONASS: UTC(SU) = UTC + 3 h, UTC = GPS - 18 s
+    const uint32_t glonassTod = 15 * 3600000 - 18000;
+    EXPECT_EQ(Rtcm3Store::gpsTimeOfDayMs(1087, (2u << 27) | glonassTod),
+        expected);
+    // Across midnight
+    EXPECT_EQ(Rtcm3Store::gpsTimeOfDayMs(1087, 3600000),
+        22u * 3600000 + 18000);
+}
+
+TEST(Rtcm3Store, BundleCompletesOnLastMsmOfEpoch)
+{
+    const uint32_t gpsTow = 100000;
+    Rtcm3Store store;
+    Rtcm3Parser parser(store);
+    std::vector<uint8_t> unfinished;
+
+    std::vector<uint8_t> buffer = buildValidRtcm3Frame(1005);
+    const auto gps = buildMsmFrame(1077, gpsTow, true);
+    buffer.insert(buffer.end(), gps.begin(), gps.end());
+    parser.parse(buffer, unfinished);
+    EXPECT_EQ(store.snapshot()->lastBundleSequence(), 0u);
+
+    const auto galileo = buildMsmFrame(1097, gpsTow, true);
+    const auto beidou = buildMsmFrame(1127, gpsTow - 14000, false);
+    buffer.assign(galileo.begin(), galileo.end());
+    buffer.insert(buffer.end(), beidou.begin(), beidou.end());
+    parser.parse(buffer, unfinished);
+
+    const auto bundles = store.snapshot()->bundlesAfter(0);
+    ASSERT_EQ(bundles.size(), 1u);
+    EXPECT_EQ(bundles[0]->sequence, 1u);
+    EXPECT_EQ(bundles[0]->epochMs, gpsTow);
+    ASSERT_EQ(bundles[0]->messages.size(), 4u);
+    EXPECT_EQ(bundles[0]->messages[0]->id, 1005);
+    EXPECT_EQ(bundles[0]->messages[1]->id, 1077);
+    EXPECT_EQ(bundles[0]->messages[2]->id, 1097);
+    EXPECT_EQ(bundles[0]->messages[3]->id, 1127);
+    EXPECT_EQ(store.incompleteBundles(), 0u);
+}
+
+TEST(Rtcm3Store, IncompleteEpochIsDropped)
+{
+    Rtcm3Store store;
+    using Frames = std::vector<std::vector<uint8_t>>;
+    store.updateFrames(Frames{ buildMsmFrame(1077, 1000, true) });
+    // The epoch's last MSM was lost; the next epoch starts
+    store.updateFrames(Frames{
+        buildMsmFrame(1077, 2000, true),
+        buildMsmFrame(1087, 2000 + 3 * 3600000 - assumedGpsUtcLeapMs, false)
+    });
+
+    const auto bundles = store.snapshot()->bundlesAfter(0);
+    ASSERT_EQ(bundles.size(), 1u);
+    EXPECT_EQ(bundles[0]->epochMs, 2000u);
+    EXPECT_EQ(bundles[0]->messages.size(), 2u);
+    EXPECT_EQ(store.incompleteBundles(), 1u);
+}
+
+TEST(Rtcm3Store, BundlesAreDeliveredOnce)
+{
+    Rtcm3Store store;
+    uint64_t lastSequence = 0;
+    std::vector<Rtcm3BundlePtr> received;
+    std::jthread consumer([&](std::stop_token stoken) {
+        received = store.waitForBundles(lastSequence, stoken);
+    });
+    store.updateFrame(1005, buildValidRtcm3Frame(1005));
+    store.updateFrame(1077, buildMsmFrame(1077, 1000, false));
+    consumer.join();
+
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0]->messages.size(), 2u);
+    EXPECT_EQ(lastSequence, 1u);
+
+    for (uint32_t epoch = 2000; epoch <= 3000; epoch += 1000)
+        store.updateFrame(1077, buildMsmFrame(1077, epoch, false));
+    std::stop_source stopSource;
+    received = store.waitForBundles(lastSequence, stopSource.get_token());
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0]->epochMs, 2000u);
+    EXPECT_EQ(received[1]->epochMs, 3000u);
+    EXPECT_EQ(lastSequence, 3u);
+
+    // The latest frames are still in the snapshot, but nothing is resent
+    EXPECT_TRUE(store.snapshot()->bundlesAfter(lastSequence).empty());
+    stopSource.request_stop();
+    EXPECT_TRUE(
+        store.waitForBundles(lastSequence, stopSource.get_token()).empty());
+}
+
+TEST(Rtcm3Store, BundleHistoryIsBounded)
+{
+    Rtcm3Store store;
+    for (uint32_t epoch = 1; epoch <= 20; epoch++)
+        store.updateFrame(1077, buildMsmFrame(1077, epoch * 1000, false));
+
+    const auto bundles = store.snapshot()->bundlesAfter(0);
+    ASSERT_EQ(bundles.size(), Rtcm3Snapshot::bundleHistory);
+    EXPECT_EQ(bundles.front()->sequence, 13u);
+    EXPECT_EQ(store.snapshot()->lastBundleSequence(), 20u);
+}
+
+TEST(Rtcm3Store, CountsBundlesALaggingConsumerMissed)
+{
+    Rtcm3Store store;
+    std::stop_source stopSource;
+    uint64_t lastSequence = 0;
+    store.updateFrame(1077, buildMsmFrame(1077, 1000, false));
+    ASSERT_EQ(store.waitForBundles(lastSequence,
+        stopSource.get_token()).size(), 1u);
+
+    // Bundles 2..11 complete; the snapshot keeps 4..11 only
+    for (uint32_t epoch = 2; epoch <= 11; epoch++)
+        store.updateFrame(1077, buildMsmFrame(1077, epoch * 1000, false));
+    const auto received =
+        store.waitForBundles(lastSequence, stopSource.get_token());
+    ASSERT_EQ(received.size(), Rtcm3Snapshot::bundleHistory);
+    EXPECT_EQ(received.front()->sequence, 4u);
+    EXPECT_EQ(lastSequence, 11u);
+    EXPECT_EQ(store.skippedBundles(), 2u);
+
+    // A fresh cursor takes what is held without counting a gap
+    uint64_t fresh = 0;
+    store.updateFrame(1077, buildMsmFrame(1077, 12000, false));
+    EXPECT_EQ(store.waitForBundles(fresh, stopSource.get_token()).size(),
+        Rtcm3Snapshot::bundleHistory);
+    EXPECT_EQ(store.waitForBundles(lastSequence,
+        stopSource.get_token()).size(), 1u);
+    EXPECT_EQ(store.skippedBundles(), 2u);
+}
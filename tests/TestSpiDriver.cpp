@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "SimulatedSpidev.hpp"
+
+#include "ublox/GnssConfig.hpp"
+#include "ublox/SpiClockCalibration.hpp"
+#include "ublox/SpiDriver.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::test;
+
+namespace
+{
+
+struct SimulatedBus
+{
+    explicit SimulatedBus(const SpiProfile& profile = {},
+        const uint32_t errorAbove_Hz = UINT32_MAX,
+        const uint32_t replyDelay = 0)
+    :   spidev(new SimulatedSpidev(errorAbove_Hz, 31, replyDelay)),
+        driver(profile, std::unique_ptr<ISpidev>(spidev))
+    {
+    }
+
+    SimulatedSpidev* spidev;
+    SpiDriver driver;
+};
+
+}  // namespace
+
+TEST(SpiDriver, AppliesProfileOnOpen)
+{
+    SimulatedBus bus({ .clock_Hz = 2'000'000 });
+    EXPECT_EQ(bus.spidev->maxSpeed_Hz, 2'000'000u);
+    EXPECT_EQ(bus.spidev->bitsPerWord, 8);
+
+    bus.driver.setClock(4'000'000);
+    EXPECT_EQ(bus.spidev->maxSpeed_Hz, 4'000'000u);
+
+    std::vector<uint8_t> rx(16);
+    bus.driver.getRxBuff(rx.data(), rx.size());
+    EXPECT_EQ(bus.spidev->messages.back().front().speed_Hz, 4'000'000u);
+}
+
+// The frame goes out straight from the caller's buffer, the rest is 0xFF
+// from the idle bank
+TEST(SpiDriver, TransmitReceiveSplitsFrameAndIdleFill)
+{
+    SimulatedBus bus;
+    const std::vector<uint8_t> tx = { 0xB5, 0x62, 0x06, 0x8A };
+    std::vector<uint8_t> rx(5000);
+    bus.driver.transmitReceive(tx, rx);
+
+    ASSERT_EQ(bus.spidev->messages.size(), 2u);
+    const auto& first = bus.spidev->messages[0];
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(first[0].len, 4u);
+    EXPECT_EQ(first[0].txAddress, reinterpret_cast<uintptr_t>(tx.data()));
+    EXPECT_EQ(first[1].len, 4092u);
+    EXPECT_TRUE(first[1].idleTx);
+    EXPECT_EQ(first[1].txAddress % PageAlignedBuffer::pageSize, 0u);
+    ASSERT_EQ(bus.spidev->messages[1].size(), 1u);
+    EXPECT_EQ(bus.spidev->messages[1][0].len, 904u);
+
+    EXPECT_EQ(bus.spidev->received, tx);
+}
+
+TEST(SpiDriver, OversizedReadsAreChunkedNotFatal)
+{
+    SimulatedBus bus({ .chunkSize = 1024 });
+    std::vector<uint8_t> rx(10000);
+    bus.driver.getRxBuff(rx.data(), rx.size());
+
+    ASSERT_EQ(bus.spidev->messages.size(), 10u);
+    for (const auto& message : bus.spidev->messages)
+        EXPECT_LE(message.front().len, 1024u);
+    EXPECT_EQ(bus.spidev->messages.back().front().len, 10000u % 1024);
+}
+
+TEST(SpiDriver, SegmentsShareOneMessage)
+{
+    SimulatedBus bus;
+    std::vector<uint8_t> rx(1024);
+    const std::vector<std::span<uint8_t>> segments = {
+        std::span(rx).first(256),
+        std::span(rx).subspan(256, 256),
+        std::span(rx).subspan(512)
+    };
+    bus.driver.getRxBuffs(segments);
+
+    ASSERT_EQ(bus.spidev->messages.size(), 1u);
+    EXPECT_EQ(bus.spidev->messages[0].size(), 3u);
+}
+
+TEST(SpiClockCalibration, StepsUpToMaxClock)
+{
+    const SpiProfile profile = { .clock_Hz = 1'000'000,
+        .maxClock_Hz = 2'000'000 };
+    const auto steps = SpiClockCalibration::clockSteps(profile);
+    ASSERT_FALSE(steps.empty());
+    EXPECT_EQ(steps.front(), 1'000'000u);
+    EXPECT_EQ(steps.back(), 2'000'000u);
+    for (std::size_t i = 1; i < steps.size(); i++)
+        EXPECT_GT(steps[i], steps[i - 1]);
+}
+
+TEST(SpiClockCalibration, CleanBusReachesMaxClock)
+{
+    SimulatedBus bus({ .clock_Hz = 1'000'000, .maxClock_Hz = 5'500'000 });
+    const auto result = SpiClockCalibration(bus.driver).run();
+
+    EXPECT_EQ(result.clock_Hz, 5'500'000u);
+    EXPECT_EQ(bus.driver.profile().clock_Hz, 5'500'000u);
+    for (const auto& step : result.steps)
+        EXPECT_EQ(step.replies, SpiClockCalibration::pollsPerStep);
+}
+
+// A reply that only comes back after another SPI message is still counted
+// for its own poll, not for the next one
+TEST(SpiClockCalibration, WaitsForDelayedReply)
+{
+    SimulatedBus bus({ .clock_Hz = 1'000'000, .maxClock_Hz = 5'500'000 },
+        UINT32_MAX, 1);
+    const auto result = SpiClockCalibration(bus.driver).run();
+
+    EXPECT_EQ(result.clock_Hz, 5'500'000u);
+    for (const auto& step : result.steps)
+    {
+        EXPECT_EQ(step.replies, SpiClockCalibration::pollsPerStep);
+        EXPECT_EQ(step.checksumFailures, 0u);
+    }
+}
+
+// Above 3 MHz the simulated spidev flips bits: calibration backs off
+TEST(SpiClockCalibration, BacksOffBelowFirstErrors)
+{
+    SimulatedBus bus({ .clock_Hz = 1'000'000, .maxClock_Hz = 5'500'000 },
+        3'000'000);
+    const auto result = SpiClockCalibration(bus.driver).run();
+
+    EXPECT_LE(result.clock_Hz, 3'000'000u);
+    EXPECT_GT(result.clock_Hz, 2'000'000u);
+    EXPECT_EQ(bus.driver.profile().clock_Hz, result.clock_Hz);
+    ASSERT_GE(result.steps.size(), 2u);
+    EXPECT_FALSE(result.steps.back().clean());
+    EXPECT_GT(result.steps.back().clock_Hz, 3'000'000u);
+    EXPECT_TRUE(result.steps[result.steps.size() - 2].clean());
+}
+
+TEST(SpiProfileValidation, DefaultsAreValid)
+{
+    EXPECT_TRUE(checkSpiProfile(std::nullopt));
+    EXPECT_TRUE(checkSpiProfile(SpiProfile{}));
+}
+
+TEST(SpiProfileValidation, RejectsOutOfRangeValues)
+{
+    EXPECT_FALSE(checkSpiProfile(SpiProfile{ .clock_Hz = 6'000'000 }));
+    EXPECT_FALSE(checkSpiProfile(SpiProfile{ .clock_Hz = 50'000 }));
+    EXPECT_FALSE(checkSpiProfile(SpiProfile{ .maxClock_Hz = 20'000'000 }));
+    EXPECT_FALSE(checkSpiProfile(SpiProfile{ .bitsPerWord = 16 }));
+    EXPECT_FALSE(checkSpiProfile(SpiProfile{ .chunkSize = 64 }));
+}
@@ -0,0 +1,371 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "ublox/Gnss.hpp"
+#include "ublox/StreamServer.hpp"
+#include "ublox/UbxDispatcher.hpp"
+#include "ublox/UbxParser.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+template<typename Predicate>
+bool waitFor(Predicate&& predicate)
+{
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+std::string socketPath(const char* name)
+{
+    return "/tmp/gnsshat-test-" + std::to_string(getpid()) + "-" + name;
+}
+
+PositionVelocityTime fixAt(uint8_t ss)
+{
+    PositionVelocityTime pvt{};
+    pvt.fixQuality = EFixQuality::GpsFix2D3D;
+    pvt.fixStatus = EFixStatus::Active;
+    pvt.fixType = EFixType::Fix3D;
+    pvt.utc = { 12, 34, ss, true, 20, 0 };
+    pvt.date = { 17, 10, 2026, true };
+    pvt.latitude = 52.2297;
+    pvt.longitude = 21.0122;
+    pvt.altitude = 140.5f;
+    pvt.altitudeMSL = 110.25f;
+    pvt.visibleSatellites = 9;
+    pvt.horizontalAccuracy = 1.5f;
+    pvt.verticalAccuracy = 2.25f;
+    return pvt;
+}
+
+std::vector<uint8_t> buildFrame(uint8_t classId, uint8_t msgId,
+    std::size_t payloadSize)
+{
+    std::vector<uint8_t> frame = {
+        0xB5, 0x62, classId, msgId,
+        static_cast<uint8_t>(payloadSize & 0xFF),
+        static_cast<uint8_t>(payloadSize >> 8)
+    };
+    for (std::size_t i = 0; i < payloadSize; i++)
+        frame.push_back(static_cast<uint8_t>(i));
+    UbxParser::addChecksum(frame);
+    return frame;
+}
+
+class Client
+{
+public:
+    explicit Client(const std::string& path)
+    :   fd_(socket(AF_UNIX, SOCK_STREAM, 0))
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(),
+            sizeof(address.sun_path) - 1);
+        connected_ = connect(fd_, reinterpret_cast<sockaddr*>(&address),
+            sizeof(address)) == 0;
+    }
+
+    ~Client() { close(fd_); }
+
+    bool connected() const { return connected_; }
+
+    void send(const std::string& text)
+    {
+        ASSERT_EQ(::send(fd_, text.data(), text.size(), MSG_NOSIGNAL),
+            static_cast<ssize_t>(text.size()));
+    }
+
+    // Whatever arrived within `timeout`; empty once the server hung up
+    std::string read(std::chrono::milliseconds timeout)
+    {
+        pollfd pfd{ fd_, POLLIN, 0 };
+        if (poll(&pfd, 1, static_cast<int>(timeout.count())) <= 0)
+            return {};
+        char buffer[16384];
+        const ssize_t received = recv(fd_, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+        {
+            closed_ = true;
+            return {};
+        }
+        return std::string(buffer, received);
+    }
+
+    bool closed() const { return closed_; }
+
+private:
+    int fd_;
+    bool connected_ = false;
+    bool closed_ = false;
+};
+
+class StreamServerTest : public ::testing::Test
+{
+protected:
+    StreamServerTest()
+    {
+        config_.unixPath = socketPath(
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    }
+
+    // Publishes epochs until the client has read `needle`
+    bool publishUntil(Client& client, std::string& received,
+        const std::string& needle)
+    {
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(3);
+        while (received.find(needle) == std::string::npos)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            iTOW_ += 1000;
+            gnss_.pvt(fixAt(iTOW_ / 1000 % 60), iTOW_);
+            received += client.read(std::chrono::milliseconds(20));
+        }
+        return true;
+    }
+
+    Gnss gnss_;
+    UbxDispatcher dispatcher_;
+    StreamServerConfig config_;
+    uint32_t iTOW_ = 0;
+};
+
+}  // namespace
+
+
+TEST(StreamServer, EncodesEpochRecord)
+{
+    NavigationEpoch epoch;
+    epoch.sequence = 0x0102030405060708;
+    epoch.iTOW = 123456;
+    epoch.complete = true;
+    epoch.navigation.pvt = fixAt(56);
+    epoch.navigation.pvt.utc.nano = -1500;
+    epoch.navigation.pvt.speedOverGround = 1.25f;
+    epoch.navigation.dop = {};
+    epoch.navigation.dop.position = 1.57f;
+    epoch.timepulse.sequence = 3;
+    epoch.timepulse.realtime_ns = 1'760'000'000'000'000'000;
+    epoch.published_ns = 42;
+    SatelliteInfo sat;
+    sat.gnssId = EGnssId::Galileo;
+    sat.svId = 11;
+    sat.cno = 38;
+    sat.elevation = -3;
+    sat.azimuth = 271;
+    sat.usedInFix = true;
+    epoch.navigation.satellites = { sat, sat };
+
+    std::vector<uint8_t> record;
+    StreamServer::encodeEpoch(epoch, record);
+    ASSERT_EQ(record.size(), 92u + 2 * 8);
+
+    const auto at = [&record]<typename T>(std::size_t offset, T) {
+        T value;
+        std::memcpy(&value, record.data() + offset, sizeof(value));
+        return value;
+    };
+    EXPECT_EQ(std::string(record.begin(), record.begin() + 4), "JPE1");
+    EXPECT_EQ(at(4, uint16_t{}), 108);
+    EXPECT_EQ(record[6], 0x07);
+    EXPECT_EQ(record[7], static_cast<uint8_t>(EFixType::Fix3D));
+    EXPECT_EQ(at(8, uint64_t{}), 0x0102030405060708u);
+    EXPECT_EQ(at(16, uint32_t{}), 123456u);
+    EXPECT_EQ(at(20, int32_t{}), 522297000);
+    EXPECT_EQ(at(24, int32_t{}), 210122000);
+    EXPECT_EQ(at(28, int32_t{}), 110250);
+    EXPECT_EQ(at(32, int32_t{}), 140500);
+    EXPECT_EQ(at(36, uint32_t{}), 1500u);
+    EXPECT_EQ(at(40, uint32_t{}), 2250u);
+    EXPECT_EQ(at(44, int32_t{}), 1250);
+    EXPECT_EQ(at(52, uint16_t{}), 157);
+    EXPECT_EQ(record[59], 9);
+    EXPECT_EQ(at(60, uint16_t{}), 2026);
+    EXPECT_EQ(record[64], 12);
+    EXPECT_EQ(record[66], 56);
+    EXPECT_EQ(at(68, int32_t{}), -1500);
+    EXPECT_EQ(at(72, int64_t{}), 1'760'000'000'000'000'000);
+    EXPECT_EQ(at(80, int64_t{}), 42);
+    EXPECT_EQ(record[88], 2);
+    EXPECT_EQ(record[92], static_cast<uint8_t>(EGnssId::Galileo));
+    EXPECT_EQ(record[93], 11);
+    EXPECT_EQ(record[94], 38);
+    EXPECT_EQ(static_cast<int8_t>(record[95]), -3);
+    EXPECT_EQ(at(96, int16_t{}), 271);
+    EXPECT_EQ(record[98], 0x01);
+}
+
+TEST_F(StreamServerTest, ClientGetsNmeaByDefault)
+{
+    StreamServer server(gnss_, dispatcher_, config_);
+    ASSERT_TRUE(server.start());
+
+    Client client(config_.unixPath);
+    ASSERT_TRUE(client.connected());
+    ASSERT_TRUE(waitFor([&] { return server.stats().clients == 1; }));
+
+    std::string received;
+    ASSERT_TRUE(publishUntil(client, received, "$GNZDA"));
+    EXPECT_NE(received.find("$GNGGA,1234"), std::string::npos);
+    EXPECT_EQ(received.find("JPE1"), std::string::npos);
+}
+
+TEST_F(StreamServerTest, ClientSelectsEpochAndUbxStreams)
+{
+    StreamServer server(gnss_, dispatcher_, config_);
+    ASSERT_TRUE(server.start());
+
+    Client client(config_.unixPath);
+    ASSERT_TRUE(client.connected());
+    client.send("epoch, ubx\n");
+
+    std::string received;
+    ASSERT_TRUE(publishUntil(client, received, "JPE1"));
+    received.clear();
+
+    // Subscribed raw frames only once the command went through; repost
+    const auto frame = buildFrame(0x05, 0x01, 2);
+    const std::string expected(frame.begin(), frame.end());
+    ASSERT_TRUE(waitFor([&] {
+        dispatcher_.post(frame);
+        iTOW_ += 1000;
+        gnss_.pvt(fixAt(iTOW_ / 1000 % 60), iTOW_);
+        received += client.read(std::chrono::milliseconds(10));
+        return received.find(expected) != std::string::npos;
+    }));
+    EXPECT_EQ(received.find("$GN"), std::string::npos);
+}
+
+TEST_F(StreamServerTest, UbxFramesOfAnEpochGoOutAsOneMessage)
+{
+    StreamServer server(gnss_, dispatcher_, config_);
+    ASSERT_TRUE(server.start());
+
+    Client client(config_.unixPath);
+    ASSERT_TRUE(client.connected());
+    client.send("UBX\n");
+
+    std::string received;
+    const auto probe = buildFrame(0x05, 0x01, 2);
+    ASSERT_TRUE(waitFor([&] {
+        dispatcher_.post(probe);
+        iTOW_ += 1000;
+        gnss_.pvt(fixAt(iTOW_ / 1000 % 60), iTOW_);
+        received += client.read(std::chrono::milliseconds(10));
+        return !received.empty();
+    }));
+
+    // Let the last probe reach the batch, then flush it with an epoch
+    ASSERT_TRUE(waitFor([&] {
+        const auto stats = dispatcher_.stats();
+        return stats.callbacks == stats.posted;
+    }));
+    client.read(std::chrono::milliseconds(50));
+    iTOW_ += 1000;
+    gnss_.pvt(fixAt(iTOW_ / 1000 % 60), iTOW_);
+    while (!client.read(std::chrono::milliseconds(100)).empty())
+        ;
+    const auto messages = server.stats().messages;
+
+    std::string expected;
+    for (uint8_t id = 0x10; id < 0x15; id++)
+    {
+        const auto frame = buildFrame(0x0A, id, 16);
+        expected.append(frame.begin(), frame.end());
+        dispatcher_.post(frame);
+    }
+    ASSERT_TRUE(waitFor([&] {
+        const auto stats = dispatcher_.stats();
+        return stats.callbacks == stats.posted;
+    }));
+    EXPECT_TRUE(client.read(std::chrono::milliseconds(50)).empty());
+
+    received.clear();
+    iTOW_ += 1000;
+    gnss_.pvt(fixAt(iTOW_ / 1000 % 60), iTOW_);
+    ASSERT_TRUE(waitFor([&] {
+        received += client.read(std::chrono::milliseconds(10));
+        return received.size() >= expected.size();
+    }));
+    EXPECT_EQ(received, expected);
+    ASSERT_TRUE(waitFor([&] {
+        return server.stats().messages == messages + 1;
+    }));
+}
+
+TEST_F(StreamServerTest, SlowClientIsEvictedOthersKeepReading)
+{
+    config_.clientQueueBytes = 16 * 1024;
+    StreamServer server(gnss_, dispatcher_, config_);
+    ASSERT_TRUE(server.start());
+
+    Client slow(config_.unixPath);
+    Client reader(config_.unixPath);
+    ASSERT_TRUE(slow.connected());
+    ASSERT_TRUE(reader.connected());
+    slow.send("UBX\n");
+    reader.send("UBX\n");
+
+    // Never read by `slow`: its socket buffer fills, then its queue
+    const auto frame = buildFrame(0x0A, 0x31, 4096);
+    ASSERT_TRUE(waitFor([&] {
+        dispatcher_.post(frame);
+        reader.read(std::chrono::milliseconds(1));
+        return server.stats().evicted == 1;
+    }));
+
+    EXPECT_EQ(server.stats().clients, 1u);
+    std::string received;
+    ASSERT_TRUE(waitFor([&] {
+        dispatcher_.post(frame);
+        received += reader.read(std::chrono::milliseconds(10));
+        return !received.empty();
+    }));
+}
+
+TEST_F(StreamServerTest, RejectsClientsOverLimit)
+{
+    config_.maxClients = 1;
+    StreamServer server(gnss_, dispatcher_, config_);
+    ASSERT_TRUE(server.start());
+
+    Client first(config_.unixPath);
+    ASSERT_TRUE(waitFor([&] { return server.stats().clients == 1; }));
+    Client second(config_.unixPath);
+    ASSERT_TRUE(waitFor([&] { return server.stats().rejected == 1; }));
+
+    second.read(std::chrono::milliseconds(500));
+    EXPECT_TRUE(second.closed());
+    EXPECT_EQ(server.stats().accepted, 1u);
+}
+
+TEST(StreamServer, StartFailsWithoutListener)
+{
+    Gnss gnss;
+    UbxDispatcher dispatcher;
+    StreamServer server(gnss, dispatcher, StreamServerConfig{});
+    EXPECT_FALSE(server.start());
+}
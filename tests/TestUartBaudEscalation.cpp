@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "SimulatedUart.hpp"
+
+#include "ublox/GnssConfig.hpp"
+#include "ublox/UartBaudEscalation.hpp"
+#include "ublox/UartDriver.hpp"
+#include "ublox/ubxmsg/UBX_CFG_VALSET.hpp"
+
+
+using namespace JimmyPaputto;
+using JimmyPaputto::test::Pty;
+using JimmyPaputto::test::SimulatedUartReceiver;
+
+namespace
+{
+
+// Same path as F10TStartup: VALSET at the current rate, no ACK awaited
+UartBaudEscalation::SetBaudrate overTheSameUart(UartDriver& uartDriver)
+{
+    return [&uartDriver](const uint32_t baudrate) {
+        uartDriver.transmit(ubxmsg::UBX_CFG_VALSET::setU4(
+            UbxCfgKeys::CFG_UART1_BAUDRATE, baudrate));
+        uartDriver.drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        return true;
+    };
+}
+
+}  // namespace
+
+TEST(UartBaudEscalation, StepsUpToMaxBaudrate)
+{
+    EXPECT_EQ(UartBaudEscalation::baudSteps(115200, 921600),
+        std::vector<uint32_t>({ 230400, 460800, 921600 }));
+    EXPECT_EQ(UartBaudEscalation::baudSteps(115200, 460800),
+        std::vector<uint32_t>({ 230400, 460800 }));
+    EXPECT_TRUE(UartBaudEscalation::baudSteps(115200, 115200).empty());
+}
+
+TEST(UartBaudEscalation, SelfTestCountsBurstReplies)
+{
+    Pty pty;
+    ASSERT_TRUE(pty.isOpen());
+    SimulatedUartReceiver receiver(pty);
+    UartDriver uartDriver(pty.slave());
+    UartBaudEscalation escalation(uartDriver, overTheSameUart(uartDriver));
+
+    const auto test = escalation.selfTest();
+    EXPECT_TRUE(test.passed());
+    EXPECT_EQ(test.replies, UartBaudEscalation::pollsPerTest);
+    EXPECT_GT(test.roundTrip.count(), 0);
+    EXPECT_GT(test.throughput_Bps, 0.0);
+}
+
+TEST(UartBaudEscalation, CleanLinkReachesMaxBaudrate)
+{
+    Pty pty;
+    ASSERT_TRUE(pty.isOpen());
+    SimulatedUartReceiver receiver(pty);
+    UartDriver uartDriver(pty.slave());
+    UartBaudEscalation escalation(uartDriver, overTheSameUart(uartDriver));
+
+    const auto result = escalation.run(921600);
+    EXPECT_EQ(result.baudrate, 921600u);
+    EXPECT_EQ(result.steps.size(), 3u);
+    EXPECT_FALSE(result.linkLost);
+    EXPECT_EQ(uartDriver.currentBaudrate(), 921600u);
+    EXPECT_EQ(receiver.baudrate(), 921600u);
+}
+
+// Receiver and host fall back to the last good baud rate
+TEST(UartBaudEscalation, FallsBackToLastStableBaudrate)
+{
+    Pty pty;
+    ASSERT_TRUE(pty.isOpen());
+    SimulatedUartReceiver receiver(pty, 230400);
+    UartDriver uartDriver(pty.slave());
+    UartBaudEscalation escalation(uartDriver, overTheSameUart(uartDriver));
+
+    const auto result = escalation.run(921600);
+    EXPECT_EQ(result.baudrate, 230400u);
+    ASSERT_EQ(result.steps.size(), 2u);
+    EXPECT_TRUE(result.steps[0].passed());
+    EXPECT_FALSE(result.steps[1].passed());
+    EXPECT_GT(result.steps[1].checksumFailures, 0u);
+    EXPECT_FALSE(result.linkLost);
+    EXPECT_EQ(uartDriver.currentBaudrate(), 230400u);
+    EXPECT_EQ(receiver.baudrate(), 230400u);
+    EXPECT_EQ(receiver.baudrateChanges(), 3u);
+}
+
+TEST(UartBaudEscalation, ReportsLostLink)
+{
+    Pty pty;
+    ASSERT_TRUE(pty.isOpen());
+    SimulatedUartReceiver receiver(pty, 0);
+    UartDriver uartDriver(pty.slave());
+    UartBaudEscalation escalation(uartDriver, overTheSameUart(uartDriver));
+
+    const auto result = escalation.run(921600);
+    EXPECT_EQ(result.baudrate, 115200u);
+    EXPECT_TRUE(result.linkLost);
+}
+
+TEST(UartBaudEscalation, MaxUartBaudrateValidation)
+{
+    EXPECT_TRUE(checkUartBaudrate(std::nullopt));
+    EXPECT_TRUE(checkUartBaudrate(115200));
+    EXPECT_TRUE(checkUartBaudrate(921600));
+    EXPECT_FALSE(checkUartBaudrate(57600));
+    EXPECT_FALSE(checkUartBaudrate(1000000));
+}
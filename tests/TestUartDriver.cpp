@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "SimulatedUart.hpp"
+
+#include "ublox/UartDriver.hpp"
+#include "ublox/UartLinePacer.hpp"
+
+
+using namespace JimmyPaputto;
+using JimmyPaputto::test::Pty;
+
+namespace
+{
+
+std::vector<uint8_t> pattern(std::size_t size, uint8_t seed)
+{
+    std::vector<uint8_t> data(size);
+    for (std::size_t i = 0; i < size; i++)
+        data[i] = static_cast<uint8_t>(seed + i * 7);
+    return data;
+}
+
+}  // namespace
+
+TEST(UartDriver, TransmitvWritesFramesInOrder)
+{
+    Pty pty;
+    ASSERT_TRUE(pty.isOpen());
+    UartDriver driver(pty.slave());
+
+    const auto a = pattern(25, 1);
+    const auto b = pattern(0, 2);
+    const auto c = pattern(300, 3);
+    const std::span<const uint8_t> frames[] = { a, b, c };
+    const auto result = driver.transmitv(frames);
+
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.bytesWritten, 325u);
+    EXPECT_EQ(result.buffersWritten, 3u);
+    EXPECT_EQ(result.writeCalls, 1u);
+
+    auto expected = a;
+    expected.insert(expected.end(), c.begin(), c.end());
+    EXPECT_EQ(pty.read(expected.size()), expected);
+}
+
+// More than the TTY buffer holds: partial writes and EAGAIN, nothing lost
+TEST(UartDriver, TransmitvResumesAfterPartialWritesAndEagain)
+{
+    Pty pty;
+    ASSERT_TRUE(pty.isOpen());
+    UartDriver driver(pty.slave());
+
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<std::span<const uint8_t>> spans;
+    std::vector<uint8_t> expected;
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        frames.push_back(pattern(1000 + i * 13, i));
+        expected.insert(expected.end(), frames.back().begin(),
+            frames.back().end());
+    }
+    for (const auto& frame : frames)
+        spans.emplace_back(frame);
+
+    std::vector<uint8_t> received;
+    std::thread reader([&] {
+        received = pty.read(expected.size(), std::chrono::microseconds(200));
+    });
+    const auto result = driver.transmitv(spans, 2000);
+    reader.join();
+
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.bytesWritten, expected.size());
+    EXPECT_GT(result.stalls, 0u);
+    EXPECT_GT(result.writeCalls, 1u);
+    EXPECT_EQ(received, expected);
+}
+
+TEST(UartDriver, TransmitvGivesUpWhenLineNeverDrains)
+{
+    Pty pty;
+    ASSERT_TRUE(pty.isOpen());
+    UartDriver driver(pty.slave());
+
+    const auto small = pattern(100, 1);
+    const auto data = pattern(1 << 20, 0);
+    const std::span<const uint8_t> frames[] = { small, data, small };
+    const auto result = driver.transmitv(frames, 20);
+
+    EXPECT_FALSE(result.complete);
+    EXPECT_GT(result.bytesWritten, small.size());
+    EXPECT_LT(result.bytesWritten, small.size() + data.size());
+    EXPECT_EQ(result.buffersWritten, 1u);
+}
+
+// 115200 baud is 11520 B/s at 8N1
+// Edge-triggered epoll: what is left after a full buffer is read at once,
+// without a new edge
+TEST(UartDriver, EpollReadsWhatFullBufferLeftWithoutNewEdge)
+{
+    Pty pty;
+    ASSERT_TRUE(pty.isOpen());
+    UartDriver driver(pty.slave());
+
+    const auto data = pattern(100, 5);
+    ASSERT_EQ(::write(pty.master(), data.data(), data.size()), 100);
+
+    std::vector<uint8_t> rx(64);
+    ASSERT_EQ(driver.epoll(rx.data(), rx.size(), 1000), 64);
+    std::vector<uint8_t> received(rx.begin(), rx.end());
+    const auto rest = driver.epoll(rx.data(), rx.size(), 0);
+    ASSERT_EQ(rest, 36);
+    received.insert(received.end(), rx.begin(), rx.begin() + rest);
+    EXPECT_EQ(received, data);
+
+    EXPECT_EQ(driver.epoll(rx.data(), rx.size(), 50), 0);
+}
+
+TEST(UartLinePacer, LineTimeCountsTenBitsPerByte)
+{
+    UartLinePacer pacer(115200);
+    EXPECT_EQ(pacer.lineTime(11520), std::chrono::seconds(1));
+    pacer.setBaudrate(38400);
+    EXPECT_EQ(pacer.lineTime(3840), std::chrono::seconds(1));
+}
+
+TEST(UartLinePacer, RefusesWhatExceedsBacklogBudget)
+{
+    UartLinePacer pacer(115200, std::chrono::milliseconds(500));
+    const UartLinePacer::Clock::time_point now {};
+
+    EXPECT_TRUE(pacer.admit(4000, now));
+    EXPECT_FALSE(pacer.admit(2000, now));
+    EXPECT_TRUE(pacer.admit(1500, now));
+    EXPECT_EQ(pacer.backlog(now), pacer.lineTime(5500));
+}
+
+TEST(UartLinePacer, RefundReleasesUnwrittenLineTime)
+{
+    UartLinePacer pacer(115200, std::chrono::milliseconds(500));
+    const UartLinePacer::Clock::time_point now {};
+
+    ASSERT_TRUE(pacer.admit(5760, now));
+    EXPECT_FALSE(pacer.admit(2880, now));
+    pacer.refund(2880);
+    EXPECT_EQ(pacer.backlog(now), std::chrono::milliseconds(250));
+    EXPECT_TRUE(pacer.admit(2880, now));
+}
+
+TEST(UartLinePacer, BacklogDrainsAtLineRate)
+{
+    UartLinePacer pacer(115200, std::chrono::milliseconds(500));
+    const UartLinePacer::Clock::time_point now {};
+
+    ASSERT_TRUE(pacer.admit(5760, now));
+    EXPECT_EQ(pacer.backlog(now), std::chrono::milliseconds(500));
+    EXPECT_FALSE(pacer.admit(1, now));
+
+    const auto later = now + std::chrono::milliseconds(250);
+    EXPECT_EQ(pacer.backlog(later), std::chrono::milliseconds(250));
+    EXPECT_TRUE(pacer.admit(2880, later));
+    EXPECT_EQ(pacer.backlog(later + std::chrono::seconds(1)),
+        std::chrono::nanoseconds(0));
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "ublox/UbxChecksum.hpp"
 #include "ublox/UbxParser.hpp"
 
 
@@ -100,3 +101,29 @@ TEST(UbxChecksum, LargerPayload)
     JimmyPaputto::UbxParser::addChecksum(frame);
     EXPECT_TRUE(JimmyPaputto::UbxParser::checkFrame(frame));
 }
+
+TEST(UbxChecksum, IncrementalMatchesBytewiseOnEverySplit)
+{
+    // A long frame (NAV-SAT, 64 SVs) goes through the blocked path
+    std::vector<uint8_t> body(4 + 8 + 64 * 12);
+    for (std::size_t i = 0; i < body.size(); i++)
+        body[i] = static_cast<uint8_t>(i * 131 + 7);
+
+    uint8_t cka = 0;
+    uint8_t ckb = 0;
+    for (const auto byte : body)
+    {
+        cka += byte;
+        ckb += cka;
+    }
+
+    const std::span<const uint8_t> all(body);
+    for (std::size_t split = 0; split <= body.size(); split += 13)
+    {
+        JimmyPaputto::UbxChecksum checksum;
+        checksum.update(all.first(split));
+        checksum.update(all.subspan(split));
+        EXPECT_EQ(checksum.value()[0], cka);
+        EXPECT_EQ(checksum.value()[1], ckb);
+    }
+}
@@ -84,3 +84,13 @@ TEST(UbxClassMsgId, CfgValgetMapping)
     EXPECT_EQ(bytes.first, 0x06);
     EXPECT_EQ(bytes.second, 0x8B);
 }
+
+TEST(UbxClassMsgId, LookupIsConstexpr)
+{
+    static_assert(UbxClassMsgId::lookup(0x01, 0x07) == EUbxMsg::UBX_NAV_PVT);
+    static_assert(UbxClassMsgId::lookup(0x0D, 0x03) == EUbxMsg::UBX_TIM_TM2);
+    static_assert(UbxClassMsgId::lookup(0x01, 0x14) == EUbxMsg::END_UBX);
+    static_assert(UbxClassMsgId::lookup(0x02, 0x15) == EUbxMsg::END_UBX);
+
+    EXPECT_EQ(numberOfUbxClasses(), 5u);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/LatencyHistogram.hpp"
+#include "ublox/Gnss.hpp"
+#include "ublox/UbloxConfigRegistry.hpp"
+#include "ublox/UbxDispatcher.hpp"
+#include "ublox/UbxParser.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+std::vector<uint8_t> buildAckAck(uint8_t classId, uint8_t msgId)
+{
+    std::vector<uint8_t> frame = {
+        0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, classId, msgId
+    };
+    UbxParser::addChecksum(frame);
+    return frame;
+}
+
+std::vector<uint8_t> buildTimTm2(uint16_t count, uint32_t towRising_ms)
+{
+    std::vector<uint8_t> frame = { 0xB5, 0x62, 0x0D, 0x03, 0x1C, 0x00 };
+    frame.resize(6 + 28, 0);
+    frame[6] = 0;     // channel
+    frame[7] = 0xC0;  // timeValid, newRisingEdge
+    frame[8] = count & 0xFF;
+    frame[9] = count >> 8;
+    for (uint8_t i = 0; i < 4; i++)
+        frame[14 + i] = (towRising_ms >> (8 * i)) & 0xFF;
+    UbxParser::addChecksum(frame);
+    return frame;
+}
+
+template<typename Predicate>
+bool waitFor(Predicate&& predicate)
+{
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+class UbxDispatcherTest : public ::testing::Test
+{
+protected:
+    UbxDispatcherTest()
+    :   registry_(GnssConfig{}),
+        parser_(registry_, gnss_, navigationNotifier_, timeMarkNotifier_,
+            false, &dispatcher_)
+    {
+    }
+
+    UbxDispatcher dispatcher_;
+    UbloxConfigRegistry registry_;
+    Gnss gnss_;
+    Notifier navigationNotifier_;
+    Notifier timeMarkNotifier_;
+    UbxParser parser_;
+};
+
+}  // namespace
+
+
+TEST_F(UbxDispatcherTest, TypedCallbackGetsDecodedPayload)
+{
+    std::atomic<uint32_t> calls = 0;
+    std::atomic<uint16_t> count = 0;
+    std::atomic<uint32_t> towRising = 0;
+    dispatcher_.subscribe<EUbxMsg::UBX_TIM_TM2>(
+        [&](const TimeMark& timeMark) {
+            count = timeMark.count;
+            towRising = timeMark.towRising_ms;
+            calls++;
+        });
+
+    parser_.parse(buildTimTm2(7, 123456));
+    parser_.parse(buildAckAck(0x06, 0x8A));
+
+    ASSERT_TRUE(waitFor([&] { return calls == 1; }));
+    EXPECT_EQ(count, 7);
+    EXPECT_EQ(towRising, 123456u);
+    EXPECT_EQ(dispatcher_.stats().posted, 1u);
+}
+
+TEST_F(UbxDispatcherTest, RawCallbackGetsEveryFrame)
+{
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>> frames;
+    dispatcher_.subscribeRaw([&](std::span<const uint8_t> frame) {
+        std::lock_guard lock(mutex);
+        frames.emplace_back(frame.begin(), frame.end());
+    });
+
+    const auto ack = buildAckAck(0x06, 0x8A);
+    const auto timeMark = buildTimTm2(1, 1000);
+    parser_.parse(ack);
+    parser_.parse(timeMark);
+
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard lock(mutex);
+        return frames.size() == 2;
+    }));
+    EXPECT_EQ(frames[0], ack);
+    EXPECT_EQ(frames[1], timeMark);
+}
+
+TEST_F(UbxDispatcherTest, NothingQueuedWithoutSubscribers)
+{
+    const auto id = dispatcher_.subscribe<EUbxMsg::UBX_NAV_PVT>(
+        [](const PositionVelocityTime&) {});
+    parser_.parse(buildTimTm2(1, 1000));
+    dispatcher_.unsubscribe(id);
+    parser_.parse(buildAckAck(0x06, 0x8A));
+
+    EXPECT_EQ(dispatcher_.stats().posted, 0u);
+    EXPECT_EQ(dispatcher_.stats().dropped, 0u);
+}
+
+TEST(UbxDispatcher, SlowCallbackDropsFramesInsteadOfBlocking)
+{
+    UbxDispatcher dispatcher(4);
+    std::atomic<bool> release = false;
+    std::atomic<uint32_t> calls = 0;
+    dispatcher.subscribeRaw([&](std::span<const uint8_t>) {
+        while (!release)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        calls++;
+    });
+
+    const auto frame = buildAckAck(0x06, 0x8A);
+    for (uint8_t i = 0; i < 20; i++)
+        dispatcher.post(frame);
+
+    auto stats = dispatcher.stats();
+    EXPECT_EQ(stats.posted + stats.dropped, 20u);
+    // Worker holds at most one frame, queue the rest of what got in
+    EXPECT_LE(stats.posted, 5u);
+
+    release = true;
+    ASSERT_TRUE(waitFor([&] { return calls == stats.posted; }));
+    stats = dispatcher.stats();
+    EXPECT_EQ(stats.callbacks, stats.posted);
+    EXPECT_EQ(stats.latency.count, stats.posted);
+}
+
+TEST(LatencyHistogram, BucketsByPowerOfTwoMicroseconds)
+{
+    using namespace std::chrono_literals;
+    LatencyHistogram histogram;
+    histogram.record(500ns);
+    histogram.record(1us);
+    histogram.record(3us);
+    histogram.record(3us);
+    histogram.record(100ms);
+
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 5u);
+    EXPECT_EQ(snapshot.buckets[0], 1u);
+    EXPECT_EQ(snapshot.buckets[1], 1u);
+    EXPECT_EQ(snapshot.buckets[2], 2u);
+    EXPECT_EQ(snapshot.max_ns, 100'000'000u);
+    EXPECT_EQ(snapshot.percentile_us(0.5), 4u);
+    EXPECT_EQ(snapshot.percentile_us(1.0), 131072u);
+    EXPECT_EQ(LatencySnapshot{}.percentile_us(0.5), 0u);
+}
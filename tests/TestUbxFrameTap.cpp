@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "ublox/Gnss.hpp"
+#include "ublox/UbloxConfigRegistry.hpp"
+#include "ublox/UbxFrameSinks.hpp"
+#include "ublox/UbxFrameTap.hpp"
+#include "ublox/UbxParser.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+template<typename Predicate>
+bool waitFor(Predicate&& predicate)
+{
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+std::vector<uint8_t> buildFrame(uint8_t classId, uint8_t msgId,
+    std::vector<uint8_t> payload)
+{
+    std::vector<uint8_t> frame = {
+        0xB5, 0x62, classId, msgId,
+        static_cast<uint8_t>(payload.size() & 0xFF),
+        static_cast<uint8_t>(payload.size() >> 8)
+    };
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    UbxParser::addChecksum(frame);
+    return frame;
+}
+
+std::vector<uint8_t> buildTimTm2(uint16_t count)
+{
+    std::vector<uint8_t> payload(28, 0);
+    payload[1] = 0xC0;  // timeValid, newRisingEdge
+    payload[2] = count & 0xFF;
+    payload[3] = count >> 8;
+    return buildFrame(0x0D, 0x03, payload);
+}
+
+// RXM-RAWX header without measurements, unknown to the decoders
+std::vector<uint8_t> buildRxmRawx()
+{
+    return buildFrame(0x02, 0x15, std::vector<uint8_t>(16, 0x11));
+}
+
+class RecordingSink : public IUbxFrameSink
+{
+public:
+    void onFrame(std::span<const uint8_t> frame) override
+    {
+        frames.emplace_back(frame.begin(), frame.end());
+    }
+
+    std::vector<std::vector<uint8_t>> frames;
+};
+
+class UbxFrameTapTest : public ::testing::Test
+{
+protected:
+    UbxFrameTapTest()
+    :   registry_(GnssConfig{}),
+        parser_(registry_, gnss_, navigationNotifier_, timeMarkNotifier_,
+            false, nullptr, &tap_)
+    {
+    }
+
+    UbxFrameTap tap_;
+    UbloxConfigRegistry registry_;
+    Gnss gnss_;
+    Notifier navigationNotifier_;
+    Notifier timeMarkNotifier_;
+    UbxParser parser_;
+};
+
+}  // namespace
+
+
+TEST_F(UbxFrameTapTest, SinkGetsEveryFrameInOrder)
+{
+    auto sink = std::make_shared<RecordingSink>();
+    tap_.add(sink);
+
+    const auto rawx = buildRxmRawx();
+    const auto timeMark = buildTimTm2(5);
+    std::vector<uint8_t> stream(7, 0xFF);
+    stream.insert(stream.end(), rawx.begin(), rawx.end());
+    stream.insert(stream.end(), timeMark.begin(), timeMark.end());
+    // Second frame split across reads, the sink still sees it whole
+    parser_.parse(std::span(stream).first(stream.size() - 10));
+    parser_.parse(std::span(stream).last(10));
+
+    ASSERT_EQ(sink->frames.size(), 2u);
+    EXPECT_EQ(sink->frames[0], rawx);
+    EXPECT_EQ(sink->frames[1], timeMark);
+    ASSERT_TRUE(gnss_.timeMark().has_value());
+    EXPECT_EQ(gnss_.timeMark()->count, 5);
+}
+
+TEST_F(UbxFrameTapTest, RemovedSinkGetsNothing)
+{
+    auto sink = std::make_shared<RecordingSink>();
+    tap_.add(sink);
+    parser_.parse(buildRxmRawx());
+    tap_.remove(sink);
+    parser_.parse(buildRxmRawx());
+
+    EXPECT_EQ(sink->frames.size(), 1u);
+}
+
+TEST_F(UbxFrameTapTest, SkippedMessageReachesSinkUndecoded)
+{
+    auto sink = std::make_shared<RecordingSink>();
+    tap_.add(sink);
+    ASSERT_TRUE(tap_.skipDecode(EUbxMsg::UBX_TIM_TM2));
+
+    parser_.parse(buildTimTm2(1));
+    EXPECT_EQ(sink->frames.size(), 1u);
+    EXPECT_FALSE(gnss_.timeMark().has_value());
+
+    ASSERT_TRUE(tap_.skipDecode(EUbxMsg::UBX_TIM_TM2, false));
+    parser_.parse(buildTimTm2(2));
+    ASSERT_TRUE(gnss_.timeMark().has_value());
+    EXPECT_EQ(gnss_.timeMark()->count, 2);
+}
+
+TEST(UbxFrameTap, StartupAndEpochMessagesAlwaysDecoded)
+{
+    UbxFrameTap tap;
+    EXPECT_FALSE(tap.skipDecode(EUbxMsg::UBX_NAV_PVT));
+    EXPECT_FALSE(tap.skipDecode(EUbxMsg::UBX_ACK_ACK));
+    EXPECT_FALSE(tap.skipDecode(EUbxMsg::UBX_CFG_VALGET));
+    EXPECT_TRUE(tap.decodes(EUbxMsg::UBX_NAV_PVT));
+
+    EXPECT_TRUE(tap.skipDecode(EUbxMsg::UBX_NAV_SAT));
+    EXPECT_FALSE(tap.decodes(EUbxMsg::UBX_NAV_SAT));
+    EXPECT_TRUE(tap.decodes(EUbxMsg::UBX_NAV_DOP));
+}
+
+TEST(UbxFrameRing, DropsOldestWhenFull)
+{
+    UbxFrameRing ring(2);
+    const auto first = buildTimTm2(1);
+    const auto second = buildTimTm2(2);
+    const auto third = buildTimTm2(3);
+    ring.onFrame(first);
+    ring.onFrame(second);
+    ring.onFrame(third);
+
+    std::vector<uint8_t> frame;
+    ASSERT_TRUE(ring.tryPop(frame));
+    EXPECT_EQ(frame, second);
+    ASSERT_TRUE(ring.tryPop(frame));
+    EXPECT_EQ(frame, third);
+    EXPECT_FALSE(ring.tryPop(frame));
+    EXPECT_EQ(ring.dropped(), 1u);
+}
+
+TEST(UbxFileSink, WritesFramesBackToBack)
+{
+    const std::string path =
+        "/tmp/gnsshat-test-" + std::to_string(getpid()) + ".ubx";
+    std::remove(path.c_str());
+
+    const auto rawx = buildRxmRawx();
+    const auto timeMark = buildTimTm2(9);
+    {
+        UbxFileSink sink(path);
+        ASSERT_TRUE(sink.isOpen());
+        sink.onFrame(rawx);
+        sink.onFrame(timeMark);
+        ASSERT_TRUE(waitFor([&] { return sink.frames() == 2; }));
+        EXPECT_EQ(sink.bytes(), rawx.size() + timeMark.size());
+        EXPECT_EQ(sink.dropped(), 0u);
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<uint8_t> written(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    std::vector<uint8_t> expected(rawx);
+    expected.insert(expected.end(), timeMark.begin(), timeMark.end());
+    EXPECT_EQ(written, expected);
+    std::remove(path.c_str());
+}
+
+// Counts only what the file took: /dev/full fails the first buffer flush
+TEST(UbxFileSink, StopsCountingWhenWritesFail)
+{
+    UbxFileSink sink("/dev/full", 256);
+    ASSERT_TRUE(sink.isOpen());
+
+    const auto rawx = buildRxmRawx();
+    std::size_t posted = 0;
+    ASSERT_TRUE(waitFor([&] {
+        for (int i = 0; i < 64; i++)
+            sink.onFrame(rawx);
+        posted += 64 * rawx.size();
+        return !sink.isOpen();
+    }));
+
+    EXPECT_GT(sink.frames(), 0u);
+    EXPECT_LT(sink.bytes(), posted);
+    EXPECT_LE(sink.bytes(), 64u * 1024);
+    EXPECT_EQ(sink.bytes(), sink.frames() * rawx.size());
+}
@@ -88,6 +88,9 @@ protected:
 TEST_F(NavPvtTest, DeserializesDateAndTime)
 {
     auto frame = buildPvtFrame();
+    // nano at offset 22: -1200 ns, top of second reached from below
+    int32_t nano = -1200;
+    std::memcpy(&frame[22], &nano, 4);
     UBX_NAV_PVT msg(frame);
     auto pvt = msg.pvt();
 
@@ -101,6 +104,7 @@ TEST_F(NavPvtTest, DeserializesDateAndTime)
     EXPECT_EQ(pvt.utc.ss, 45);
     EXPECT_TRUE(pvt.utc.valid);
     EXPECT_EQ(pvt.utc.accuracy, 50);
+    EXPECT_EQ(pvt.utc.nano, -1200);
 }
 
 TEST_F(NavPvtTest, DeserializesFixInfo)
@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+
+#include "ublox/Gnss.hpp"
+#include "ublox/UbloxConfigRegistry.hpp"
+#include "ublox/UbxClassMsgId.hpp"
+#include "ublox/UbxParser.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+std::vector<uint8_t> buildAckAck(uint8_t classId, uint8_t msgId)
+{
+    std::vector<uint8_t> frame = {
+        0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, classId, msgId
+    };
+    UbxParser::addChecksum(frame);
+    return frame;
+}
+
+class UbxParserTest : public ::testing::Test
+{
+protected:
+    UbxParserTest()
+    :   registry_(GnssConfig{}),
+        parser_(registry_, gnss_, navigationNotifier_, timeMarkNotifier_,
+            false)
+    {
+    }
+
+    bool acked(EUbxMsg eUbxMsg)
+    {
+        return registry_.ack()[to_underlying(eUbxMsg)];
+    }
+
+    UbloxConfigRegistry registry_;
+    Gnss gnss_;
+    Notifier navigationNotifier_;
+    Notifier timeMarkNotifier_;
+    UbxParser parser_;
+};
+
+}  // namespace
+
+
+TEST_F(UbxParserTest, DispatchesCompleteFrame)
+{
+    auto frame = buildAckAck(0x06, 0x8A);
+    parser_.parse(frame);
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALSET));
+}
+
+TEST_F(UbxParserTest, SkipsIdleFillAroundFrames)
+{
+    std::vector<uint8_t> buffer(100, 0xFF);
+    auto frame = buildAckAck(0x06, 0x8B);
+    buffer.insert(buffer.begin() + 40, frame.begin(), frame.end());
+    parser_.parse(buffer);
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALGET));
+}
+
+TEST_F(UbxParserTest, CarriesFrameSplitAcrossChunks)
+{
+    auto frame = buildAckAck(0x06, 0x8A);
+    const std::span<const uint8_t> all(frame);
+
+    parser_.parse(all.first(7));
+    EXPECT_FALSE(acked(EUbxMsg::UBX_CFG_VALSET));
+    parser_.parse(all.subspan(7));
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALSET));
+}
+
+TEST_F(UbxParserTest, CarriesSyncWordSplitAcrossChunks)
+{
+    std::vector<uint8_t> first = { 0xFF, 0xFF, 0xB5 };
+    auto frame = buildAckAck(0x06, 0x8A);
+    std::vector<uint8_t> second(frame.begin() + 1, frame.end());
+
+    parser_.parse(first);
+    parser_.parse(second);
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALSET));
+}
+
+TEST_F(UbxParserTest, ByteByByteFeed)
+{
+    auto frame1 = buildAckAck(0x06, 0x8A);
+    auto frame2 = buildAckAck(0x06, 0x8B);
+    std::vector<uint8_t> stream;
+    stream.insert(stream.end(), frame1.begin(), frame1.end());
+    stream.insert(stream.end(), frame2.begin(), frame2.end());
+
+    for (const auto byte : stream)
+        parser_.parse(std::span<const uint8_t>(&byte, 1));
+
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALSET));
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALGET));
+}
+
+TEST_F(UbxParserTest, RejectsCorruptedFrame)
+{
+    auto frame = buildAckAck(0x06, 0x8A);
+    frame.back() ^= 0xFF;
+    parser_.parse(frame);
+    EXPECT_FALSE(acked(EUbxMsg::UBX_CFG_VALSET));
+}
+
+TEST_F(UbxParserTest, ResyncsInsideFalseCarriedFrame)
+{
+    // A false sync with a plausible length swallows the real frame behind it
+    // while it is being carried over; the real frame must still come out.
+    std::vector<uint8_t> stream = { 0xB5, 0x62, 0x01, 0x07, 0x20, 0x00 };
+    auto frame = buildAckAck(0x06, 0x8A);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+    stream.resize(stream.size() + 40, 0xFF);
+
+    const std::span<const uint8_t> all(stream);
+    parser_.parse(all.first(10));
+    parser_.parse(all.subspan(10));
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALSET));
+}
+
+TEST_F(UbxParserTest, IgnoresOversizedLengthField)
+{
+    std::vector<uint8_t> stream = { 0xB5, 0x62, 0x01, 0x07, 0xFF, 0xFF };
+    auto frame = buildAckAck(0x06, 0x8A);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+
+    parser_.parse(stream);
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALSET));
+}
+
+TEST_F(UbxParserTest, ResetDropsCarriedFrame)
+{
+    auto frame = buildAckAck(0x06, 0x8A);
+    const std::span<const uint8_t> all(frame);
+
+    parser_.parse(all.first(7));
+    parser_.reset();
+    parser_.parse(all.subspan(7));
+    EXPECT_FALSE(acked(EUbxMsg::UBX_CFG_VALSET));
+}
+
+TEST_F(UbxParserTest, CountsSkippedIdleFill)
+{
+    std::vector<uint8_t> buffer(100, 0xFF);
+    auto frame = buildAckAck(0x06, 0x8A);
+    buffer.insert(buffer.begin() + 40, frame.begin(), frame.end());
+    parser_.parse(buffer);
+
+    EXPECT_EQ(parser_.scanStats().bytesSkipped, 100u);
+    EXPECT_EQ(parser_.scanStats().falseSyncs, 0u);
+}
+
+TEST_F(UbxParserTest, RejectsLengthAboveMessageMaximum)
+{
+    // NAV-PVT payload is 92 bytes, a 0x0100 length can only be a false sync
+    std::vector<uint8_t> stream = { 0xB5, 0x62, 0x01, 0x07, 0x00, 0x01 };
+    auto frame = buildAckAck(0x06, 0x8A);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+
+    parser_.parse(stream);
+    EXPECT_TRUE(acked(EUbxMsg::UBX_CFG_VALSET));
+    EXPECT_EQ(parser_.scanStats().falseSyncs, 1u);
+    EXPECT_EQ(parser_.scanStats().checksumFailures, 0u);
+}
+
+// Noise that looks like a sync and a long frame of a class UBX does not
+// have must not hold the real frame behind it
+TEST_F(UbxParserTest, RejectsUndocumentedClassBeforeNavPvt)
+{
+    std::vector<uint8_t> stream = { 0xB5, 0x62, 0x77, 0x01, 0x00, 0x1F };
+    std::vector<uint8_t> pvt = { 0xB5, 0x62, 0x01, 0x07, 92, 0x00 };
+    pvt.resize(pvt.size() + 92);
+    UbxParser::addChecksum(pvt);
+    stream.insert(stream.end(), pvt.begin(), pvt.end());
+
+    parser_.parse(stream, monotonicRawNow());
+    EXPECT_EQ(parser_.ingressLatency(EUbxMsg::UBX_NAV_PVT).count, 1u);
+    EXPECT_EQ(parser_.scanStats().falseSyncs, 1u);
+}
+
+TEST_F(UbxParserTest, CountsChecksumFailuresAndTruncatedFrames)
+{
+    auto frame = buildAckAck(0x06, 0x8A);
+    frame.back() ^= 0xFF;
+    parser_.parse(frame);
+    EXPECT_EQ(parser_.scanStats().checksumFailures, 1u);
+
+    parser_.parse(std::span<const uint8_t>(frame).first(7));
+    parser_.reset();
+    EXPECT_EQ(parser_.scanStats().truncatedFrames, 1u);
+}
+
+// Latency is measured from the read that completed the frame
+TEST_F(UbxParserTest, IngressLatencyFromTheReadThatCompletesFrame)
+{
+    auto frame = buildAckAck(0x06, 0x8A);
+    const std::span<const uint8_t> all(frame);
+
+    parser_.parse(all.first(7), monotonicRawNow());
+    EXPECT_EQ(parser_.ingressLatency(EUbxMsg::UBX_ACK_ACK).count, 0u);
+
+    const auto rxTimestamp = monotonicRawNow() - std::chrono::milliseconds(2);
+    parser_.parse(all.subspan(7), rxTimestamp);
+    const auto latency = parser_.ingressLatency(EUbxMsg::UBX_ACK_ACK);
+    EXPECT_EQ(latency.count, 1u);
+    EXPECT_GE(latency.max_ns, 2'000'000u);
+}
+
+TEST_F(UbxParserTest, UntimedParseRecordsNoIngressLatency)
+{
+    parser_.parse(buildAckAck(0x06, 0x8A));
+    EXPECT_EQ(parser_.ingressLatency(EUbxMsg::UBX_ACK_ACK).count, 0u);
+    EXPECT_EQ(parser_.ingressLatency(EUbxMsg::END_UBX).count, 0u);
+}
+
+TEST(UbxScannerTest, MaxPayloadLengthPerMessage)
+{
+    EXPECT_EQ(UbxScanner::maxPayloadLength(0x01, 0x07), 92u);
+    EXPECT_EQ(UbxScanner::maxPayloadLength(0x05, 0x01), 2u);
+    EXPECT_EQ(UbxScanner::maxPayloadLength(0x0D, 0x03), 28u);
+    EXPECT_EQ(UbxScanner::maxPayloadLength(0x27, 0x03),
+        UbxScanner::maxFrameSize - UbxScanner::frameOverhead);
+
+    const auto [monClass, sysId] = ubxClassMsgIds[
+        to_underlying(EUbxMsg::UBX_MON_SYS)];
+    EXPECT_EQ(UbxScanner::maxPayloadLength(monClass, sysId), 24u);
+}
+
+TEST(UbxScannerTest, KnownClassesOnly)
+{
+    EXPECT_TRUE(UbxScanner::knownClass(0x02));
+    EXPECT_TRUE(UbxScanner::knownClass(0x29));
+    EXPECT_FALSE(UbxScanner::knownClass(0x00));
+    EXPECT_FALSE(UbxScanner::knownClass(0x77));
+    EXPECT_FALSE(UbxScanner::knownClass(0xF0));
+}
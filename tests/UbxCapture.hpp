@@ -0,0 +1,188 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JP_TESTS_UBX_CAPTURE_HPP_
+#define JP_TESTS_UBX_CAPTURE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "ublox/CommRecording.hpp"
+#include "ublox/Gnss.hpp"
+#include "ublox/UbloxConfigRegistry.hpp"
+#include "ublox/UbxParser.hpp"
+#include "common/Utils.hpp"
+
+
+namespace JimmyPaputto::test
+{
+
+struct UbxCapture
+{
+    std::vector<uint8_t> bytes;
+    uint32_t epochs;
+};
+
+inline std::vector<uint8_t> ubxFrame(uint8_t classId, uint8_t msgId,
+    std::span<const uint8_t> payload)
+{
+    std::vector<uint8_t> frame = { 0xB5, 0x62, classId, msgId };
+    appendLE<uint16_t>(static_cast<uint16_t>(payload.size()), frame);
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    UbxParser::addChecksum(frame);
+    return frame;
+}
+
+inline uint32_t countEpochs(std::span<const uint8_t> stream)
+{
+    constexpr std::array<uint8_t, 4> navPvtHeader = { 0xB5, 0x62, 0x01, 0x07 };
+    uint32_t epochs = 0;
+    auto it = stream.begin();
+    while (true)
+    {
+        it = std::search(it, stream.end(),
+            navPvtHeader.begin(), navPvtHeader.end());
+        if (it == stream.end())
+            return epochs;
+        epochs++;
+        it += navPvtHeader.size();
+    }
+}
+
+// Synthetic NAV-PVT + NAV-DOP + NAV-SAT + MON-RF epochs, `epochPeriodMs`
+// apart in iTOW. With `spiBatch` set every epoch is followed by 0xFF idle
+// fill up to the next read boundary, the way M9NRun drains the receiver;
+// with 0 the epochs are back to back as on UART.
+inline UbxCapture syntheticCapture(const uint32_t epochs,
+    const uint32_t spiBatch, const uint8_t numSvs = 32,
+    const uint32_t epochPeriodMs = 100)
+{
+    UbxCapture capture{ {}, epochs };
+
+    std::vector<uint8_t> pvt(92, 0);
+    pvt[17] = 0x03;
+    pvt[20] = 0x03;
+    pvt[21] = 0x01;
+    pvt[23] = numSvs;
+
+    std::vector<uint8_t> dop(18, 0);
+
+    std::vector<uint8_t> sat(8 + 12 * numSvs, 0);
+    sat[4] = 1;
+    sat[5] = numSvs;
+    for (uint8_t i = 0; i < numSvs; i++)
+    {
+        sat[8 + i * 12 + 0] = i % 7;
+        sat[8 + i * 12 + 1] = i + 1;
+        sat[8 + i * 12 + 2] = 30 + i % 20;
+        sat[8 + i * 12 + 8] = 0x1F;
+    }
+
+    std::vector<uint8_t> rf(4 + 24 * 2, 0);
+    rf[1] = 2;
+
+    for (uint32_t epoch = 0; epoch < epochs; epoch++)
+    {
+        const uint32_t iTow = epoch * epochPeriodMs;
+        std::memcpy(pvt.data(), &iTow, sizeof(iTow));
+        std::memcpy(dop.data(), &iTow, sizeof(iTow));
+        std::memcpy(sat.data(), &iTow, sizeof(iTow));
+
+        for (const auto& frame : {
+            ubxFrame(0x01, 0x07, pvt),
+            ubxFrame(0x01, 0x04, dop),
+            ubxFrame(0x01, 0x35, sat),
+            ubxFrame(0x0A, 0x38, rf) })
+        {
+            capture.bytes.insert(capture.bytes.end(), frame.begin(),
+                frame.end());
+        }
+
+        if (spiBatch > 0)
+        {
+            const auto padded =
+                (capture.bytes.size() / spiBatch + 1) * spiBatch;
+            capture.bytes.resize(padded, 0xFF);
+        }
+    }
+
+    return capture;
+}
+
+// Receiver output recorded to the file named by $GNSSHAT_UBX_CAPTURE,
+// either a RecordingCommDriver file or a raw byte dump.
+inline std::optional<UbxCapture> recordedCapture()
+{
+    const char* path = std::getenv("GNSSHAT_UBX_CAPTURE");
+    if (!path)
+        return std::nullopt;
+
+    auto recording = CommRecording::load(path);
+    if (!recording.has_value())
+        return std::nullopt;
+
+    UbxCapture capture{ std::move(recording->bytes), 0 };
+    capture.epochs = countEpochs(capture.bytes);
+    if (capture.epochs == 0)
+        return std::nullopt;
+    return capture;
+}
+
+// The capture as the receiver would have produced it: one read per epoch,
+// `epochPeriodMs` apart. Epochs of a synthetic capture are all the same
+// size, so they are cut evenly.
+inline CommRecording timedRecording(const UbxCapture& capture,
+    const uint32_t epochPeriodMs)
+{
+    CommRecording recording;
+    const std::size_t epochSize = capture.bytes.size() / capture.epochs;
+    for (uint32_t epoch = 0; epoch < capture.epochs; epoch++)
+    {
+        const auto offset = epoch * epochSize;
+        const auto size = epoch + 1 == capture.epochs
+            ? capture.bytes.size() - offset
+            : epochSize;
+        recording.append(std::chrono::milliseconds(epoch * epochPeriodMs),
+            std::span(capture.bytes).subspan(offset, size));
+    }
+    return recording;
+}
+
+// Everything one receiver owns on the parse path, as GnssHat wires it
+struct ReplayReceiver
+{
+    ReplayReceiver()
+    :   registry(GnssConfig{}),
+        parser(registry, gnss, navigationNotifier, timeMarkNotifier, false)
+    {
+    }
+
+    // Feeds the stream in `readSize` chunks, like one SPI/UART read each
+    void replay(std::span<const uint8_t> stream, const std::size_t readSize)
+    {
+        for (std::size_t offset = 0; offset < stream.size();
+            offset += readSize)
+        {
+            parser.parse(stream.subspan(offset,
+                std::min(readSize, stream.size() - offset)));
+        }
+    }
+
+    UbloxConfigRegistry registry;
+    Gnss gnss;
+    Notifier navigationNotifier;
+    Notifier timeMarkNotifier;
+    UbxParser parser;
+};
+
+}  // JimmyPaputto::bench
+
+#endif  // JP_TESTS_UBX_CAPTURE_HPP_
@@ -0,0 +1,37 @@
+/*
+ * Jimmy Paputto 2026
+ */
+
+#ifndef JP_BENCH_ALLOCATION_COUNTER_HPP_
+#define JP_BENCH_ALLOCATION_COUNTER_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace JimmyPaputto::bench
+{
+
+// Incremented by the replaced global operator new of the benchmark binary.
+extern std::atomic<uint64_t> allocationCount;
+
+class AllocationScope
+{
+public:
+    AllocationScope()
+    :   begin_(allocationCount.load(std::memory_order_relaxed))
+    {
+    }
+
+    uint64_t allocations() const
+    {
+        return allocationCount.load(std::memory_order_relaxed) - begin_;
+    }
+
+private:
+    uint64_t begin_;
+};
+
+}  // JimmyPaputto::bench
+
+#endif  // JP_BENCH_ALLOCATION_COUNTER_HPP_
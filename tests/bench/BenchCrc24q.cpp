@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "common/Crc24q.hpp"
+
+
+using namespace JimmyPaputto;
+
+namespace
+{
+
+// Rtcm3Parser::crc24q before Crc24q.hpp: one 24-bit table, byte at a time
+uint32_t legacyCrc24q(const uint8_t* data, std::size_t length)
+{
+    uint32_t crc = 0;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        crc = ((crc << 8) & 0xFFFFFF) ^
+            (detail::crc24qTables[0][(crc >> 16) ^ data[i]] >> 8);
+    }
+    return crc;
+}
+
+uint32_t slicingCrc24q(const uint8_t* data, std::size_t length)
+{
+    return detail::crc24qSlicing(0, data, length) >> 8;
+}
+
+struct Stream
+{
+    std::vector<uint8_t> bytes;
+    std::size_t frameSize;
+};
+
+// About 4 MB of RTCM3 frames of `frameSize` bytes, CRC over all but the
+// three CRC bytes as the parsers do
+Stream syntheticStream(const std::size_t frameSize)
+{
+    Stream stream { {}, frameSize };
+    const std::size_t count = (4u << 20) / frameSize;
+    stream.bytes.resize(count * frameSize);
+    for (std::size_t i = 0; i < stream.bytes.size(); i++)
+        stream.bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+    return stream;
+}
+
+template<typename CrcFn>
+double megabytesPerSecond(const Stream& stream, CrcFn&& crc,
+    uint32_t& checksum)
+{
+    constexpr int passes = 10;
+    checksum = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (std::size_t offset = 0; offset < stream.bytes.size();
+            offset += stream.frameSize)
+        {
+            checksum ^= crc(stream.bytes.data() + offset,
+                stream.frameSize - 3);
+        }
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    return passes * stream.bytes.size() / elapsed.count() / 1e6;
+}
+
+void compare(const char* name, const std::size_t frameSize)
+{
+    const auto stream = syntheticStream(frameSize);
+    uint32_t legacySum = 0;
+    uint32_t slicingSum = 0;
+    uint32_t currentSum = 0;
+    const auto legacy = megabytesPerSecond(stream, legacyCrc24q, legacySum);
+    const auto slicing =
+        megabytesPerSecond(stream, slicingCrc24q, slicingSum);
+    const auto current = megabytesPerSecond(stream, crc24q, currentSum);
+    EXPECT_EQ(slicingSum, legacySum);
+    EXPECT_EQ(currentSum, legacySum);
+
+    printf("[ BENCH    ] %-22s legacy: %7.1f MB/s | slicing-by-8: %7.1f "
+        "MB/s | crc24q: %7.1f MB/s\n", name, legacy, slicing, current);
+}
+
+}  // namespace
+
+
+TEST(Crc24qBench, Arp1005)
+{
+    compare("1005 ARP (25 B)", 25);
+}
+
+TEST(Crc24qBench, Msm7GpsTenSatellites)
+{
+    compare("1077 MSM7 10 SV (~460 B)", 460);
+}
+
+TEST(Crc24qBench, MaxFrame)
+{
+    compare("max frame (1029 B)", 1029);
+}
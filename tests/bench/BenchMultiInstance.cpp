@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "UbxCapture.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::test;
+
+namespace
+{
+
+// Replays the capture `passes` times on `instances` receivers at once, one
+// thread each, and returns the aggregate parse throughput in bytes/s
+double replayConcurrently(const UbxCapture& capture, const int instances,
+    const int passes)
+{
+    std::vector<std::unique_ptr<ReplayReceiver>> receivers;
+    for (int i = 0; i < instances; i++)
+    {
+        receivers.push_back(std::make_unique<ReplayReceiver>());
+        receivers.back()->replay(capture.bytes, 1024);
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (auto& receiver : receivers)
+        {
+            threads.emplace_back([&capture, &receiver, passes] {
+                for (int pass = 0; pass < passes; pass++)
+                    receiver->replay(capture.bytes, 1024);
+            });
+        }
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+
+    for (const auto& receiver : receivers)
+        EXPECT_EQ(receiver->gnss.navigation().satellites.size(), 32u);
+
+    return static_cast<double>(instances) * passes * capture.bytes.size() /
+        elapsed.count();
+}
+
+}  // namespace
+
+
+// Receivers share no state, so throughput should grow with instances up to
+// the number of cores; past that it can only stay flat.
+TEST(MultiInstanceBench, ParserScaling)
+{
+    const auto capture = syntheticCapture(1000, 1024);
+    const int cores = std::max(1u, std::thread::hardware_concurrency());
+
+    double single = 0;
+    for (const int instances : { 1, 2, 4, 8 })
+    {
+        const auto bytesPerSecond = replayConcurrently(capture, instances, 3);
+        if (instances == 1)
+            single = bytesPerSecond;
+
+        const auto ideal = single * std::min(instances, cores);
+        printf("[ BENCH    ] %d instances on %d cores: %8.1f MB/s "
+            "(%5.1f%% of linear)\n", instances, cores, bytesPerSecond / 1e6,
+            100.0 * bytesPerSecond / ideal);
+    }
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "UbxCapture.hpp"
+
+#include "common/JPGuard.hpp"
+#include "ublox/Gnss.hpp"
+#include "ublox/UbloxConfigRegistry.hpp"
+#include "ublox/UbxParser.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::test;
+
+namespace
+{
+
+// Gnss before SnapshotBuffer: setters and readers share one JPGuard and a
+// setter that cannot get it within 100 ms drops its update.
+class LegacyGnss
+{
+public:
+    void pvt(const PositionVelocityTime& pvt)
+    {
+        if (guard_.takeResource(100))
+        {
+            navigation_.pvt = pvt;
+            guard_.releaseResource();
+        }
+    }
+
+    void dop(const DilutionOverPrecision& dop)
+    {
+        if (guard_.takeResource(100))
+        {
+            navigation_.dop = dop;
+            guard_.releaseResource();
+        }
+    }
+
+    void satellites(const std::vector<SatelliteInfo>& satellites)
+    {
+        if (guard_.takeResource(100))
+        {
+            navigation_.satellites = satellites;
+            guard_.releaseResource();
+        }
+    }
+
+    Navigation navigation()
+    {
+        Navigation navigation;
+        if (guard_.takeResource(100))
+        {
+            navigation = navigation_;
+            guard_.releaseResource();
+        }
+        return navigation;
+    }
+
+private:
+    Navigation navigation_;
+    JPGuard guard_;
+};
+
+struct ContentionResult
+{
+    double writerUsPerEpochP50;
+    double writerUsPerEpochMax;
+    double readsPerSecond;
+};
+
+// Runs `epochs` writer steps while `readers` threads call `read` in a loop
+template<typename WriteFn, typename ReadFn>
+ContentionResult contend(const int readers, const uint32_t epochs,
+    WriteFn&& write, ReadFn&& read)
+{
+    std::atomic<bool> done = false;
+    std::atomic<uint64_t> reads = 0;
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < readers; i++)
+    {
+        threads.emplace_back([&] {
+            uint64_t local = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                const auto navigation = read();
+                local += navigation.satellites.size() > 64 ? 0 : 1;
+            }
+            reads += local;
+        });
+    }
+
+    std::vector<double> epochUs;
+    epochUs.reserve(epochs);
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint32_t epoch = 0; epoch < epochs; epoch++)
+    {
+        const auto epochBegin = std::chrono::steady_clock::now();
+        write(epoch);
+        const std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - epochBegin;
+        epochUs.push_back(elapsed.count());
+    }
+    const std::chrono::duration<double> total =
+        std::chrono::steady_clock::now() - begin;
+    done.store(true);
+    threads.clear();
+
+    std::sort(epochUs.begin(), epochUs.end());
+    return {
+        epochUs[epochUs.size() / 2],
+        epochUs.back(),
+        reads.load() / total.count()
+    };
+}
+
+void report(const char* name, const int readers, const ContentionResult& r)
+{
+    printf("[ BENCH    ] %-9s %d readers: epoch p50 %7.2f us max %8.2f us | "
+        "%10.0f reads/s\n", name, readers, r.writerUsPerEpochP50,
+        r.writerUsPerEpochMax, r.readsPerSecond);
+}
+
+}  // namespace
+
+
+TEST(NavigationContentionBench, GuardVersusSnapshot)
+{
+    constexpr uint32_t epochs = 5000;
+    PositionVelocityTime pvt {};
+    DilutionOverPrecision dop {};
+    const std::vector<SatelliteInfo> satellites(32);
+
+    for (const int readers : { 1, 2, 4, 8 })
+    {
+        LegacyGnss legacy;
+        const auto guarded = contend(readers, epochs,
+            [&](uint32_t epoch) {
+                pvt.latitude = epoch;
+                legacy.pvt(pvt);
+                legacy.dop(dop);
+                legacy.satellites(satellites);
+            },
+            [&] { return legacy.navigation(); });
+        report("JPGuard", readers, guarded);
+
+        Gnss gnss;
+        const auto snapshot = contend(readers, epochs,
+            [&](uint32_t epoch) {
+                pvt.latitude = epoch;
+                gnss.pvt(pvt, epoch * 40);
+                gnss.dop(dop, epoch * 40);
+                gnss.satellites(satellites, epoch * 40);
+            },
+            [&] { return gnss.navigation(); });
+        report("snapshot", readers, snapshot);
+    }
+}
+
+TEST(NavigationContentionBench, ParserReplayWithReaders)
+{
+    // 25 Hz stream replayed at full speed, one SPI batch per epoch
+    UbloxConfigRegistry registry(GnssConfig{});
+    Gnss gnss;
+    Notifier navigationNotifier;
+    Notifier timeMarkNotifier;
+    UbxParser parser(registry, gnss, navigationNotifier, timeMarkNotifier,
+        false);
+
+    const auto capture = syntheticCapture(2500, 1024, 32, 40);
+    const auto epochBytes = capture.bytes.size() / capture.epochs;
+    const std::span<const uint8_t> stream(capture.bytes);
+
+    for (const int readers : { 0, 4 })
+    {
+        const auto result = contend(readers, capture.epochs,
+            [&](uint32_t epoch) {
+                parser.parse(stream.subspan(epoch * epochBytes, epochBytes));
+            },
+            [&] { return gnss.navigation(); });
+        report("replay", readers, result);
+    }
+
+    const auto navigation = gnss.navigation();
+    EXPECT_EQ(navigation.pvt.visibleSatellites, 32);
+    EXPECT_EQ(navigation.satellites.size(), 32u);
+}
@@ -0,0 +1,535 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+
+#include "ublox/NmeaFormatter.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::bench;
+
+namespace
+{
+
+// NmeaForwarder's sentence builders before NmeaFormatter: ostringstream
+// and std::string concatenation, one string per field
+namespace legacy
+{
+
+const char* gnssIdToGsvTalkerId(EGnssId id)
+{
+    switch (id)
+    {
+        case EGnssId::GPS:
+        case EGnssId::SBAS:    return "GP";
+        case EGnssId::GLONASS: return "GL";
+        case EGnssId::Galileo: return "GA";
+        case EGnssId::BeiDou:  return "GB";
+        case EGnssId::QZSS:    return "GQ";
+        default:               return "GP";
+    }
+}
+
+uint8_t gnssIdToNmeaSystemId(EGnssId id)
+{
+    switch (id)
+    {
+        case EGnssId::GPS:
+        case EGnssId::SBAS:    return 1;
+        case EGnssId::GLONASS: return 2;
+        case EGnssId::Galileo: return 3;
+        case EGnssId::BeiDou:  return 4;
+        case EGnssId::QZSS:    return 5;
+        default:               return 1;
+    }
+}
+
+int satelliteToNmeaPrn(const SatelliteInfo& sat)
+{
+    switch (sat.gnssId)
+    {
+        case EGnssId::GLONASS: return sat.svId + 64;
+        default:               return sat.svId;
+    }
+}
+
+std::string calculateNmeaChecksum(const std::string& sentence);
+std::string formatLatitude(const double lat);
+std::string formatLongitude(double lon);
+std::string formatTime(const Navigation& navigation);
+std::string formatDate(const Navigation& navigation);
+
+std::string generateNmeaGGA(const Navigation& navigation)
+{
+    std::ostringstream oss;
+    
+    std::string sentence = "GNGGA,";
+    
+    sentence += formatTime(navigation) + ",";
+    
+    sentence += formatLatitude(navigation.pvt.latitude) + ",";
+    sentence += (navigation.pvt.latitude >= 0 ? "N," : "S,");
+    
+    sentence += formatLongitude(navigation.pvt.longitude) + ",";
+    sentence += (navigation.pvt.longitude >= 0 ? "E," : "W,");
+
+    const int quality = static_cast<int>(navigation.pvt.fixQuality);
+    sentence += std::to_string(quality) + ",";
+
+    sentence += std::to_string(navigation.pvt.visibleSatellites) + ",";
+
+    oss.str("");
+    oss << std::fixed << std::setprecision(1) << navigation.dop.horizontal;
+    sentence += oss.str() + ",";
+ 
+    oss.str("");
+    oss << std::fixed << std::setprecision(1) << navigation.pvt.altitudeMSL;
+    sentence += oss.str() + ",M,";
+
+    const float geoidSep = navigation.pvt.altitude - navigation.pvt.altitudeMSL;
+    oss.str("");
+    oss << std::fixed << std::setprecision(1) << geoidSep;
+    sentence += oss.str() + ",M,,";
+
+    const std::string checksum = calculateNmeaChecksum(sentence);
+    return "$" + sentence + "*" + checksum + "\r\n";
+}
+
+std::string generateNmeaRMC(const Navigation& navigation)
+{
+    std::ostringstream oss;
+
+    std::string sentence = "GNRMC,";
+
+    sentence += formatTime(navigation) + ",";
+    sentence += (navigation.pvt.fixStatus == EFixStatus::Active ? "A," : "V,");
+
+    sentence += formatLatitude(navigation.pvt.latitude) + ",";
+    sentence += (navigation.pvt.latitude >= 0 ? "N," : "S,");
+
+    sentence += formatLongitude(navigation.pvt.longitude) + ",";
+    sentence += (navigation.pvt.longitude >= 0 ? "E," : "W,");
+
+    // Speed m/s to knots
+    // 1 m/s = 1.94384 knots
+    constexpr float knotsConversionFactor = 1.94384f;
+    const float speedKnots =
+        navigation.pvt.speedOverGround * knotsConversionFactor;
+    oss.str("");
+    oss << std::fixed << std::setprecision(1) << speedKnots;
+    sentence += oss.str() + ",";
+
+    oss.str("");
+    oss << std::fixed << std::setprecision(1) << navigation.pvt.heading;
+    sentence += oss.str() + ",";
+
+    sentence += formatDate(navigation) + ",,,";
+
+    const std::string checksum = calculateNmeaChecksum(sentence);
+    return "$" + sentence + "*" + checksum + "\r\n";
+}
+
+std::string generateNmeaGSA(const Navigation& navigation)
+{
+    int fixType = 1;
+    switch (navigation.pvt.fixType)
+    {
+        case EFixType::Fix2D: fixType = 2; break;
+        case EFixType::Fix3D:
+        case EFixType::GnssWithDeadReckoning: fixType = 3; break;
+        default: fixType = 1; break;
+    }
+
+    std::map<uint8_t, std::vector<int>> usedPrnsBySystem;
+
+    for (const auto& sat : navigation.satellites)
+    {
+        if (!sat.usedInFix)
+            continue;
+
+        if (sat.gnssId == EGnssId::IMES)
+            continue;
+
+        const uint8_t sysId = gnssIdToNmeaSystemId(sat.gnssId);
+        const int prn = satelliteToNmeaPrn(sat);
+        usedPrnsBySystem[sysId].push_back(prn);
+    }
+
+    std::ostringstream ossPdop, ossHdop, ossVdop;
+    ossPdop << std::fixed << std::setprecision(1) << navigation.dop.position;
+    ossHdop << std::fixed << std::setprecision(1) << navigation.dop.horizontal;
+    ossVdop << std::fixed << std::setprecision(1) << navigation.dop.vertical;
+
+    std::string result;
+
+    if (usedPrnsBySystem.empty())
+    {
+        std::string sentence = "GNGSA,A,"
+            + std::to_string(fixType) + ",";
+
+        for (int i = 0; i < 12; i++)
+            sentence += ",";
+
+        sentence += ossPdop.str() + ","
+                  + ossHdop.str() + ","
+                  + ossVdop.str() + ",1";
+
+        result += "$" + sentence + "*"
+               + calculateNmeaChecksum(sentence) + "\r\n";
+    }
+    else
+    {
+        for (const auto& [sysId, prns] : usedPrnsBySystem)
+        {
+            std::string sentence = "GNGSA,A,"
+                + std::to_string(fixType) + ",";
+
+            for (int i = 0; i < 12; i++)
+            {
+                if (i < static_cast<int>(prns.size()))
+                    sentence += std::to_string(prns[i]);
+                sentence += ",";
+            }
+
+            sentence += ossPdop.str() + ","
+                      + ossHdop.str() + ","
+                      + ossVdop.str() + ","
+                      + std::to_string(sysId);
+
+            result += "$" + sentence + "*"
+                   + calculateNmeaChecksum(sentence) + "\r\n";
+        }
+    }
+
+    return result;
+}
+
+std::string generateNmeaGSV(const Navigation& navigation)
+{
+    std::map<uint8_t, std::vector<const SatelliteInfo*>> groups;
+
+    for (const auto& sat : navigation.satellites)
+    {
+        if (sat.gnssId == EGnssId::IMES)
+            continue;
+
+        const uint8_t sysId = gnssIdToNmeaSystemId(sat.gnssId);
+        groups[sysId].push_back(&sat);
+    }
+
+    std::string result;
+
+    for (const auto& [sysId, sats] : groups)
+    {
+        if (sats.empty())
+            continue;
+
+        const char* talkerId = gnssIdToGsvTalkerId(sats[0]->gnssId);
+        const int totalSvs = static_cast<int>(sats.size());
+        const int totalMsgs = (totalSvs + 3) / 4;
+
+        for (int msgNum = 1; msgNum <= totalMsgs; msgNum++)
+        {
+            std::string sentence = std::string(talkerId) + "GSV,"
+                + std::to_string(totalMsgs) + ","
+                + std::to_string(msgNum) + ","
+                + std::to_string(totalSvs);
+
+            const int startIdx = (msgNum - 1) * 4;
+            const int endIdx = std::min(startIdx + 4, totalSvs);
+
+            for (int i = startIdx; i < endIdx; i++)
+            {
+                const auto& sat = *sats[i];
+                const int prn = satelliteToNmeaPrn(sat);
+
+                std::ostringstream oss;
+                oss << std::setfill('0') << std::setw(2) << prn;
+                sentence += "," + oss.str();
+
+                sentence += "," + std::to_string(
+                    static_cast<int>(sat.elevation));
+
+                oss.str("");
+                oss << std::setfill('0') << std::setw(3)
+                    << sat.azimuth;
+                sentence += "," + oss.str();
+
+                sentence += ",";
+                if (sat.cno > 0)
+                {
+                    oss.str("");
+                    oss << std::setfill('0') << std::setw(2)
+                        << static_cast<int>(sat.cno);
+                    sentence += oss.str();
+                }
+            }
+
+            const std::string checksum =
+                calculateNmeaChecksum(sentence);
+            result += "$" + sentence + "*" + checksum + "\r\n";
+        }
+    }
+
+    return result;
+}
+
+std::string generateNmeaGST(const Navigation& navigation)
+{
+    std::string sentence = "GNGST,";
+
+    sentence += formatTime(navigation) + ",";
+
+    // RMS, semi-major, semi-minor, orientation - not available from UBX-NAV-PVT
+    sentence += ",,,,";
+
+    // hAcc = sqrt(stdLat^2 + stdLon^2), assuming stdLat ≈ stdLon
+    constexpr float invSqrt2 = 0.707107f;
+    const float stdLatLon = navigation.pvt.horizontalAccuracy * invSqrt2;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3) << stdLatLon;
+    sentence += oss.str() + ",";
+
+    oss.str("");
+    oss << std::fixed << std::setprecision(3) << stdLatLon;
+    sentence += oss.str() + ",";
+
+    oss.str("");
+    oss << std::fixed << std::setprecision(3) << navigation.pvt.verticalAccuracy;
+    sentence += oss.str();
+
+    const std::string checksum = calculateNmeaChecksum(sentence);
+    return "$" + sentence + "*" + checksum + "\r\n";
+}
+
+std::string calculateNmeaChecksum(const std::string& sentence)
+{
+    uint8_t checksum = 0;
+    for (const char c : sentence)
+        checksum ^= c;
+
+    std::ostringstream oss;
+    oss << std::hex << std::uppercase << std::setfill('0')
+        << std::setw(2) << (int)checksum;
+    return oss.str();
+}
+
+std::string formatLatitude(const double lat)
+{
+    const double absLat = std::abs(lat);
+    const int degrees = (int)absLat;
+    const double minutes = (absLat - degrees) * 60.0;
+
+    std::ostringstream oss;
+    oss << std::setfill('0') << std::setw(2) << degrees;
+    oss << std::fixed << std::setprecision(5) << std::setfill('0')
+        << std::setw(8) << minutes;
+    return oss.str();
+}
+
+std::string formatLongitude(double lon)
+{
+    const double absLon = std::abs(lon);
+    const int degrees = (int)absLon;
+    const double minutes = (absLon - degrees) * 60.0;
+
+    std::ostringstream oss;
+    oss << std::setfill('0') << std::setw(3) << degrees;
+    oss << std::fixed << std::setprecision(5) << std::setfill('0')
+        << std::setw(8) << minutes;
+    return oss.str();
+}
+
+std::string generateNmeaZDA(const Navigation& navigation)
+{
+    const auto& date = navigation.pvt.date;
+
+    std::string sentence = "GNZDA,";
+
+    sentence += formatTime(navigation) + ",";
+
+    if (date.valid)
+    {
+        std::ostringstream oss;
+        oss << std::setfill('0') << std::setw(2) << (int)date.day;
+        sentence += oss.str() + ",";
+
+        oss.str("");
+        oss << std::setfill('0') << std::setw(2) << (int)date.month;
+        sentence += oss.str() + ",";
+
+        sentence += std::to_string(date.year) + ",";
+    }
+    else
+    {
+        sentence += ",,,,";
+    }
+
+    // Local zone hours and minutes (UTC = 00,00)
+    sentence += "00,00";
+
+    const std::string checksum = calculateNmeaChecksum(sentence);
+    return "$" + sentence + "*" + checksum + "\r\n";
+}
+
+std::string formatTime(const Navigation& navigation)
+{
+    const auto& utc = navigation.pvt.utc;
+    if (!utc.valid)
+        return "";
+
+    std::ostringstream oss;
+    oss << std::setfill('0') << std::setw(2) << (int)utc.hh;
+    oss << std::setfill('0') << std::setw(2) << (int)utc.mm;
+    oss << std::setfill('0') << std::setw(2) << (int)utc.ss;
+    return oss.str();
+}
+
+std::string formatDate(const Navigation& navigation)
+{
+    const auto& date = navigation.pvt.date;
+    if (!date.valid)
+        return "";
+    
+    std::ostringstream oss;
+    oss << std::setfill('0') << std::setw(2) << (int)date.day;
+    oss << std::setfill('0') << std::setw(2) << (int)date.month;
+    oss << std::setfill('0') << std::setw(2) << (date.year % 100);
+    return oss.str();
+}
+
+}  // namespace legacy
+
+// A receiver tracking `numSvs` satellites over the five NMEA systems
+Navigation benchNavigation(const uint8_t numSvs)
+{
+    constexpr EGnssId systems[] = {
+        EGnssId::GPS, EGnssId::Galileo, EGnssId::GLONASS, EGnssId::BeiDou,
+        EGnssId::SBAS, EGnssId::QZSS
+    };
+
+    Navigation nav;
+    nav.pvt = {};
+    nav.pvt.fixQuality = EFixQuality::GpsFix2D3D;
+    nav.pvt.fixStatus = EFixStatus::Active;
+    nav.pvt.fixType = EFixType::Fix3D;
+    nav.pvt.utc = { 12, 30, 45, true, 20, 0 };
+    nav.pvt.date = { 15, 3, 2025, true };
+    nav.pvt.latitude = 52.2297;
+    nav.pvt.longitude = 21.0122;
+    nav.pvt.altitude = 150.61f;
+    nav.pvt.altitudeMSL = 110.27f;
+    nav.pvt.speedOverGround = 2.5f;
+    nav.pvt.heading = 87.3f;
+    nav.pvt.visibleSatellites = numSvs;
+    nav.pvt.horizontalAccuracy = 1.5f;
+    nav.pvt.verticalAccuracy = 2.25f;
+    nav.dop = { 1.6f, 1.47f, 0.9f, 1.21f, 0.84f, 0.6f, 0.6f };
+    for (uint8_t i = 0; i < numSvs; i++)
+    {
+        SatelliteInfo sat {};
+        sat.gnssId = systems[i % std::size(systems)];
+        sat.svId = i + 1;
+        sat.cno = i % 5 ? 25 + i % 20 : 0;
+        sat.elevation = static_cast<int8_t>(5 + i * 7 % 85);
+        sat.azimuth = static_cast<int16_t>(i * 37 % 360);
+        sat.usedInFix = i % 3 != 0;
+        nav.satellites.push_back(sat);
+    }
+    return nav;
+}
+
+struct EpochCost
+{
+    double microseconds;
+    double allocations;
+    std::size_t bytes;
+};
+
+// Formats `epochs` epochs of all six sentences, as the forwarder writes them
+template<typename FormatFn>
+EpochCost measure(Navigation nav, FormatFn&& format)
+{
+    constexpr int epochs = 5'000;
+    std::size_t bytes = 0;
+    AllocationScope allocations;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int epoch = 0; epoch < epochs; epoch++)
+    {
+        nav.pvt.utc.nano = (epoch % 10) * 100'000'000;
+        bytes += format(nav);
+    }
+    const std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - begin;
+
+    return {
+        elapsed.count() / epochs,
+        static_cast<double>(allocations.allocations()) / epochs,
+        bytes / epochs
+    };
+}
+
+void compare(const char* name, const uint8_t numSvs)
+{
+    const auto nav = benchNavigation(numSvs);
+
+    const auto legacyCost = measure(nav, [](const Navigation& nav) {
+        const std::string combined = legacy::generateNmeaGGA(nav) +
+            legacy::generateNmeaGSA(nav) + legacy::generateNmeaGSV(nav) +
+            legacy::generateNmeaGST(nav) + legacy::generateNmeaRMC(nav) +
+            legacy::generateNmeaZDA(nav);
+        return combined.size();
+    });
+
+    std::array<char, 4096> buffer;
+    NmeaFormatter formatter(buffer);
+    const auto cost = measure(nav, [&formatter](const Navigation& nav) {
+        formatter.clear();
+        formatter.gga(nav);
+        formatter.gsa(nav);
+        formatter.gsv(nav);
+        formatter.gst(nav);
+        formatter.rmc(nav);
+        formatter.zda(nav);
+        return formatter.sentences().size();
+    });
+
+    printf("[ BENCH    ] %-10s %5zu B | legacy: %7.2f us %5.0f allocs | "
+        "to_chars: %7.2f us %3.0f allocs\n",
+        name, cost.bytes, legacyCost.microseconds, legacyCost.allocations,
+        cost.microseconds, cost.allocations);
+
+    EXPECT_EQ(cost.allocations, 0.0);
+    EXPECT_EQ(formatter.dropped(), 0u);
+    // GGA, RMC, GST and ZDA now carry hundredths: "hhmmss.ss"
+    EXPECT_EQ(legacyCost.bytes + 4 * 3, cost.bytes);
+}
+
+}  // namespace
+
+
+TEST(NmeaBench, EightSvs)
+{
+    compare("8 SVs", 8);
+}
+
+TEST(NmeaBench, ThirtyTwoSvs)
+{
+    compare("32 SVs", 32);
+}
+
+TEST(NmeaBench, SixtyFourSvs)
+{
+    compare("64 SVs", 64);
+}
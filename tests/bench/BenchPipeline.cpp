@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "UbxCapture.hpp"
+
+#include "ublox/ReplayCommDriver.hpp"
+#include "ublox/Run.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::test;
+
+namespace
+{
+
+// Drives F10TRun over a max-speed replay until the recording is used up,
+// so driver reads, run-loop buffering, parsing and Gnss publishing are all
+// in the measurement
+void benchF10TRun(const char* scenario, CommRecording recording,
+    const uint32_t expectedEpochs, const uint32_t readSize)
+{
+    const auto totalBytes = recording.bytes.size();
+    ReplayCommDriver driver(std::move(recording), {
+        .speed = 0,
+        .chunking = EReplayChunking::UartRead,
+        .maxReadSize = readSize
+    });
+    ReplayReceiver receiver;
+    F10TRun run(driver, receiver.parser);
+
+    const auto begin = std::chrono::steady_clock::now();
+    while (!driver.finished())
+        run.execute({});
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    // A tail shorter than the parse threshold is parsed on the next idle
+    // epoll, which waits out its timeout
+    run.execute({});
+
+    const auto epochs = receiver.gnss.navigationEpoch().sequence;
+    printf("[ BENCH    ] %-14s %4u B reads: %8.1f MB/s %10.0f epochs/s\n",
+        scenario, readSize, totalBytes / elapsed.count() / 1e6,
+        epochs / elapsed.count());
+    EXPECT_EQ(epochs, expectedEpochs);
+}
+
+// Drives M9NRun off the emulated TX-ready line; a drain per epoch as
+// long as the replay keeps epochs apart
+void benchM9NRun(const char* scenario, const UbxCapture& capture,
+    const uint32_t epochPeriodMs, const double speed)
+{
+    ReplayCommDriver driver(timedRecording(capture, epochPeriodMs),
+        { .speed = speed });
+    ReplayReceiver receiver;
+    Notifier txReady;
+    M9NRun run(driver, receiver.parser, txReady, receiver.navigationNotifier);
+
+    std::jthread txReadyLine([&](std::stop_token stoken) {
+        driver.driveTxReady(txReady, stoken);
+    });
+    std::stop_source stopSource;
+    while (!driver.finished())
+        run.execute(stopSource.get_token());
+
+    const auto stats = run.drainStats();
+    printf("[ BENCH    ] %-14s %llu drains: %5.2f ioctls/drain "
+        "%6.0f B clocked/drain %5.1f%% useful, %llu overruns\n",
+        scenario, static_cast<unsigned long long>(stats.epochs),
+        static_cast<double>(stats.ioctls) / stats.epochs,
+        static_cast<double>(stats.bytesClocked) / stats.epochs,
+        100.0 * stats.efficiency(),
+        static_cast<unsigned long long>(stats.overruns));
+    EXPECT_EQ(receiver.gnss.navigationEpoch().sequence, capture.epochs);
+}
+
+}  // namespace
+
+
+TEST(PipelineBench, F10TRunUartReplay)
+{
+    const auto capture = syntheticCapture(3000, 0);
+    for (const uint32_t readSize : { 64u, 256u, 4096u })
+    {
+        benchF10TRun("f10t-replay", CommRecording::untimed(capture.bytes),
+            capture.epochs, readSize);
+    }
+}
+
+TEST(PipelineBench, M9NRunSpiDrain)
+{
+    benchM9NRun("m9n-10Hz-32sv", syntheticCapture(300, 0, 32), 100, 50);
+    benchM9NRun("m9n-25Hz-64sv", syntheticCapture(300, 0, 64), 40, 20);
+    // Everything due at once, far past the 8 KiB run buffer
+    benchM9NRun("m9n-backlog", syntheticCapture(300, 0, 32), 100, 0);
+}
+
+TEST(PipelineBench, RecordedReplay)
+{
+    const char* path = std::getenv("GNSSHAT_UBX_CAPTURE");
+    const auto recording = path
+        ? CommRecording::load(path)
+        : std::nullopt;
+    if (!recording.has_value())
+        GTEST_SKIP() << "set GNSSHAT_UBX_CAPTURE to a recorded UBX stream";
+
+    benchF10TRun("recorded", *recording, countEpochs(recording->bytes), 256);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+
+#include "common/Crc24q.hpp"
+#include "ntrip/Rtcm3FrameExtractor.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::bench;
+
+namespace
+{
+
+// NtripClient::extractFrames before Rtcm3FrameExtractor: a vector that is
+// erased from the front for every skipped byte and every frame, and one
+// vector per frame
+class LegacyExtractor
+{
+public:
+    void feed(const uint8_t* data, std::size_t len,
+        std::vector<std::vector<uint8_t>>& out)
+    {
+        buffer_.insert(buffer_.end(), data, data + len);
+        while (buffer_.size() >= 6)
+        {
+            auto it = std::find(buffer_.begin(), buffer_.end(), 0xD3);
+            if (it == buffer_.end())
+            {
+                buffer_.clear();
+                return;
+            }
+            if (it != buffer_.begin())
+                buffer_.erase(buffer_.begin(), it);
+            if (buffer_.size() < 6)
+                return;
+            if ((buffer_[1] & 0xFC) != 0)
+            {
+                buffer_.erase(buffer_.begin());
+                continue;
+            }
+            const std::size_t payloadLen =
+                (static_cast<std::size_t>(buffer_[1] & 0x03) << 8) |
+                buffer_[2];
+            const std::size_t frameLen = payloadLen + 6;
+            if (buffer_.size() < frameLen)
+                return;
+            const uint32_t received =
+                (static_cast<uint32_t>(buffer_[3 + payloadLen]) << 16) |
+                (static_cast<uint32_t>(buffer_[4 + payloadLen]) << 8) |
+                static_cast<uint32_t>(buffer_[5 + payloadLen]);
+            if (crc24q(buffer_.data(), 3 + payloadLen) != received)
+            {
+                buffer_.erase(buffer_.begin());
+                continue;
+            }
+            out.emplace_back(buffer_.begin(), buffer_.begin() + frameLen);
+            buffer_.erase(buffer_.begin(), buffer_.begin() + frameLen);
+        }
+    }
+
+private:
+    std::vector<uint8_t> buffer_;
+};
+
+std::vector<uint8_t> rtcm3Frame(const std::size_t payloadLen,
+    const uint8_t fill)
+{
+    std::vector<uint8_t> frame = {
+        0xD3,
+        static_cast<uint8_t>(payloadLen >> 8),
+        static_cast<uint8_t>(payloadLen & 0xFF),
+        0x43, 0x50
+    };
+    frame.resize(3 + payloadLen, fill);
+    const uint32_t crc = crc24q(frame.data(), frame.size());
+    frame.push_back(static_cast<uint8_t>(crc >> 16));
+    frame.push_back(static_cast<uint8_t>(crc >> 8));
+    frame.push_back(static_cast<uint8_t>(crc));
+    return frame;
+}
+
+// One second of MSM7 corrections, ~2 KB, optionally behind `noise` bytes
+// of HTTP / chunk-size junk with a 0xD3 every 64 bytes
+std::vector<uint8_t> correctionStream(const std::size_t noise)
+{
+    std::vector<uint8_t> stream;
+    for (std::size_t i = 0; i < noise; i++)
+    {
+        stream.push_back(
+            i % 64 == 0 ? 0xD3 : static_cast<uint8_t>('0' + i % 10));
+    }
+    for (const std::size_t payloadLen : { 19u, 460u, 380u, 420u, 310u })
+    {
+        const auto frame = rtcm3Frame(payloadLen, 0x5A);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+    return stream;
+}
+
+struct Result
+{
+    double microseconds;
+    uint64_t allocations;
+    std::size_t frames;
+};
+
+template<typename FeedFn>
+Result run(const std::vector<uint8_t>& stream, FeedFn&& feed)
+{
+    constexpr int epochs = 200;
+    constexpr std::size_t readSize = 1400;  // one TCP segment
+    // Warm-up epoch, lets the batch arena grow to a full epoch
+    for (std::size_t offset = 0; offset < stream.size(); offset += readSize)
+    {
+        feed(stream.data() + offset,
+            std::min(readSize, stream.size() - offset));
+    }
+
+    std::size_t frames = 0;
+    const AllocationScope allocations;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int epoch = 0; epoch < epochs; epoch++)
+    {
+        for (std::size_t offset = 0; offset < stream.size();
+            offset += readSize)
+        {
+            frames += feed(stream.data() + offset,
+                std::min(readSize, stream.size() - offset));
+        }
+    }
+    const std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    return { elapsed.count() / epochs, allocations.allocations(), frames };
+}
+
+void compare(const char* name, const std::size_t noise)
+{
+    const auto stream = correctionStream(noise);
+
+    LegacyExtractor legacyExtractor;
+    std::vector<std::vector<uint8_t>> legacyFrames;
+    const auto legacy = run(stream, [&](const uint8_t* data, std::size_t len) {
+        const std::size_t before = legacyFrames.size();
+        legacyExtractor.feed(data, len, legacyFrames);
+        const std::size_t frames = legacyFrames.size() - before;
+        legacyFrames.clear();
+        return frames;
+    });
+
+    Rtcm3FrameExtractor extractor;
+    RtcmFrameBatch batch;
+    const auto current = run(stream, [&](const uint8_t* data, std::size_t len) {
+        const std::size_t frames = extractor.feed({ data, len }, batch);
+        batch.clear();
+        return frames;
+    });
+
+    EXPECT_EQ(current.frames, legacy.frames);
+    EXPECT_EQ(current.allocations, 0u);
+
+    printf("[ BENCH    ] %-24s legacy: %8.1f us/epoch %6lu allocs | "
+        "ring: %8.1f us/epoch %6lu allocs\n", name, legacy.microseconds,
+        static_cast<unsigned long>(legacy.allocations), current.microseconds,
+        static_cast<unsigned long>(current.allocations));
+}
+
+}  // namespace
+
+
+TEST(Rtcm3ExtractorBench, CleanStream)
+{
+    compare("clean", 0);
+}
+
+TEST(Rtcm3ExtractorBench, NoiseBeforeFrames)
+{
+    compare("64 KiB noise", 64 * 1024);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "UbxCapture.hpp"
+
+#include "ublox/UbxChecksum.hpp"
+#include "ublox/UbxParser.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::test;
+
+namespace
+{
+
+// UbxParser::checkFrame before UbxChecksum, the byte-at-a-time baseline
+bool legacyCheckFrame(std::span<const uint8_t> frame)
+{
+    uint8_t cka = 0;
+    uint8_t ckb = 0;
+
+    for (std::size_t i = 2; i < frame.size() - 2; i++)
+    {
+        cka += frame[i];
+        ckb += cka;
+    }
+
+    return cka == frame[frame.size() - 2] && ckb == frame[frame.size() - 1];
+}
+
+bool checkFrame(std::span<const uint8_t> frame)
+{
+    UbxChecksum checksum;
+    checksum.update(frame.subspan(2, frame.size() - 4));
+    return checksum.matches(frame.last(2));
+}
+
+struct Stream
+{
+    std::vector<uint8_t> bytes;
+    std::vector<std::span<const uint8_t>> frames;
+};
+
+// About 4 MB of back-to-back frames with `payloadSize` bytes of payload
+Stream syntheticStream(const uint16_t payloadSize)
+{
+    Stream stream;
+    std::vector<uint8_t> payload(payloadSize);
+    for (std::size_t i = 0; i < payload.size(); i++)
+        payload[i] = static_cast<uint8_t>(i * 37 + 11);
+
+    const auto frame = ubxFrame(0x0A, 0x31, payload);
+    const std::size_t count = (4u << 20) / frame.size();
+    stream.bytes.reserve(count * frame.size());
+    for (std::size_t i = 0; i < count; i++)
+        stream.bytes.insert(stream.bytes.end(), frame.begin(), frame.end());
+    for (std::size_t i = 0; i < count; i++)
+        stream.frames.emplace_back(stream.bytes.data() + i * frame.size(),
+            frame.size());
+    return stream;
+}
+
+template<typename CheckFn>
+double megabytesPerSecond(const Stream& stream, CheckFn&& check)
+{
+    constexpr int passes = 10;
+    std::size_t valid = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+        for (const auto frame : stream.frames)
+            valid += check(frame);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(valid, passes * stream.frames.size());
+    return passes * stream.bytes.size() / elapsed.count() / 1e6;
+}
+
+void compare(const char* name, const uint16_t payloadSize)
+{
+    const auto stream = syntheticStream(payloadSize);
+    const auto legacy = megabytesPerSecond(stream, legacyCheckFrame);
+    const auto current = megabytesPerSecond(stream, checkFrame);
+    printf("[ BENCH    ] %-22s legacy: %8.1f MB/s | blocked: %8.1f MB/s\n",
+        name, legacy, current);
+}
+
+}  // namespace
+
+
+TEST(UbxChecksumBench, NavPvt)
+{
+    compare("NAV-PVT (92 B)", 92);
+}
+
+TEST(UbxChecksumBench, NavSat64Svs)
+{
+    compare("NAV-SAT 64 SVs (776 B)", 8 + 64 * 12);
+}
+
+TEST(UbxChecksumBench, MonSpanTwoBlocks)
+{
+    compare("MON-SPAN 2 RF (548 B)", 4 + 2 * 272);
+}
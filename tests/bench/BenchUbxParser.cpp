@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+#include "UbxCapture.hpp"
+
+#include "ublox/Gnss.hpp"
+#include "ublox/UbloxConfigRegistry.hpp"
+#include "ublox/UbxCallbacks.hpp"
+#include "ublox/UbxParser.hpp"
+
+
+using namespace JimmyPaputto;
+using namespace JimmyPaputto::bench;
+using namespace JimmyPaputto::test;
+
+namespace
+{
+
+// The frame extraction UbxParser::parse used before the span-based path,
+// kept as the baseline: every frame is copied into one of 300 pre-reserved
+// vectors and the unfinished tail is returned by value. Decoding goes
+// through the current UbxCallbacks so only extraction is compared.
+class LegacyUbxParser
+{
+public:
+    explicit LegacyUbxParser(UbxCallbacks& ubxCallbacks)
+    :   endFrameIt_(frames_.end()),
+        ubxCallbacks_(ubxCallbacks)
+    {
+        unfinishedFrameFromBuffer_.reserve(1024);
+        for (auto& frame: frames_)
+            frame.reserve(1024);
+    }
+
+    std::vector<uint8_t> parse(std::span<const uint8_t> buffer)
+    {
+        unfinishedFrameFromBuffer_.clear();
+        extractFrames(buffer);
+        for (auto frameIt = frames_.begin(); frameIt != endFrameIt_; frameIt++)
+        {
+            if (frameIt->empty())
+                continue;
+
+            ubxCallbacks_.dispatch(*frameIt);
+        }
+        return unfinishedFrameFromBuffer_;
+    }
+
+private:
+    void extractFrames(std::span<const uint8_t> buffer)
+    {
+        std::array<uint8_t, 2> pattern {0xB5, 0x62};
+        auto bufferBegin = buffer.begin();
+        for (auto frameIt = frames_.begin(); frameIt != endFrameIt_; frameIt++)
+            frameIt->clear();
+
+        endFrameIt_ = frames_.begin();
+
+        for (uint16_t frameIndex = 0; frameIndex < maxNumberOfFrames_;
+            frameIndex++)
+        {
+            const auto beginFrameIterator = std::search(
+                bufferBegin, buffer.end(), pattern.begin(), pattern.end()
+            );
+
+            if (beginFrameIterator != buffer.end() &&
+                std::distance(beginFrameIterator, buffer.end()) > 5)
+            {
+                auto endFrameIterator = beginFrameIterator + 4;
+                uint16_t dataLength;
+                std::memcpy(&dataLength, &(*endFrameIterator), sizeof(uint16_t));
+                if (std::distance(++endFrameIterator, buffer.end()) <
+                    dataLength + 3)
+                {
+                    std::copy(beginFrameIterator, buffer.end(),
+                        std::back_inserter(unfinishedFrameFromBuffer_));
+                    break;
+                }
+                endFrameIterator += dataLength + 3;
+                std::copy(beginFrameIterator, endFrameIterator,
+                    std::back_inserter(frames_[frameIndex]));
+                if (!UbxParser::checkFrame(frames_[frameIndex]))
+                    frames_[frameIndex].clear();
+                endFrameIt_++;
+                bufferBegin = endFrameIterator;
+            }
+            else if (beginFrameIterator != buffer.end())
+            {
+                std::copy(beginFrameIterator, buffer.end(),
+                    std::back_inserter(unfinishedFrameFromBuffer_));
+                break;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    constexpr static uint16_t maxNumberOfFrames_ = 300;
+    std::array<std::vector<uint8_t>, maxNumberOfFrames_> frames_;
+    std::array<std::vector<uint8_t>, maxNumberOfFrames_>::iterator endFrameIt_;
+    std::vector<uint8_t> unfinishedFrameFromBuffer_;
+    UbxCallbacks& ubxCallbacks_;
+};
+
+struct BenchResult
+{
+    double bytesPerSecond;
+    double allocationsPerEpoch;
+};
+
+// Replays `capture` in reads of `readSize` bytes, the way M9NRun (one read
+// per SPI batch) and F10TRun (whatever epoll returned) hand data over.
+template<typename ReadFn>
+BenchResult replay(const UbxCapture& capture, const uint32_t readSize,
+    ReadFn&& onRead)
+{
+    const std::span<const uint8_t> stream(capture.bytes);
+
+    // Warm-up pass so one-time growth of decoder scratch vectors and the
+    // Gnss state is not attributed to steady state.
+    for (std::size_t offset = 0; offset < stream.size(); offset += readSize)
+        onRead(stream.subspan(offset,
+            std::min<std::size_t>(readSize, stream.size() - offset)));
+
+    constexpr int passes = 5;
+    const AllocationScope allocations;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (std::size_t offset = 0; offset < stream.size();
+            offset += readSize)
+        {
+            onRead(stream.subspan(offset,
+                std::min<std::size_t>(readSize, stream.size() - offset)));
+        }
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+
+    return {
+        passes * stream.size() / elapsed.count(),
+        static_cast<double>(allocations.allocations()) /
+            (passes * capture.epochs)
+    };
+}
+
+void report(const char* scenario, const BenchResult& legacy,
+    const BenchResult& current)
+{
+    printf("[ BENCH    ] %-14s legacy: %8.1f MB/s %6.2f allocs/epoch | "
+        "span: %8.1f MB/s %6.2f allocs/epoch\n",
+        scenario,
+        legacy.bytesPerSecond / 1e6, legacy.allocationsPerEpoch,
+        current.bytesPerSecond / 1e6, current.allocationsPerEpoch);
+}
+
+class UbxParserBench : public ::testing::Test
+{
+protected:
+    UbxParserBench()
+    :   registry_(GnssConfig{}),
+        callbacks_(registry_, gnss_, navigationNotifier_, timeMarkNotifier_,
+            false),
+        legacy_(callbacks_),
+        parser_(registry_, gnss_, navigationNotifier_, timeMarkNotifier_,
+            false),
+        runRxBuff_(8192)
+    {
+    }
+
+    BenchResult runLegacy(const UbxCapture& capture, const uint32_t readSize)
+    {
+        uint32_t offset = 0;
+        return replay(capture, readSize, [&](std::span<const uint8_t> read) {
+            if (offset + read.size() > runRxBuff_.size())
+                offset = 0;
+            std::memcpy(runRxBuff_.data() + offset, read.data(), read.size());
+            const auto unfinished = legacy_.parse(std::vector<uint8_t>(
+                runRxBuff_.data(), runRxBuff_.data() + offset + read.size()));
+            std::copy(unfinished.begin(), unfinished.end(),
+                runRxBuff_.begin());
+            offset = unfinished.size();
+        });
+    }
+
+    BenchResult runSpan(const UbxCapture& capture, const uint32_t readSize)
+    {
+        return replay(capture, readSize, [&](std::span<const uint8_t> read) {
+            std::memcpy(runRxBuff_.data(), read.data(), read.size());
+            parser_.parse(std::span<const uint8_t>(runRxBuff_.data(),
+                read.size()));
+        });
+    }
+
+    UbloxConfigRegistry registry_;
+    Gnss gnss_;
+    Notifier navigationNotifier_;
+    Notifier timeMarkNotifier_;
+    UbxCallbacks callbacks_;
+    LegacyUbxParser legacy_;
+    UbxParser parser_;
+    std::vector<uint8_t> runRxBuff_;
+};
+
+}  // namespace
+
+
+TEST_F(UbxParserBench, SpiEpochBatches)
+{
+    constexpr uint32_t spiBatch = 1024;
+    const auto capture = syntheticCapture(3000, spiBatch);
+    const auto epochBytes = capture.bytes.size() / capture.epochs;
+
+    const auto legacy = runLegacy(capture, epochBytes);
+    const auto current = runSpan(capture, epochBytes);
+    report("spi-10Hz", legacy, current);
+
+    EXPECT_EQ(current.allocationsPerEpoch, 0.0);
+}
+
+TEST_F(UbxParserBench, UartChunks)
+{
+    const auto capture = syntheticCapture(3000, 0);
+
+    const auto legacy = runLegacy(capture, 100);
+    const auto current = runSpan(capture, 100);
+    report("uart-100B", legacy, current);
+
+    EXPECT_EQ(current.allocationsPerEpoch, 0.0);
+}
+
+TEST_F(UbxParserBench, RecordedCapture)
+{
+    const auto capture = recordedCapture();
+    if (!capture.has_value())
+        GTEST_SKIP() << "set GNSSHAT_UBX_CAPTURE to a recorded UBX stream";
+
+    const auto legacy = runLegacy(*capture, 1024);
+    const auto current = runSpan(*capture, 1024);
+    report("recorded", legacy, current);
+
+    EXPECT_EQ(current.allocationsPerEpoch, 0.0);
+}